@@ -36,6 +36,7 @@ namespace Piccolo
         void updateCursorOnAxis(Vector2 cursor_uv);
         void processEditorCommand();
         void onKeyInEditorMode(int key, int scancode, int action, int mods);
+        void toggleProfilerCapture();
 
         void onKey(int key, int scancode, int action, int mods);
         void onReset();
@@ -4,6 +4,9 @@
 #include "editor/include/editor_global_context.h"
 #include "editor/include/editor_scene_manager.h"
 
+#include "runtime/core/base/macro.h"
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/engine.h"
 #include "runtime/function/framework/level/level.h"
 #include "runtime/function/framework/world/world_manager.h"
@@ -14,6 +17,8 @@
 #include "runtime/function/render/render_system.h"
 #include "runtime/function/render/window_system.h"
 
+#include "runtime/resource/config_manager/config_manager.h"
+
 namespace Piccolo
 {
     void EditorInputManager::initialize() { registerInput(); }
@@ -174,12 +179,40 @@ namespace Piccolo
 
     void EditorInputManager::onKey(int key, int scancode, int action, int mods)
     {
+        if (key == GLFW_KEY_F9 && action == GLFW_PRESS)
+        {
+            toggleProfilerCapture();
+        }
+
         if (g_is_editor_mode)
         {
             onKeyInEditorMode(key, scancode, action, mods);
         }
     }
 
+    void EditorInputManager::toggleProfilerCapture()
+    {
+        if (!Profiler::isCapturing())
+        {
+            Profiler::startCapture();
+            LOG_INFO("profiler capture started");
+            return;
+        }
+
+        Profiler::stopCapture();
+
+        const std::filesystem::path trace_file_path =
+            g_runtime_global_context.m_config_manager->getRootFolder() / "piccolo_trace.json";
+        if (Profiler::saveChromeTrace(trace_file_path))
+        {
+            LOG_INFO("profiler capture saved to {}", trace_file_path.generic_string());
+        }
+        else
+        {
+            LOG_ERROR("failed to save profiler capture to {}", trace_file_path.generic_string());
+        }
+    }
+
     void EditorInputManager::onReset()
     {
         // to do
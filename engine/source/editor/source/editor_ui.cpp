@@ -329,8 +329,8 @@ namespace Piccolo
             {
                 if (ImGui::MenuItem("Reload Current Level"))
                 {
+                    // the render scene is cleared by the world manager when the reloaded level takes over
                     g_runtime_global_context.m_world_manager->reloadCurrentLevel();
-                    g_runtime_global_context.m_render_system->clearForLevelReloading();
                     g_editor_global_context.m_scene_manager->onGObjectSelected(k_invalid_gobject_id);
                 }
                 if (ImGui::MenuItem("Save Current Level"))
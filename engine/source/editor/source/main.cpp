@@ -1,10 +1,21 @@
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <string>
 #include <thread>
 #include <unordered_map>
 
+#include "runtime/core/base/macro.h"
+#include "runtime/core/meta/meta_example.h"
+#include "runtime/core/profile/profiler.h"
 #include "runtime/engine.h"
+#include "runtime/function/animation/animation_benchmark.h"
+#include "runtime/function/framework/component/component_store_benchmark.h"
+#include "runtime/function/render/render_draw_list_benchmark.h"
+#include "runtime/function/render/render_entity_spawn_benchmark.h"
+#include "runtime/function/render/interface/vulkan/vulkan_upload_queue_test.h"
+#include "runtime/function/render/render_import_cache_test.h"
+#include "runtime/resource/asset_manager/asset_cooker.h"
 
 #include "editor/include/editor.h"
 
@@ -19,6 +30,163 @@ int main(int argc, char** argv)
 
     Piccolo::PiccoloEngine* engine = new Piccolo::PiccoloEngine();
 
+    // --cook: convert the json assets into the cooked binary format and exit
+    if (argc >= 2 && std::string(argv[1]) == "--cook")
+    {
+        engine->startEngine(config_file_path.generic_string(), true);
+
+        Piccolo::AssetCooker asset_cooker;
+        asset_cooker.cookAllAssets();
+
+        engine->shutdownEngine();
+
+        return 0;
+    }
+
+    // --animation-benchmark <character_count> <frame_count>: sample the player animation for that many characters
+    if (argc >= 4 && std::string(argv[1]) == "--animation-benchmark")
+    {
+        engine->startEngine(config_file_path.generic_string(), true);
+
+        Piccolo::runAnimationSamplingBenchmark("asset/objects/character/player/player.object.json",
+                                               static_cast<uint32_t>(std::stoul(argv[2])),
+                                               static_cast<uint32_t>(std::stoul(argv[3])));
+
+        engine->shutdownEngine();
+
+        return 0;
+    }
+
+    // --component-store-benchmark <frame_count>: tick the transforms of 10k, 50k and 100k objects from the heap and
+    // from a component store
+    if (argc >= 3 && std::string(argv[1]) == "--component-store-benchmark")
+    {
+        engine->startEngine(config_file_path.generic_string(), true);
+
+        for (const uint32_t object_count : {10000u, 50000u, 100000u})
+        {
+            Piccolo::runComponentStoreBenchmark(object_count, static_cast<uint32_t>(std::stoul(argv[2])));
+        }
+
+        engine->shutdownEngine();
+
+        return 0;
+    }
+
+    // --draw-list-benchmark <node_count> <frame_count>: build the main camera draw list of that many visible nodes
+    if (argc >= 4 && std::string(argv[1]) == "--draw-list-benchmark")
+    {
+        engine->startEngine(config_file_path.generic_string(), true);
+
+        Piccolo::runDrawListBenchmark(static_cast<uint32_t>(std::stoul(argv[2])),
+                                      static_cast<uint32_t>(std::stoul(argv[3])));
+
+        engine->shutdownEngine();
+
+        return 0;
+    }
+
+    // --meta-lookup-benchmark: look up the reflection type meta of the example classes by name
+    if (argc >= 2 && std::string(argv[1]) == "--meta-lookup-benchmark")
+    {
+        engine->startEngine(config_file_path.generic_string(), true);
+
+        Piccolo::metaLookupBenchmark();
+
+        engine->shutdownEngine();
+
+        return 0;
+    }
+
+    // --render-entity-benchmark <entity_count> <round_count>: spawn and despawn that many render entities per round
+    if (argc >= 4 && std::string(argv[1]) == "--render-entity-benchmark")
+    {
+        engine->startEngine(config_file_path.generic_string(), true);
+
+        Piccolo::runRenderEntitySpawnBenchmark(static_cast<uint32_t>(std::stoul(argv[2])),
+                                               static_cast<uint32_t>(std::stoul(argv[3])));
+
+        engine->shutdownEngine();
+
+        return 0;
+    }
+
+    // --import-cache-test: check the invalidation of the import cache in a temporary folder, fails if a check fails
+    if (argc >= 2 && std::string(argv[1]) == "--import-cache-test")
+    {
+        engine->startEngine(config_file_path.generic_string(), true);
+
+        const std::filesystem::path cache_folder = std::filesystem::temp_directory_path() / "piccolo_import_cache_test";
+        const bool                  is_passed    = Piccolo::runImportCacheInvalidationTest(cache_folder);
+
+        engine->shutdownEngine();
+
+        return is_passed ? 0 : 1;
+    }
+
+    // --upload-queue-test <mesh_count> <texture_count>: upload meshes and textures through the staging ring on an
+    // offscreen vulkan device and read them back, fails on a mismatch or when the ring never wrapped
+    if (argc >= 4 && std::string(argv[1]) == "--upload-queue-test")
+    {
+        engine->startEngine(config_file_path.generic_string(), true);
+
+        const bool is_passed = Piccolo::runUploadQueueStressTest(static_cast<uint32_t>(std::stoul(argv[2])),
+                                                                 static_cast<uint32_t>(std::stoul(argv[3])));
+
+        engine->shutdownEngine();
+
+        return is_passed ? 0 : 1;
+    }
+
+    // --headless <frame_count> [trace_file]: tick the default world without window and gpu and log per-system
+    // timings, the optional trace file receives a Chrome trace of the run
+    if (argc >= 3 && std::string(argv[1]) == "--headless")
+    {
+        const uint32_t frame_count = static_cast<uint32_t>(std::stoul(argv[2]));
+
+        engine->startEngine(config_file_path.generic_string(), true);
+        engine->initialize();
+
+        if (argc >= 4)
+        {
+            Piccolo::Profiler::startCapture();
+        }
+
+        engine->runHeadless(frame_count, 1.0f / 60.0f);
+
+        if (argc >= 4)
+        {
+            Piccolo::Profiler::stopCapture();
+            if (!Piccolo::Profiler::saveChromeTrace(argv[3]))
+            {
+                // the log macros refer to the engine globals unqualified
+                using namespace Piccolo;
+                LOG_ERROR("failed to write trace file {}", argv[3]);
+            }
+        }
+
+        engine->clear();
+        engine->shutdownEngine();
+
+        return 0;
+    }
+
+    // --headless-pipelined <frame_count>: tick the default world with the render thread and without window and gpu,
+    // fails if the render thread does not consume every frame once and in order
+    if (argc >= 3 && std::string(argv[1]) == "--headless-pipelined")
+    {
+        engine->startEngine(config_file_path.generic_string(), true);
+        engine->initialize();
+
+        const bool is_in_order =
+            engine->runHeadlessPipelined(static_cast<uint32_t>(std::stoul(argv[2])), 1.0f / 60.0f);
+
+        engine->clear();
+        engine->shutdownEngine();
+
+        return is_in_order ? 0 : 1;
+    }
+
     engine->startEngine(config_file_path.generic_string());
     engine->initialize();
 
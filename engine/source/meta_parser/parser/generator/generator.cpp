@@ -17,6 +17,7 @@ namespace Generator
         class_def.set("class_name", class_temp->getClassName());
         class_def.set("class_base_class_size", std::to_string(class_temp->m_base_classes.size()));
         class_def.set("class_need_register", true);
+        class_def.set("class_lua_bindable", class_temp->shouldBindLua());
 
         if (class_temp->m_base_classes.size() > 0)
         {
@@ -56,6 +57,9 @@ namespace Generator
             filed_define.set("class_field_display_name", field->m_display_name);
             bool is_vector = field->m_type.find(vector_prefix) == 0;
             filed_define.set("class_field_is_vector", is_vector);
+            // plain values and reflected classes, containers and pointers are left to the reflection accessors
+            bool is_lua_bindable = field->m_type.find_first_of("<*&[") == std::string::npos;
+            filed_define.set("class_field_is_lua_bindable", is_lua_bindable);
             feild_defs.push_back(filed_define);
         }
     }
@@ -68,7 +72,9 @@ namespace Generator
                 continue;
             Mustache::data method_define;
 
-            method_define.set("class_method_name", method->m_name);   
+            method_define.set("class_method_name", method->m_name);
+            // lua binds methods as calls without arguments
+            method_define.set("class_method_is_lua_bindable", method->m_parameter_count == 0);
             method_defs.push_back(method_define);
         }
     }
@@ -21,6 +21,7 @@ namespace Generator
         GeneratorInterface::prepareStatus(path);
         TemplateManager::getInstance()->loadTemplates(m_root_path, "commonReflectionFile");
         TemplateManager::getInstance()->loadTemplates(m_root_path, "allReflectionFile");
+        TemplateManager::getInstance()->loadTemplates(m_root_path, "allComponentTypeIdFile");
         return;
     }
 
@@ -44,9 +45,20 @@ namespace Generator
             Mustache::data("headfile_name", Utils::makeRelativePath(m_root_path, path).string()));
 
         std::map<std::string, bool> class_names;
+        bool                        lua_binding_exist = false;
         // class defs
         for (auto class_temp : schema.classes)
         {
+            // remember the hierarchy of every class, component type ids are assigned in finish
+            std::vector<std::string>& base_class_names = m_base_class_names[class_temp->getClassName()];
+            for (auto& base_class : class_temp->m_base_classes)
+            {
+                std::string base_class_name = base_class->name;
+                Utils::replaceAll(base_class_name, " ", "");
+                Utils::replaceAll(base_class_name, "Piccolo::", "");
+                base_class_names.emplace_back(base_class_name);
+            }
+
             if (!class_temp->shouldCompile())
                 continue;
 
@@ -60,6 +72,7 @@ namespace Generator
             Mustache::data vector_defines(Mustache::data::type::list);
 
             genClassRenderData(class_temp, class_def);
+            lua_binding_exist = lua_binding_exist || class_temp->shouldBindLua();
             for (auto field : class_temp->m_fields)
             {
                 if (!field->shouldCompile())
@@ -103,6 +116,8 @@ namespace Generator
 
         mustache_data.set("class_defines", class_defines);
         mustache_data.set("include_headfiles", include_headfiles);
+        // only the files with lua bound classes pull in sol
+        mustache_data.set("lua_binding_exist", lua_binding_exist);
 
         std::string tmp = Utils::convertNameToUpperCamelCase(fs::path(path).stem().string(), "_");
         mustache_data.set("sourefile_name_upper_camel_case", tmp);
@@ -135,6 +150,53 @@ namespace Generator
         std::string render_string =
             TemplateManager::getInstance()->renderByTemplate("allReflectionFile", mustache_data);
         Utils::saveFile(render_string, m_out_path + "/all_reflection.h");
+
+        genComponentTypeIdFile();
+    }
+
+    bool ReflectionGenerator::isComponentClass(const std::string& class_name) const
+    {
+        auto base_iter = m_base_class_names.find(class_name);
+        if (base_iter == m_base_class_names.end())
+            return false;
+
+        for (auto& base_class_name : base_iter->second)
+        {
+            if (base_class_name == "Component" || isComponentClass(base_class_name))
+                return true;
+        }
+        return false;
+    }
+
+    void ReflectionGenerator::genComponentTypeIdFile()
+    {
+        // std::set keeps the names sorted, so the ids are dense and stable between runs
+        std::set<std::string> component_type_names;
+        for (auto& class_item : m_base_class_names)
+        {
+            if (isComponentClass(class_item.first))
+            {
+                component_type_names.insert(class_item.first);
+            }
+        }
+
+        Mustache::data mustache_data;
+        Mustache::data component_type_defines = Mustache::data::type::list;
+
+        size_t component_type_id = 0;
+        for (auto& component_type_name : component_type_names)
+        {
+            Mustache::data component_type_define;
+            component_type_define.set("component_type_name", component_type_name);
+            component_type_define.set("component_type_id", std::to_string(component_type_id++));
+            component_type_defines.push_back(component_type_define);
+        }
+        mustache_data.set("component_type_defines", component_type_defines);
+        mustache_data.set("component_type_count", std::to_string(component_type_names.size()));
+
+        std::string render_string =
+            TemplateManager::getInstance()->renderByTemplate("allComponentTypeIdFile", mustache_data);
+        Utils::saveFile(render_string, m_out_path + "/all_component_type_id.h");
     }
 
     ReflectionGenerator::~ReflectionGenerator() {}
@@ -1,5 +1,7 @@
 #pragma once
 #include "generator/generator.h"
+
+#include <map>
 namespace Generator
 {
     class ReflectionGenerator : public GeneratorInterface
@@ -16,7 +18,12 @@ namespace Generator
         virtual std::string processFileName(std::string path) override;
 
     private:
+        bool isComponentClass(const std::string& class_name) const;
+        void genComponentTypeIdFile();
+
         std::vector<std::string> m_head_file_list;
         std::vector<std::string> m_sourcefile_list;
+        // class name -> names of its direct base classes
+        std::map<std::string, std::vector<std::string>> m_base_class_names;
     };
 } // namespace Generator
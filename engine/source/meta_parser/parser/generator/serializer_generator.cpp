@@ -43,6 +43,20 @@ namespace Generator
             Mustache::data class_def;
             genClassRenderData(class_temp, class_def);
 
+            std::string& class_layout = m_class_layouts[class_temp->getClassName()];
+            class_layout.clear();
+            for (auto& base_class : class_temp->m_base_classes)
+            {
+                class_layout += ":" + base_class->name;
+            }
+            for (auto& field : class_temp->m_fields)
+            {
+                if (field->shouldCompile())
+                {
+                    class_layout += ";" + field->m_type + " " + field->m_name;
+                }
+            }
+
             // deal base class
             for (int index = 0; index < class_temp->m_base_classes.size(); ++index)
             {
@@ -94,9 +108,23 @@ namespace Generator
 
     void SerializerGenerator::finish()
     {
+        // fnv-1a over all class layouts, cooked binary assets store it to detect a changed schema
+        uint64_t schema_hash = 14695981039346656037ull;
+        for (const auto& class_layout : m_class_layouts)
+        {
+            for (const std::string& text : {class_layout.first, class_layout.second})
+            {
+                for (char character : text)
+                {
+                    schema_hash = (schema_hash ^ static_cast<uint8_t>(character)) * 1099511628211ull;
+                }
+            }
+        }
+
         Mustache::data mustache_data;
         mustache_data.set("class_defines", m_class_defines);
         mustache_data.set("include_headfiles", m_include_headfiles);
+        mustache_data.set("schema_hash", std::to_string(schema_hash));
 
         std::string render_string = TemplateManager::getInstance()->renderByTemplate("allSerializer.h", mustache_data);
         Utils::saveFile(render_string, m_out_path + "/all_serializer.h");
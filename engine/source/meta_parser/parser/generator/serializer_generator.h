@@ -22,5 +22,7 @@ namespace Generator
     private:
         Mustache::data m_class_defines {Mustache::data::type::list};
         Mustache::data m_include_headfiles {Mustache::data::type::list};
+        // serialized layout of every class, sorted by class name so that the schema hash is stable
+        std::map<std::string, std::string> m_class_layouts;
     };
 } // namespace Generator
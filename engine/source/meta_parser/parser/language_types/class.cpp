@@ -49,6 +49,8 @@ bool Class::shouldCompileMethods(void) const{
            m_meta_data.getFlag(NativeProperty::WhiteListMethods);
 }
 
+bool Class::shouldBindLua(void) const { return m_meta_data.getFlag(NativeProperty::LuaBinding); }
+
 std::string Class::getClassName(void) { return m_name; }
 
 bool Class::isAccessible(void) const { return m_enabled; }
\ No newline at end of file
@@ -4,8 +4,14 @@
 #include "method.h"
 
 Method::Method(const Cursor& cursor, const Namespace& current_namespace, Class* parent) :
-    TypeInfo(cursor, current_namespace), m_parent(parent), m_name(cursor.getSpelling())
-{}
+    TypeInfo(cursor, current_namespace), m_parent(parent), m_name(cursor.getSpelling()), m_parameter_count(0)
+{
+    for (auto& child : cursor.getChildren())
+    {
+        if (child.getKind() == CXCursor_ParmDecl)
+            ++m_parameter_count;
+    }
+}
 
 bool Method::shouldCompile(void) const { return isAccessible(); }
 
@@ -20,5 +20,7 @@ public:
 
     std::string m_name;
 
+    size_t m_parameter_count;
+
     bool isAccessible(void) const;
 };
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "runtime/core/job/job_system.h"
+
+#include "runtime/core/profile/profiler.h"
+
+#include <algorithm>
+#include <string>
+
+namespace Piccolo
+{
+    // index of the queue owned by the current thread, threads not created by the job system share the last queue
+    static thread_local uint32_t t_worker_queue_index = JobSystem::k_auto_worker_count;
+
+    JobSystem::~JobSystem() { clear(); }
+
+    void JobSystem::initialize(uint32_t worker_count)
+    {
+        clear();
+
+        if (worker_count == k_auto_worker_count)
+        {
+            const uint32_t hardware_thread_count = std::thread::hardware_concurrency();
+            worker_count                         = hardware_thread_count > 1 ? hardware_thread_count - 1 : 0;
+        }
+
+        // one queue per worker plus one shared by external threads
+        m_queues.resize(worker_count + 1);
+        for (auto& queue : m_queues)
+        {
+            queue = std::make_unique<JobQueue>();
+        }
+
+        m_is_running = true;
+        m_workers.reserve(worker_count);
+        for (uint32_t worker_index = 0; worker_index < worker_count; ++worker_index)
+        {
+            m_workers.emplace_back(&JobSystem::workerLoop, this, worker_index);
+        }
+    }
+
+    void JobSystem::clear()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_is_running = false;
+        }
+        m_wake_condition.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+
+        // run what is left so that no counter stays pending forever
+        for (auto& queue : m_queues)
+        {
+            for (Job& job : queue->m_jobs)
+            {
+                executeJob(job);
+            }
+        }
+        m_queues.clear();
+        m_queued_job_count = 0;
+    }
+
+    void JobSystem::submit(std::function<void()> job, JobCounter& counter)
+    {
+        counter.m_pending_count.fetch_add(1, std::memory_order_relaxed);
+
+        if (isSingleThreaded())
+        {
+            Job inline_job {std::move(job), &counter};
+            executeJob(inline_job);
+            return;
+        }
+
+        // workers keep their own jobs local, other threads spread jobs over all queues
+        uint32_t queue_index = t_worker_queue_index;
+        if (queue_index >= m_queues.size())
+        {
+            queue_index = m_next_queue_index.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+        }
+
+        {
+            JobQueue&                   queue = *m_queues[queue_index];
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            queue.m_jobs.push_back({std::move(job), &counter});
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_queued_job_count.fetch_add(1, std::memory_order_release);
+        }
+        m_wake_condition.notify_one();
+    }
+
+    void JobSystem::wait(const JobCounter& counter)
+    {
+        const uint32_t queue_index =
+            t_worker_queue_index < m_queues.size() ? t_worker_queue_index : static_cast<uint32_t>(m_queues.size() - 1);
+
+        while (!counter.isDone())
+        {
+            if (!tryExecuteJob(queue_index))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::parallelFor(uint32_t                                        count,
+                                uint32_t                                        batch_size,
+                                const std::function<void(uint32_t, uint32_t)>& func)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        batch_size = std::max(batch_size, 1u);
+
+        if (isSingleThreaded() || count <= batch_size)
+        {
+            func(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = 0; begin < count; begin += batch_size)
+        {
+            const uint32_t end = std::min(begin + batch_size, count);
+            submit([&func, begin, end]() { func(begin, end); }, counter);
+        }
+        wait(counter);
+    }
+
+    void JobSystem::workerLoop(uint32_t worker_index)
+    {
+        t_worker_queue_index = worker_index;
+
+        const std::string thread_name = "job worker " + std::to_string(worker_index);
+        PICCOLO_PROFILE_THREAD_NAME(thread_name.c_str());
+
+        while (m_is_running)
+        {
+            if (tryExecuteJob(worker_index))
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+            m_wake_condition.wait(lock, [this]() {
+                return !m_is_running || m_queued_job_count.load(std::memory_order_acquire) > 0;
+            });
+        }
+
+        t_worker_queue_index = k_auto_worker_count;
+    }
+
+    bool JobSystem::tryExecuteJob(uint32_t queue_index)
+    {
+        Job          job;
+        bool         has_job     = false;
+        const size_t queue_count = m_queues.size();
+
+        // pop from the front of the own queue first, then steal from the back of the others
+        for (size_t offset = 0; offset < queue_count && !has_job; ++offset)
+        {
+            JobQueue&                   queue = *m_queues[(queue_index + offset) % queue_count];
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            if (queue.m_jobs.empty())
+            {
+                continue;
+            }
+
+            if (offset == 0)
+            {
+                job = std::move(queue.m_jobs.front());
+                queue.m_jobs.pop_front();
+            }
+            else
+            {
+                job = std::move(queue.m_jobs.back());
+                queue.m_jobs.pop_back();
+            }
+            has_job = true;
+        }
+
+        if (!has_job)
+        {
+            return false;
+        }
+
+        m_queued_job_count.fetch_sub(1, std::memory_order_acq_rel);
+        executeJob(job);
+        return true;
+    }
+
+    void JobSystem::executeJob(Job& job)
+    {
+        job.m_function();
+        if (job.m_counter)
+        {
+            job.m_counter->m_pending_count.fetch_sub(1, std::memory_order_release);
+        }
+    }
+} // namespace Piccolo
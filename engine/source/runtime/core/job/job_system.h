@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Piccolo
+{
+    /// Tracks the number of unfinished jobs of a submission, a job group is finished when it reaches zero
+    class JobCounter
+    {
+    public:
+        bool isDone() const { return m_pending_count.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_pending_count {0};
+    };
+
+    /// Work-stealing job scheduler shared by the runtime systems.
+    /// Every worker owns a job queue, idle workers steal from the other queues, and a thread waiting on a
+    /// counter executes pending jobs instead of blocking. In single-threaded mode every job runs inline on
+    /// the submitting thread in submission order, which is meant for debugging.
+    class JobSystem
+    {
+        struct Job
+        {
+            std::function<void()> m_function;
+            JobCounter*           m_counter {nullptr};
+        };
+
+        struct JobQueue
+        {
+            std::mutex      m_mutex;
+            std::deque<Job> m_jobs;
+        };
+
+    public:
+        ~JobSystem();
+
+        /// @worker_count: number of worker threads, k_auto_worker_count uses hardware concurrency minus the
+        /// calling thread, 0 runs every job on the submitting thread
+        void initialize(uint32_t worker_count = k_auto_worker_count);
+        void clear();
+
+        uint32_t getWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+        void setSingleThreaded(bool is_single_threaded) { m_is_single_threaded = is_single_threaded; }
+        bool isSingleThreaded() const { return m_is_single_threaded || m_workers.empty(); }
+
+        /// queue a job, the counter is increased now and decreased when the job is finished
+        void submit(std::function<void()> job, JobCounter& counter);
+
+        /// execute pending jobs on the calling thread until all jobs of the counter are finished
+        void wait(const JobCounter& counter);
+
+        /// split [0, count) into batches of batch_size and run them in parallel, returns when all batches are
+        /// finished. Batches are fixed ranges, so the work assigned to a batch does not depend on scheduling
+        void parallelFor(uint32_t count, uint32_t batch_size, const std::function<void(uint32_t, uint32_t)>& func);
+
+        static constexpr uint32_t k_auto_worker_count = 0xffffffff;
+
+    private:
+        void workerLoop(uint32_t worker_index);
+        bool tryExecuteJob(uint32_t queue_index);
+        void executeJob(Job& job);
+
+        std::vector<std::thread>                m_workers;
+        std::vector<std::unique_ptr<JobQueue>>  m_queues;
+        std::atomic<uint32_t>                   m_next_queue_index {0};
+        std::atomic<uint32_t>                   m_queued_job_count {0};
+        std::atomic<bool>                       m_is_running {false};
+        std::atomic<bool>                       m_is_single_threaded {false};
+
+        std::mutex              m_wake_mutex;
+        std::condition_variable m_wake_condition;
+    };
+} // namespace Piccolo
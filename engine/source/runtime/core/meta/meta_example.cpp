@@ -3,6 +3,7 @@
 
 #include "runtime/core/base/macro.h"
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -77,4 +78,23 @@ namespace Piccolo
             }
         }
     }
+
+    void metaLookupBenchmark()
+    {
+        static const std::string type_names[] = {"BaseTest", "Test1", "Test2"};
+        static constexpr int     k_lookup_count = 300000;
+
+        size_t     valid_count = 0;
+        const auto begin_time  = std::chrono::steady_clock::now();
+        for (int lookup_index = 0; lookup_index < k_lookup_count; ++lookup_index)
+        {
+            Reflection::TypeMeta meta = Reflection::TypeMeta::newMetaFromName(type_names[lookup_index % 3]);
+            valid_count += meta.isValid() ? meta.getFields().size() : 0;
+        }
+        const auto end_time = std::chrono::steady_clock::now();
+
+        const double lookup_ns =
+            std::chrono::duration<double, std::nano>(end_time - begin_time).count() / k_lookup_count;
+        LOG_INFO("newMetaFromName: {:.1f} ns per lookup, {} fields seen", lookup_ns, valid_count);
+    }
 } // namespace Piccolo
@@ -32,4 +32,11 @@ namespace Piccolo
     public:
         std::vector<Reflection::ReflectionPtr<BaseTest>> m_test_base_array;
     };
+
+    /**
+     *  Looks up the type meta of the example classes by name the way the editor inspector, the serializers and the
+     *  lua bridge do, and logs the time per lookup. Needs the reflection registered and the log system started,
+     *  headless is enough
+     */
+    void metaLookupBenchmark();
 } // namespace Piccolo
@@ -1,6 +1,8 @@
 #include "reflection.h"
+#include <algorithm>
 #include <cstring>
-#include <map>
+#include <memory>
+#include <string_view>
 
 namespace Piccolo
 {
@@ -9,24 +11,60 @@ namespace Piccolo
         const char* k_unknown_type = "UnknownType";
         const char* k_unknown      = "Unknown";
 
-        static std::map<std::string, ClassFunctionTuple*>       m_class_map;
-        static std::multimap<std::string, FieldFunctionTuple*>  m_field_map;
-        static std::multimap<std::string, MethodFunctionTuple*> m_method_map;
-        static std::map<std::string, ArrayFunctionTuple*>       m_array_map;
+        struct TypeMetaData
+        {
+            uint32_t                    m_type_id {TypeMeta::k_invalid_type_id};
+            std::string                 m_type_name;
+            std::vector<FieldAccessor>  m_fields;
+            std::vector<MethodAccessor> m_methods;
+            ClassFunctionTuple*         m_class_functions {nullptr};
+        };
+
+        // every registered type once, indexed by type id. The tables are only written while the types register,
+        // afterwards all lookups are read only and safe from any thread
+        static std::vector<std::unique_ptr<TypeMetaData>>              m_types;
+        static std::unordered_map<std::string_view, TypeMetaData*>       m_type_map;
+        static std::unordered_map<std::string_view, ArrayFunctionTuple*> m_array_map;
+        // the array maps keys by view, the names of array types are owned here
+        static std::vector<std::unique_ptr<std::string>> m_array_type_names;
+
+        static const TypeMetaData* findTypeMetaData(std::string_view type_name)
+        {
+            auto iter = m_type_map.find(type_name);
+            return iter != m_type_map.end() ? iter->second : nullptr;
+        }
+
+        static TypeMetaData& internTypeMetaData(const char* type_name)
+        {
+            auto iter = m_type_map.find(type_name);
+            if (iter != m_type_map.end())
+            {
+                return *iter->second;
+            }
+
+            std::unique_ptr<TypeMetaData> data = std::make_unique<TypeMetaData>();
+            data->m_type_id                    = static_cast<uint32_t>(m_types.size());
+            data->m_type_name                  = type_name;
+            // the key views the name owned by the data, which never moves
+            m_type_map.emplace(data->m_type_name, data.get());
+            m_types.push_back(std::move(data));
+            return *m_types.back();
+        }
 
         void TypeMetaRegisterinterface::registerToFieldMap(const char* name, FieldFunctionTuple* value)
         {
-            m_field_map.insert(std::make_pair(name, value));
+            internTypeMetaData(name).m_fields.emplace_back(FieldAccessor(value));
         }
         void TypeMetaRegisterinterface::registerToMethodMap(const char* name, MethodFunctionTuple* value)
         {
-            m_method_map.insert(std::make_pair(name, value));
+            internTypeMetaData(name).m_methods.emplace_back(MethodAccessor(value));
         }
         void TypeMetaRegisterinterface::registerToArrayMap(const char* name, ArrayFunctionTuple* value)
         {
             if (m_array_map.find(name) == m_array_map.end())
             {
-                m_array_map.insert(std::make_pair(name, value));
+                m_array_type_names.push_back(std::make_unique<std::string>(name));
+                m_array_map.emplace(*m_array_type_names.back(), value);
             }
             else
             {
@@ -36,9 +74,10 @@ namespace Piccolo
 
         void TypeMetaRegisterinterface::registerToClassMap(const char* name, ClassFunctionTuple* value)
         {
-            if (m_class_map.find(name) == m_class_map.end())
+            TypeMetaData& data = internTypeMetaData(name);
+            if (data.m_class_functions == nullptr)
             {
-                m_class_map.insert(std::make_pair(name, value));
+                data.m_class_functions = value;
             }
             else
             {
@@ -48,58 +87,56 @@ namespace Piccolo
 
         void TypeMetaRegisterinterface::unregisterAll()
         {
-            for (const auto& itr : m_field_map)
-            {
-                delete itr.second;
-            }
-            m_field_map.clear();
-            for (const auto& itr : m_class_map)
+            for (const auto& data : m_types)
             {
-                delete itr.second;
+                for (const FieldAccessor& field : data->m_fields)
+                {
+                    delete field.m_functions;
+                }
+                for (const MethodAccessor& method : data->m_methods)
+                {
+                    delete method.m_functions;
+                }
+                delete data->m_class_functions;
             }
-            m_class_map.clear();
+            m_type_map.clear();
+            m_types.clear();
             for (const auto& itr : m_array_map)
             {
                 delete itr.second;
             }
             m_array_map.clear();
+            m_array_type_names.clear();
         }
 
-        TypeMeta::TypeMeta(std::string type_name) : m_type_name(type_name)
+        TypeMeta::TypeMeta(const std::string& type_name) : TypeMeta(findTypeMetaData(type_name))
         {
-            m_is_valid = false;
-            m_fields.clear();
-            m_methods.clear();
-
-            auto fileds_iter = m_field_map.equal_range(type_name);
-            while (fileds_iter.first != fileds_iter.second)
+            if (m_data == nullptr)
             {
-                FieldAccessor f_field(fileds_iter.first->second);
-                m_fields.emplace_back(f_field);
-                m_is_valid = true;
-
-                ++fileds_iter.first;
+                m_unregistered_type_name = type_name;
             }
+        }
 
-            auto methods_iter = m_method_map.equal_range(type_name);
-            while (methods_iter.first != methods_iter.second)
-            {
-                MethodAccessor f_method(methods_iter.first->second);
-                m_methods.emplace_back(f_method);
-                m_is_valid = true;
-
-                ++methods_iter.first;
-            }
+        TypeMeta::TypeMeta(const TypeMetaData* data) : m_data(data)
+        {
+            // a type only counts as reflected when it has fields or methods, as before the registry was interned
+            m_is_valid = m_data != nullptr && (!m_data->m_fields.empty() || !m_data->m_methods.empty());
         }
 
-        TypeMeta::TypeMeta() : m_type_name(k_unknown_type), m_is_valid(false) { m_fields.clear(); m_methods.clear(); }
+        TypeMeta::TypeMeta() : m_data(nullptr), m_unregistered_type_name(k_unknown_type), m_is_valid(false) {}
 
-        TypeMeta TypeMeta::newMetaFromName(std::string type_name)
+        TypeMeta TypeMeta::newMetaFromName(const std::string& type_name)
         {
             TypeMeta f_type(type_name);
             return f_type;
         }
 
+        TypeMeta TypeMeta::newMetaFromId(uint32_t type_id)
+        {
+            TypeMeta f_type(type_id < m_types.size() ? m_types[type_id].get() : nullptr);
+            return f_type;
+        }
+
         bool TypeMeta::newArrayAccessorFromName(std::string array_type_name, ArrayAccessor& accessor)
         {
             auto iter = m_array_map.find(array_type_name);
@@ -116,57 +153,94 @@ namespace Piccolo
 
         ReflectionInstance TypeMeta::newFromNameAndJson(std::string type_name, const Json& json_context)
         {
-            auto iter = m_class_map.find(type_name);
+            const TypeMetaData* data = findTypeMetaData(type_name);
 
-            if (iter != m_class_map.end())
+            if (data != nullptr && data->m_class_functions != nullptr)
             {
-                return ReflectionInstance(TypeMeta(type_name), (std::get<1>(*iter->second)(json_context)));
+                return ReflectionInstance(TypeMeta(data), (std::get<1>(*data->m_class_functions)(json_context)));
             }
             return ReflectionInstance();
         }
 
         Json TypeMeta::writeByName(std::string type_name, void* instance)
         {
-            auto iter = m_class_map.find(type_name);
+            const TypeMetaData* data = findTypeMetaData(type_name);
 
-            if (iter != m_class_map.end())
+            if (data != nullptr && data->m_class_functions != nullptr)
             {
-                return std::get<2>(*iter->second)(instance);
+                return std::get<2>(*data->m_class_functions)(instance);
             }
             return Json();
         }
 
-        std::string TypeMeta::getTypeName() { return m_type_name; }
+        ReflectionInstance TypeMeta::newFromNameAndBinary(std::string type_name, BinaryReader& reader)
+        {
+            const TypeMetaData* data = findTypeMetaData(type_name);
+
+            if (data != nullptr && data->m_class_functions != nullptr)
+            {
+                return ReflectionInstance(TypeMeta(data), (std::get<3>(*data->m_class_functions)(reader)));
+            }
+            return ReflectionInstance();
+        }
+
+        void TypeMeta::writeBinaryByName(std::string type_name, BinaryWriter& writer, void* instance)
+        {
+            const TypeMetaData* data = findTypeMetaData(type_name);
+
+            if (data != nullptr && data->m_class_functions != nullptr)
+            {
+                std::get<4>(*data->m_class_functions)(writer, instance);
+            }
+        }
+
+        std::string TypeMeta::getTypeName() { return m_data ? m_data->m_type_name : m_unregistered_type_name; }
+
+        uint32_t TypeMeta::getTypeId() const { return m_data ? m_data->m_type_id : k_invalid_type_id; }
 
         int TypeMeta::getFieldsList(FieldAccessor*& out_list)
         {
-            int count = m_fields.size();
+            const std::vector<FieldAccessor>& fields = getFields();
+
+            int count = fields.size();
             out_list  = new FieldAccessor[count];
             for (int i = 0; i < count; ++i)
             {
-                out_list[i] = m_fields[i];
+                out_list[i] = fields[i];
             }
             return count;
         }
 
         int TypeMeta::getMethodsList(MethodAccessor*& out_list)
         {
-            int count = m_methods.size();
+            const std::vector<MethodAccessor>& methods = getMethods();
+
+            int count = methods.size();
             out_list  = new MethodAccessor[count];
             for (int i = 0; i < count; ++i)
             {
-                out_list[i] = m_methods[i];
+                out_list[i] = methods[i];
             }
             return count;
         }
 
-        int TypeMeta::getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance)
+        const std::vector<FieldAccessor>& TypeMeta::getFields() const
         {
-            auto iter = m_class_map.find(m_type_name);
+            static const std::vector<FieldAccessor> k_no_fields;
+            return m_data ? m_data->m_fields : k_no_fields;
+        }
 
-            if (iter != m_class_map.end())
+        const std::vector<MethodAccessor>& TypeMeta::getMethods() const
+        {
+            static const std::vector<MethodAccessor> k_no_methods;
+            return m_data ? m_data->m_methods : k_no_methods;
+        }
+
+        int TypeMeta::getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance)
+        {
+            if (m_data != nullptr && m_data->m_class_functions != nullptr)
             {
-                return (std::get<0>(*iter->second))(out_list, instance);
+                return (std::get<0>(*m_data->m_class_functions))(out_list, instance);
             }
 
             return 0;
@@ -174,20 +248,24 @@ namespace Piccolo
 
         FieldAccessor TypeMeta::getFieldByName(const char* name)
         {
-            const auto it = std::find_if(m_fields.begin(), m_fields.end(), [&](const auto& i) {
+            const std::vector<FieldAccessor>& fields = getFields();
+
+            const auto it = std::find_if(fields.begin(), fields.end(), [&](const auto& i) {
                 return std::strcmp(i.getFieldName(), name) == 0;
             });
-            if (it != m_fields.end())
+            if (it != fields.end())
                 return *it;
             return FieldAccessor(nullptr);
         }
 
         MethodAccessor TypeMeta::getMethodByName(const char* name)
         {
-            const auto it = std::find_if(m_methods.begin(), m_methods.end(), [&](const auto& i) {
+            const std::vector<MethodAccessor>& methods = getMethods();
+
+            const auto it = std::find_if(methods.begin(), methods.end(), [&](const auto& i) {
                 return std::strcmp(i.getMethodName(), name) == 0;
             });
-            if (it != m_methods.end())
+            if (it != methods.end())
                 return *it;
             return MethodAccessor(nullptr);
         }
@@ -198,15 +276,9 @@ namespace Piccolo
             {
                 return *this;
             }
-            m_fields.clear();
-            m_fields = dest.m_fields;
-
-            
-            m_methods.clear();
-            m_methods = dest.m_methods;
-
-            m_type_name = dest.m_type_name;
-            m_is_valid  = dest.m_is_valid;
+            m_data                   = dest.m_data;
+            m_unregistered_type_name = dest.m_unregistered_type_name;
+            m_is_valid               = dest.m_is_valid;
 
             return *this;
         }
@@ -230,13 +302,13 @@ namespace Piccolo
             m_field_name      = (std::get<3>(*m_functions))();
         }
 
-        void* FieldAccessor::get(void* instance)
+        void* FieldAccessor::get(void* instance) const
         {
             // todo: should check validation
             return static_cast<void*>((std::get<1>(*m_functions))(instance));
         }
 
-        void FieldAccessor::set(void* instance, void* value)
+        void FieldAccessor::set(void* instance, void* value) const
         {
             // todo: should check validation
             (std::get<0>(*m_functions))(instance, value);
@@ -245,13 +317,17 @@ namespace Piccolo
         TypeMeta FieldAccessor::getOwnerTypeMeta()
         {
             // todo: should check validation
-            TypeMeta f_type((std::get<2>(*m_functions))());
+            TypeMeta f_type(std::string((std::get<2>(*m_functions))()));
             return f_type;
         }
 
         bool FieldAccessor::getTypeMeta(TypeMeta& field_type)
         {
-            TypeMeta f_type(m_field_type_name);
+            TypeMeta f_type(findTypeMetaData(m_field_type_name));
+            if (f_type.m_data == nullptr)
+            {
+                f_type.m_unregistered_type_name = m_field_type_name;
+            }
             field_type = f_type;
             return f_type.m_is_valid;
         }
@@ -293,9 +369,7 @@ namespace Piccolo
 
             m_method_name      = (std::get<0>(*m_functions))();
         }
-        const char* MethodAccessor::getMethodName() const{
-            return (std::get<0>(*m_functions))();
-        }
+        const char* MethodAccessor::getMethodName() const { return m_method_name; }
         MethodAccessor& MethodAccessor::operator=(const MethodAccessor& dest)
         {
             if (this == &dest)
@@ -306,7 +380,7 @@ namespace Piccolo
             m_method_name      = dest.m_method_name;
             return *this;
         }
-        void MethodAccessor::invoke(void* instance) { (std::get<1>(*m_functions))(instance); }
+        void MethodAccessor::invoke(void* instance) const { (std::get<1>(*m_functions))(instance); }
         ArrayAccessor::ArrayAccessor() :
             m_func(nullptr), m_array_type_name("UnKnownType"), m_element_type_name("UnKnownType")
         {}
@@ -1,6 +1,7 @@
 #pragma once
 #include "runtime/core/meta/json.h"
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -24,7 +25,8 @@ namespace Piccolo
 
 #define REFLECTION_BODY(class_name) \
     friend class Reflection::TypeFieldReflectionOparator::Type##class_name##Operator; \
-    friend class Serializer;
+    friend class Serializer; \
+    friend class BinarySerializer;
     // public: virtual std::string getTypeName() override {return #class_name;}
 
 #define REFLECTION_TYPE(class_name) \
@@ -68,6 +70,9 @@ namespace Piccolo
     struct is_safely_castable<T, U, std::void_t<decltype(static_cast<U>(std::declval<T>()))>> : std::true_type
     {};
 
+    class BinaryReader;
+    class BinaryWriter;
+
     namespace Reflection
     {
         class TypeMeta;
@@ -87,13 +92,20 @@ namespace Piccolo
 
     typedef std::function<void*(const Json&)>                           ConstructorWithJson;
     typedef std::function<Json(void*)>                                  WriteJsonByName;
+    typedef std::function<void*(BinaryReader&)>                         ConstructorWithBinary;
+    typedef std::function<void(BinaryWriter&, void*)>                   WriteBinaryByName;
     typedef std::function<int(Reflection::ReflectionInstance*&, void*)> GetBaseClassReflectionInstanceListFunc;
 
     typedef std::tuple<SetFuncion, GetFuncion, GetNameFuncion, GetNameFuncion, GetNameFuncion, GetBoolFunc>
                                                        FieldFunctionTuple;
     typedef std::tuple<GetNameFuncion, InvokeFunction> MethodFunctionTuple;
-    typedef std::tuple<GetBaseClassReflectionInstanceListFunc, ConstructorWithJson, WriteJsonByName> ClassFunctionTuple;
-    typedef std::tuple<SetArrayFunc, GetArrayFunc, GetSizeFunc, GetNameFuncion, GetNameFuncion>      ArrayFunctionTuple;
+    typedef std::tuple<GetBaseClassReflectionInstanceListFunc,
+                       ConstructorWithJson,
+                       WriteJsonByName,
+                       ConstructorWithBinary,
+                       WriteBinaryByName>
+                                                                                                ClassFunctionTuple;
+    typedef std::tuple<SetArrayFunc, GetArrayFunc, GetSizeFunc, GetNameFuncion, GetNameFuncion> ArrayFunctionTuple;
 
     namespace Reflection
     {
@@ -108,6 +120,9 @@ namespace Piccolo
 
             static void unregisterAll();
         };
+        // the registered data of a type, shared by all TypeMeta handles of it
+        struct TypeMetaData;
+
         class TypeMeta
         {
             friend class FieldAccessor;
@@ -115,21 +130,32 @@ namespace Piccolo
             friend class TypeMetaRegisterinterface;
 
         public:
+            static constexpr uint32_t k_invalid_type_id = 0xffffffff;
+
             TypeMeta();
 
             // static void Register();
 
-            static TypeMeta newMetaFromName(std::string type_name);
+            static TypeMeta newMetaFromName(const std::string& type_name);
+            static TypeMeta newMetaFromId(uint32_t type_id);
 
             static bool               newArrayAccessorFromName(std::string array_type_name, ArrayAccessor& accessor);
             static ReflectionInstance newFromNameAndJson(std::string type_name, const Json& json_context);
             static Json               writeByName(std::string type_name, void* instance);
+            static ReflectionInstance newFromNameAndBinary(std::string type_name, BinaryReader& reader);
+            static void               writeBinaryByName(std::string type_name, BinaryWriter& writer, void* instance);
 
             std::string getTypeName();
+            // dense and assigned in registration order, k_invalid_type_id for names without a registered type
+            uint32_t getTypeId() const;
 
             int getFieldsList(FieldAccessor*& out_list);
             int getMethodsList(MethodAccessor*& out_list);
 
+            // the shared tables of the type, unlike the lists above nothing is copied
+            const std::vector<FieldAccessor>&  getFields() const;
+            const std::vector<MethodAccessor>& getMethods() const;
+
             int getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance);
 
             FieldAccessor getFieldByName(const char* name);
@@ -140,12 +166,13 @@ namespace Piccolo
             TypeMeta& operator=(const TypeMeta& dest);
 
         private:
-            TypeMeta(std::string type_name);
+            TypeMeta(const std::string& type_name);
+            TypeMeta(const TypeMetaData* data);
 
         private:
-            std::vector<FieldAccessor, std::allocator<FieldAccessor>>   m_fields;
-            std::vector<MethodAccessor, std::allocator<MethodAccessor>> m_methods;
-            std::string                                                 m_type_name;
+            const TypeMetaData* m_data;
+            // only set when no type of the name is registered, getTypeName still reports the name
+            std::string         m_unregistered_type_name;
 
             bool m_is_valid;
         };
@@ -153,12 +180,13 @@ namespace Piccolo
         class FieldAccessor
         {
             friend class TypeMeta;
+            friend class TypeMetaRegisterinterface;
 
         public:
             FieldAccessor();
 
-            void* get(void* instance);
-            void  set(void* instance, void* value);
+            void* get(void* instance) const;
+            void  set(void* instance, void* value) const;
 
             TypeMeta getOwnerTypeMeta();
 
@@ -188,11 +216,12 @@ namespace Piccolo
         class MethodAccessor
         {
             friend class TypeMeta;
+            friend class TypeMetaRegisterinterface;
 
         public:
             MethodAccessor();
 
-            void invoke(void* instance);
+            void invoke(void* instance) const;
 
             const char* getMethodName() const;
 
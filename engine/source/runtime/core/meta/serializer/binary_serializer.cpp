@@ -0,0 +1,103 @@
+#include "runtime/core/meta/serializer/binary_serializer.h"
+
+namespace Piccolo
+{
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const char& instance)
+    {
+        writer.writeValue(instance);
+    }
+    template<>
+    char& BinarySerializer::read(BinaryReader& reader, char& instance)
+    {
+        return instance = reader.readValue<char>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const int& instance)
+    {
+        writer.writeValue(instance);
+    }
+    template<>
+    int& BinarySerializer::read(BinaryReader& reader, int& instance)
+    {
+        return instance = reader.readValue<int>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const unsigned int& instance)
+    {
+        writer.writeValue(instance);
+    }
+    template<>
+    unsigned int& BinarySerializer::read(BinaryReader& reader, unsigned int& instance)
+    {
+        return instance = reader.readValue<unsigned int>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const unsigned short& instance)
+    {
+        writer.writeValue(instance);
+    }
+    template<>
+    unsigned short& BinarySerializer::read(BinaryReader& reader, unsigned short& instance)
+    {
+        return instance = reader.readValue<unsigned short>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const float& instance)
+    {
+        writer.writeValue(instance);
+    }
+    template<>
+    float& BinarySerializer::read(BinaryReader& reader, float& instance)
+    {
+        return instance = reader.readValue<float>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const double& instance)
+    {
+        writer.writeValue(instance);
+    }
+    template<>
+    double& BinarySerializer::read(BinaryReader& reader, double& instance)
+    {
+        return instance = reader.readValue<double>();
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const bool& instance)
+    {
+        writer.writeValue(static_cast<uint8_t>(instance ? 1 : 0));
+    }
+    template<>
+    bool& BinarySerializer::read(BinaryReader& reader, bool& instance)
+    {
+        return instance = reader.readValue<uint8_t>() != 0;
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const std::string& instance)
+    {
+        writer.writeValue(static_cast<uint32_t>(instance.size()));
+        writer.writeBytes(instance.data(), instance.size());
+    }
+    template<>
+    std::string& BinarySerializer::read(BinaryReader& reader, std::string& instance)
+    {
+        const uint32_t size  = reader.readValue<uint32_t>();
+        const uint8_t* bytes = reader.readBytes(size);
+        if (bytes)
+        {
+            instance.assign(reinterpret_cast<const char*>(bytes), size);
+        }
+        else
+        {
+            instance.clear();
+        }
+        return instance;
+    }
+} // namespace Piccolo
@@ -0,0 +1,257 @@
+#pragma once
+#include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/core/meta/serializer/serializer.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Piccolo
+{
+    /// Appends the binary representation of cooked assets to a growing byte buffer
+    class BinaryWriter
+    {
+    public:
+        void writeBytes(const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+        }
+
+        template<typename T>
+        void writeValue(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written raw");
+            writeBytes(&value, sizeof(T));
+        }
+
+        const std::vector<uint8_t>& getBuffer() const { return m_buffer; }
+
+    private:
+        std::vector<uint8_t> m_buffer;
+    };
+
+    /// Reads cooked data in place from a memory range, usually a mapped file.
+    /// Reading past the end does not throw, it marks the reader invalid and returns zeroed values,
+    /// callers check isValid() once the whole asset is read
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const void* data, size_t size) : m_data(static_cast<const uint8_t*>(data)), m_size(size) {}
+
+        /// returns a pointer into the source range and advances, nullptr if the range is too short
+        const uint8_t* readBytes(size_t size)
+        {
+            if (!m_is_valid || size > m_size - m_offset)
+            {
+                m_is_valid = false;
+                return nullptr;
+            }
+
+            const uint8_t* bytes = m_data + m_offset;
+            m_offset += size;
+            return bytes;
+        }
+
+        template<typename T>
+        T readValue()
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be read raw");
+            T              value {};
+            const uint8_t* bytes = readBytes(sizeof(T));
+            if (bytes)
+            {
+                // the source is not aligned for T
+                std::memcpy(&value, bytes, sizeof(T));
+            }
+            return value;
+        }
+
+        bool   isValid() const { return m_is_valid; }
+        size_t getOffset() const { return m_offset; }
+        size_t getSize() const { return m_size; }
+
+    private:
+        const uint8_t* m_data {nullptr};
+        size_t         m_size {0};
+        size_t         m_offset {0};
+        bool           m_is_valid {true};
+    };
+
+    /// Binary counterpart of Serializer used for cooked assets.
+    /// Reflected classes are written as their base classes followed by their fields in declaration order,
+    /// without names, the specializations are generated together with the json ones.
+    /// The layout of a cooked file is only valid for the reflection schema it was cooked with.
+    class BinarySerializer
+    {
+    public:
+        template<typename T>
+        static void writePointer(BinaryWriter& writer, T* instance)
+        {
+            BinarySerializer::write(writer, std::string("*"));
+            BinarySerializer::write(writer, *instance);
+        }
+
+        template<typename T>
+        static T*& readPointer(BinaryReader& reader, T*& instance)
+        {
+            assert(instance == nullptr);
+            std::string type_name;
+            read(reader, type_name);
+            if (type_name.empty())
+            {
+                return instance;
+            }
+
+            if ('*' == type_name[0])
+            {
+                instance = new T;
+                read(reader, *instance);
+            }
+            else
+            {
+                instance = static_cast<T*>(Reflection::TypeMeta::newFromNameAndBinary(type_name, reader).m_instance);
+            }
+            return instance;
+        }
+
+        template<typename T>
+        static void write(BinaryWriter& writer, const Reflection::ReflectionPtr<T>& instance)
+        {
+            T*          instance_ptr = static_cast<T*>(instance.operator->());
+            std::string type_name    = instance.getTypeName();
+            BinarySerializer::write(writer, type_name);
+            Reflection::TypeMeta::writeBinaryByName(type_name, writer, instance_ptr);
+        }
+
+        template<typename T>
+        static T*& read(BinaryReader& reader, Reflection::ReflectionPtr<T>& instance)
+        {
+            // the json format stores the type name twice, the binary one once in front of the instance
+            std::string type_name;
+            read(reader, type_name);
+            instance.setTypeName(type_name);
+
+            T*& instance_ptr = instance.getPtrReference();
+            if (!type_name.empty())
+            {
+                instance_ptr = static_cast<T*>(Reflection::TypeMeta::newFromNameAndBinary(type_name, reader).m_instance);
+            }
+            return instance_ptr;
+        }
+
+        /// arrays of arithmetic elements are stored as one block and read with a single copy
+        template<typename T>
+        static void writeArray(BinaryWriter& writer, const std::vector<T>& instance)
+        {
+            writer.writeValue(static_cast<uint32_t>(instance.size()));
+            if constexpr (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value)
+            {
+                writer.writeBytes(instance.data(), instance.size() * sizeof(T));
+            }
+            else
+            {
+                for (const auto& item : instance)
+                {
+                    BinarySerializer::write(writer, item);
+                }
+            }
+        }
+
+        template<typename T>
+        static std::vector<T>& readArray(BinaryReader& reader, std::vector<T>& instance)
+        {
+            const uint32_t count = reader.readValue<uint32_t>();
+            if constexpr (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value)
+            {
+                const uint8_t* bytes = reader.readBytes(count * sizeof(T));
+                instance.resize(bytes ? count : 0);
+                if (bytes)
+                {
+                    std::memcpy(instance.data(), bytes, count * sizeof(T));
+                }
+            }
+            else
+            {
+                // do not trust the count of a truncated file with the allocation
+                instance.resize(count <= reader.getSize() - reader.getOffset() ? count : 0);
+                for (auto& item : instance)
+                {
+                    BinarySerializer::read(reader, item);
+                }
+            }
+            return instance;
+        }
+
+        template<typename T>
+        static void write(BinaryWriter& writer, const T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                writePointer(writer, (T)instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "BinarySerializer::write<T> has not been implemented yet!");
+            }
+        }
+
+        template<typename T>
+        static T& read(BinaryReader& reader, T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                return readPointer(reader, instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "BinarySerializer::read<T> has not been implemented yet!");
+                return instance;
+            }
+        }
+    };
+
+    // implementation of base types
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const char& instance);
+    template<>
+    char& BinarySerializer::read(BinaryReader& reader, char& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const int& instance);
+    template<>
+    int& BinarySerializer::read(BinaryReader& reader, int& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const unsigned int& instance);
+    template<>
+    unsigned int& BinarySerializer::read(BinaryReader& reader, unsigned int& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const unsigned short& instance);
+    template<>
+    unsigned short& BinarySerializer::read(BinaryReader& reader, unsigned short& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const float& instance);
+    template<>
+    float& BinarySerializer::read(BinaryReader& reader, float& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const double& instance);
+    template<>
+    double& BinarySerializer::read(BinaryReader& reader, double& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const bool& instance);
+    template<>
+    bool& BinarySerializer::read(BinaryReader& reader, bool& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const std::string& instance);
+    template<>
+    std::string& BinarySerializer::read(BinaryReader& reader, std::string& instance);
+} // namespace Piccolo
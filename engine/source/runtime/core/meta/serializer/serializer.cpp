@@ -39,6 +39,18 @@ namespace Piccolo
         return instance = static_cast<unsigned int>(json_context.number_value());
     }
 
+    template<>
+    Json Serializer::write(const unsigned short& instance)
+    {
+        return Json(static_cast<int>(instance));
+    }
+    template<>
+    unsigned short& Serializer::read(const Json& json_context, unsigned short& instance)
+    {
+        assert(json_context.is_number());
+        return instance = static_cast<unsigned short>(json_context.number_value());
+    }
+
     template<>
     Json Serializer::write(const float& instance)
     {
@@ -100,6 +100,11 @@ namespace Piccolo
     template<>
     unsigned int& Serializer::read(const Json& json_context, unsigned int& instance);
 
+    template<>
+    Json Serializer::write(const unsigned short& instance);
+    template<>
+    unsigned short& Serializer::read(const Json& json_context, unsigned short& instance);
+
     template<>
     Json Serializer::write(const float& instance);
     template<>
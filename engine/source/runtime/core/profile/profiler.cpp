@@ -0,0 +1,216 @@
+#include "runtime/core/profile/profiler.h"
+
+#include <array>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Piccolo
+{
+    std::atomic<bool> Profiler::s_is_capturing {false};
+
+    namespace
+    {
+        struct ProfileEvent
+        {
+            const char* m_zone_name {nullptr};
+            uint64_t    m_begin_ns {0};
+            uint64_t    m_end_ns {0};
+            uint32_t    m_thread_id {0};
+        };
+
+        /// single producer single consumer ring, the owning thread writes and endFrame reads under the registry lock
+        struct ThreadEventBuffer
+        {
+            static constexpr uint32_t k_capacity = 1 << 14;
+
+            bool push(const ProfileEvent& event)
+            {
+                const uint32_t write_index = m_write_index.load(std::memory_order_relaxed);
+                if (write_index - m_read_index.load(std::memory_order_acquire) >= k_capacity)
+                {
+                    return false;
+                }
+
+                m_events[write_index % k_capacity] = event;
+                m_write_index.store(write_index + 1, std::memory_order_release);
+                return true;
+            }
+
+            void drain(std::vector<ProfileEvent>& out_events)
+            {
+                const uint32_t read_index  = m_read_index.load(std::memory_order_relaxed);
+                const uint32_t write_index = m_write_index.load(std::memory_order_acquire);
+                for (uint32_t index = read_index; index != write_index; ++index)
+                {
+                    out_events.push_back(m_events[index % k_capacity]);
+                }
+                m_read_index.store(write_index, std::memory_order_release);
+            }
+
+            std::array<ProfileEvent, k_capacity> m_events;
+            std::atomic<uint32_t>                m_write_index {0};
+            std::atomic<uint32_t>                m_read_index {0};
+            std::string                          m_thread_name;
+            uint32_t                             m_thread_id {0};
+        };
+
+        struct ProfilerRegistry
+        {
+            std::mutex m_mutex;
+            // buffers stay alive after their thread exits so that pending events can still be collected
+            std::vector<std::unique_ptr<ThreadEventBuffer>> m_buffers;
+            std::vector<ProfileEvent>                       m_captured_events;
+            std::atomic<uint64_t>                           m_dropped_event_count {0};
+            uint64_t                                        m_capture_begin_ns {0};
+        };
+
+        ProfilerRegistry& getRegistry()
+        {
+            static ProfilerRegistry registry;
+            return registry;
+        }
+
+        thread_local ThreadEventBuffer* t_event_buffer = nullptr;
+
+        ThreadEventBuffer& getThreadEventBuffer()
+        {
+            if (t_event_buffer == nullptr)
+            {
+                ProfilerRegistry&           registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry.m_mutex);
+
+                registry.m_buffers.push_back(std::make_unique<ThreadEventBuffer>());
+                t_event_buffer              = registry.m_buffers.back().get();
+                t_event_buffer->m_thread_id = static_cast<uint32_t>(registry.m_buffers.size());
+            }
+            return *t_event_buffer;
+        }
+
+        void collectEvents(ProfilerRegistry& registry)
+        {
+            for (auto& buffer : registry.m_buffers)
+            {
+                buffer->drain(registry.m_captured_events);
+            }
+        }
+
+        void writeJsonString(std::ofstream& stream, const char* text)
+        {
+            stream << '"';
+            for (const char* character = text; *character != '\0'; ++character)
+            {
+                if (*character == '"' || *character == '\\')
+                {
+                    stream << '\\';
+                }
+                stream << *character;
+            }
+            stream << '"';
+        }
+    } // namespace
+
+    void Profiler::startCapture()
+    {
+        ProfilerRegistry&           registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_mutex);
+
+        // throw away whatever was recorded before the capture started
+        collectEvents(registry);
+        registry.m_captured_events.clear();
+        registry.m_dropped_event_count = 0;
+        registry.m_capture_begin_ns    = getTimestamp();
+
+        s_is_capturing.store(true, std::memory_order_relaxed);
+    }
+
+    void Profiler::stopCapture()
+    {
+        s_is_capturing.store(false, std::memory_order_relaxed);
+
+        ProfilerRegistry&           registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_mutex);
+        collectEvents(registry);
+    }
+
+    void Profiler::endFrame()
+    {
+        if (!isCapturing())
+        {
+            return;
+        }
+
+        ProfilerRegistry&           registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_mutex);
+        collectEvents(registry);
+    }
+
+    void Profiler::setThreadName(const char* thread_name)
+    {
+        ThreadEventBuffer&          buffer   = getThreadEventBuffer();
+        ProfilerRegistry&           registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_mutex);
+        buffer.m_thread_name = thread_name;
+    }
+
+    bool Profiler::saveChromeTrace(const std::filesystem::path& file_path)
+    {
+        ProfilerRegistry&           registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_mutex);
+        collectEvents(registry);
+
+        std::ofstream stream(file_path);
+        if (!stream.is_open())
+        {
+            return false;
+        }
+
+        stream.setf(std::ios::fixed);
+        stream.precision(3);
+
+        // timestamps are in microseconds relative to the capture start
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool is_first_event = true;
+        for (const auto& buffer : registry.m_buffers)
+        {
+            if (buffer->m_thread_name.empty())
+            {
+                continue;
+            }
+            stream << (is_first_event ? "" : ",") << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":"
+                   << buffer->m_thread_id << ",\"args\":{\"name\":";
+            writeJsonString(stream, buffer->m_thread_name.c_str());
+            stream << "}}";
+            is_first_event = false;
+        }
+
+        for (const ProfileEvent& event : registry.m_captured_events)
+        {
+            if (event.m_begin_ns < registry.m_capture_begin_ns)
+            {
+                continue;
+            }
+            stream << (is_first_event ? "" : ",") << "\n{\"ph\":\"X\",\"cat\":\"cpu\",\"name\":";
+            writeJsonString(stream, event.m_zone_name);
+            stream << ",\"pid\":0,\"tid\":" << event.m_thread_id
+                   << ",\"ts\":" << (event.m_begin_ns - registry.m_capture_begin_ns) / 1000.0
+                   << ",\"dur\":" << (event.m_end_ns - event.m_begin_ns) / 1000.0 << "}";
+            is_first_event = false;
+        }
+
+        stream << "\n],\"otherData\":{\"dropped_events\":" << registry.m_dropped_event_count.load() << "}}\n";
+        return stream.good();
+    }
+
+    void Profiler::recordZone(const char* zone_name, uint64_t begin_ns, uint64_t end_ns)
+    {
+        ThreadEventBuffer& buffer = getThreadEventBuffer();
+        if (!buffer.push({zone_name, begin_ns, end_ns, buffer.m_thread_id}))
+        {
+            // the ring is full until the next endFrame, losing events beats blocking the hot path
+            getRegistry().m_dropped_event_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+} // namespace Piccolo
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+// zones compile to nothing when the engine is built with PICCOLO_ENABLE_PROFILER=0
+#ifndef PICCOLO_ENABLE_PROFILER
+#define PICCOLO_ENABLE_PROFILER 1
+#endif
+
+namespace Piccolo
+{
+    /// Scoped-zone cpu profiler.
+    /// Every thread records finished zones into its own lock-free ring buffer, the buffers are drained once per
+    /// frame by endFrame and the capture is written as Chrome trace json, which chrome://tracing and Perfetto open.
+    /// Zones nest by time on their thread, so the hierarchy needs no explicit parent links.
+    /// While no capture is running a zone costs one relaxed atomic load.
+    class Profiler
+    {
+    public:
+        /// start a new capture, events of the previous capture are discarded
+        static void startCapture();
+        /// stop recording and collect everything that is still in the thread buffers
+        static void stopCapture();
+        static bool isCapturing() { return s_is_capturing.load(std::memory_order_relaxed); }
+
+        /// move finished zones of all threads into the capture, called once per frame by the thread driving the engine
+        static void endFrame();
+
+        /// name shown for the calling thread in the trace
+        static void setThreadName(const char* thread_name);
+
+        /// write the collected events in Chrome trace event format, returns false if the file can not be written
+        static bool saveChromeTrace(const std::filesystem::path& file_path);
+
+        /// @zone_name: has to outlive the capture, zones are meant to be named with string literals
+        static void recordZone(const char* zone_name, uint64_t begin_ns, uint64_t end_ns);
+
+        static uint64_t getTimestamp()
+        {
+            using namespace std::chrono;
+            return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+        }
+
+    private:
+        static std::atomic<bool> s_is_capturing;
+    };
+
+    class ProfileZone
+    {
+    public:
+        explicit ProfileZone(const char* zone_name)
+        {
+            if (Profiler::isCapturing())
+            {
+                m_zone_name = zone_name;
+                m_begin_ns  = Profiler::getTimestamp();
+            }
+        }
+
+        ~ProfileZone()
+        {
+            if (m_zone_name)
+            {
+                Profiler::recordZone(m_zone_name, m_begin_ns, Profiler::getTimestamp());
+            }
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        const char* m_zone_name {nullptr};
+        uint64_t    m_begin_ns {0};
+    };
+} // namespace Piccolo
+
+#define PICCOLO_PROFILE_CONCAT_IMPL(a, b) a##b
+#define PICCOLO_PROFILE_CONCAT(a, b) PICCOLO_PROFILE_CONCAT_IMPL(a, b)
+
+#if PICCOLO_ENABLE_PROFILER
+#define PICCOLO_PROFILE_ZONE(zone_name) \
+    Piccolo::ProfileZone PICCOLO_PROFILE_CONCAT(piccolo_profile_zone_, __LINE__)(zone_name)
+#define PICCOLO_PROFILE_END_FRAME() Piccolo::Profiler::endFrame()
+#define PICCOLO_PROFILE_THREAD_NAME(thread_name) Piccolo::Profiler::setThreadName(thread_name)
+#else
+#define PICCOLO_PROFILE_ZONE(zone_name)
+#define PICCOLO_PROFILE_END_FRAME()
+#define PICCOLO_PROFILE_THREAD_NAME(thread_name)
+#endif
@@ -2,7 +2,9 @@
 
 #include "runtime/core/base/macro.h"
 #include "runtime/core/meta/reflection/reflection_register.h"
+#include "runtime/core/profile/profiler.h"
 
+#include "runtime/function/animation/animation_lod.h"
 #include "runtime/function/framework/world/world_manager.h"
 #include "runtime/function/global/global_context.h"
 #include "runtime/function/input/input_system.h"
@@ -12,16 +14,22 @@
 #include "runtime/function/render/window_system.h"
 #include "runtime/function/render/debugdraw/debug_draw_manager.h"
 
+#include "runtime/resource/config_manager/config_manager.h"
+
+#include <algorithm>
+
 namespace Piccolo
 {
     bool                            g_is_editor_mode {false};
     std::unordered_set<std::string> g_editor_tick_component_types {};
 
-    void PiccoloEngine::startEngine(const std::string& config_file_path)
+    void PiccoloEngine::startEngine(const std::string& config_file_path, bool is_headless)
     {
         Reflection::TypeMetaRegister::metaRegister();
+        PICCOLO_PROFILE_THREAD_NAME("main");
 
-        g_runtime_global_context.startSystems(config_file_path);
+        m_is_headless = is_headless;
+        g_runtime_global_context.startSystems(config_file_path, is_headless);
 
         LOG_INFO("engine start");
     }
@@ -43,13 +51,153 @@ namespace Piccolo
         std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
         ASSERT(window_system);
 
+        // the editor ui reads the world while it is drawn, so only the standalone runtime renders on its own thread.
+        // opt-in: a swapchain recreation on the render thread still waits for window events there
+        const bool is_render_thread_enabled =
+            !g_is_editor_mode && g_runtime_global_context.m_config_manager->isRenderThreadEnabled();
+        if (is_render_thread_enabled)
+        {
+            startRenderThread();
+        }
+
         while (!window_system->shouldClose())
         {
             const float delta_time = calculateDeltaTime();
-            tickOneFrame(delta_time);
+            if (is_render_thread_enabled)
+            {
+                tickOneFramePipelined(delta_time);
+            }
+            else
+            {
+                tickOneFrame(delta_time);
+            }
+        }
+
+        if (is_render_thread_enabled)
+        {
+            stopRenderThread();
         }
     }
 
+    void PiccoloEngine::runHeadless(uint32_t frame_count, float fixed_delta_time)
+    {
+        ASSERT(m_is_headless);
+
+        using namespace std::chrono;
+
+        struct StageTiming
+        {
+            const char* m_name;
+            double      m_total_ms {0.0};
+            double      m_max_ms {0.0};
+
+            void add(steady_clock::time_point begin, steady_clock::time_point end)
+            {
+                const double duration_ms = duration<double, std::milli>(end - begin).count();
+                m_total_ms += duration_ms;
+                m_max_ms = std::max(m_max_ms, duration_ms);
+            }
+        };
+
+        // same order as tickOneFrame, split so that each system is timed on its own
+        StageTiming world_timing {"world"};
+        StageTiming input_timing {"input"};
+        StageTiming swap_timing {"swap"};
+        StageTiming render_timing {"render"};
+        StageTiming frame_timing {"frame"};
+
+        // the world is loaded lazily by the first tick and its level streams in over the following ticks, keep
+        // the loading out of the per-frame numbers
+        const steady_clock::time_point load_begin       = steady_clock::now();
+        uint32_t                       load_frame_count = 0;
+        do
+        {
+            logicalTick(fixed_delta_time);
+            g_runtime_global_context.m_render_system->swapLogicRenderData();
+            rendererTick(fixed_delta_time);
+            ++load_frame_count;
+        } while (g_runtime_global_context.m_world_manager->isLevelLoading());
+        const double load_ms = duration<double, std::milli>(steady_clock::now() - load_begin).count();
+
+        for (uint32_t frame_index = 0; frame_index < frame_count; ++frame_index)
+        {
+            const steady_clock::time_point frame_begin = steady_clock::now();
+            g_runtime_global_context.m_world_manager->tick(fixed_delta_time);
+
+            const steady_clock::time_point input_begin = steady_clock::now();
+            g_runtime_global_context.m_input_system->tick();
+
+            const steady_clock::time_point swap_begin = steady_clock::now();
+            calculateFPS(fixed_delta_time);
+            g_runtime_global_context.m_render_system->swapLogicRenderData();
+
+            const steady_clock::time_point render_begin = steady_clock::now();
+            rendererTick(fixed_delta_time);
+
+            const steady_clock::time_point frame_end = steady_clock::now();
+            PICCOLO_PROFILE_END_FRAME();
+            world_timing.add(frame_begin, input_begin);
+            input_timing.add(input_begin, swap_begin);
+            swap_timing.add(swap_begin, render_begin);
+            render_timing.add(render_begin, frame_end);
+            frame_timing.add(frame_begin, frame_end);
+        }
+
+        LOG_INFO("headless run: {} frames, {:.4f} s fixed timestep, loading took {} frames and {:.3f} ms",
+                 frame_count,
+                 fixed_delta_time,
+                 load_frame_count,
+                 load_ms);
+        for (const StageTiming* timing : {&world_timing, &input_timing, &swap_timing, &render_timing, &frame_timing})
+        {
+            LOG_INFO("{:<8} avg {:8.3f} ms  max {:8.3f} ms  total {:10.3f} ms",
+                     timing->m_name,
+                     frame_count > 0 ? timing->m_total_ms / frame_count : 0.0,
+                     timing->m_max_ms,
+                     timing->m_total_ms);
+        }
+
+        // includes the loading frames
+        const AnimationLodManager::Statistics& animation_lod_statistics = AnimationLodManager::getTotalStatistics();
+        LOG_INFO("animation lods: {} full, {} reduced, {} minimal evaluations, {} interpolated, {} culled skeletons",
+                 animation_lod_statistics.m_evaluated_counts[static_cast<size_t>(AnimationLod::Full)],
+                 animation_lod_statistics.m_evaluated_counts[static_cast<size_t>(AnimationLod::Reduced)],
+                 animation_lod_statistics.m_evaluated_counts[static_cast<size_t>(AnimationLod::Minimal)],
+                 animation_lod_statistics.m_interpolated_count,
+                 animation_lod_statistics.m_evaluated_counts[static_cast<size_t>(AnimationLod::Culled)]);
+    }
+
+    bool PiccoloEngine::runHeadlessPipelined(uint32_t frame_count, float fixed_delta_time)
+    {
+        ASSERT(m_is_headless);
+
+        // the world loads and streams its level in while the frames run, so the swap data carries object
+        // creations as well as the per-frame transforms
+        startRenderThread();
+        for (uint32_t frame_index = 0; frame_index < frame_count; ++frame_index)
+        {
+            tickOneFramePipelined(fixed_delta_time);
+        }
+        stopRenderThread();
+
+        const bool is_in_order =
+            m_render_thread_frame_count == frame_count && m_render_thread_out_of_order_frame_count == 0;
+        if (is_in_order)
+        {
+            LOG_INFO("pipelined run: {} frames published, {} consumed in order",
+                     frame_count,
+                     m_render_thread_frame_count);
+        }
+        else
+        {
+            LOG_ERROR("pipelined run: {} frames published, {} consumed, {} out of order",
+                      frame_count,
+                      m_render_thread_frame_count,
+                      m_render_thread_out_of_order_frame_count);
+        }
+        return is_in_order;
+    }
+
     float PiccoloEngine::calculateDeltaTime()
     {
         float delta_time;
@@ -67,6 +215,10 @@ namespace Piccolo
 
     bool PiccoloEngine::tickOneFrame(float delta_time)
     {
+        // zones of the previous frame are finished at this point
+        PICCOLO_PROFILE_END_FRAME();
+        PICCOLO_PROFILE_ZONE("PiccoloEngine::tickOneFrame");
+
         logicalTick(delta_time);
         calculateFPS(delta_time);
 
@@ -90,6 +242,90 @@ namespace Piccolo
         return !should_window_close;
     }
 
+    bool PiccoloEngine::tickOneFramePipelined(float delta_time)
+    {
+        // also collects the zones the render thread finished meanwhile
+        PICCOLO_PROFILE_END_FRAME();
+        PICCOLO_PROFILE_ZONE("PiccoloEngine::tickOneFramePipelined");
+
+        logicalTick(delta_time);
+        calculateFPS(delta_time);
+
+        // hand the frame over to the render thread, waits while the render thread is still on the previous one
+        {
+            PICCOLO_PROFILE_ZONE("RenderSwapContext::publishLogicFrame");
+            g_runtime_global_context.m_render_system->getSwapContext().publishLogicFrame(delta_time);
+        }
+
+        if (m_is_headless)
+        {
+            return true;
+        }
+
+#ifdef ENABLE_PHYSICS_DEBUG_RENDERER
+        g_runtime_global_context.m_physics_manager->renderPhysicsWorld(delta_time);
+#endif
+
+        // window events have to be polled on the thread that created the window
+        g_runtime_global_context.m_window_system->pollEvents();
+
+        g_runtime_global_context.m_window_system->setTitle(
+            std::string("Piccolo - " + std::to_string(getFPS()) + " FPS").c_str());
+
+        const bool should_window_close = g_runtime_global_context.m_window_system->shouldClose();
+        return !should_window_close;
+    }
+
+    void PiccoloEngine::startRenderThread()
+    {
+        g_runtime_global_context.m_render_system->getSwapContext().startPipelining();
+        m_render_thread = std::thread(&PiccoloEngine::renderThreadLoop, this);
+
+        LOG_INFO("render thread started");
+    }
+
+    void PiccoloEngine::stopRenderThread()
+    {
+        g_runtime_global_context.m_render_system->getSwapContext().stopPipelining();
+        if (m_render_thread.joinable())
+        {
+            m_render_thread.join();
+        }
+
+        LOG_INFO("render thread stopped");
+    }
+
+    void PiccoloEngine::renderThreadLoop()
+    {
+        PICCOLO_PROFILE_THREAD_NAME("render");
+
+        RenderSwapContext& swap_context = g_runtime_global_context.m_render_system->getSwapContext();
+
+        m_render_thread_frame_count              = 0;
+        m_render_thread_out_of_order_frame_count = 0;
+
+        float    delta_time           = 0.f;
+        uint64_t frame_index          = 0;
+        uint64_t previous_frame_index = 0;
+        while (swap_context.waitForLogicFrame(delta_time, frame_index))
+        {
+            // no frame is skipped or repeated, and the render side holds the swap data published with the frame
+            const bool is_next_frame = previous_frame_index == 0 || frame_index == previous_frame_index + 1;
+            if (!is_next_frame || swap_context.getRenderSwapData().m_frame_index != frame_index)
+            {
+                LOG_ERROR("render thread got frame {} after frame {} with the swap data of frame {}",
+                          frame_index,
+                          previous_frame_index,
+                          swap_context.getRenderSwapData().m_frame_index);
+                ++m_render_thread_out_of_order_frame_count;
+            }
+            previous_frame_index = frame_index;
+            ++m_render_thread_frame_count;
+
+            rendererTick(delta_time);
+        }
+    }
+
     void PiccoloEngine::logicalTick(float delta_time)
     {
         g_runtime_global_context.m_world_manager->tick(delta_time);
@@ -2,8 +2,10 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <string>
+#include <thread>
 #include <unordered_set>
 
 namespace Piccolo
@@ -18,7 +20,7 @@ namespace Piccolo
         static const float s_fps_alpha;
 
     public:
-        void startEngine(const std::string& config_file_path);
+        void startEngine(const std::string& config_file_path, bool is_headless = false);
         void shutdownEngine();
 
         void initialize();
@@ -26,6 +28,17 @@ namespace Piccolo
 
         bool isQuit() const { return m_is_quit; }
         void run();
+        /**
+         *  Windowless run for benchmarking, needs an engine started headless.
+         *  Ticks frame_count frames with a fixed timestep and logs the time spent in each system
+         */
+        void runHeadless(uint32_t frame_count, float fixed_delta_time);
+        /**
+         *  Windowless run of the pipelined mode, needs an engine started headless. Ticks frame_count frames with
+         *  the render thread and returns whether it consumed every frame once, in order and with the swap data
+         *  published with it
+         */
+        bool runHeadlessPipelined(uint32_t frame_count, float fixed_delta_time);
         bool tickOneFrame(float delta_time);
 
         int getFPS() const { return m_fps; }
@@ -36,6 +49,15 @@ namespace Piccolo
 
         void calculateFPS(float delta_time);
 
+        /**
+         *  Logic half of a frame when rendering runs on the render thread, the render thread draws the previous
+         *  frame meanwhile
+         */
+        bool tickOneFramePipelined(float delta_time);
+        void startRenderThread();
+        void stopRenderThread();
+        void renderThreadLoop();
+
         /**
          *  Each frame can only be called once
          */
@@ -43,12 +65,18 @@ namespace Piccolo
 
     protected:
         bool m_is_quit {false};
+        bool m_is_headless {false};
 
         std::chrono::steady_clock::time_point m_last_tick_time_point {std::chrono::steady_clock::now()};
 
         float m_average_duration {0.f};
         int   m_frame_count {0};
         int   m_fps {0};
+
+        std::thread m_render_thread;
+        // written by the render thread, read once it is joined
+        uint64_t m_render_thread_frame_count {0};
+        uint64_t m_render_thread_out_of_order_frame_count {0};
     };
 
 } // namespace Piccolo
@@ -0,0 +1,125 @@
+#include "runtime/function/animation/animation_benchmark.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/res_type/common/object.h"
+
+#include "runtime/function/animation/animation_system.h"
+#include "runtime/function/animation/skeleton.h"
+#include "runtime/function/framework/component/animation/animation_component.h"
+#include "runtime/function/global/global_context.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // what an animation component keeps between ticks
+        struct BenchmarkCharacter
+        {
+            Skeleton           m_skeleton;
+            ResolvedBlendState m_blend_state;
+            std::vector<float> m_blend_ratio;
+            AnimationResult    m_result;
+        };
+    } // namespace
+
+    void runAnimationSamplingBenchmark(const std::string& object_definition_url,
+                                       uint32_t           character_count,
+                                       uint32_t           frame_count)
+    {
+        using namespace std::chrono;
+
+        ObjectDefinitionRes definition_res;
+        if (!g_runtime_global_context.m_asset_manager->loadAsset(object_definition_url, definition_res))
+        {
+            LOG_ERROR("load object definition {} failed", object_definition_url);
+            return;
+        }
+
+        AnimationComponentRes animation_res;
+        bool                  has_animation = false;
+        for (auto& component : definition_res.m_components)
+        {
+            if (!has_animation && component.getTypeName() == "AnimationComponent")
+            {
+                animation_res = static_cast<AnimationComponent*>(component.getPtr())->getAnimationRes();
+                has_animation = true;
+            }
+            PICCOLO_REFLECTION_DELETE(component);
+        }
+        if (!has_animation)
+        {
+            LOG_ERROR("object definition {} has no animation component", object_definition_url);
+            return;
+        }
+
+        std::shared_ptr<SkeletonData> skeleton_data =
+            AnimationManager::tryLoadSkeleton(animation_res.skeleton_file_path);
+
+        std::vector<std::unique_ptr<BenchmarkCharacter>> characters;
+        for (uint32_t character_index = 0; character_index < character_count; ++character_index)
+        {
+            std::unique_ptr<BenchmarkCharacter> character = std::make_unique<BenchmarkCharacter>();
+            character->m_skeleton.buildSkeleton(*skeleton_data);
+            if (!AnimationManager::resolveBlendState(animation_res.blend_state, character->m_blend_state))
+            {
+                return;
+            }
+            // spread the characters over the clip so they do not all sample the same frame
+            character->m_blend_ratio = animation_res.blend_state.blend_ratio;
+            character->m_blend_ratio[0] += static_cast<float>(character_index) / character_count;
+            characters.push_back(std::move(character));
+        }
+
+        const std::vector<float>& clip_lengths     = animation_res.blend_state.blend_clip_file_length;
+        const float               fixed_delta_time = 1.0f / 60.0f;
+        double                    total_ms         = 0.0;
+        double                    max_ms           = 0.0;
+        // the first frame grows the result buffers and is not counted
+        for (uint32_t frame_index = 0; frame_index <= frame_count; ++frame_index)
+        {
+            const steady_clock::time_point frame_begin = steady_clock::now();
+            // one character per job, like the animation phase of a level
+            g_runtime_global_context.m_job_system->parallelFor(
+                character_count, 1, [&characters, &clip_lengths, fixed_delta_time](uint32_t begin, uint32_t end) {
+                    for (uint32_t character_index = begin; character_index < end; ++character_index)
+                    {
+                        BenchmarkCharacter& character = *characters[character_index];
+                        for (size_t clip_index = 0;
+                             clip_index < character.m_blend_ratio.size() && clip_index < clip_lengths.size();
+                             ++clip_index)
+                        {
+                            float& blend_ratio = character.m_blend_ratio[clip_index];
+                            blend_ratio += fixed_delta_time / clip_lengths[clip_index];
+                            blend_ratio -= floor(blend_ratio);
+                        }
+
+                        character.m_skeleton.applyAnimation(character.m_blend_state, character.m_blend_ratio);
+                        character.m_skeleton.outputAnimationResult(character.m_result);
+                    }
+                });
+            const double frame_ms = duration<double, std::milli>(steady_clock::now() - frame_begin).count();
+            if (frame_index > 0)
+            {
+                total_ms += frame_ms;
+                max_ms = std::max(max_ms, frame_ms);
+            }
+        }
+
+        const double average_ms = frame_count > 0 ? total_ms / frame_count : 0.0;
+        LOG_INFO("animation sampling: {} characters, {} bones, {} frames, {:.3f} ms average, {:.3f} ms max per frame, "
+                 "{:.2f} us per character",
+                 character_count,
+                 skeleton_data->bones_map.size(),
+                 frame_count,
+                 average_ms,
+                 max_ms,
+                 character_count > 0 ? average_ms * 1000.0 / character_count : 0.0);
+    }
+} // namespace Piccolo
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Piccolo
+{
+    /**
+     *  Samples character_count copies of the animation of an object definition for frame_count frames, one
+     *  character per job like the animation components of a level, and logs the time per frame. Needs the
+     *  engine systems started, headless is enough
+     */
+    void runAnimationSamplingBenchmark(const std::string& object_definition_url,
+                                       uint32_t           character_count,
+                                       uint32_t           frame_count);
+} // namespace Piccolo
@@ -0,0 +1,666 @@
+#include "runtime/function/animation/animation_compression.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/math/math.h"
+
+#include "runtime/resource/config_manager/config_manager.h"
+
+#include "runtime/function/global/global_context.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PICCOLO_ANIMATION_SAMPLER_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Piccolo
+{
+    static constexpr size_t k_simd_width = 4;
+
+    static constexpr float    k_vector_quantization_max   = 65535.0f;
+    static constexpr float    k_rotation_quantization_max = 32767.0f;
+    static constexpr uint16_t k_rotation_component_mask   = 0x7fff;
+    // the three smallest components of a unit quaternion are within +-1/sqrt(2)
+    static constexpr float k_rotation_component_range = 0.70710678f;
+
+    namespace
+    {
+        /// quantizes the vectors of one track to 16 bits per component in the range the track covers
+        struct VectorTrackCodec
+        {
+            Vector3 m_minimum;
+            Vector3 m_step;
+
+            explicit VectorTrackCodec(const std::vector<Vector3>& values)
+            {
+                m_minimum       = values[0];
+                Vector3 maximum = values[0];
+                for (const Vector3& value : values)
+                {
+                    m_minimum.makeFloor(value);
+                    maximum.makeCeil(value);
+                }
+                m_step = (maximum - m_minimum) / k_vector_quantization_max;
+            }
+
+            void encode(const Vector3& value, uint16_t* out_components) const
+            {
+                for (size_t component_index = 0; component_index < 3; ++component_index)
+                {
+                    const float step = m_step[component_index];
+                    const float quantized =
+                        step > 0.0f ? std::round((value[component_index] - m_minimum[component_index]) / step) : 0.0f;
+                    out_components[component_index] =
+                        static_cast<uint16_t>(Math::clamp(quantized, 0.0f, k_vector_quantization_max));
+                }
+            }
+
+            Vector3 decode(const uint16_t* components) const
+            {
+                return Vector3(m_minimum.x + components[0] * m_step.x,
+                               m_minimum.y + components[1] * m_step.y,
+                               m_minimum.z + components[2] * m_step.z);
+            }
+        };
+
+        /// smallest three: the largest component is dropped and rebuilt from the unit length, its index is kept
+        /// in the top bits of the first two components
+        void encodeRotation(const Quaternion& rotation, uint16_t* out_components)
+        {
+            Quaternion normalized = rotation;
+            normalized.normalise();
+            const float components[4] = {normalized.x, normalized.y, normalized.z, normalized.w};
+
+            uint16_t largest_index = 0;
+            for (uint16_t component_index = 1; component_index < 4; ++component_index)
+            {
+                if (std::fabs(components[component_index]) > std::fabs(components[largest_index]))
+                {
+                    largest_index = component_index;
+                }
+            }
+
+            // q and -q are the same rotation, the dropped component is always stored positive
+            const float sign         = components[largest_index] < 0.0f ? -1.0f : 1.0f;
+            size_t      output_index = 0;
+            for (uint16_t component_index = 0; component_index < 4; ++component_index)
+            {
+                if (component_index == largest_index)
+                {
+                    continue;
+                }
+                const float normalized_component =
+                    components[component_index] * sign / k_rotation_component_range * 0.5f + 0.5f;
+                out_components[output_index++] = static_cast<uint16_t>(
+                    Math::clamp(std::round(normalized_component * k_rotation_quantization_max),
+                                0.0f,
+                                k_rotation_quantization_max));
+            }
+            out_components[0] |= static_cast<uint16_t>((largest_index >> 1) << 15);
+            out_components[1] |= static_cast<uint16_t>((largest_index & 1) << 15);
+        }
+
+        /// writes x, y, z, w
+        void decodeRotation(const uint16_t* components, float* out_components)
+        {
+            const uint16_t largest_index = static_cast<uint16_t>(((components[0] >> 15) << 1) | (components[1] >> 15));
+
+            float  square_sum  = 0.0f;
+            size_t input_index = 0;
+            for (uint16_t component_index = 0; component_index < 4; ++component_index)
+            {
+                if (component_index == largest_index)
+                {
+                    continue;
+                }
+                const float normalized_component =
+                    (components[input_index++] & k_rotation_component_mask) / k_rotation_quantization_max;
+                const float component           = (normalized_component * 2.0f - 1.0f) * k_rotation_component_range;
+                out_components[component_index] = component;
+                square_sum += component * component;
+            }
+            out_components[largest_index] = std::sqrt(std::max(0.0f, 1.0f - square_sum));
+        }
+
+        Quaternion decodeRotation(const uint16_t* components)
+        {
+            float decoded[4];
+            decodeRotation(components, decoded);
+            return Quaternion(decoded[3], decoded[0], decoded[1], decoded[2]);
+        }
+
+        /// Picks the keys to keep, the first, the last and every key the linear interpolation between the kept
+        /// keys around it misses by more than the tolerance. The interpolation runs on the decoded values, so the
+        /// quantization error is part of the measured error
+        template<typename ValueType, typename InterpolateFunction, typename IsWithinToleranceFunction>
+        void selectKeys(const std::vector<ValueType>& source_values,
+                        const std::vector<ValueType>& decoded_values,
+                        InterpolateFunction           interpolate,
+                        IsWithinToleranceFunction     is_within_tolerance,
+                        std::vector<uint32_t>&        out_key_indices)
+        {
+            out_key_indices.clear();
+            out_key_indices.push_back(0);
+
+            const size_t value_count = source_values.size();
+            const bool   is_constant =
+                std::all_of(source_values.begin(), source_values.end(), [&](const ValueType& value) {
+                    return is_within_tolerance(decoded_values[0], value);
+                });
+            if (is_constant)
+            {
+                return;
+            }
+
+            auto segment_fits = [&](size_t begin, size_t end) {
+                for (size_t value_index = begin + 1; value_index < end; ++value_index)
+                {
+                    const float     ratio = static_cast<float>(value_index - begin) / static_cast<float>(end - begin);
+                    const ValueType value = interpolate(decoded_values[begin], decoded_values[end], ratio);
+                    if (!is_within_tolerance(value, source_values[value_index]))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            // extend the segment from the last kept key until it stops fitting, then keep the key before
+            size_t anchor_index = 0;
+            for (size_t end_index = 2; end_index < value_count; ++end_index)
+            {
+                if (!segment_fits(anchor_index, end_index))
+                {
+                    anchor_index = end_index - 1;
+                    out_key_indices.push_back(static_cast<uint32_t>(anchor_index));
+                }
+            }
+            if (value_count > 1)
+            {
+                out_key_indices.push_back(static_cast<uint32_t>(value_count - 1));
+            }
+        }
+
+        void appendTrack(const std::vector<uint32_t>&   key_indices,
+                         const std::vector<uint16_t>&   encoded_values,
+                         CompressedAnimationTrackGroup& out_tracks)
+        {
+            for (uint32_t key_index : key_indices)
+            {
+                out_tracks.key_frames.push_back(static_cast<unsigned short>(key_index));
+                out_tracks.key_values.insert(out_tracks.key_values.end(),
+                                             encoded_values.begin() + key_index * 3,
+                                             encoded_values.begin() + key_index * 3 + 3);
+            }
+            out_tracks.key_offsets.push_back(static_cast<uint32_t>(out_tracks.key_frames.size()));
+        }
+
+        /// returns the largest error the quantization alone can cause, half a step in each component
+        float compressVectorTrack(std::vector<Vector3>           values,
+                                  const Vector3&                 default_value,
+                                  float                          tolerance,
+                                  CompressedAnimationTrackGroup& out_tracks)
+        {
+            if (values.empty())
+            {
+                values.push_back(default_value);
+            }
+
+            const VectorTrackCodec codec(values);
+            std::vector<uint16_t>  encoded_values(values.size() * 3);
+            std::vector<Vector3>   decoded_values(values.size());
+            for (size_t value_index = 0; value_index < values.size(); ++value_index)
+            {
+                codec.encode(values[value_index], &encoded_values[value_index * 3]);
+                decoded_values[value_index] = codec.decode(&encoded_values[value_index * 3]);
+            }
+
+            std::vector<uint32_t> key_indices;
+            selectKeys(
+                values,
+                decoded_values,
+                [](const Vector3& from, const Vector3& to, float ratio) { return Vector3::lerp(from, to, ratio); },
+                [tolerance](const Vector3& lhs, const Vector3& rhs) { return lhs.distance(rhs) <= tolerance; },
+                key_indices);
+
+            appendTrack(key_indices, encoded_values, out_tracks);
+
+            const float ranges[6] = {codec.m_minimum.x,
+                                     codec.m_minimum.y,
+                                     codec.m_minimum.z,
+                                     codec.m_step.x,
+                                     codec.m_step.y,
+                                     codec.m_step.z};
+            out_tracks.ranges.insert(out_tracks.ranges.end(), std::begin(ranges), std::end(ranges));
+            return codec.m_step.length() * 0.5f;
+        }
+
+        void compressRotationTrack(std::vector<Quaternion>        values,
+                                   float                          tolerance,
+                                   CompressedAnimationTrackGroup& out_tracks)
+        {
+            if (values.empty())
+            {
+                values.push_back(Quaternion::IDENTITY);
+            }
+
+            std::vector<uint16_t>   encoded_values(values.size() * 3);
+            std::vector<Quaternion> decoded_values(values.size());
+            for (size_t value_index = 0; value_index < values.size(); ++value_index)
+            {
+                values[value_index].normalise();
+                encodeRotation(values[value_index], &encoded_values[value_index * 3]);
+                decoded_values[value_index] = decodeRotation(&encoded_values[value_index * 3]);
+            }
+
+            // the angle between two unit quaternions is 2 * acos(|dot|)
+            const float minimum_dot = std::cos(tolerance * 0.5f);
+
+            std::vector<uint32_t> key_indices;
+            selectKeys(
+                values,
+                decoded_values,
+                [](const Quaternion& from, const Quaternion& to, float ratio) {
+                    return Quaternion::nLerp(ratio, from, to, true);
+                },
+                [minimum_dot](const Quaternion& lhs, const Quaternion& rhs) {
+                    return std::fabs(lhs.dot(rhs)) >= minimum_dot;
+                },
+                key_indices);
+
+            appendTrack(key_indices, encoded_values, out_tracks);
+        }
+
+        /// the last key at or before frame, starting at the key of the previous sample
+        uint32_t seekKey(const unsigned short* key_frames, uint32_t key_count, float frame, uint32_t& cursor)
+        {
+            uint32_t key_index = cursor < key_count ? cursor : 0;
+            if (key_frames[key_index] <= frame)
+            {
+                // playing forward passes at most a key or two between samples
+                for (uint32_t step = 0; step < 2 && key_index + 1 < key_count && key_frames[key_index + 1] <= frame;
+                     ++step)
+                {
+                    ++key_index;
+                }
+                if (key_index + 1 == key_count || frame < key_frames[key_index + 1])
+                {
+                    cursor = key_index;
+                    return key_index;
+                }
+            }
+
+            const unsigned short* upper = std::upper_bound(key_frames, key_frames + key_count, frame);
+            key_index                   = upper == key_frames ? 0 : static_cast<uint32_t>(upper - key_frames - 1);
+            cursor                      = key_index;
+            return key_index;
+        }
+
+        /// the keys of a track around frame and the interpolation ratio between them
+        float seekKeyPair(const CompressedAnimationTrackGroup& tracks,
+                          size_t                               node_index,
+                          float                                frame,
+                          uint32_t&                            cursor,
+                          uint32_t&                            out_from_key,
+                          uint32_t&                            out_to_key)
+        {
+            const uint32_t        key_begin  = tracks.key_offsets[node_index];
+            const uint32_t        key_count  = tracks.key_offsets[node_index + 1] - key_begin;
+            const unsigned short* key_frames = &tracks.key_frames[key_begin];
+
+            // a track that kept every key, constant ones included, has the key of each frame at its index
+            if (key_frames[key_count - 1] + 1u == key_count)
+            {
+                const uint32_t from_key = std::min(static_cast<uint32_t>(frame), key_count - 1);
+                const uint32_t to_key   = std::min(from_key + 1, key_count - 1);
+                out_from_key            = key_begin + from_key;
+                out_to_key              = key_begin + to_key;
+                return to_key == from_key ? 0.0f : frame - static_cast<float>(from_key);
+            }
+
+            const uint32_t from_key = seekKey(key_frames, key_count, frame, cursor);
+            const uint32_t to_key   = std::min(from_key + 1, key_count - 1);
+            out_from_key            = key_begin + from_key;
+            out_to_key              = key_begin + to_key;
+            if (to_key == from_key)
+            {
+                return 0.0f;
+            }
+
+            const float frame_span = static_cast<float>(key_frames[to_key] - key_frames[from_key]);
+            return Math::clamp((frame - key_frames[from_key]) / frame_span, 0.0f, 1.0f);
+        }
+
+        /// whether none of the tracks of the nodes from block_begin on has more than one key
+        bool isConstantBlock(const CompressedAnimationTrackGroup& tracks, size_t block_begin, size_t node_count)
+        {
+            const size_t block_end = std::min(block_begin + k_simd_width, node_count);
+            for (size_t node_index = block_begin; node_index < block_end; ++node_index)
+            {
+                if (tracks.key_offsets[node_index + 1] - tracks.key_offsets[node_index] > 1)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// Vector3::lerp of the nodes from block_begin to block_begin + k_simd_width, for each of the
+        /// component_count arrays of from, to and results
+        void lerpBlock(const float* from,
+                       const float* to,
+                       const float* ratios,
+                       float*       results,
+                       size_t       block_begin,
+                       size_t       stride,
+                       size_t       component_count)
+        {
+#ifdef PICCOLO_ANIMATION_SAMPLER_SSE
+            const __m128 ratio = _mm_loadu_ps(ratios + block_begin);
+            for (size_t component_index = 0; component_index < component_count; ++component_index)
+            {
+                const size_t offset     = component_index * stride + block_begin;
+                const __m128 from_value = _mm_loadu_ps(from + offset);
+                const __m128 to_value   = _mm_loadu_ps(to + offset);
+                const __m128 difference = _mm_sub_ps(to_value, from_value);
+                _mm_storeu_ps(results + offset, _mm_add_ps(from_value, _mm_mul_ps(difference, ratio)));
+            }
+#else
+            for (size_t component_index = 0; component_index < component_count; ++component_index)
+            {
+                for (size_t node_index = block_begin; node_index < block_begin + k_simd_width; ++node_index)
+                {
+                    const size_t offset = component_index * stride + node_index;
+                    results[offset]     = from[offset] + (to[offset] - from[offset]) * ratios[node_index];
+                }
+            }
+#endif
+        }
+
+        /// Quaternion::nLerp with the shortest path of the nodes from block_begin to block_begin + k_simd_width,
+        /// the rotations are stored as x, y, z and w arrays
+        void nlerpBlock(const float* from,
+                        const float* to,
+                        const float* ratios,
+                        float*       results,
+                        size_t       block_begin,
+                        size_t       stride)
+        {
+#ifdef PICCOLO_ANIMATION_SAMPLER_SSE
+            __m128 from_value[4];
+            __m128 to_value[4];
+            for (size_t component_index = 0; component_index < 4; ++component_index)
+            {
+                from_value[component_index] = _mm_loadu_ps(from + component_index * stride + block_begin);
+                to_value[component_index]   = _mm_loadu_ps(to + component_index * stride + block_begin);
+            }
+
+            // negate the target where the keys are in opposite hemispheres
+            const __m128 dot =
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(from_value[0], to_value[0]), _mm_mul_ps(from_value[1], to_value[1])),
+                           _mm_add_ps(_mm_mul_ps(from_value[2], to_value[2]), _mm_mul_ps(from_value[3], to_value[3])));
+            const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+
+            const __m128 ratio = _mm_loadu_ps(ratios + block_begin);
+            __m128       result[4];
+            __m128       square_length = _mm_setzero_ps();
+            for (size_t component_index = 0; component_index < 4; ++component_index)
+            {
+                const __m128 target     = _mm_xor_ps(to_value[component_index], flip);
+                const __m128 difference = _mm_sub_ps(target, from_value[component_index]);
+                result[component_index] = _mm_add_ps(from_value[component_index], _mm_mul_ps(difference, ratio));
+                square_length = _mm_add_ps(square_length, _mm_mul_ps(result[component_index], result[component_index]));
+            }
+
+            const __m128 inverse_length = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(square_length));
+            for (size_t component_index = 0; component_index < 4; ++component_index)
+            {
+                _mm_storeu_ps(results + component_index * stride + block_begin,
+                              _mm_mul_ps(result[component_index], inverse_length));
+            }
+#else
+            for (size_t node_index = block_begin; node_index < block_begin + k_simd_width; ++node_index)
+            {
+                const Quaternion from_rotation(from[stride * 3 + node_index],
+                                               from[node_index],
+                                               from[stride + node_index],
+                                               from[stride * 2 + node_index]);
+                const Quaternion to_rotation(
+                    to[stride * 3 + node_index], to[node_index], to[stride + node_index], to[stride * 2 + node_index]);
+                const Quaternion rotation = Quaternion::nLerp(ratios[node_index], from_rotation, to_rotation, true);
+                results[node_index]              = rotation.x;
+                results[stride + node_index]     = rotation.y;
+                results[stride * 2 + node_index] = rotation.z;
+                results[stride * 3 + node_index] = rotation.w;
+            }
+#endif
+        }
+    } // namespace
+
+    AnimationCompressionSettings AnimationCompressor::getConfiguredSettings()
+    {
+        std::shared_ptr<ConfigManager> config_manager = g_runtime_global_context.m_config_manager;
+
+        AnimationCompressionSettings settings;
+        settings.m_position_tolerance = config_manager->getAnimationPositionTolerance();
+        settings.m_rotation_tolerance = config_manager->getAnimationRotationTolerance();
+        settings.m_scaling_tolerance  = config_manager->getAnimationScalingTolerance();
+        return settings;
+    }
+
+    bool AnimationCompressor::compressClip(const AnimationClip&                source_clip,
+                                           const AnimationCompressionSettings& settings,
+                                           CompressedAnimationClip&            out_clip)
+    {
+        const size_t node_count =
+            std::min(static_cast<size_t>(std::max(source_clip.node_count, 0)), source_clip.node_channels.size());
+        for (size_t node_index = 0; node_index < node_count; ++node_index)
+        {
+            const AnimationChannel& channel = source_clip.node_channels[node_index];
+            const size_t            max_key_count =
+                std::max({channel.position_keys.size(), channel.rotation_keys.size(), channel.scaling_keys.size()});
+            if (max_key_count > std::numeric_limits<unsigned short>::max() + size_t(1))
+            {
+                LOG_ERROR("animation channel {} has {} keys, more than a compressed clip can hold",
+                          channel.name,
+                          max_key_count);
+                return false;
+            }
+        }
+
+        out_clip             = CompressedAnimationClip {};
+        out_clip.total_frame = source_clip.total_frame;
+        out_clip.node_count  = static_cast<int>(node_count);
+
+        CompressedAnimationTrackGroup* track_groups[] = {
+            &out_clip.position_tracks, &out_clip.rotation_tracks, &out_clip.scaling_tracks};
+        for (CompressedAnimationTrackGroup* track_group : track_groups)
+        {
+            track_group->key_offsets.reserve(node_count + 1);
+            track_group->key_offsets.push_back(0);
+        }
+
+        for (size_t node_index = 0; node_index < node_count; ++node_index)
+        {
+            const AnimationChannel& channel = source_clip.node_channels[node_index];
+            const float             position_quantization_error = compressVectorTrack(
+                channel.position_keys, Vector3::ZERO, settings.m_position_tolerance, out_clip.position_tracks);
+            compressRotationTrack(channel.rotation_keys, settings.m_rotation_tolerance, out_clip.rotation_tracks);
+            const float scaling_quantization_error = compressVectorTrack(
+                channel.scaling_keys, Vector3::UNIT_SCALE, settings.m_scaling_tolerance, out_clip.scaling_tracks);
+
+            // a track with a large range keeps all keys and still misses the tolerance by up to half a step
+            if (position_quantization_error > settings.m_position_tolerance)
+            {
+                LOG_WARN("animation channel {}: 16 bit position quantization error {} exceeds the tolerance {}",
+                         channel.name,
+                         position_quantization_error,
+                         settings.m_position_tolerance);
+            }
+            if (scaling_quantization_error > settings.m_scaling_tolerance)
+            {
+                LOG_WARN("animation channel {}: 16 bit scaling quantization error {} exceeds the tolerance {}",
+                         channel.name,
+                         scaling_quantization_error,
+                         settings.m_scaling_tolerance);
+            }
+        }
+
+        for (CompressedAnimationTrackGroup* track_group : track_groups)
+        {
+            track_group->key_frames.shrink_to_fit();
+            track_group->key_values.shrink_to_fit();
+            track_group->ranges.shrink_to_fit();
+        }
+        return true;
+    }
+
+    void AnimationClipSampler::sample(const CompressedAnimationClip& clip, float phase)
+    {
+        if (m_clip != &clip || m_node_count != static_cast<size_t>(std::max(clip.node_count, 0)))
+        {
+            reset(clip);
+        }
+
+        const float frame = Math::clamp(phase, 0.0f, 1.0f) * static_cast<float>(std::max(clip.total_frame - 1, 0));
+        sampleVectorTracks(clip.position_tracks, frame, m_position_state);
+        sampleRotationTracks(clip.rotation_tracks, frame, m_rotation_state);
+        sampleVectorTracks(clip.scaling_tracks, frame, m_scaling_state);
+        m_are_constant_blocks_sampled = true;
+    }
+
+    Vector3 AnimationClipSampler::getPosition(size_t node_index) const
+    {
+        const std::vector<float>& results = m_position_state.m_results;
+        return Vector3(results[node_index], results[m_stride + node_index], results[m_stride * 2 + node_index]);
+    }
+
+    Quaternion AnimationClipSampler::getRotation(size_t node_index) const
+    {
+        const std::vector<float>& results = m_rotation_state.m_results;
+        return Quaternion(results[m_stride * 3 + node_index],
+                          results[node_index],
+                          results[m_stride + node_index],
+                          results[m_stride * 2 + node_index]);
+    }
+
+    Vector3 AnimationClipSampler::getScaling(size_t node_index) const
+    {
+        const std::vector<float>& results = m_scaling_state.m_results;
+        return Vector3(results[node_index], results[m_stride + node_index], results[m_stride * 2 + node_index]);
+    }
+
+    void AnimationClipSampler::reset(const CompressedAnimationClip& clip)
+    {
+        m_clip                        = &clip;
+        m_node_count                  = static_cast<size_t>(std::max(clip.node_count, 0));
+        m_stride                      = (m_node_count + k_simd_width - 1) / k_simd_width * k_simd_width;
+        m_are_constant_blocks_sampled = false;
+
+        // the lanes past the last node interpolate identities, the rotation ones must not normalize zero
+        auto reset_state = [this](TrackGroupState& state, size_t component_count, float last_component) {
+            state.m_key_cursors.assign(m_node_count, 0);
+            state.m_decoded_keys.assign(m_node_count, std::numeric_limits<uint32_t>::max());
+            state.m_ratios.assign(m_stride, 0.0f);
+            state.m_from.assign(component_count * m_stride, 0.0f);
+            std::fill(state.m_from.end() - m_stride, state.m_from.end(), last_component);
+            state.m_to      = state.m_from;
+            state.m_results = state.m_from;
+        };
+        reset_state(m_position_state, 3, 0.0f);
+        reset_state(m_rotation_state, 4, 1.0f);
+        reset_state(m_scaling_state, 3, 0.0f);
+    }
+
+    void AnimationClipSampler::sampleVectorTracks(const CompressedAnimationTrackGroup& tracks,
+                                                  float                                frame,
+                                                  TrackGroupState&                     state)
+    {
+        for (size_t block_begin = 0; block_begin < m_node_count; block_begin += k_simd_width)
+        {
+            if (m_are_constant_blocks_sampled && isConstantBlock(tracks, block_begin, m_node_count))
+            {
+                continue;
+            }
+
+            const size_t block_end = std::min(block_begin + k_simd_width, m_node_count);
+            for (size_t node_index = block_begin; node_index < block_end; ++node_index)
+            {
+                uint32_t from_key;
+                uint32_t to_key;
+                state.m_ratios[node_index] =
+                    seekKeyPair(tracks, node_index, frame, state.m_key_cursors[node_index], from_key, to_key);
+                if (state.m_decoded_keys[node_index] == from_key)
+                {
+                    continue;
+                }
+                state.m_decoded_keys[node_index] = from_key;
+
+                const unsigned short* from_values = &tracks.key_values[from_key * 3];
+                const unsigned short* to_values   = &tracks.key_values[to_key * 3];
+                const float*          minimum     = &tracks.ranges[node_index * 6];
+                const float*          step        = minimum + 3;
+                for (size_t component_index = 0; component_index < 3; ++component_index)
+                {
+                    const size_t offset  = component_index * m_stride + node_index;
+                    const float  base    = minimum[component_index];
+                    state.m_from[offset] = base + from_values[component_index] * step[component_index];
+                    state.m_to[offset]   = base + to_values[component_index] * step[component_index];
+                }
+            }
+            lerpBlock(state.m_from.data(),
+                      state.m_to.data(),
+                      state.m_ratios.data(),
+                      state.m_results.data(),
+                      block_begin,
+                      m_stride,
+                      3);
+        }
+    }
+
+    void AnimationClipSampler::sampleRotationTracks(const CompressedAnimationTrackGroup& tracks,
+                                                    float                                frame,
+                                                    TrackGroupState&                     state)
+    {
+        for (size_t block_begin = 0; block_begin < m_node_count; block_begin += k_simd_width)
+        {
+            if (m_are_constant_blocks_sampled && isConstantBlock(tracks, block_begin, m_node_count))
+            {
+                continue;
+            }
+
+            const size_t block_end = std::min(block_begin + k_simd_width, m_node_count);
+            for (size_t node_index = block_begin; node_index < block_end; ++node_index)
+            {
+                uint32_t from_key;
+                uint32_t to_key;
+                state.m_ratios[node_index] =
+                    seekKeyPair(tracks, node_index, frame, state.m_key_cursors[node_index], from_key, to_key);
+                if (state.m_decoded_keys[node_index] == from_key)
+                {
+                    continue;
+                }
+                state.m_decoded_keys[node_index] = from_key;
+
+                float from_rotation[4];
+                float to_rotation[4];
+                decodeRotation(&tracks.key_values[from_key * 3], from_rotation);
+                decodeRotation(&tracks.key_values[to_key * 3], to_rotation);
+                for (size_t component_index = 0; component_index < 4; ++component_index)
+                {
+                    state.m_from[component_index * m_stride + node_index] = from_rotation[component_index];
+                    state.m_to[component_index * m_stride + node_index]   = to_rotation[component_index];
+                }
+            }
+            nlerpBlock(state.m_from.data(),
+                       state.m_to.data(),
+                       state.m_ratios.data(),
+                       state.m_results.data(),
+                       block_begin,
+                       m_stride);
+        }
+    }
+} // namespace Piccolo
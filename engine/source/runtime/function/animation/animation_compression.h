@@ -0,0 +1,79 @@
+#pragma once
+
+#include "runtime/core/math/quaternion.h"
+#include "runtime/core/math/vector3.h"
+
+#include "runtime/resource/res_type/data/animation_clip.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Piccolo
+{
+    /// the largest error the compressed clip may have against the source clip at any source frame
+    struct AnimationCompressionSettings
+    {
+        float m_position_tolerance {0.0005f};
+        // angle in radians
+        float m_rotation_tolerance {0.001f};
+        float m_scaling_tolerance {0.0005f};
+    };
+
+    /// Builds CompressedAnimationClip from AnimationClip. Positions and scalings are quantized to 16 bits in the
+    /// range of their track, rotations to the three smallest components with 15 bits each. Afterwards every key
+    /// that linear interpolation between its neighbouring kept keys reproduces within the tolerance is removed
+    class AnimationCompressor
+    {
+    public:
+        /// the tolerances of the config file
+        static AnimationCompressionSettings getConfiguredSettings();
+
+        static bool compressClip(const AnimationClip&                source_clip,
+                                 const AnimationCompressionSettings& settings,
+                                 CompressedAnimationClip&            out_clip);
+    };
+
+    /// Samples all nodes of a compressed clip at once. The keys around the sampled frame are decoded into
+    /// structure-of-arrays buffers and interpolated four nodes at a time with SIMD. The sampler remembers the key
+    /// of every track, so a clip played forward seeks without searching and decodes a key pair only once, and
+    /// nodes without animated tracks are skipped after the first sample. One sampler per playing clip
+    class AnimationClipSampler
+    {
+    public:
+        /// @phase: in [0, 1] over the whole clip
+        void sample(const CompressedAnimationClip& clip, float phase);
+
+        Vector3    getPosition(size_t node_index) const;
+        Quaternion getRotation(size_t node_index) const;
+        Vector3    getScaling(size_t node_index) const;
+
+    private:
+        /// the arrays hold the components one after another, each padded to the stride
+        struct TrackGroupState
+        {
+            std::vector<uint32_t> m_key_cursors;
+            // the key m_from and m_to were decoded from
+            std::vector<uint32_t> m_decoded_keys;
+            std::vector<float>    m_ratios;
+            std::vector<float>    m_from;
+            std::vector<float>    m_to;
+            std::vector<float>    m_results;
+        };
+
+        void reset(const CompressedAnimationClip& clip);
+
+        void sampleVectorTracks(const CompressedAnimationTrackGroup& tracks, float frame, TrackGroupState& state);
+        void sampleRotationTracks(const CompressedAnimationTrackGroup& tracks, float frame, TrackGroupState& state);
+
+        const CompressedAnimationClip* m_clip {nullptr};
+        size_t                         m_node_count {0};
+        // node count padded to the simd width
+        size_t m_stride {0};
+        // blocks of four nodes without animated tracks keep their results from the first sample of the clip
+        bool m_are_constant_blocks_sampled {false};
+
+        TrackGroupState m_position_state;
+        TrackGroupState m_rotation_state;
+        TrackGroupState m_scaling_state;
+    };
+} // namespace Piccolo
@@ -5,6 +5,7 @@
 #include "runtime/resource/res_type/data/animation_clip.h"
 #include "runtime/resource/res_type/data/skeleton_mask.h"
 
+#include "runtime/function/animation/animation_compression.h"
 #include "runtime/function/animation/utilities.h"
 #include "runtime/function/global/global_context.h"
 
@@ -71,11 +72,28 @@ namespace Piccolo
         }
     } // namespace
 
-    std::shared_ptr<Piccolo::AnimationClip> AnimationLoader::loadAnimationClipData(std::string animation_clip_url)
+    std::shared_ptr<Piccolo::CompressedAnimationClip>
+    AnimationLoader::loadAnimationClipData(std::string animation_clip_url)
     {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+
+        // the cooker writes clips compressed, so the cooked file holds a CompressedAnimationAsset
+        CompressedAnimationAsset compressed_animation_clip;
+        if (asset_manager->loadCookedAsset(animation_clip_url, compressed_animation_clip))
+        {
+            return std::make_shared<Piccolo::CompressedAnimationClip>(std::move(compressed_animation_clip.clip_data));
+        }
+
         AnimationAsset animation_clip;
-        g_runtime_global_context.m_asset_manager->loadAsset(animation_clip_url, animation_clip);
-        return std::make_shared<Piccolo::AnimationClip>(animation_clip.clip_data);
+        asset_manager->loadJsonAsset(animation_clip_url, animation_clip);
+
+        std::shared_ptr<CompressedAnimationClip> compressed_clip = std::make_shared<Piccolo::CompressedAnimationClip>();
+        if (!AnimationCompressor::compressClip(
+                animation_clip.clip_data, AnimationCompressor::getConfiguredSettings(), *compressed_clip))
+        {
+            LOG_ERROR("compress animation clip {} failed", animation_clip_url);
+        }
+        return compressed_clip;
     }
 
     std::shared_ptr<Piccolo::SkeletonData> AnimationLoader::loadSkeletonData(std::string skeleton_data_url)
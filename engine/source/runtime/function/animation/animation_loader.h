@@ -13,9 +13,10 @@ namespace Piccolo
     class AnimationLoader
     {
     public:
-        std::shared_ptr<AnimationClip> loadAnimationClipData(std::string animation_clip_url);
-        std::shared_ptr<SkeletonData>  loadSkeletonData(std::string skeleton_data_url);
-        std::shared_ptr<AnimSkelMap>   loadAnimSkelMap(std::string anim_skel_map_url);
-        std::shared_ptr<BoneBlendMask> loadSkeletonMask(std::string skeleton_mask_file_url);
+        /// the cooked clip if there is one, otherwise the json clip compressed with the configured tolerances
+        std::shared_ptr<CompressedAnimationClip> loadAnimationClipData(std::string animation_clip_url);
+        std::shared_ptr<SkeletonData>            loadSkeletonData(std::string skeleton_data_url);
+        std::shared_ptr<AnimSkelMap>             loadAnimSkelMap(std::string anim_skel_map_url);
+        std::shared_ptr<BoneBlendMask>           loadSkeletonMask(std::string skeleton_mask_file_url);
     };
 } // namespace Piccolo
\ No newline at end of file
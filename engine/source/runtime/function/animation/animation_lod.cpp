@@ -0,0 +1,115 @@
+#include "runtime/function/animation/animation_lod.h"
+
+#include "runtime/core/math/math.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    AnimationLodConfig AnimationLodManager::m_config;
+
+    std::mutex                          AnimationLodManager::m_published_view_mutex;
+    AnimationLodManager::MainCameraView AnimationLodManager::m_published_view;
+    bool                                AnimationLodManager::m_is_view_published {false};
+    AnimationLodManager::MainCameraView AnimationLodManager::m_view;
+
+    std::atomic<uint32_t>           AnimationLodManager::m_evaluated_counts[k_animation_lod_count];
+    std::atomic<uint32_t>           AnimationLodManager::m_interpolated_count {0};
+    AnimationLodManager::Statistics AnimationLodManager::m_frame_statistics;
+    AnimationLodManager::Statistics AnimationLodManager::m_total_statistics;
+
+    void AnimationLodManager::setConfig(const AnimationLodConfig& config) { m_config = config; }
+
+    void AnimationLodManager::publishMainCameraView(const Vector3&           camera_position,
+                                                    float                    fov_y_degrees,
+                                                    std::vector<GObjectID>&& culled_object_ids)
+    {
+        std::lock_guard<std::mutex> lock(m_published_view_mutex);
+
+        m_published_view.m_is_valid        = true;
+        m_published_view.m_camera_position = camera_position;
+        m_published_view.m_tan_half_fov_y  = Math::tan(Radian(Degree(fov_y_degrees * 0.5f)));
+        m_published_view.m_culled_object_ids.swap(culled_object_ids);
+        m_is_view_published = true;
+    }
+
+    void AnimationLodManager::beginFrame()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_published_view_mutex);
+            if (m_is_view_published)
+            {
+                // the published ids become the storage of the next publish
+                std::swap(m_view, m_published_view);
+                m_is_view_published = false;
+            }
+        }
+
+        for (size_t lod_index = 0; lod_index < k_animation_lod_count; lod_index++)
+        {
+            const uint32_t evaluated_count = m_evaluated_counts[lod_index].exchange(0, std::memory_order_relaxed);
+            m_frame_statistics.m_evaluated_counts[lod_index] = evaluated_count;
+            m_total_statistics.m_evaluated_counts[lod_index] += evaluated_count;
+        }
+        m_frame_statistics.m_interpolated_count = m_interpolated_count.exchange(0, std::memory_order_relaxed);
+        m_total_statistics.m_interpolated_count += m_frame_statistics.m_interpolated_count;
+    }
+
+    AnimationLod AnimationLodManager::selectLod(GObjectID object_id, const Vector3& position, float bounding_radius)
+    {
+        // until the renderer has drawn a frame everything is animated at full rate
+        if (!m_config.m_enable || !m_view.m_is_valid)
+        {
+            return AnimationLod::Full;
+        }
+
+        if (m_config.m_skip_culled &&
+            std::binary_search(m_view.m_culled_object_ids.begin(), m_view.m_culled_object_ids.end(), object_id))
+        {
+            return AnimationLod::Culled;
+        }
+
+        // the fraction of the screen height the bounding sphere covers
+        const float distance = (position - m_view.m_camera_position).length();
+        if (distance <= bounding_radius)
+        {
+            return AnimationLod::Full;
+        }
+        const float screen_coverage = bounding_radius / (distance * m_view.m_tan_half_fov_y);
+
+        if (screen_coverage >= m_config.m_reduced_screen_coverage)
+        {
+            return AnimationLod::Full;
+        }
+        if (screen_coverage >= m_config.m_minimal_screen_coverage)
+        {
+            return AnimationLod::Reduced;
+        }
+        return AnimationLod::Minimal;
+    }
+
+    AnimationLodSettings AnimationLodManager::getLodSettings(AnimationLod lod)
+    {
+        AnimationLodSettings settings;
+        if (lod == AnimationLod::Reduced)
+        {
+            settings.m_update_interval = static_cast<uint32_t>(std::max(m_config.m_reduced_update_interval, 1));
+        }
+        else if (lod == AnimationLod::Minimal)
+        {
+            settings.m_update_interval = static_cast<uint32_t>(std::max(m_config.m_minimal_update_interval, 1));
+            settings.m_max_bone_depth  = m_config.m_minimal_max_bone_depth;
+        }
+        return settings;
+    }
+
+    void AnimationLodManager::countSkeleton(AnimationLod lod, bool is_interpolated)
+    {
+        if (is_interpolated)
+        {
+            m_interpolated_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_evaluated_counts[static_cast<size_t>(lod)].fetch_add(1, std::memory_order_relaxed);
+    }
+} // namespace Piccolo
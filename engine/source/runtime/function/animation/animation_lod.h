@@ -0,0 +1,96 @@
+#pragma once
+
+#include "runtime/core/math/vector3.h"
+
+#include "runtime/resource/res_type/global/global_rendering.h"
+
+#include "runtime/function/framework/object/object_id_allocator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Piccolo
+{
+    enum class AnimationLod : uint8_t
+    {
+        Full = 0,
+        Reduced,
+        Minimal,
+        // culled by the main camera, the skeleton keeps its last pose
+        Culled,
+        Count
+    };
+
+    constexpr size_t k_animation_lod_count = static_cast<size_t>(AnimationLod::Count);
+
+    struct AnimationLodSettings
+    {
+        // frames between two evaluations of the skeleton
+        uint32_t m_update_interval {1};
+        // bones deeper in the hierarchy keep their binding pose, negative evaluates all bones
+        int32_t m_max_bone_depth {-1};
+    };
+
+    /// Picks the animation lod of a character from the size it covers on screen and whether the main camera
+    /// culled it. The renderer feeds back what it saw in the last drawn frame, the logic picks the lods of the
+    /// next frame from it, so the lods lag one frame behind the camera
+    class AnimationLodManager
+    {
+    public:
+        /// skeletons per lod, a skeleton is counted once per frame. Culled skeletons are skipped, and frames that
+        /// only interpolate are not counted as evaluations
+        struct Statistics
+        {
+            uint32_t m_evaluated_counts[k_animation_lod_count] {};
+            // frames of reduced lods that only interpolated between two evaluations
+            uint32_t m_interpolated_count {0};
+        };
+
+        static void setConfig(const AnimationLodConfig& config);
+
+        /// render thread, after the visible objects of the main camera are updated
+        /// @culled_object_ids: objects with render entities of which none is visible, sorted
+        static void publishMainCameraView(const Vector3&           camera_position,
+                                          float                    fov_y_degrees,
+                                          std::vector<GObjectID>&& culled_object_ids);
+
+        /// logic thread, before the animation components tick: takes the last published view and finishes the
+        /// statistics of the previous frame
+        static void beginFrame();
+
+        /// @bounding_radius: of the character in world space, around its position
+        static AnimationLod selectLod(GObjectID object_id, const Vector3& position, float bounding_radius);
+        static AnimationLodSettings getLodSettings(AnimationLod lod);
+
+        /// called by each skeleton once per frame, safe from parallel component ticks
+        static void countSkeleton(AnimationLod lod, bool is_interpolated);
+
+        static const Statistics& getFrameStatistics() { return m_frame_statistics; }
+        static const Statistics& getTotalStatistics() { return m_total_statistics; }
+
+    private:
+        struct MainCameraView
+        {
+            bool                   m_is_valid {false};
+            Vector3                m_camera_position {Vector3::ZERO};
+            float                  m_tan_half_fov_y {1.0f};
+            std::vector<GObjectID> m_culled_object_ids;
+        };
+
+        static AnimationLodConfig m_config;
+
+        // written by the render thread, taken over by the logic thread in beginFrame
+        static std::mutex     m_published_view_mutex;
+        static MainCameraView m_published_view;
+        static bool           m_is_view_published;
+        // read only while the components tick
+        static MainCameraView m_view;
+
+        static std::atomic<uint32_t> m_evaluated_counts[k_animation_lod_count];
+        static std::atomic<uint32_t> m_interpolated_count;
+        static Statistics            m_frame_statistics;
+        static Statistics            m_total_statistics;
+    };
+} // namespace Piccolo
@@ -1,5 +1,7 @@
 #include "runtime/function/animation/animation_system.h"
 
+#include "runtime/core/base/macro.h"
+
 #include "resource/res_type/data/skeleton_mask.h"
 
 #include "runtime/function/animation/animation_loader.h"
@@ -7,13 +9,24 @@
 
 namespace Piccolo
 {
-    std::map<std::string, std::shared_ptr<SkeletonData>>  AnimationManager::m_skeleton_definition_cache;
-    std::map<std::string, std::shared_ptr<AnimationClip>> AnimationManager::m_animation_data_cache;
-    std::map<std::string, std::shared_ptr<AnimSkelMap>>   AnimationManager::m_animation_skeleton_map_cache;
-    std::map<std::string, std::shared_ptr<BoneBlendMask>> AnimationManager::m_skeleton_mask_cache;
+    namespace
+    {
+        bool isBoneEnabled(const BoneBlendMask& blend_mask, size_t bone_index)
+        {
+            return bone_index < blend_mask.enabled.size() && blend_mask.enabled[bone_index] != 0;
+        }
+    } // namespace
+
+    std::map<std::string, std::shared_ptr<SkeletonData>>            AnimationManager::m_skeleton_definition_cache;
+    std::map<std::string, std::shared_ptr<CompressedAnimationClip>> AnimationManager::m_animation_data_cache;
+    std::map<std::string, std::shared_ptr<AnimSkelMap>>             AnimationManager::m_animation_skeleton_map_cache;
+    std::map<std::string, std::shared_ptr<BoneBlendMask>>           AnimationManager::m_skeleton_mask_cache;
+    std::recursive_mutex                                            AnimationManager::m_cache_mutex;
 
     std::shared_ptr<SkeletonData> AnimationManager::tryLoadSkeleton(std::string file_path)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_cache_mutex);
+
         std::shared_ptr<SkeletonData> res;
         AnimationLoader               loader;
         auto                          found = m_skeleton_definition_cache.find(file_path);
@@ -29,11 +42,13 @@ namespace Piccolo
         return res;
     }
 
-    std::shared_ptr<AnimationClip> AnimationManager::tryLoadAnimation(std::string file_path)
+    std::shared_ptr<CompressedAnimationClip> AnimationManager::tryLoadAnimation(std::string file_path)
     {
-        std::shared_ptr<AnimationClip> res;
-        AnimationLoader                loader;
-        auto                           found = m_animation_data_cache.find(file_path);
+        std::lock_guard<std::recursive_mutex> lock(m_cache_mutex);
+
+        std::shared_ptr<CompressedAnimationClip> res;
+        AnimationLoader                          loader;
+        auto                                     found = m_animation_data_cache.find(file_path);
         if (found == m_animation_data_cache.end())
         {
             res = loader.loadAnimationClipData(file_path);
@@ -48,6 +63,8 @@ namespace Piccolo
 
     std::shared_ptr<AnimSkelMap> AnimationManager::tryLoadAnimationSkeletonMap(std::string file_path)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_cache_mutex);
+
         std::shared_ptr<AnimSkelMap> res;
         AnimationLoader              loader;
         auto                         found = m_animation_skeleton_map_cache.find(file_path);
@@ -65,6 +82,8 @@ namespace Piccolo
 
     std::shared_ptr<BoneBlendMask> AnimationManager::tryLoadSkeletonMask(std::string file_path)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_cache_mutex);
+
         std::shared_ptr<BoneBlendMask> res;
         AnimationLoader                loader;
         auto                           found = m_skeleton_mask_cache.find(file_path);
@@ -80,73 +99,78 @@ namespace Piccolo
         return res;
     }
 
-    BlendStateWithClipData AnimationManager::getBlendStateWithClipData(const BlendState& blend_state)
+    bool AnimationManager::resolveBlendState(const BlendState& blend_state, ResolvedBlendState& out_resolved_state)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_cache_mutex);
 
-        for (auto animation_file_path : blend_state.blend_clip_file_path)
-        {
-            tryLoadAnimation(animation_file_path);
-        }
-        for (auto anim_skel_map_path : blend_state.blend_anim_skel_map_path)
-        {
-            tryLoadAnimationSkeletonMap(anim_skel_map_path);
-        }
-        for (auto skeleton_mask_path : blend_state.blend_mask_file_path)
-        {
-            tryLoadSkeletonMask(skeleton_mask_path);
-        }
+        out_resolved_state.m_source_clip_count          = blend_state.clip_count;
+        out_resolved_state.m_source_clip_file_paths     = blend_state.blend_clip_file_path;
+        out_resolved_state.m_source_anim_skel_map_paths = blend_state.blend_anim_skel_map_path;
+        out_resolved_state.m_source_mask_file_paths     = blend_state.blend_mask_file_path;
+        out_resolved_state.m_source_blend_weights       = blend_state.blend_weight;
 
-        BlendStateWithClipData blend_state_with_clip_data;
-        blend_state_with_clip_data.clip_count  = blend_state.clip_count;
-        blend_state_with_clip_data.blend_ratio = blend_state.blend_ratio;
-        for (const auto& iter : blend_state.blend_clip_file_path)
+        const size_t clip_count = static_cast<size_t>(blend_state.clip_count);
+        if (blend_state.blend_clip_file_path.size() < clip_count ||
+            blend_state.blend_anim_skel_map_path.size() < clip_count ||
+            blend_state.blend_mask_file_path.size() < clip_count || blend_state.blend_weight.size() < clip_count ||
+            blend_state.blend_ratio.size() < clip_count || clip_count == 0)
         {
-            blend_state_with_clip_data.blend_clip.push_back(*m_animation_data_cache[iter]);
-        }
-        for (const auto& iter : blend_state.blend_anim_skel_map_path)
-        {
-            blend_state_with_clip_data.blend_anim_skel_map.push_back(*m_animation_skeleton_map_cache[iter]);
+            LOG_ERROR("blend state with {} clips lacks clips, maps, masks, weights or ratios", clip_count);
+            return false;
         }
+
+        out_resolved_state.m_clip_count = blend_state.clip_count;
+        out_resolved_state.m_clips.clear();
+        out_resolved_state.m_anim_skel_maps.clear();
         std::vector<std::shared_ptr<BoneBlendMask>> blend_masks;
-        for (auto& iter : blend_state.blend_mask_file_path)
+        for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
         {
-            blend_masks.push_back(m_skeleton_mask_cache[iter]);
-            tryLoadAnimationSkeletonMap(m_skeleton_mask_cache[iter]->skeleton_file_path);
+            out_resolved_state.m_clips.push_back(tryLoadAnimation(blend_state.blend_clip_file_path[clip_index]));
+            out_resolved_state.m_anim_skel_maps.push_back(
+                tryLoadAnimationSkeletonMap(blend_state.blend_anim_skel_map_path[clip_index]));
+            blend_masks.push_back(tryLoadSkeletonMask(blend_state.blend_mask_file_path[clip_index]));
         }
-        size_t skeleton_bone_count = m_skeleton_definition_cache[blend_masks[0]->skeleton_file_path]->bones_map.size();
-        blend_state_with_clip_data.blend_weight.resize(blend_state.clip_count);
-        for (size_t clip_index = 0; clip_index < blend_state.clip_count; clip_index++)
+
+        const size_t skeleton_bone_count = tryLoadSkeleton(blend_masks[0]->skeleton_file_path)->bones_map.size();
+        out_resolved_state.m_blend_weights.resize(clip_count);
+        for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
         {
-            blend_state_with_clip_data.blend_weight[clip_index].blend_weight.resize(skeleton_bone_count);
+            out_resolved_state.m_blend_weights[clip_index].blend_weight.resize(skeleton_bone_count);
         }
         for (size_t bone_index = 0; bone_index < skeleton_bone_count; bone_index++)
         {
+            // each bone is driven by the clips whose masks enable it, their weights are normalized per bone
             float sum_weight = 0;
-            for (size_t clip_index = 0; clip_index < blend_state.clip_count; clip_index++)
+            for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
             {
-                if (blend_masks[clip_index]->enabled[bone_index])
+                if (isBoneEnabled(*blend_masks[clip_index], bone_index))
                 {
                     sum_weight += blend_state.blend_weight[clip_index];
                 }
             }
-            if (fabs(sum_weight) < 0.0001f)
+            for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
             {
-                // LOG_ERROR
-            }
-            for (size_t clip_index = 0; clip_index < blend_state.clip_count; clip_index++)
-            {
-                if (blend_masks[clip_index]->enabled[bone_index])
+                float& bone_weight = out_resolved_state.m_blend_weights[clip_index].blend_weight[bone_index];
+                if (fabs(sum_weight) >= 0.0001f && isBoneEnabled(*blend_masks[clip_index], bone_index))
                 {
-
-                    blend_state_with_clip_data.blend_weight[clip_index].blend_weight[bone_index] =
-                        blend_state.blend_weight[clip_index] / sum_weight;
+                    bone_weight = blend_state.blend_weight[clip_index] / sum_weight;
                 }
                 else
                 {
-                    blend_state_with_clip_data.blend_weight[clip_index].blend_weight[bone_index] = 0;
+                    // a bone no clip enables keeps the binding pose
+                    bone_weight = 0;
                 }
             }
         }
-        return blend_state_with_clip_data;
+        return true;
+    }
+
+    bool AnimationManager::isBlendStateChanged(const BlendState& blend_state, const ResolvedBlendState& resolved_state)
+    {
+        return blend_state.clip_count != resolved_state.m_source_clip_count ||
+               blend_state.blend_weight != resolved_state.m_source_blend_weights ||
+               blend_state.blend_clip_file_path != resolved_state.m_source_clip_file_paths ||
+               blend_state.blend_anim_skel_map_path != resolved_state.m_source_anim_skel_map_paths ||
+               blend_state.blend_mask_file_path != resolved_state.m_source_mask_file_paths;
     }
 } // namespace Piccolo
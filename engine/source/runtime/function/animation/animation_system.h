@@ -8,24 +8,52 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace Piccolo
 {
+    /// A blend state resolved against the animation caches. The cached clips and maps are immutable, so the
+    /// resolved state references them instead of copying them. It keeps the inputs it was resolved from, so an
+    /// edited blend state is detected with AnimationManager::isBlendStateChanged and resolved again
+    struct ResolvedBlendState
+    {
+        int                                                         m_clip_count {0};
+        std::vector<std::shared_ptr<const CompressedAnimationClip>> m_clips;
+        std::vector<std::shared_ptr<const AnimSkelMap>>             m_anim_skel_maps;
+        // per clip, the weight of each bone of the skeleton
+        std::vector<BoneBlendWeight> m_blend_weights;
+
+        // the blend state without its ratios, which advance every tick
+        int                      m_source_clip_count {0};
+        std::vector<std::string> m_source_clip_file_paths;
+        std::vector<std::string> m_source_anim_skel_map_paths;
+        std::vector<std::string> m_source_mask_file_paths;
+        std::vector<float>       m_source_blend_weights;
+    };
+
     class AnimationManager
     {
     private:
-        static std::map<std::string, std::shared_ptr<SkeletonData>>  m_skeleton_definition_cache;
-        static std::map<std::string, std::shared_ptr<AnimationClip>> m_animation_data_cache;
-        static std::map<std::string, std::shared_ptr<AnimSkelMap>>   m_animation_skeleton_map_cache;
-        static std::map<std::string, std::shared_ptr<BoneBlendMask>> m_skeleton_mask_cache;
+        static std::map<std::string, std::shared_ptr<SkeletonData>>            m_skeleton_definition_cache;
+        static std::map<std::string, std::shared_ptr<CompressedAnimationClip>> m_animation_data_cache;
+        static std::map<std::string, std::shared_ptr<AnimSkelMap>>             m_animation_skeleton_map_cache;
+        static std::map<std::string, std::shared_ptr<BoneBlendMask>>           m_skeleton_mask_cache;
+
+        // animation components tick in parallel, the caches are filled lazily from any of them
+        static std::recursive_mutex m_cache_mutex;
 
     public:
-        static std::shared_ptr<SkeletonData>  tryLoadSkeleton(std::string file_path);
-        static std::shared_ptr<AnimationClip> tryLoadAnimation(std::string file_path);
-        static std::shared_ptr<AnimSkelMap>   tryLoadAnimationSkeletonMap(std::string file_path);
-        static std::shared_ptr<BoneBlendMask> tryLoadSkeletonMask(std::string file_path);
-        static BlendStateWithClipData         getBlendStateWithClipData(const BlendState& blend_state);
+        static std::shared_ptr<SkeletonData>            tryLoadSkeleton(std::string file_path);
+        static std::shared_ptr<CompressedAnimationClip> tryLoadAnimation(std::string file_path);
+        static std::shared_ptr<AnimSkelMap>             tryLoadAnimationSkeletonMap(std::string file_path);
+        static std::shared_ptr<BoneBlendMask>           tryLoadSkeletonMask(std::string file_path);
+
+        /// loads what the blend state references and derives the per bone weights from its masks, the inputs are
+        /// kept even when it fails, so a broken blend state is reported once
+        static bool resolveBlendState(const BlendState& blend_state, ResolvedBlendState& out_resolved_state);
+        /// whether the clips, maps, masks or weights differ from the ones the state was resolved from
+        static bool isBlendStateChanged(const BlendState& blend_state, const ResolvedBlendState& resolved_state);
 
         AnimationManager() = default;
     };
@@ -1,167 +1,301 @@
 #include "runtime/function/animation/skeleton.h"
 
+#include "runtime/core/base/macro.h"
 #include "runtime/core/math/math.h"
 
-#include "runtime/function/animation/utilities.h"
+#include "runtime/function/animation/animation_system.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace Piccolo
 {
-    Skeleton::~Skeleton() { delete[] m_bones; }
+    static constexpr float k_min_blend_weight = 0.0001f;
 
     void Skeleton::resetSkeleton()
     {
-        for (size_t i = 0; i < m_bone_count; i++)
-            m_bones[i].resetToInitialPose();
+        m_local_pose = m_binding_pose;
+        updateModelPose();
+        stopInterpolation();
     }
 
     void Skeleton::buildSkeleton(const SkeletonData& skeleton_definition)
     {
-        m_is_flat = skeleton_definition.is_flat;
-        if (m_bones != nullptr)
-        {
-            delete[] m_bones;
-        }
+        m_is_flat    = skeleton_definition.is_flat;
+        m_bone_count = 0;
         if (!m_is_flat || !skeleton_definition.in_topological_order)
         {
-            // LOG_ERROR
+            LOG_ERROR("skeleton must be flat and in topological order");
             return;
         }
-        m_bone_count = skeleton_definition.bones_map.size();
-        m_bones      = new Bone[m_bone_count];
-        for (size_t i = 0; i < m_bone_count; i++)
+
+        const size_t bone_count = skeleton_definition.bones_map.size();
+        m_parent_indices.resize(bone_count);
+        m_bone_ids.resize(bone_count);
+        m_bone_names.resize(bone_count);
+        m_bone_depths.resize(bone_count);
+        m_binding_pose.resize(bone_count);
+        m_inverse_tposes.resize(bone_count);
+        for (size_t bone_index = 0; bone_index < bone_count; bone_index++)
+        {
+            const RawBone& bone_definition = skeleton_definition.bones_map[bone_index];
+
+            // in a flat skeleton the parent index is the position in bones_map
+            const int parent_index = bone_definition.parent_index;
+            if (parent_index == std::numeric_limits<int>::max() || parent_index < 0 ||
+                static_cast<size_t>(parent_index) >= bone_index)
+            {
+                m_parent_indices[bone_index] = -1;
+            }
+            else
+            {
+                m_parent_indices[bone_index] = parent_index;
+            }
+            m_bone_depths[bone_index] = m_parent_indices[bone_index] < 0 ? 0 : m_bone_depths[parent_index] + 1;
+            m_bone_ids[bone_index]       = bone_definition.index;
+            m_bone_names[bone_index]     = bone_definition.name;
+            m_inverse_tposes[bone_index] = bone_definition.tpose_matrix;
+
+            Transform& binding_pose = m_binding_pose[bone_index];
+            binding_pose            = bone_definition.binding_pose;
+            if (binding_pose.m_rotation.isNaN())
+            {
+                binding_pose.m_rotation = Quaternion::IDENTITY;
+            }
+            binding_pose.m_rotation.normalise();
+        }
+        m_bone_count = static_cast<int>(bone_count);
+
+        m_blended_positions.resize(bone_count);
+        m_blended_rotations.resize(bone_count);
+        m_blended_scalings.resize(bone_count);
+        m_blended_weights.resize(bone_count);
+        m_model_pose.resize(bone_count);
+        m_interpolation_from.resize(bone_count);
+        m_interpolation_to.resize(bone_count);
+        resetSkeleton();
+
+        m_bounding_radius = 0.0f;
+        for (const Transform& model_pose : m_model_pose)
         {
-            const RawBone bone_definition = skeleton_definition.bones_map[i];
-            Bone*         parent_bone     = find_by_index(m_bones, bone_definition.parent_index, i, m_is_flat);
-            m_bones[i].initialize(std::make_shared<RawBone>(bone_definition), parent_bone);
+            m_bounding_radius = std::max(m_bounding_radius, model_pose.m_position.length());
         }
     }
 
-    void Skeleton::applyAnimation(const BlendStateWithClipData& blend_state)
+    void Skeleton::applyAnimation(const ResolvedBlendState& blend_state,
+                                  const std::vector<float>& blend_ratio,
+                                  uint32_t                  interpolation_frame_count,
+                                  int32_t                   max_bone_depth)
     {
-        if (!m_bones)
+        if (m_bone_count == 0)
         {
             return;
         }
-        resetSkeleton();
-        for (size_t clip_index = 0; clip_index < 1; clip_index++)
+
+        const bool is_interpolated = interpolation_frame_count > 1;
+        if (is_interpolated && m_is_model_pose_shown)
         {
-            const AnimationClip& animation_clip = blend_state.blend_clip[clip_index];
-            const float          phase          = blend_state.blend_ratio[clip_index];
-            const AnimSkelMap&   anim_skel_map  = blend_state.blend_anim_skel_map[clip_index];
-
-            float exact_frame        = phase * (animation_clip.total_frame - 1);
-            int   current_frame_low  = floor(exact_frame);
-            int   current_frame_high = ceil(exact_frame);
-            float lerp_ratio         = exact_frame - current_frame_low;
-            // for (size_t node_index = 0; node_index < 0; node_index++)
-            for (size_t node_index = 0;
-                 node_index < animation_clip.node_count && node_index < anim_skel_map.convert.size();
-                 node_index++)
+            m_interpolation_from = m_model_pose;
+        }
+
+        const size_t clip_count = static_cast<size_t>(blend_state.m_clip_count);
+        if (m_clip_samplers.size() < clip_count)
+        {
+            m_clip_samplers.resize(clip_count);
+        }
+
+        clearBlendedPose();
+        for (size_t clip_index = 0; clip_index < clip_count && clip_index < blend_ratio.size(); clip_index++)
+        {
+            if (!blend_state.m_clips[clip_index] || !blend_state.m_anim_skel_maps[clip_index] ||
+                clip_index >= blend_state.m_blend_weights.size())
             {
-                AnimationChannel channel    = animation_clip.node_channels[node_index];
-                size_t           bone_index = anim_skel_map.convert[node_index];
-                float            weight     = 1; // blend_state.blend_weight[clip_index]->blend_weight[bone_index];
-                weight                      = 1;
-                if (fabs(weight) < 0.0001f)
-                {
-                    continue;
-                }
-                if (bone_index == std::numeric_limits<size_t>().max())
-                {
-                    // LOG_WARNING
-                    continue;
-                }
-                Bone* bone = &m_bones[bone_index];
-                if (channel.position_keys.size() <= current_frame_high)
-                {
-                    current_frame_high = channel.position_keys.size() - 1;
-                }
-                if (channel.scaling_keys.size() <= current_frame_high)
-                {
-                    current_frame_high = channel.scaling_keys.size() - 1;
-                }
-                if (channel.rotation_keys.size() <= current_frame_high)
-                {
-                    current_frame_high = channel.rotation_keys.size() - 1;
-                }
-                current_frame_low = (current_frame_low < current_frame_high) ? current_frame_low : current_frame_high;
-                Vector3 position  = Vector3::lerp(
-                    channel.position_keys[current_frame_low], channel.position_keys[current_frame_high], lerp_ratio);
-                Vector3 scaling = Vector3::lerp(
-                    channel.scaling_keys[current_frame_low], channel.scaling_keys[current_frame_high], lerp_ratio);
-                Quaternion rotation = Quaternion::nLerp(lerp_ratio,
-                                                        channel.rotation_keys[current_frame_low],
-                                                        channel.rotation_keys[current_frame_high],
-                                                        true);
-
-                {
-                    bone->rotate(rotation);
-                    bone->scale(scaling);
-                    bone->translate(position);
-
-                    // bone->rotate({ {},0.01,0,0,1 });
-                    // bone->scale({ {},0.9,0.9,0.9 });
-                }
+                continue;
             }
+
+            const CompressedAnimationClip& animation_clip = *blend_state.m_clips[clip_index];
+            AnimationClipSampler&          clip_sampler   = m_clip_samplers[clip_index];
+            clip_sampler.sample(animation_clip, blend_ratio[clip_index]);
+            blendClip(clip_sampler,
+                      animation_clip,
+                      *blend_state.m_anim_skel_maps[clip_index],
+                      blend_state.m_blend_weights[clip_index],
+                      max_bone_depth);
         }
-        // bones[77].rotate(Quaternion{ {},1,0,0,1 });
-        // bones[18].translate(Vector3{ {},0,1,0 });
-        // bones[0].setScale(Vector3{ {},0,1,0.01 });
-        for (size_t i = 0; i < m_bone_count; i++)
+        resolveLocalPose();
+        updateModelPose();
+
+        if (!is_interpolated)
         {
-            m_bones[i].update();
+            m_interpolation_frame       = 0;
+            m_interpolation_frame_count = 0;
+            m_is_model_pose_shown       = true;
+            return;
         }
-#ifdef _DEBUG
-        // bones[107].m_derived_position += Vector3{ {},10, 0, 0 };
-#endif
+
+        std::swap(m_model_pose, m_interpolation_to);
+        if (!m_is_model_pose_shown)
+        {
+            // nothing to move from, the evaluated pose is shown right away
+            m_interpolation_from = m_interpolation_to;
+        }
+        m_interpolation_frame       = 0;
+        m_interpolation_frame_count = interpolation_frame_count;
+        stepInterpolation();
     }
 
-    AnimationResult Skeleton::outputAnimationResult()
+    bool Skeleton::stepInterpolation()
     {
-        AnimationResult animation_result;
-        for (size_t i = 0; i < m_bone_count; i++)
+        if (m_interpolation_frame >= m_interpolation_frame_count)
         {
-            std::shared_ptr<AnimationResultElement> animation_result_element =
-                std::make_shared<AnimationResultElement>();
-            Bone* bone                      = &m_bones[i];
-            animation_result_element->index = bone->getID() + 1;
-            Vector3 temp_translation        = bone->_getDerivedPosition();
+            return false;
+        }
 
-            // TODO: the unit of the joint matrices is wrong
-            Vector3 temp_scale = bone->_getDerivedScale();
+        m_interpolation_frame++;
+        interpolateModelPose();
+        m_is_model_pose_shown = true;
+        return true;
+    }
 
-            Quaternion temp_rotation = bone->_getDerivedOrientation();
+    void Skeleton::stopInterpolation()
+    {
+        m_interpolation_frame       = 0;
+        m_interpolation_frame_count = 0;
+        m_is_model_pose_shown       = false;
+    }
 
-            // auto scale = bone->_getDerivedTScale();
-            // scale.x = 1.f / scale.x;
-            // scale.y = 1.f / scale.y;
-            // scale.z = 1.f / scale.z;
+    void Skeleton::interpolateModelPose()
+    {
+        const float ratio = static_cast<float>(m_interpolation_frame) / m_interpolation_frame_count;
+        for (size_t bone_index = 0; bone_index < static_cast<size_t>(m_bone_count); bone_index++)
+        {
+            const Transform& from       = m_interpolation_from[bone_index];
+            const Transform& to         = m_interpolation_to[bone_index];
+            Transform&       model_pose = m_model_pose[bone_index];
 
-            // auto revTmat = getMatrix(
-            //	-bone->_getDerivedTPosition(),
-            //	scale,
-            //	conjugate( bone->_getDerivedTOrientation())
-            //);
-            auto objMat =
-                Transform(bone->_getDerivedPosition(), bone->_getDerivedOrientation(), bone->_getDerivedScale())
-                    .getMatrix();
+            model_pose.m_position = Vector3::lerp(from.m_position, to.m_position, ratio);
+            model_pose.m_rotation = Quaternion::nLerp(ratio, from.m_rotation, to.m_rotation, true);
+            model_pose.m_scale    = Vector3::lerp(from.m_scale, to.m_scale, ratio);
+        }
+    }
+
+    void Skeleton::clearBlendedPose()
+    {
+        std::fill(m_blended_positions.begin(), m_blended_positions.end(), Vector3::ZERO);
+        std::fill(m_blended_rotations.begin(), m_blended_rotations.end(), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+        std::fill(m_blended_scalings.begin(), m_blended_scalings.end(), Vector3::ZERO);
+        std::fill(m_blended_weights.begin(), m_blended_weights.end(), 0.0f);
+    }
+
+    void Skeleton::blendClip(const AnimationClipSampler&    clip_sampler,
+                             const CompressedAnimationClip& clip,
+                             const AnimSkelMap&             anim_skel_map,
+                             const BoneBlendWeight&         bone_weights,
+                             int32_t                        max_bone_depth)
+    {
+        const size_t node_count = std::min(static_cast<size_t>(clip.node_count), anim_skel_map.convert.size());
+        for (size_t node_index = 0; node_index < node_count; node_index++)
+        {
+            const size_t bone_index = static_cast<size_t>(anim_skel_map.convert[node_index]);
+            if (bone_index >= static_cast<size_t>(m_bone_count) || bone_index >= bone_weights.blend_weight.size())
+            {
+                continue;
+            }
+
+            const float weight      = bone_weights.blend_weight[bone_index];
+            const bool  is_too_deep = max_bone_depth >= 0 && m_bone_depths[bone_index] > max_bone_depth;
+            if (fabs(weight) < k_min_blend_weight || is_too_deep)
+            {
+                continue;
+            }
+
+            // q and -q are the same rotation, flip to the hemisphere of what is accumulated so they do not cancel
+            Quaternion        rotation             = clip_sampler.getRotation(node_index);
+            const Quaternion& accumulated_rotation = m_blended_rotations[bone_index];
+            if (accumulated_rotation.dot(rotation) < 0.0f)
+            {
+                rotation = -rotation;
+            }
+
+            m_blended_positions[bone_index] += clip_sampler.getPosition(node_index) * weight;
+            m_blended_rotations[bone_index] = accumulated_rotation + rotation * weight;
+            m_blended_scalings[bone_index] += clip_sampler.getScaling(node_index) * weight;
+            m_blended_weights[bone_index] += weight;
+        }
+    }
+
+    void Skeleton::resolveLocalPose()
+    {
+        for (size_t bone_index = 0; bone_index < static_cast<size_t>(m_bone_count); bone_index++)
+        {
+            const Transform& binding_pose = m_binding_pose[bone_index];
+            Transform&       local_pose   = m_local_pose[bone_index];
 
-            auto resMat = objMat * bone->_getInverseTpose();
+            // bones no clip reaches keep the binding pose
+            const float weight = m_blended_weights[bone_index];
+            if (weight < k_min_blend_weight)
+            {
+                local_pose = binding_pose;
+                continue;
+            }
 
-            animation_result_element->transform = resMat.toMatrix4x4_();
+            // the clips are relative to the binding pose, positions are added to it, rotations and scalings applied
+            const float inverse_weight = 1.0f / weight;
+            Quaternion  rotation       = m_blended_rotations[bone_index];
+            rotation.normalise();
 
-            animation_result.node.push_back(*animation_result_element);
+            local_pose.m_position = binding_pose.m_position + m_blended_positions[bone_index] * inverse_weight;
+            local_pose.m_rotation = binding_pose.m_rotation * rotation;
+            local_pose.m_rotation.normalise();
+            local_pose.m_scale = binding_pose.m_scale * (m_blended_scalings[bone_index] * inverse_weight);
         }
-        return animation_result;
     }
 
-    const Bone* Skeleton::getBones() const
+    void Skeleton::updateModelPose()
     {
-        return m_bones;
+        // parents precede their children, so every parent is final when its children read it
+        for (size_t bone_index = 0; bone_index < static_cast<size_t>(m_bone_count); bone_index++)
+        {
+            const Transform& local_pose   = m_local_pose[bone_index];
+            Transform&       model_pose   = m_model_pose[bone_index];
+            const int32_t    parent_index = m_parent_indices[bone_index];
+            if (parent_index < 0)
+            {
+                model_pose = local_pose;
+                continue;
+            }
+
+            const Transform& parent_pose = m_model_pose[parent_index];
+            model_pose.m_rotation        = parent_pose.m_rotation * local_pose.m_rotation;
+            model_pose.m_rotation.normalise();
+            model_pose.m_scale = parent_pose.m_scale * local_pose.m_scale;
+            model_pose.m_position =
+                parent_pose.m_rotation * (parent_pose.m_scale * local_pose.m_position) + parent_pose.m_position;
+        }
     }
 
-    int32_t Skeleton::getBonesCount() const
+    void Skeleton::outputAnimationResult(AnimationResult& out_result) const
     {
-        return m_bone_count;
+        out_result.node.resize(m_bone_count);
+        for (size_t bone_index = 0; bone_index < static_cast<size_t>(m_bone_count); bone_index++)
+        {
+            AnimationResultElement& animation_result_element = out_result.node[bone_index];
+            animation_result_element.index                   = m_bone_ids[bone_index] + 1;
+
+            // TODO: the unit of the joint matrices is wrong
+            auto objMat = m_model_pose[bone_index].getMatrix();
+
+            auto resMat = objMat * m_inverse_tposes[bone_index];
+
+            animation_result_element.transform = resMat.toMatrix4x4_();
+        }
     }
-} // namespace Piccolo
\ No newline at end of file
+
+    int32_t Skeleton::getBonesCount() const { return m_bone_count; }
+
+    int32_t Skeleton::getBoneParentIndex(size_t bone_index) const { return m_parent_indices[bone_index]; }
+
+    const std::string& Skeleton::getBoneName(size_t bone_index) const { return m_bone_names[bone_index]; }
+
+    const Transform& Skeleton::getBoneModelTransform(size_t bone_index) const { return m_model_pose[bone_index]; }
+} // namespace Piccolo
@@ -1,29 +1,95 @@
 #pragma once
 
+#include "runtime/core/math/transform.h"
+
 #include "runtime/resource/res_type/components/animation.h"
 
-#include "runtime/function/animation/node.h"
+#include "runtime/function/animation/animation_compression.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace Piccolo
 {
     class SkeletonData;
-    class BlendStateWithClipData;
+    class AnimSkelMap;
+    class BoneBlendWeight;
+    struct ResolvedBlendState;
 
+    /// The pose of a skeleton kept in flat arrays indexed by bone. Bones are stored in topological order, so the
+    /// model space pose is derived in one pass over the arrays without following parent pointers
     class Skeleton
     {
     private:
-        bool  m_is_flat {false};
-        int   m_bone_count {0};
-        Bone* m_bones {nullptr};
+        bool m_is_flat {false};
+        int  m_bone_count {0};
+
+        // immutable after the skeleton is built, parents are negative for roots and always precede their children
+        std::vector<int32_t>     m_parent_indices;
+        std::vector<size_t>      m_bone_ids;
+        std::vector<std::string> m_bone_names;
+        std::vector<int32_t>     m_bone_depths;
+        std::vector<Transform>   m_binding_pose;
+        std::vector<Matrix4x4>   m_inverse_tposes;
+        // of the binding pose around the skeleton origin
+        float m_bounding_radius {0.0f};
+
+        // the blended clips relative to the binding pose, divided by the accumulated weights when resolved
+        std::vector<Vector3>    m_blended_positions;
+        std::vector<Quaternion> m_blended_rotations;
+        std::vector<Vector3>    m_blended_scalings;
+        std::vector<float>      m_blended_weights;
+
+        std::vector<Transform> m_local_pose;
+        std::vector<Transform> m_model_pose;
+
+        // with an update interval the shown model pose moves from the pose shown before the last evaluation to the
+        // evaluated one over the frames of the interval
+        std::vector<Transform> m_interpolation_from;
+        std::vector<Transform> m_interpolation_to;
+        uint32_t               m_interpolation_frame {0};
+        uint32_t               m_interpolation_frame_count {0};
+        // false while the model pose is older than the last frame
+        bool m_is_model_pose_shown {false};
+
+        // one per blended clip, they keep the decode buffers and the key cursors between frames
+        std::vector<AnimationClipSampler> m_clip_samplers;
+
+        void clearBlendedPose();
+        void blendClip(const AnimationClipSampler&    clip_sampler,
+                       const CompressedAnimationClip& clip,
+                       const AnimSkelMap&             anim_skel_map,
+                       const BoneBlendWeight&         bone_weights,
+                       int32_t                        max_bone_depth);
+        void resolveLocalPose();
+        void updateModelPose();
+        void interpolateModelPose();
 
     public:
-        ~Skeleton();
-
-        void            buildSkeleton(const SkeletonData& skeleton_definition);
-        void            applyAnimation(const BlendStateWithClipData& blend_state);
-        AnimationResult outputAnimationResult();
-        void            resetSkeleton();
-        const Bone*     getBones() const;
-        int32_t         getBonesCount() const;
+        void buildSkeleton(const SkeletonData& skeleton_definition);
+        /// samples every clip at its phase in blend_ratio and blends them per bone with the weights of the masks.
+        /// @interpolation_frame_count: frames until the next evaluation, blend_ratio has to be the phase of the
+        /// last of them. The pose is shown over these frames, advanced by stepInterpolation
+        /// @max_bone_depth: deeper bones keep their binding pose, negative evaluates all bones
+        void applyAnimation(const ResolvedBlendState& blend_state,
+                            const std::vector<float>& blend_ratio,
+                            uint32_t                  interpolation_frame_count = 1,
+                            int32_t                   max_bone_depth            = -1);
+        /// shows the next interpolated pose, returns false when the interpolation has ended and the skeleton needs
+        /// to be evaluated again
+        bool stepInterpolation();
+        /// the next evaluation starts from the evaluated pose instead of the pose shown last, e.g. after the
+        /// skeleton was not updated for a while
+        void stopInterpolation();
+        /// writes the joint matrices into the result, its storage is reused once it has grown to the bone count
+        void outputAnimationResult(AnimationResult& out_result) const;
+        void resetSkeleton();
+
+        int32_t            getBonesCount() const;
+        float              getBoundingRadius() const { return m_bounding_radius; }
+        int32_t            getBoneParentIndex(size_t bone_index) const;
+        const std::string& getBoneName(size_t bone_index) const;
+        const Transform&   getBoneModelTransform(size_t bone_index) const;
     };
 } // namespace Piccolo
@@ -1,8 +1,11 @@
 #include "runtime/function/framework/component/animation/animation_component.h"
 
 #include "runtime/function/animation/animation_system.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
 #include "runtime/function/framework/object/object.h"
 
+#include <algorithm>
+
 namespace Piccolo
 {
     void AnimationComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
@@ -12,16 +15,91 @@ namespace Piccolo
         auto skeleton_res = AnimationManager::tryLoadSkeleton(m_animation_res.skeleton_file_path);
 
         m_skeleton.buildSkeleton(*skeleton_res);
+
+        m_is_blend_state_resolved =
+            AnimationManager::resolveBlendState(m_animation_res.blend_state, m_resolved_blend_state);
     }
 
     void AnimationComponent::tick(float delta_time)
     {
-        m_animation_res.blend_state.blend_ratio[0] +=
-            (delta_time / m_animation_res.blend_state.blend_clip_file_length[0]);
-        m_animation_res.blend_state.blend_ratio[0] -= floor(m_animation_res.blend_state.blend_ratio[0]);
+        // the inspector edits the blend state in place, the pose of the old clips is not interpolated from
+        if (AnimationManager::isBlendStateChanged(m_animation_res.blend_state, m_resolved_blend_state))
+        {
+            m_is_blend_state_resolved =
+                AnimationManager::resolveBlendState(m_animation_res.blend_state, m_resolved_blend_state);
+            m_skeleton.stopInterpolation();
+        }
+
+        if (!m_is_blend_state_resolved)
+        {
+            return;
+        }
+
+        // every blended clip loops at its own length
+        BlendState&  blend_state = m_animation_res.blend_state;
+        const size_t clip_count  = std::min(blend_state.blend_ratio.size(), blend_state.blend_clip_file_length.size());
+        for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
+        {
+            float& blend_ratio = blend_state.blend_ratio[clip_index];
+            blend_ratio += delta_time / blend_state.blend_clip_file_length[clip_index];
+            blend_ratio -= floor(blend_ratio);
+        }
+
+        const AnimationLod lod = selectLod();
+        if (lod == AnimationLod::Culled)
+        {
+            // the result keeps the last pose, the next evaluation does not interpolate from it
+            m_skeleton.stopInterpolation();
+            AnimationLodManager::countSkeleton(lod, false);
+            return;
+        }
+
+        if (m_skeleton.stepInterpolation())
+        {
+            AnimationLodManager::countSkeleton(lod, true);
+            m_skeleton.outputAnimationResult(m_animation_res.animation_result);
+            return;
+        }
+
+        // an interpolated skeleton is evaluated at the phase of the last frame of its interval, assuming the
+        // frame time stays the same
+        const AnimationLodSettings lod_settings  = AnimationLodManager::getLodSettings(lod);
+        const float                interval_time = (lod_settings.m_update_interval - 1) * delta_time;
+        m_interval_end_blend_ratio               = blend_state.blend_ratio;
+        for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
+        {
+            float& blend_ratio = m_interval_end_blend_ratio[clip_index];
+            blend_ratio += interval_time / blend_state.blend_clip_file_length[clip_index];
+            blend_ratio -= floor(blend_ratio);
+        }
+
+        // steady state ticks sample the shared clips in place and refill the same result, nothing is allocated
+        m_skeleton.applyAnimation(m_resolved_blend_state,
+                                  m_interval_end_blend_ratio,
+                                  lod_settings.m_update_interval,
+                                  lod_settings.m_max_bone_depth);
+        AnimationLodManager::countSkeleton(lod, false);
+        m_skeleton.outputAnimationResult(m_animation_res.animation_result);
+    }
+
+    AnimationLod AnimationComponent::selectLod() const
+    {
+        std::shared_ptr<GObject> parent_object = m_parent_object.lock();
+        if (!parent_object)
+        {
+            return AnimationLod::Full;
+        }
+
+        const TransformComponent* transform_component = parent_object->tryGetComponentConst(TransformComponent);
+        if (transform_component == nullptr)
+        {
+            return AnimationLod::Full;
+        }
 
-        m_skeleton.applyAnimation(AnimationManager::getBlendStateWithClipData(m_animation_res.blend_state));
-        m_animation_res.animation_result = m_skeleton.outputAnimationResult();
+        const Vector3 scale     = transform_component->getScale();
+        const float   max_scale = std::max(std::max(std::fabs(scale.x), std::fabs(scale.y)), std::fabs(scale.z));
+        return AnimationLodManager::selectLod(
+            parent_object->getID(), transform_component->getPosition(), m_skeleton.getBoundingRadius() * max_scale);
     }
 
     const AnimationResult& AnimationComponent::getResult() const { return m_animation_res.animation_result; }
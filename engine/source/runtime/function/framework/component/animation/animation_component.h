@@ -1,5 +1,7 @@
 #pragma once
 
+#include "runtime/function/animation/animation_lod.h"
+#include "runtime/function/animation/animation_system.h"
 #include "runtime/function/animation/skeleton.h"
 #include "runtime/function/framework/component/component.h"
 #include "runtime/resource/res_type/components/animation.h"
@@ -22,10 +24,20 @@ namespace Piccolo
 
         const Skeleton& getSkeleton() const;
 
+        const AnimationComponentRes& getAnimationRes() const { return m_animation_res; }
+
     protected:
         META(Enable)
         AnimationComponentRes m_animation_res;
 
         Skeleton m_skeleton;
+        // the clips of m_animation_res.blend_state, resolved on load and again when the blend state is edited
+        ResolvedBlendState m_resolved_blend_state;
+        bool               m_is_blend_state_resolved {false};
+        // the phases the skeleton was last evaluated at, ahead of the blend state when it is interpolated
+        std::vector<float> m_interval_end_blend_ratio;
+
+    private:
+        AnimationLod selectLod() const;
     };
 } // namespace Piccolo
@@ -0,0 +1,51 @@
+#include "runtime/function/framework/component/component_store.h"
+
+#include "runtime/function/framework/component/mesh/mesh_component.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
+
+namespace Piccolo
+{
+    ComponentStore::ComponentStore()
+    {
+        // only types that can be relocated by a plain move are pooled, components owning raw resources in their
+        // destructor (skeletons, controllers, rigid bodies) stay heap allocated
+        registerPool<TransformComponent>("TransformComponent");
+        registerPool<MeshComponent>("MeshComponent");
+    }
+
+    void ComponentStore::adopt(Reflection::ReflectionPtr<Component>& component)
+    {
+        if (!component)
+            return;
+
+        ComponentPoolBase* pool = getPool(component.getTypeName());
+        if (pool == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        component.getPtrReference() = pool->adopt(component.getPtr());
+    }
+
+    bool ComponentStore::release(Reflection::ReflectionPtr<Component>& component)
+    {
+        if (!component)
+            return false;
+
+        ComponentPoolBase* pool = getPool(component.getTypeName());
+        if (pool == nullptr)
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!pool->release(component.getPtr()))
+            return false;
+
+        component.getPtrReference() = nullptr;
+        return true;
+    }
+
+    ComponentPoolBase* ComponentStore::getPool(const std::string& type_name) const
+    {
+        auto iter = m_pools.find(type_name);
+        return iter != m_pools.end() ? iter->second.get() : nullptr;
+    }
+} // namespace Piccolo
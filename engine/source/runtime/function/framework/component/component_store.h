@@ -0,0 +1,183 @@
+#pragma once
+
+#include "runtime/core/job/job_system.h"
+
+#include "runtime/function/framework/component/component.h"
+#include "runtime/function/global/global_context.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Piccolo
+{
+    /// Type-erased interface of a pool that keeps all components of one type in contiguous chunks
+    class ComponentPoolBase
+    {
+    public:
+        virtual ~ComponentPoolBase() = default;
+
+        /// move a heap allocated component into the pool and delete the original, returns the pooled component
+        virtual Component* adopt(Component* component) = 0;
+        /// destroy the component if it lives in this pool
+        virtual bool release(Component* component) = 0;
+
+        /// tick all live components in parallel batches of contiguous slots
+        virtual void tick(float delta_time) = 0;
+
+        virtual void getComponents(std::vector<Reflection::ReflectionPtr<Component>>& out_components) const = 0;
+
+        virtual uint32_t getComponentCount() const = 0;
+    };
+
+    template<typename TComponent>
+    class ComponentPool final : public ComponentPoolBase
+    {
+        static constexpr uint32_t k_chunk_capacity  = 256;
+        static constexpr uint32_t k_tick_batch_size = 64;
+
+        struct Chunk
+        {
+            alignas(TComponent) unsigned char m_storage[k_chunk_capacity][sizeof(TComponent)];
+            bool m_is_alive[k_chunk_capacity] {};
+        };
+
+    public:
+        explicit ComponentPool(std::string type_name) : m_type_name(std::move(type_name)) {}
+
+        ~ComponentPool() override
+        {
+            for (uint32_t slot = 0; slot < m_slot_count; ++slot)
+            {
+                if (isAlive(slot))
+                {
+                    getSlot(slot)->~TComponent();
+                }
+            }
+        }
+
+        Component* adopt(Component* component) override
+        {
+            uint32_t slot;
+            if (!m_free_slots.empty())
+            {
+                slot = m_free_slots.back();
+                m_free_slots.pop_back();
+            }
+            else
+            {
+                if (m_slot_count == m_chunks.size() * k_chunk_capacity)
+                {
+                    m_chunks.push_back(std::make_unique<Chunk>());
+                }
+                slot = m_slot_count++;
+            }
+
+            TComponent* source = static_cast<TComponent*>(component);
+            TComponent* pooled = new (m_chunks[slot / k_chunk_capacity]->m_storage[slot % k_chunk_capacity])
+                TComponent(std::move(*source));
+            delete source;
+
+            m_chunks[slot / k_chunk_capacity]->m_is_alive[slot % k_chunk_capacity] = true;
+            ++m_component_count;
+            return pooled;
+        }
+
+        bool release(Component* component) override
+        {
+            const unsigned char* address = reinterpret_cast<const unsigned char*>(static_cast<TComponent*>(component));
+            for (size_t chunk_index = 0; chunk_index < m_chunks.size(); ++chunk_index)
+            {
+                const unsigned char* begin = m_chunks[chunk_index]->m_storage[0];
+                if (address < begin || address >= begin + sizeof(Chunk::m_storage))
+                {
+                    continue;
+                }
+
+                const uint32_t slot =
+                    static_cast<uint32_t>(chunk_index * k_chunk_capacity + (address - begin) / sizeof(TComponent));
+                getSlot(slot)->~TComponent();
+                m_chunks[chunk_index]->m_is_alive[slot % k_chunk_capacity] = false;
+                m_free_slots.push_back(slot);
+                --m_component_count;
+                return true;
+            }
+            return false;
+        }
+
+        void tick(float delta_time) override
+        {
+            // the pool only holds exact TComponent instances, so the tick call does not need virtual dispatch
+            g_runtime_global_context.m_job_system->parallelFor(
+                m_slot_count, k_tick_batch_size, [this, delta_time](uint32_t begin, uint32_t end) {
+                    for (uint32_t slot = begin; slot < end; ++slot)
+                    {
+                        if (isAlive(slot))
+                        {
+                            getSlot(slot)->TComponent::tick(delta_time);
+                        }
+                    }
+                });
+        }
+
+        void getComponents(std::vector<Reflection::ReflectionPtr<Component>>& out_components) const override
+        {
+            for (uint32_t slot = 0; slot < m_slot_count; ++slot)
+            {
+                if (isAlive(slot))
+                {
+                    out_components.emplace_back(m_type_name, getSlot(slot));
+                }
+            }
+        }
+
+        uint32_t getComponentCount() const override { return m_component_count; }
+
+    private:
+        bool isAlive(uint32_t slot) const
+        {
+            return m_chunks[slot / k_chunk_capacity]->m_is_alive[slot % k_chunk_capacity];
+        }
+
+        TComponent* getSlot(uint32_t slot) const
+        {
+            return reinterpret_cast<TComponent*>(m_chunks[slot / k_chunk_capacity]->m_storage[slot % k_chunk_capacity]);
+        }
+
+        std::string                         m_type_name;
+        std::vector<std::unique_ptr<Chunk>> m_chunks;
+        std::vector<uint32_t>               m_free_slots;
+        uint32_t                            m_slot_count {0};
+        uint32_t                            m_component_count {0};
+    };
+
+    /// Level owned storage that keeps components of the same type contiguous in memory.
+    /// Objects still reference their components through ReflectionPtr, so editor and serializer are unaffected,
+    /// only the allocation moves from the heap into the pools.
+    class ComponentStore
+    {
+    public:
+        ComponentStore();
+
+        /// relocate the component into its type pool if the type is pooled, the pointer is updated in place
+        void adopt(Reflection::ReflectionPtr<Component>& component);
+        /// destroy a pooled component, returns false if the component is not owned by the store
+        bool release(Reflection::ReflectionPtr<Component>& component);
+
+        /// nullptr if components of this type are not pooled
+        ComponentPoolBase* getPool(const std::string& type_name) const;
+
+    private:
+        template<typename TComponent>
+        void registerPool(const std::string& type_name)
+        {
+            m_pools.emplace(type_name, std::make_unique<ComponentPool<TComponent>>(type_name));
+        }
+
+        std::mutex                                                          m_mutex;
+        std::unordered_map<std::string, std::unique_ptr<ComponentPoolBase>> m_pools;
+    };
+} // namespace Piccolo
@@ -0,0 +1,127 @@
+#include "runtime/function/framework/component/component_store_benchmark.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
+
+#include "runtime/function/framework/component/component_store.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
+#include "runtime/function/framework/object/object.h"
+#include "runtime/function/global/global_context.h"
+
+#include "runtime/resource/res_type/common/object.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        constexpr uint32_t k_benchmark_tick_batch_size = 64;
+
+        struct BenchmarkTiming
+        {
+            double m_total_ms {0.0};
+            double m_max_ms {0.0};
+
+            void add(double duration_ms)
+            {
+                m_total_ms += duration_ms;
+                m_max_ms = std::max(m_max_ms, duration_ms);
+            }
+        };
+
+        std::vector<std::shared_ptr<GObject>> loadBenchmarkObjects(uint32_t                        object_count,
+                                                                   std::shared_ptr<ComponentStore> component_store)
+        {
+            std::mt19937                          random_engine(0);
+            std::uniform_real_distribution<float> position_distribution(-500.0f, 500.0f);
+
+            std::vector<std::shared_ptr<GObject>> objects;
+            objects.reserve(object_count);
+            for (uint32_t object_index = 0; object_index < object_count; ++object_index)
+            {
+                // the components are allocated between the objects and their names, like when a level loads
+                TransformComponent* transform_component = new TransformComponent();
+                transform_component->setPosition(Vector3(position_distribution(random_engine),
+                                                         position_distribution(random_engine),
+                                                         position_distribution(random_engine)));
+
+                ObjectInstanceRes object_instance_res;
+                object_instance_res.m_name = "benchmark_object_" + std::to_string(object_index);
+                object_instance_res.m_instanced_components.emplace_back("TransformComponent", transform_component);
+
+                ObjectDefinitionRes definition_res;
+
+                std::shared_ptr<GObject> object = std::make_shared<GObject>(object_index, component_store);
+                object->load(object_instance_res, definition_res);
+                objects.push_back(object);
+            }
+            return objects;
+        }
+    } // namespace
+
+    void runComponentStoreBenchmark(uint32_t object_count, uint32_t frame_count)
+    {
+        using namespace std::chrono;
+
+        std::shared_ptr<ComponentStore> component_store = std::make_shared<ComponentStore>();
+        ComponentPoolBase*              transform_pool  = component_store->getPool("TransformComponent");
+
+        std::vector<std::shared_ptr<GObject>> heap_objects  = loadBenchmarkObjects(object_count, nullptr);
+        std::vector<std::shared_ptr<GObject>> store_objects = loadBenchmarkObjects(object_count, component_store);
+
+        // what the transform phase of Level::tick lists when the type is not pooled
+        std::vector<Component*> heap_components;
+        heap_components.reserve(object_count);
+        for (const std::shared_ptr<GObject>& object : heap_objects)
+        {
+            heap_components.push_back(object->tryGetComponent(TransformComponent));
+        }
+
+        const float     delta_time = 1.0f / 60.0f;
+        BenchmarkTiming heap_timing;
+        BenchmarkTiming store_timing;
+        // the first frame warms up the caches and the job system and is not counted
+        for (uint32_t frame_index = 0; frame_index <= frame_count; ++frame_index)
+        {
+            const steady_clock::time_point heap_begin = steady_clock::now();
+            g_runtime_global_context.m_job_system->parallelFor(
+                static_cast<uint32_t>(heap_components.size()),
+                k_benchmark_tick_batch_size,
+                [&heap_components, delta_time](uint32_t begin, uint32_t end) {
+                    for (uint32_t index = begin; index < end; ++index)
+                    {
+                        heap_components[index]->tick(delta_time);
+                    }
+                });
+            const steady_clock::time_point store_begin = steady_clock::now();
+            transform_pool->tick(delta_time);
+            const steady_clock::time_point store_end = steady_clock::now();
+
+            if (frame_index > 0)
+            {
+                heap_timing.add(duration<double, std::milli>(store_begin - heap_begin).count());
+                store_timing.add(duration<double, std::milli>(store_end - store_begin).count());
+            }
+        }
+
+        LOG_INFO("component store tick: {} objects, {} frames, heap components {:.3f} ms average {:.3f} ms max, "
+                 "component store {:.3f} ms average {:.3f} ms max for {} pooled components",
+                 object_count,
+                 frame_count,
+                 frame_count > 0 ? heap_timing.m_total_ms / frame_count : 0.0,
+                 heap_timing.m_max_ms,
+                 frame_count > 0 ? store_timing.m_total_ms / frame_count : 0.0,
+                 store_timing.m_max_ms,
+                 transform_pool->getComponentCount());
+
+        // the objects release their components into the store, so they go first
+        store_objects.clear();
+        heap_objects.clear();
+    }
+} // namespace Piccolo
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Piccolo
+{
+    /**
+     *  Loads object_count objects with a transform component twice, once with the components on the heap and once
+     *  with them in a component store, and ticks the transform phase of both for frame_count frames the way
+     *  Level::tick does. Logs the average and maximum tick time of both. Needs the log and job systems started,
+     *  headless is enough
+     */
+    void runComponentStoreBenchmark(uint32_t object_count, uint32_t frame_count);
+} // namespace Piccolo
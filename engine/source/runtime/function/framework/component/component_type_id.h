@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace Piccolo
+{
+    /// Dense id of a reflected component type, the specializations are generated by the meta parser
+    template<typename TComponent>
+    struct ComponentTypeId;
+
+    static constexpr uint32_t k_invalid_component_type_id = 0xffffffff;
+} // namespace Piccolo
+
+#if defined(__REFLECTION_PARSER__)
+// the generated ids do not exist yet while the parser runs
+namespace Piccolo
+{
+    static constexpr uint32_t k_component_type_count = 1;
+
+    inline uint32_t getComponentTypeId(const std::string& component_type_name) { return k_invalid_component_type_id; }
+} // namespace Piccolo
+#else
+#include "_generated/reflection/all_component_type_id.h"
+#endif // __REFLECTION_PARSER__
+
+namespace Piccolo
+{
+    template<typename TComponent>
+    constexpr uint32_t getComponentTypeId()
+    {
+        return ComponentTypeId<std::remove_const_t<TComponent>>::value;
+    }
+} // namespace Piccolo
@@ -0,0 +1,184 @@
+#include "runtime/function/framework/component/lua/lua_binding.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/framework/object/object.h"
+
+namespace Piccolo
+{
+    std::unordered_map<std::string, LuaTypeRegistry::LuaTypeFunctions> LuaTypeRegistry::m_types;
+
+    std::unordered_map<std::string, LuaFieldBinding>  LuaBindingCache::m_field_bindings;
+    std::unordered_map<std::string, LuaMethodBinding> LuaBindingCache::m_method_bindings;
+
+    namespace
+    {
+        std::vector<std::string> splitPath(const char* path)
+        {
+            std::vector<std::string> names;
+            const char*              name_begin = path;
+            for (const char* iter = path;; ++iter)
+            {
+                if (*iter == '.' || *iter == '\0')
+                {
+                    names.emplace_back(name_begin, iter);
+                    if (*iter == '\0')
+                    {
+                        break;
+                    }
+                    name_begin = iter + 1;
+                }
+            }
+            return names;
+        }
+
+        // walks the field names after the component name, out_meta is the type of the last field
+        bool resolveFieldPath(const std::vector<std::string>&         names,
+                              size_t                                  field_name_count,
+                              std::vector<Reflection::FieldAccessor>& out_field_path,
+                              Reflection::TypeMeta&                   out_meta)
+        {
+            out_meta = Reflection::TypeMeta::newMetaFromName(names[0]);
+            for (size_t name_index = 1; name_index <= field_name_count; ++name_index)
+            {
+                Reflection::FieldAccessor field_accessor = out_meta.getFieldByName(names[name_index].c_str());
+                if (names[name_index] != field_accessor.getFieldName())
+                {
+                    return false;
+                }
+
+                out_field_path.push_back(field_accessor);
+                field_accessor.getTypeMeta(out_meta);
+            }
+            return true;
+        }
+
+        void* walkFieldPath(void* instance, const std::vector<Reflection::FieldAccessor>& field_path)
+        {
+            for (const Reflection::FieldAccessor& field_accessor : field_path)
+            {
+                instance = field_accessor.get(instance);
+            }
+            return instance;
+        }
+    } // namespace
+
+    void LuaTypeRegistry::registerType(const char*             type_name,
+                                       LuaTypeRegisterFunction register_function,
+                                       LuaObjectMaker          object_maker)
+    {
+        m_types.emplace(type_name, LuaTypeFunctions {register_function, object_maker});
+    }
+
+    void LuaTypeRegistry::bindTypes(sol::state& lua_state)
+    {
+        for (const auto& type_item : m_types)
+        {
+            type_item.second.m_register_function(lua_state);
+        }
+    }
+
+    sol::object LuaTypeRegistry::makeObject(sol::state_view lua_state, const std::string& type_name, void* instance)
+    {
+        auto type_iter = m_types.find(type_name);
+        if (type_iter == m_types.end() || instance == nullptr)
+        {
+            return sol::make_object(lua_state, sol::lua_nil);
+        }
+        return type_iter->second.m_object_maker(lua_state, instance);
+    }
+
+    const LuaFieldBinding& LuaBindingCache::getFieldBinding(const char* field_path)
+    {
+        auto binding_iter = m_field_bindings.find(field_path);
+        if (binding_iter != m_field_bindings.end())
+        {
+            return binding_iter->second;
+        }
+
+        LuaFieldBinding&               binding = m_field_bindings[field_path];
+        const std::vector<std::string> names   = splitPath(field_path);
+        Reflection::TypeMeta           field_meta;
+        if (names.size() >= 2)
+        {
+            binding.m_component_type_id = getComponentTypeId(names[0]);
+        }
+        if (binding.m_component_type_id == k_invalid_component_type_id)
+        {
+            LOG_ERROR("lua field {} does not start with a component type", field_path);
+            return binding;
+        }
+        if (!resolveFieldPath(names, names.size() - 1, binding.m_field_path, field_meta))
+        {
+            LOG_ERROR("lua field {} can not be found", field_path);
+            binding.m_field_path.clear();
+            return binding;
+        }
+
+        binding.m_field_type_name = binding.m_field_path.back().getFieldTypeName();
+        return binding;
+    }
+
+    const LuaMethodBinding& LuaBindingCache::getMethodBinding(const char* method_path)
+    {
+        auto binding_iter = m_method_bindings.find(method_path);
+        if (binding_iter != m_method_bindings.end())
+        {
+            return binding_iter->second;
+        }
+
+        LuaMethodBinding&              binding = m_method_bindings[method_path];
+        const std::vector<std::string> names   = splitPath(method_path);
+        Reflection::TypeMeta           owner_meta;
+        if (names.size() >= 2)
+        {
+            binding.m_component_type_id = getComponentTypeId(names[0]);
+        }
+        if (binding.m_component_type_id == k_invalid_component_type_id)
+        {
+            LOG_ERROR("lua method {} does not start with a component type", method_path);
+            return binding;
+        }
+        if (!resolveFieldPath(names, names.size() - 2, binding.m_field_path, owner_meta))
+        {
+            LOG_ERROR("lua method {} can not be found", method_path);
+            return binding;
+        }
+
+        binding.m_method = owner_meta.getMethodByName(names.back().c_str());
+        if (names.back() != binding.m_method.getMethodName())
+        {
+            LOG_ERROR("lua method {} can not be found", method_path);
+            return binding;
+        }
+
+        binding.m_is_valid = true;
+        return binding;
+    }
+
+    void* LuaBindingCache::getFieldInstance(const GObject& game_object, const LuaFieldBinding& binding)
+    {
+        Component* component = game_object.tryGetComponentByTypeId(binding.m_component_type_id);
+        if (component == nullptr)
+        {
+            return nullptr;
+        }
+        return walkFieldPath(component, binding.m_field_path);
+    }
+
+    void* LuaBindingCache::getMethodInstance(const GObject& game_object, const LuaMethodBinding& binding)
+    {
+        Component* component = game_object.tryGetComponentByTypeId(binding.m_component_type_id);
+        if (component == nullptr)
+        {
+            return nullptr;
+        }
+        return walkFieldPath(component, binding.m_field_path);
+    }
+
+    void LuaBindingCache::clear()
+    {
+        m_field_bindings.clear();
+        m_method_bindings.clear();
+    }
+} // namespace Piccolo
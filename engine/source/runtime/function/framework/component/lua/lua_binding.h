@@ -0,0 +1,90 @@
+#pragma once
+
+#include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/function/framework/component/component_type_id.h"
+
+#include "sol/sol.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Piccolo
+{
+    class GObject;
+
+#define REGISTER_LUA_TYPE_TO_MAP(name, register_function, object_maker) \
+    LuaTypeRegistry::registerType(name, register_function, object_maker);
+
+    typedef void (*LuaTypeRegisterFunction)(sol::state& lua_state);
+    typedef sol::object (*LuaObjectMaker)(sol::state_view lua_state, void* instance);
+
+    /// Typed lua usertypes of the reflected classes marked with LuaBinding. The meta parser generates a usertype per
+    /// marked class with its plain reflected fields and its reflected methods without parameters, scripts then access
+    /// them through member pointers instead of reflection lookups
+    class LuaTypeRegistry
+    {
+    public:
+        static void
+        registerType(const char* type_name, LuaTypeRegisterFunction register_function, LuaObjectMaker object_maker);
+
+        /// creates the usertypes of all registered classes in the state
+        static void bindTypes(sol::state& lua_state);
+
+        /// the instance as a reference of its usertype, nil when the type has no usertype
+        static sol::object makeObject(sol::state_view lua_state, const std::string& type_name, void* instance);
+
+    private:
+        struct LuaTypeFunctions
+        {
+            LuaTypeRegisterFunction m_register_function;
+            LuaObjectMaker          m_object_maker;
+        };
+
+        static std::unordered_map<std::string, LuaTypeFunctions> m_types;
+    };
+
+    /// "Component.field.field" resolved to the component type and the accessors along the path
+    struct LuaFieldBinding
+    {
+        uint32_t                               m_component_type_id {k_invalid_component_type_id};
+        std::vector<Reflection::FieldAccessor> m_field_path;
+        std::string                            m_field_type_name;
+
+        bool isValid() const { return !m_field_path.empty(); }
+    };
+
+    /// "Component.method" or "Component.field.method" resolved to the component type, the accessors to the
+    /// owner of the method and the method
+    struct LuaMethodBinding
+    {
+        uint32_t                               m_component_type_id {k_invalid_component_type_id};
+        std::vector<Reflection::FieldAccessor> m_field_path;
+        Reflection::MethodAccessor             m_method;
+        bool                                   m_is_valid {false};
+
+        bool isValid() const { return m_is_valid; }
+    };
+
+    /// Paths of the string based script functions, each resolved through reflection the first time a script uses
+    /// it. Unresolvable paths are cached as well, so they are reported once instead of every call. Only used from
+    /// the logic tick, so there is no locking
+    class LuaBindingCache
+    {
+    public:
+        static const LuaFieldBinding&  getFieldBinding(const char* field_path);
+        static const LuaMethodBinding& getMethodBinding(const char* method_path);
+
+        /// the address of the bound field in the object, nullptr when the object has no such component
+        static void* getFieldInstance(const GObject& game_object, const LuaFieldBinding& binding);
+        /// the instance the bound method is called on, nullptr when the object has no such component
+        static void* getMethodInstance(const GObject& game_object, const LuaMethodBinding& binding);
+
+        static void clear();
+
+    private:
+        static std::unordered_map<std::string, LuaFieldBinding>  m_field_bindings;
+        static std::unordered_map<std::string, LuaMethodBinding> m_method_bindings;
+    };
+} // namespace Piccolo
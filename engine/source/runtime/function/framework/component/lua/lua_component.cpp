@@ -1,62 +1,57 @@
 #include "runtime/function/framework/component/lua/lua_component.h"
 #include "runtime/core/base/macro.h"
+#include "runtime/function/framework/component/lua/lua_binding.h"
+#include "runtime/function/framework/component/lua/lua_vm_pool.h"
 #include "runtime/function/framework/object/object.h"
+#include "runtime/function/global/global_context.h"
 namespace Piccolo
 {
-
-    bool find_component_field(std::weak_ptr<GObject>     game_object,
-                              const char*                field_name,
-                              Reflection::FieldAccessor& field_accessor,
-                              void*&                     target_instance)
+    namespace
     {
-        auto components = game_object.lock()->getComponents();
-
-        std::istringstream iss(field_name);
-        std::string        current_name;
-        std::getline(iss, current_name, '.');
-        auto component_iter = std::find_if(
-            components.begin(), components.end(), [current_name](auto c) { return c.getTypeName() == current_name; });
-        if (component_iter != components.end())
+        // the type names the meta parser records for the field types scripts can access
+        template<typename T>
+        const char* getLuaFieldTypeName();
+        template<>
+        const char* getLuaFieldTypeName<float>()
+        {
+            return "float";
+        }
+        template<>
+        const char* getLuaFieldTypeName<bool>()
         {
-            auto  meta           = Reflection::TypeMeta::newMetaFromName(current_name);
-            void* field_instance = component_iter->getPtr();
+            return "bool";
+        }
 
-            // find target field
-            while (std::getline(iss, current_name, '.'))
+        template<typename T>
+        T* findTypedField(std::weak_ptr<GObject> game_object, const char* name)
+        {
+            const LuaFieldBinding& binding = LuaBindingCache::getFieldBinding(name);
+            if (!binding.isValid())
+            {
+                return nullptr;
+            }
+            if (binding.m_field_type_name != getLuaFieldTypeName<T>())
             {
-                Reflection::FieldAccessor* fields;
-                int                        fields_count = meta.getFieldsList(fields);
-                auto                       field_iter   = std::find_if(
-                    fields, fields + fields_count, [current_name](auto f) { return f.getFieldName() == current_name; });
-                if (field_iter == fields + fields_count) // not found
-                {
-                    delete[] fields;
-                    return false;
-                }
-
-                field_accessor = *field_iter;
-                delete[] fields;
-
-                target_instance = field_instance;
-
-                // for next iteration
-                field_instance = field_accessor.get(target_instance);
-                field_accessor.getTypeMeta(meta);
+                LOG_ERROR("lua field {} is a {}, not a {}", name, binding.m_field_type_name, getLuaFieldTypeName<T>());
+                return nullptr;
             }
-            return true;
+
+            std::shared_ptr<GObject> object = game_object.lock();
+            if (!object)
+            {
+                return nullptr;
+            }
+            return static_cast<T*>(LuaBindingCache::getFieldInstance(*object, binding));
         }
-        return false;
-    }
+    } // namespace
 
     template<typename T>
     void LuaComponent::set(std::weak_ptr<GObject> game_object, const char* name, T value)
     {
-        LOG_INFO(name);
-        Reflection::FieldAccessor field_accessor;
-        void*                     target_instance;
-        if (find_component_field(game_object, name, field_accessor, target_instance))
+        T* field = findTypedField<T>(game_object, name);
+        if (field)
         {
-            field_accessor.set(target_instance, &value);
+            *field = value;
         }
         else
         {
@@ -67,98 +62,111 @@ namespace Piccolo
     template<typename T>
     T LuaComponent::get(std::weak_ptr<GObject> game_object, const char* name)
     {
-
-        LOG_INFO(name);
-
-        Reflection::FieldAccessor field_accessor;
-        void*                     target_instance;
-        if (find_component_field(game_object, name, field_accessor, target_instance))
+        T* field = findTypedField<T>(game_object, name);
+        if (field)
         {
-            return *(T*)field_accessor.get(target_instance);
+            return *field;
         }
         else
         {
             LOG_ERROR("Can't find target field.");
+            return T {};
         }
     }
 
     void LuaComponent::invoke(std::weak_ptr<GObject> game_object, const char* name)
     {
-        LOG_INFO(name);
+        const LuaMethodBinding&  binding = LuaBindingCache::getMethodBinding(name);
+        std::shared_ptr<GObject> object  = game_object.lock();
+        if (!binding.isValid() || !object)
+        {
+            LOG_ERROR("Cand find method");
+            return;
+        }
+
+        void* target_instance = LuaBindingCache::getMethodInstance(*object, binding);
+        if (target_instance == nullptr)
+        {
+            LOG_ERROR("Cand find component");
+            return;
+        }
+        binding.m_method.invoke(target_instance);
+    }
+
+    sol::object
+    LuaComponent::getComponent(std::weak_ptr<GObject> game_object, const char* name, sol::this_state lua_state)
+    {
+        std::shared_ptr<GObject> object    = game_object.lock();
+        Component*               component = object ? object->tryGetComponentByTypeName(name) : nullptr;
+        return LuaTypeRegistry::makeObject(lua_state, name, component);
+    }
+
+    void LuaComponent::registerFunctions(sol::state& lua_state)
+    {
+        lua_state.set_function("set_float", &LuaComponent::set<float>);
+        lua_state.set_function("get_bool", &LuaComponent::get<bool>);
+        lua_state.set_function("invoke", &LuaComponent::invoke);
+        lua_state.set_function("get_component", &LuaComponent::getComponent);
+        LuaTypeRegistry::bindTypes(lua_state);
+    }
+
+    void LuaComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
+    {
+        m_parent_object = parent_object;
 
-        Reflection::TypeMeta meta;
-        void*                target_instance = nullptr;
-        std::string          method_name;
+        std::shared_ptr<LuaVMPool> lua_vm_pool = g_runtime_global_context.m_lua_vm_pool;
+        sol::state&                lua_state   = lua_vm_pool->getVM(m_parent_object.lock()->getID());
 
-        // get target instance and meta
-        std::string target_name(name);
-        size_t      pos = target_name.find_last_of('.');
-        method_name     = target_name.substr(pos + 1, target_name.size());
-        target_name     = target_name.substr(0, pos);
+        m_environment               = sol::environment(lua_state, sol::create, lua_state.globals());
+        m_environment["GameObject"] = m_parent_object;
 
-        if (target_name.find_first_of('.') == target_name.npos)
+        m_is_chunk_executed   = false;
+        m_has_update_function = false;
+        m_update_function     = sol::protected_function();
+        if (lua_vm_pool->loadScript(lua_state, m_lua_script, m_chunk))
         {
-            // target is a component
-            auto components = game_object.lock()->getComponents();
+            sol::set_environment(m_environment, m_chunk);
+        }
+    }
 
-            auto component_iter = std::find_if(
-                components.begin(), components.end(), [target_name](auto c) { return c.getTypeName() == target_name; });
-            if (component_iter != components.end())
-            {
-                meta            = Reflection::TypeMeta::newMetaFromName(target_name);
-                target_instance = component_iter->getPtr();
-            }
-            else
-            {
-                LOG_ERROR("Cand find component");
-                return;
-            }
+    void LuaComponent::tick(float delta_time)
+    {
+        if (!m_chunk.valid())
+        {
+            return;
         }
-        else
+
+        // the chunk first runs on the first tick, as scripts without update(dt) used to run then
+        if (!m_is_chunk_executed)
         {
-            Reflection::FieldAccessor field_accessor;
-            if (find_component_field(game_object, name, field_accessor, target_instance))
+            m_is_chunk_executed = true;
+            if (!runScriptFunction(m_chunk, delta_time))
             {
-                target_instance = field_accessor.get(target_instance);
-                field_accessor.getTypeMeta(meta);
+                return;
             }
-            else
+
+            sol::object update_function = m_environment.raw_get<sol::object>("update");
+            if (update_function.get_type() != sol::type::function)
             {
-                LOG_ERROR("Can't find target field.");
+                m_update_function = m_chunk;
                 return;
             }
+            m_update_function     = update_function.as<sol::protected_function>();
+            m_has_update_function = true;
         }
 
-        // invoke function
-        Reflection::MethodAccessor* methods;
-        size_t                      method_count = meta.getMethodsList(methods);
-        auto                        method_iter  = std::find_if(
-            methods, methods + method_count, [method_name](auto m) { return m.getMethodName() == method_name; });
-        if (method_iter != methods + method_count)
-        {
-            method_iter->invoke(target_instance);
-        }
-        else
-        {
-            LOG_ERROR("Cand find method");
-        }
-        delete[] methods;
-    }
-
-    void LuaComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
-    {
-        m_parent_object = parent_object;
-        m_lua_state.open_libraries(sol::lib::base);
-        m_lua_state.set_function("set_float", &LuaComponent::set<float>);
-        m_lua_state.set_function("get_bool", &LuaComponent::get<bool>);
-        m_lua_state.set_function("invoke", &LuaComponent::invoke);
-        m_lua_state["GameObject"] = m_parent_object;
+        runScriptFunction(m_update_function, delta_time);
     }
 
-    void LuaComponent::tick(float delta_time)
+    bool LuaComponent::runScriptFunction(const sol::protected_function& function, float delta_time)
     {
-        // LOG_INFO(m_lua_script);
-        m_lua_state.script(m_lua_script);
+        sol::protected_function_result result = m_has_update_function ? function(delta_time) : function();
+        if (!result.valid())
+        {
+            sol::error error = result;
+            LOG_ERROR("run lua script failed: {}", error.what());
+            return false;
+        }
+        return true;
     }
-
 } // namespace Piccolo
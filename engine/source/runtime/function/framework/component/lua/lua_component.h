@@ -23,9 +23,27 @@ namespace Piccolo
         static T get(std::weak_ptr<GObject> game_object, const char* name);
 
         static void invoke(std::weak_ptr<GObject> game_object, const char* name);
+
+        /// the component as its generated usertype, scripts then access its reflected fields and methods directly
+        static sol::object
+        getComponent(std::weak_ptr<GObject> game_object, const char* name, sol::this_state lua_state);
+
+        /// binds the engine functions scripts can call, once per lua state of the pool
+        static void registerFunctions(sol::state& lua_state);
+
     protected:
-        sol::state m_lua_state;
+        bool runScriptFunction(const sol::protected_function& function, float delta_time);
+
         META(Enable)
         std::string m_lua_script;
+
+        // the globals of this object, falling back to the globals of the shared lua state
+        sol::environment        m_environment;
+        // this object's instance of the compiled script
+        sol::protected_function m_chunk;
+        // update(dt) when the script defines it, otherwise the chunk is run as a whole every tick
+        sol::protected_function m_update_function;
+        bool                    m_is_chunk_executed {false};
+        bool                    m_has_update_function {false};
     };
 } // namespace Piccolo
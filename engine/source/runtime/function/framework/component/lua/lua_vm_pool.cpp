@@ -0,0 +1,76 @@
+#include "runtime/function/framework/component/lua/lua_vm_pool.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/framework/component/lua/lua_binding.h"
+#include "runtime/function/framework/component/lua/lua_component.h"
+
+namespace Piccolo
+{
+    static const char* const k_lua_chunk_name = "=LuaComponent";
+
+    void LuaVMPool::initialize(uint32_t vm_count)
+    {
+        ASSERT(vm_count > 0);
+
+        m_vms.reserve(vm_count);
+        for (uint32_t vm_index = 0; vm_index < vm_count; ++vm_index)
+        {
+            std::unique_ptr<sol::state> vm = std::make_unique<sol::state>();
+            vm->open_libraries(sol::lib::base);
+            LuaComponent::registerFunctions(*vm);
+            m_vms.push_back(std::move(vm));
+        }
+    }
+
+    void LuaVMPool::clear()
+    {
+        // the bytecode is independent of the states, but nothing is loaded into them anymore
+        m_compiled_scripts.clear();
+        m_vms.clear();
+        LuaBindingCache::clear();
+    }
+
+    sol::state& LuaVMPool::getVM(GObjectID object_id) { return *m_vms[object_id % m_vms.size()]; }
+
+    bool LuaVMPool::loadScript(sol::state& vm, const std::string& script, sol::protected_function& out_chunk)
+    {
+        const sol::bytecode* bytecode = compileScript(vm, script);
+        if (bytecode == nullptr)
+        {
+            return false;
+        }
+
+        // every load creates a new closure, so each object can bind the chunk to its own environment
+        sol::load_result chunk = vm.load(bytecode->as_string_view(), k_lua_chunk_name, sol::load_mode::binary);
+        if (!chunk.valid())
+        {
+            sol::error error = chunk;
+            LOG_ERROR("load compiled lua script failed: {}", error.what());
+            return false;
+        }
+
+        out_chunk = chunk;
+        return true;
+    }
+
+    const sol::bytecode* LuaVMPool::compileScript(sol::state& vm, const std::string& script)
+    {
+        auto compiled_iter = m_compiled_scripts.find(script);
+        if (compiled_iter != m_compiled_scripts.end())
+        {
+            return &compiled_iter->second;
+        }
+
+        sol::load_result chunk = vm.load(script, k_lua_chunk_name, sol::load_mode::text);
+        if (!chunk.valid())
+        {
+            sol::error error = chunk;
+            LOG_ERROR("compile lua script failed: {}", error.what());
+            return nullptr;
+        }
+
+        sol::protected_function chunk_function = chunk;
+        return &m_compiled_scripts.emplace(script, chunk_function.dump()).first->second;
+    }
+} // namespace Piccolo
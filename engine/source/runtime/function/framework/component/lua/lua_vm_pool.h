@@ -0,0 +1,40 @@
+#pragma once
+
+#include "runtime/function/framework/object/object_id_allocator.h"
+
+#include "sol/sol.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Piccolo
+{
+    /// A few lua states shared by all lua components. Every object runs its script in an environment of its own
+    /// inside one of the states, so objects can not see each other's globals while the libraries and the engine
+    /// bindings exist only once per state. Script sources are compiled to bytecode once per distinct content
+    class LuaVMPool
+    {
+    public:
+        static constexpr uint32_t k_default_vm_count = 4;
+
+        void initialize(uint32_t vm_count = k_default_vm_count);
+        void clear();
+
+        /// objects are spread over the states by id, an object always runs in the same state
+        sol::state& getVM(GObjectID object_id);
+
+        /// creates a function of the script in the given state, the source is only parsed the first time its
+        /// content is seen, later loads instantiate the cached bytecode
+        bool loadScript(sol::state& vm, const std::string& script, sol::protected_function& out_chunk);
+
+    private:
+        const sol::bytecode* compileScript(sol::state& vm, const std::string& script);
+
+        std::vector<std::unique_ptr<sol::state>>       m_vms;
+        // keyed by the script source, the lookup hashes the content
+        std::unordered_map<std::string, sol::bytecode> m_compiled_scripts;
+    };
+} // namespace Piccolo
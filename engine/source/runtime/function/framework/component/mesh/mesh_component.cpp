@@ -67,6 +67,13 @@ namespace Piccolo
 
         if (transform_component->isDirty())
         {
+            if (m_is_render_entity_created)
+            {
+                updateRenderEntityTransforms(*transform_component, animation_component);
+                transform_component->setDirtyFlag(false);
+                return;
+            }
+
             std::vector<GameObjectPartDesc> dirty_mesh_parts;
             SkeletonAnimationResult         animation_result;
             animation_result.m_transforms.push_back({Matrix4x4::IDENTITY});
@@ -98,8 +105,35 @@ namespace Piccolo
             RenderSwapData&    logic_swap_data     = render_swap_context.getLogicSwapData();
 
             logic_swap_data.addDirtyGameObject(GameObjectDesc {m_parent_object.lock()->getID(), dirty_mesh_parts});
+            m_is_render_entity_created = true;
 
             transform_component->setDirtyFlag(false);
         }
     }
+
+    void MeshComponent::updateRenderEntityTransforms(const TransformComponent& transform_component,
+                                                     const AnimationComponent* animation_component)
+    {
+        m_part_model_matrices.resize(m_raw_meshes.size());
+        for (size_t part_index = 0; part_index < m_raw_meshes.size(); ++part_index)
+        {
+            m_part_model_matrices[part_index] =
+                transform_component.getMatrix() * m_raw_meshes[part_index].m_transform_desc.m_transform_matrix;
+        }
+
+        m_joint_matrices.clear();
+        if (animation_component != nullptr)
+        {
+            // same layout as the skeleton animation result of the part descs
+            m_joint_matrices.push_back(Matrix4x4::IDENTITY);
+            for (const AnimationResultElement& node : animation_component->getResult().node)
+            {
+                m_joint_matrices.push_back(Matrix4x4(node.transform));
+            }
+        }
+
+        RenderSwapContext& render_swap_context = g_runtime_global_context.m_render_system->getSwapContext();
+        render_swap_context.getLogicSwapData().addRenderEntityTransforms(
+            m_parent_object.lock()->getID(), m_part_model_matrices, m_joint_matrices);
+    }
 } // namespace Piccolo
@@ -10,7 +10,9 @@
 
 namespace Piccolo
 {
+    class AnimationComponent;
     class RenderSwapContext;
+    class TransformComponent;
 
     REFLECTION_TYPE(MeshComponent)
     CLASS(MeshComponent : public Component, WhiteListFields)
@@ -26,9 +28,18 @@ namespace Piccolo
         void tick(float delta_time) override;
 
     private:
+        void updateRenderEntityTransforms(const TransformComponent& transform_component,
+                                          const AnimationComponent* animation_component);
+
         META(Enable)
         MeshComponentRes m_mesh_res;
 
         std::vector<GameObjectPartDesc> m_raw_meshes;
+
+        // the first update creates the render entities from the part descs, the later ones only send the
+        // transforms and joints of the parts
+        bool                   m_is_render_entity_created {false};
+        std::vector<Matrix4x4> m_part_model_matrices;
+        std::vector<Matrix4x4> m_joint_matrices;
     };
 } // namespace Piccolo
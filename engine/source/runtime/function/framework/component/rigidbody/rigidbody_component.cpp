@@ -39,6 +39,29 @@ namespace Piccolo
         physics_scene->removeRigidBody(m_rigidbody_id);
     }
 
+    void RigidBodyComponent::tick(float delta_time)
+    {
+        std::shared_ptr<PhysicsScene> physics_scene =
+            g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
+        if (!physics_scene)
+        {
+            return;
+        }
+
+        Transform simulated_transform;
+        if (!physics_scene->getInterpolatedTransform(m_rigidbody_id, simulated_transform))
+        {
+            return;
+        }
+
+        TransformComponent* transform_component = m_parent_object.lock()->tryGetComponent(TransformComponent);
+        if (transform_component)
+        {
+            transform_component->setSimulatedTransform(simulated_transform.m_position,
+                                                       simulated_transform.m_rotation);
+        }
+    }
+
     void RigidBodyComponent::createRigidBody(const Transform& global_transform)
     {
         std::shared_ptr<PhysicsScene> physics_scene =
@@ -16,7 +16,8 @@ namespace Piccolo
 
         void postLoadResource(std::weak_ptr<GObject> parent_object) override;
 
-        void tick(float delta_time) override {}
+        /// moves the object along with its simulated body, before the transforms tick
+        void tick(float delta_time) override;
         void updateGlobalTransform(const Transform& transform, bool is_scale_dirty);
         void getShapeBoundingBoxes(std::vector<AxisAlignedBox> & out_boudning_boxes) const;
 
@@ -35,15 +35,23 @@ namespace Piccolo
         m_is_dirty                                  = true;
     }
 
+    void TransformComponent::setSimulatedTransform(const Vector3& new_translation, const Quaternion& new_rotation)
+    {
+        setPosition(new_translation);
+        setRotation(new_rotation);
+        m_is_simulated = true;
+    }
+
     void TransformComponent::tick(float delta_time)
     {
         std::swap(m_current_index, m_next_index);
 
-        if (m_is_dirty)
+        if (m_is_dirty && !m_is_simulated)
         {
             // update transform component, dirty flag will be reset in mesh component
             tryUpdateRigidBodyComponent();
         }
+        m_is_simulated = false;
 
         if (g_is_editor_mode)
         {
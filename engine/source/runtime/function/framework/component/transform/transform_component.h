@@ -28,6 +28,9 @@ namespace Piccolo
 
         void setRotation(const Quaternion& new_rotation);
 
+        /// takes over the transform of the simulated rigid body of the object, without moving the body back to it
+        void setSimulatedTransform(const Vector3& new_translation, const Quaternion& new_rotation);
+
         const Transform& getTransformConst() const { return m_transform_buffer[m_current_index]; }
         Transform&       getTransform() { return m_transform_buffer[m_next_index]; }
 
@@ -44,5 +47,8 @@ namespace Piccolo
         Transform m_transform_buffer[2];
         size_t    m_current_index {0};
         size_t    m_next_index {1};
+
+        // the dirty transform comes from the physics scene, the rigid body is already there
+        bool m_is_simulated {false};
     };
 } // namespace Piccolo
@@ -1,30 +1,114 @@
 #include "runtime/function/framework/level/level.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
+#include "runtime/core/profile/profiler.h"
 
 #include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
 #include "runtime/resource/res_type/common/level.h"
 
 #include "runtime/engine.h"
+#include "runtime/function/animation/animation_lod.h"
 #include "runtime/function/character/character.h"
+#include "runtime/function/framework/component/component_store.h"
 #include "runtime/function/framework/object/object.h"
 #include "runtime/function/particle/particle_manager.h"
 #include "runtime/function/physics/physics_manager.h"
 #include "runtime/function/physics/physics_scene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <limits>
 
 namespace Piccolo
 {
+    // time a tick may spend creating streamed objects, at least one object is created per tick
+    static constexpr double k_level_publish_time_budget_ms = 2.0;
+
+    /// Resources read on the streaming thread. Object i of the level is created from m_definitions[i], the
+    /// vectors are only touched by the tick thread after the loading stage switched to ResourcesLoaded
+    struct LevelStreamingState
+    {
+        LevelRes                         m_level_res;
+        std::vector<ObjectDefinitionRes> m_definitions;
+        std::vector<uint8_t>             m_is_definition_loaded;
+
+        std::atomic<uint32_t> m_object_count {0};
+        std::atomic<uint32_t> m_loaded_object_count {0};
+        std::atomic<bool>     m_is_cancelled {false};
+        size_t                m_published_object_count {0};
+
+        std::future<bool> m_loading_task;
+    };
+
+    namespace
+    {
+        bool loadLevelResources(const std::string& level_res_url, LevelStreamingState& state)
+        {
+            PICCOLO_PROFILE_ZONE("loadLevelResources");
+
+            std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+            if (!asset_manager->loadAsset(level_res_url, state.m_level_res))
+            {
+                return false;
+            }
+
+            // every object gets its own definition, the loaded components are handed over to the object
+            const std::vector<ObjectInstanceRes>& objects = state.m_level_res.m_objects;
+            state.m_definitions.resize(objects.size());
+            state.m_is_definition_loaded.resize(objects.size(), 0);
+            state.m_object_count = static_cast<uint32_t>(objects.size());
+            for (size_t object_index = 0; object_index < objects.size(); ++object_index)
+            {
+                if (state.m_is_cancelled)
+                {
+                    return false;
+                }
+
+                state.m_is_definition_loaded[object_index] =
+                    asset_manager->loadAsset(objects[object_index].m_definition, state.m_definitions[object_index]);
+                ++state.m_loaded_object_count;
+            }
+
+            return true;
+        }
+
+        void deleteComponents(std::vector<Reflection::ReflectionPtr<Component>>& components)
+        {
+            for (auto& component : components)
+            {
+                PICCOLO_REFLECTION_DELETE(component);
+            }
+            components.clear();
+        }
+    } // namespace
+
+    Level::Level() = default;
+
+    Level::~Level() { releaseStreamingState(); }
+
     void Level::clear()
     {
+        releaseStreamingState();
+        m_loading_stage = LevelLoadingStage::Unloaded;
+
         m_current_active_character.reset();
         m_gobjects.clear();
+        m_component_store.reset();
+        m_is_tick_list_dirty = true;
 
         ASSERT(g_runtime_global_context.m_physics_manager);
         g_runtime_global_context.m_physics_manager->deletePhysicsScene(m_physics_scene);
     }
 
     GObjectID Level::createObject(const ObjectInstanceRes& object_instance_res)
+    {
+        return createObject(object_instance_res, nullptr);
+    }
+
+    GObjectID Level::createObject(const ObjectInstanceRes& object_instance_res, ObjectDefinitionRes* definition_res)
     {
         GObjectID object_id = ObjectIDAllocator::alloc();
         ASSERT(object_id != k_invalid_gobject_id);
@@ -32,17 +116,19 @@ namespace Piccolo
         std::shared_ptr<GObject> gobject;
         try
         {
-            gobject = std::make_shared<GObject>(object_id);
+            gobject = std::make_shared<GObject>(object_id, m_component_store);
         }
         catch (const std::bad_alloc&)
         {
             LOG_FATAL("cannot allocate memory for new gobject");
         }
 
-        bool is_loaded = gobject->load(object_instance_res);
+        bool is_loaded = definition_res ? gobject->load(object_instance_res, *definition_res) :
+                                          gobject->load(object_instance_res);
         if (is_loaded)
         {
             m_gobjects.emplace(object_id, gobject);
+            m_is_tick_list_dirty = true;
         }
         else
         {
@@ -56,43 +142,185 @@ namespace Piccolo
     {
         LOG_INFO("loading level: {}", level_res_url);
 
-        m_level_res_url = level_res_url;
-
-        LevelRes   level_res;
-        const bool is_load_success = g_runtime_global_context.m_asset_manager->loadAsset(level_res_url, level_res);
-        if (is_load_success == false)
+        m_level_res_url   = level_res_url;
+        m_streaming_state = std::make_unique<LevelStreamingState>();
+        if (!loadLevelResources(level_res_url, *m_streaming_state))
         {
+            LOG_ERROR("loading level {} failed", level_res_url);
+            releaseStreamingState();
+            m_loading_stage = LevelLoadingStage::Failed;
             return false;
         }
 
+        beginPublishing();
+        publishStreamedObjects(std::numeric_limits<double>::max());
+
+        return true;
+    }
+
+    void Level::loadAsync(const std::string& level_res_url)
+    {
+        LOG_INFO("streaming level: {}", level_res_url);
+
+        m_level_res_url   = level_res_url;
+        m_streaming_state = std::make_unique<LevelStreamingState>();
+        m_loading_stage   = LevelLoadingStage::LoadingResources;
+
+        // a thread of its own rather than jobs: a job system wait on the tick thread would pick up the long
+        // loading jobs and stall the frame they are meant to keep steady
+        LevelStreamingState* state = m_streaming_state.get();
+        state->m_loading_task      = std::async(std::launch::async, [this, state, level_res_url]() {
+            PICCOLO_PROFILE_THREAD_NAME("level streaming");
+
+            const bool is_load_success = loadLevelResources(level_res_url, *state);
+            m_loading_stage = is_load_success ? LevelLoadingStage::ResourcesLoaded : LevelLoadingStage::Failed;
+            return is_load_success;
+        });
+    }
+
+    float Level::getLoadingProgress() const
+    {
+        if (m_streaming_state == nullptr)
+        {
+            return m_loading_stage == LevelLoadingStage::Loaded ? 1.f : 0.f;
+        }
+
+        const uint32_t object_count = m_streaming_state->m_object_count;
+        if (object_count == 0)
+        {
+            return m_loading_stage == LevelLoadingStage::LoadingResources ? 0.f : 0.5f;
+        }
+
+        const float loaded_ratio    = static_cast<float>(m_streaming_state->m_loaded_object_count) / object_count;
+        const float published_ratio = static_cast<float>(m_streaming_state->m_published_object_count) / object_count;
+        return 0.5f * (loaded_ratio + published_ratio);
+    }
+
+    void Level::updateStreaming()
+    {
+        switch (m_loading_stage)
+        {
+            case LevelLoadingStage::ResourcesLoaded:
+                beginPublishing();
+                publishStreamedObjects(k_level_publish_time_budget_ms);
+                break;
+            case LevelLoadingStage::PublishingObjects:
+                publishStreamedObjects(k_level_publish_time_budget_ms);
+                break;
+            case LevelLoadingStage::Failed:
+                if (m_streaming_state)
+                {
+                    LOG_ERROR("loading level {} failed", m_level_res_url);
+                    releaseStreamingState();
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    void Level::beginPublishing()
+    {
+        ASSERT(m_streaming_state);
+
         ASSERT(g_runtime_global_context.m_physics_manager);
-        m_physics_scene = g_runtime_global_context.m_physics_manager->createPhysicsScene(level_res.m_gravity);
+        m_physics_scene =
+            g_runtime_global_context.m_physics_manager->createPhysicsScene(m_streaming_state->m_level_res.m_gravity);
         ParticleEmitterIDAllocator::reset();
 
-        for (const ObjectInstanceRes& object_instance_res : level_res.m_objects)
+        if (g_runtime_global_context.m_config_manager->isComponentStoreEnabled())
+        {
+            m_component_store = std::make_shared<ComponentStore>();
+        }
+
+        // the published objects tick while the rest is still being created
+        m_loading_stage = LevelLoadingStage::PublishingObjects;
+    }
+
+    void Level::publishStreamedObjects(double time_budget_ms)
+    {
+        PICCOLO_PROFILE_ZONE("Level::publishStreamedObjects");
+
+        using namespace std::chrono;
+
+        LevelStreamingState&            state   = *m_streaming_state;
+        std::vector<ObjectInstanceRes>& objects = state.m_level_res.m_objects;
+
+        const steady_clock::time_point begin = steady_clock::now();
+        while (state.m_published_object_count < objects.size())
+        {
+            const size_t object_index = state.m_published_object_count++;
+            if (state.m_is_definition_loaded[object_index])
+            {
+                createObject(objects[object_index], &state.m_definitions[object_index]);
+            }
+            else
+            {
+                LOG_ERROR("loading object " + objects[object_index].m_name + " failed");
+                deleteComponents(objects[object_index].m_instanced_components);
+            }
+
+            if (duration<double, std::milli>(steady_clock::now() - begin).count() >= time_budget_ms)
+            {
+                break;
+            }
+        }
+
+        if (state.m_published_object_count == objects.size())
         {
-            createObject(object_instance_res);
+            finishLoading();
         }
+    }
 
+    void Level::finishLoading()
+    {
         // create active character
+        const std::string& character_name = m_streaming_state->m_level_res.m_character_name;
         for (const auto& object_pair : m_gobjects)
         {
             std::shared_ptr<GObject> object = object_pair.second;
             if (object == nullptr)
                 continue;
 
-            if (level_res.m_character_name == object->getName())
+            if (character_name == object->getName())
             {
                 m_current_active_character = std::make_shared<Character>(object);
                 break;
             }
         }
 
-        m_is_loaded = true;
+        releaseStreamingState();
+        m_loading_stage = LevelLoadingStage::Loaded;
 
         LOG_INFO("level load succeed");
+    }
 
-        return true;
+    void Level::releaseStreamingState()
+    {
+        if (m_streaming_state == nullptr)
+        {
+            return;
+        }
+
+        LevelStreamingState& state = *m_streaming_state;
+        state.m_is_cancelled       = true;
+        if (state.m_loading_task.valid())
+        {
+            state.m_loading_task.wait();
+        }
+
+        // components of objects that were never created are still owned by the resources
+        std::vector<ObjectInstanceRes>& objects = state.m_level_res.m_objects;
+        for (size_t object_index = state.m_published_object_count; object_index < objects.size(); ++object_index)
+        {
+            deleteComponents(objects[object_index].m_instanced_components);
+            if (object_index < state.m_definitions.size())
+            {
+                deleteComponents(state.m_definitions[object_index].m_components);
+            }
+        }
+
+        m_streaming_state.reset();
     }
 
     void Level::unload()
@@ -103,6 +331,13 @@ namespace Piccolo
 
     bool Level::save()
     {
+        // the objects that are not published yet would be missing from the saved level
+        if (isLoading())
+        {
+            LOG_WARN("level {} is still loading and is not saved", m_level_res_url);
+            return false;
+        }
+
         LOG_INFO("saving level: {}", m_level_res_url);
         LevelRes output_level_res;
 
@@ -137,19 +372,27 @@ namespace Piccolo
 
     void Level::tick(float delta_time)
     {
-        if (!m_is_loaded)
+        PICCOLO_PROFILE_ZONE("Level::tick");
+
+        updateStreaming();
+        if (m_loading_stage != LevelLoadingStage::PublishingObjects && m_loading_stage != LevelLoadingStage::Loaded)
         {
             return;
         }
 
-        for (const auto& id_object_pair : m_gobjects)
+        if (m_is_tick_list_dirty)
         {
-            assert(id_object_pair.second);
-            if (id_object_pair.second)
-            {
-                id_object_pair.second->tick(delta_time);
-            }
+            rebuildTickLists();
         }
+
+        AnimationLodManager::beginFrame();
+        tickComponentPhase(m_animation_phase, delta_time);
+        tickComponentPhase(m_motor_phase, delta_time);
+        tickComponentPhase(m_rigidbody_phase, delta_time);
+        tickComponentPhase(m_transform_phase, delta_time);
+        tickGeneralComponents(delta_time);
+        tickComponentPhase(m_mesh_phase, delta_time);
+
         if (m_current_active_character && g_is_editor_mode == false)
         {
             m_current_active_character->tick(delta_time);
@@ -162,6 +405,92 @@ namespace Piccolo
         }
     }
 
+    void Level::rebuildTickLists()
+    {
+        ComponentTickPhase* phases[] = {
+            &m_animation_phase, &m_motor_phase, &m_rigidbody_phase, &m_transform_phase, &m_mesh_phase};
+        for (ComponentTickPhase* phase : phases)
+        {
+            phase->m_components.clear();
+            phase->m_pool = m_component_store ? m_component_store->getPool(phase->m_component_type_name) : nullptr;
+        }
+        m_general_components.clear();
+
+        // tick in object id order so that the batches do not depend on the hash map layout
+        std::vector<GObjectID> object_ids;
+        object_ids.reserve(m_gobjects.size());
+        for (const auto& id_object_pair : m_gobjects)
+        {
+            if (id_object_pair.second)
+            {
+                object_ids.push_back(id_object_pair.first);
+            }
+        }
+        std::sort(object_ids.begin(), object_ids.end());
+
+        for (GObjectID object_id : object_ids)
+        {
+            for (const auto& component : m_gobjects[object_id]->getComponents())
+            {
+                const std::string type_name = component.getTypeName();
+
+                auto phase_iter = std::find_if(std::begin(phases), std::end(phases), [&type_name](auto phase) {
+                    return phase->m_component_type_name == type_name;
+                });
+                if (phase_iter != std::end(phases))
+                {
+                    // pooled components are ticked straight from their pool
+                    if ((*phase_iter)->m_pool == nullptr)
+                    {
+                        (*phase_iter)->m_components.push_back(component.getPtr());
+                    }
+                }
+                else
+                {
+                    m_general_components.push_back(component);
+                }
+            }
+        }
+
+        m_is_tick_list_dirty = false;
+    }
+
+    void Level::tickComponentPhase(const ComponentTickPhase& phase, float delta_time)
+    {
+        if (!shouldComponentTick(phase.m_component_type_name))
+        {
+            return;
+        }
+
+        if (phase.m_pool)
+        {
+            phase.m_pool->tick(delta_time);
+            return;
+        }
+
+        const std::vector<Component*>& components = phase.m_components;
+        g_runtime_global_context.m_job_system->parallelFor(
+            static_cast<uint32_t>(components.size()),
+            phase.m_tick_batch_size,
+            [&components, delta_time](uint32_t begin, uint32_t end) {
+                for (uint32_t index = begin; index < end; ++index)
+                {
+                    components[index]->tick(delta_time);
+                }
+            });
+    }
+
+    void Level::tickGeneralComponents(float delta_time)
+    {
+        for (auto& component : m_general_components)
+        {
+            if (shouldComponentTick(component.getTypeName()))
+            {
+                component->tick(delta_time);
+            }
+        }
+    }
+
     std::weak_ptr<GObject> Level::getGObjectByID(GObjectID go_id) const
     {
         auto iter = m_gobjects.find(go_id);
@@ -189,6 +518,7 @@ namespace Piccolo
         }
 
         m_gobjects.erase(go_id);
+        m_is_tick_list_dirty = true;
     }
 
 } // namespace Piccolo
@@ -1,29 +1,69 @@
 #pragma once
 
+#include "runtime/function/framework/component/component.h"
 #include "runtime/function/framework/object/object_id_allocator.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Piccolo
 {
     class Character;
+    class ComponentPoolBase;
+    class ComponentStore;
     class GObject;
+    class ObjectDefinitionRes;
     class ObjectInstanceRes;
     class PhysicsScene;
+    struct LevelStreamingState;
 
     using LevelObjectsMap = std::unordered_map<GObjectID, std::shared_ptr<GObject>>;
 
+    /// Components of one type that are ticked in parallel batches on the job system, either from the list or,
+    /// when the type is pooled by the level's component store, directly from the pool
+    struct ComponentTickPhase
+    {
+        std::string             m_component_type_name;
+        std::vector<Component*> m_components;
+        ComponentPoolBase*      m_pool {nullptr};
+        // number of listed components ticked by a single job
+        uint32_t m_tick_batch_size {64};
+    };
+
+    enum class LevelLoadingStage : uint8_t
+    {
+        Unloaded,
+        LoadingResources,  // the level and object definitions are read on the streaming thread
+        ResourcesLoaded,   // waiting for the next tick to publish the objects
+        PublishingObjects, // objects are created by tick within a time budget per frame
+        Loaded,
+        Failed
+    };
+
     /// The main class to manage all game objects
     class Level
     {
     public:
-        virtual ~Level(){};
+        Level();
+        virtual ~Level();
 
+        /// load everything on the calling thread before returning
         bool load(const std::string& level_res_url);
+        /// read the resources on a streaming thread and return immediately, tick publishes the objects in
+        /// time-sliced batches once the resources are loaded
+        void loadAsync(const std::string& level_res_url);
         void unload();
 
+        LevelLoadingStage getLoadingStage() const { return m_loading_stage; }
+        bool              isLoading() const { return m_streaming_state != nullptr; }
+        /// 0 to 1, reading the resources is the first half and publishing the objects the second half
+        float getLoadingProgress() const;
+
+        /// fails while the level is still loading
         bool save();
 
         void tick(float delta_time);
@@ -40,15 +80,51 @@ namespace Piccolo
 
         std::weak_ptr<PhysicsScene> getPhysicsScene() const { return m_physics_scene; }
 
+        // nullptr if the component store is disabled in the engine config
+        std::shared_ptr<ComponentStore> getComponentStore() const { return m_component_store; }
+
     protected:
         void clear();
 
-        bool        m_is_loaded {false};
-        std::string m_level_res_url;
+        GObjectID createObject(const ObjectInstanceRes& object_instance_res, ObjectDefinitionRes* definition_res);
+
+        void updateStreaming();
+        void beginPublishing();
+        void publishStreamedObjects(double time_budget_ms);
+        void finishLoading();
+        void releaseStreamingState();
+
+        void rebuildTickLists();
+        void tickComponentPhase(const ComponentTickPhase& phase, float delta_time);
+        void tickGeneralComponents(float delta_time);
+
+        std::atomic<LevelLoadingStage> m_loading_stage {LevelLoadingStage::Unloaded};
+        std::string                    m_level_res_url;
+
+        // alive while the level is loading, owns the resources not yet handed to objects
+        std::unique_ptr<LevelStreamingState> m_streaming_state;
+
+        // contiguous storage for the components of this level's objects, declared before the objects so that it
+        // outlives them
+        std::shared_ptr<ComponentStore> m_component_store;
 
         // all game objects in this level, key: object id, value: object instance
         LevelObjectsMap m_gobjects;
 
+        // per-phase component lists in object id order, rebuilt when objects are created or deleted.
+        // phases run one after another: animation and motor produce the pose and the target position, rigid body
+        // hands over the simulated positions, transform publishes the position, the remaining components tick
+        // object by object on the calling thread, and mesh consumes both the animation result and the published
+        // transform
+        bool                                             m_is_tick_list_dirty {true};
+        // a skeleton evaluation is enough work for a job of its own
+        ComponentTickPhase                               m_animation_phase {"AnimationComponent", {}, nullptr, 1};
+        ComponentTickPhase                               m_motor_phase {"MotorComponent"};
+        ComponentTickPhase                               m_rigidbody_phase {"RigidBodyComponent"};
+        ComponentTickPhase                               m_transform_phase {"TransformComponent"};
+        ComponentTickPhase                               m_mesh_phase {"MeshComponent"};
+        std::vector<Reflection::ReflectionPtr<Component>> m_general_components;
+
         std::shared_ptr<Character> m_current_active_character;
 
         std::weak_ptr<PhysicsScene> m_physics_scene;
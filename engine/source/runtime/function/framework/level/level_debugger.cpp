@@ -91,10 +91,8 @@ namespace Piccolo
     }
     void LevelDebugger::drawBones(std::shared_ptr<GObject> object) const
     {
-        const TransformComponent* transform_component =
-            object->tryGetComponentConst<TransformComponent>("TransformComponent");
-        const AnimationComponent* animation_component =
-            object->tryGetComponentConst<AnimationComponent>("AnimationComponent");
+        const TransformComponent* transform_component = object->tryGetComponentConst(TransformComponent);
+        const AnimationComponent* animation_component = object->tryGetComponentConst(AnimationComponent);
 
         if (transform_component == nullptr || animation_component == nullptr)
             return;
@@ -108,26 +106,19 @@ namespace Piccolo
                                       .getMatrix();
 
         const Skeleton& skeleton    = animation_component->getSkeleton();
-        const Bone*     bones       = skeleton.getBones();
         int32_t         bones_count = skeleton.getBonesCount();
         for (int32_t bone_index = 0; bone_index < bones_count; bone_index++)
         {
-            if (bones[bone_index].getParent() == nullptr || bone_index == 1)
+            const int32_t parent_index = skeleton.getBoneParentIndex(bone_index);
+            if (parent_index < 0 || bone_index == 1)
                 continue;
 
-            Matrix4x4 bone_matrix = Transform(bones[bone_index]._getDerivedPosition(),
-                                              bones[bone_index]._getDerivedOrientation(),
-                                              bones[bone_index]._getDerivedScale())
-                                        .getMatrix();
+            Matrix4x4 bone_matrix = skeleton.getBoneModelTransform(bone_index).getMatrix();
             Vector4 bone_position(0.0f, 0.0f, 0.0f, 1.0f);
             bone_position = object_matrix * bone_matrix * bone_position;
             bone_position /= bone_position[3];
 
-            Node*     parent_bone        = bones[bone_index].getParent();
-            Matrix4x4 parent_bone_matrix = Transform(parent_bone->_getDerivedPosition(),
-                                                     parent_bone->_getDerivedOrientation(),
-                                                     parent_bone->_getDerivedScale())
-                                               .getMatrix();
+            Matrix4x4 parent_bone_matrix = skeleton.getBoneModelTransform(parent_index).getMatrix();
             Vector4 parent_bone_position(0.0f, 0.0f, 0.0f, 1.0f);
             parent_bone_position = object_matrix * parent_bone_matrix * parent_bone_position;
             parent_bone_position /= parent_bone_position[3];
@@ -148,10 +139,8 @@ namespace Piccolo
 
     void LevelDebugger::drawBonesName(std::shared_ptr<GObject> object) const
     {
-        const TransformComponent* transform_component =
-            object->tryGetComponentConst<TransformComponent>("TransformComponent");
-        const AnimationComponent* animation_component =
-            object->tryGetComponentConst<AnimationComponent>("AnimationComponent");
+        const TransformComponent* transform_component = object->tryGetComponentConst(TransformComponent);
+        const AnimationComponent* animation_component = object->tryGetComponentConst(AnimationComponent);
 
         if (transform_component == nullptr || animation_component == nullptr)
             return;
@@ -165,22 +154,19 @@ namespace Piccolo
                                       .getMatrix();
 
         const Skeleton& skeleton    = animation_component->getSkeleton();
-        const Bone*     bones       = skeleton.getBones();
         int32_t         bones_count = skeleton.getBonesCount();
         for (int32_t bone_index = 0; bone_index < bones_count; bone_index++)
         {
-            if (bones[bone_index].getParent() == nullptr || bone_index == 1)
+            const int32_t parent_index = skeleton.getBoneParentIndex(bone_index);
+            if (parent_index < 0 || bone_index == 1)
                 continue;
 
-            Matrix4x4 bone_matrix = Transform(bones[bone_index]._getDerivedPosition(),
-                                              bones[bone_index]._getDerivedOrientation(),
-                                              bones[bone_index]._getDerivedScale())
-                                        .getMatrix();
+            Matrix4x4 bone_matrix = skeleton.getBoneModelTransform(bone_index).getMatrix();
             Vector4 bone_position(0.0f, 0.0f, 0.0f, 1.0f);
             bone_position = object_matrix * bone_matrix * bone_position;
             bone_position /= bone_position[3];
 
-            debug_draw_group->addText(bones[bone_index].getName(),
+            debug_draw_group->addText(skeleton.getBoneName(bone_index),
                                       Vector4(1.0f, 0.0f, 0.0f, 1.0f),
                                       Vector3(bone_position.x, bone_position.y, bone_position.z),
                                       8,
@@ -190,8 +176,7 @@ namespace Piccolo
 
     void LevelDebugger::drawBoundingBox(std::shared_ptr<GObject> object) const
     {
-        const RigidBodyComponent* rigidbody_component =
-            object->tryGetComponentConst<RigidBodyComponent>("RigidBodyComponent");
+        const RigidBodyComponent* rigidbody_component = object->tryGetComponentConst(RigidBodyComponent);
         if (rigidbody_component == nullptr)
             return;
 
@@ -214,7 +199,7 @@ namespace Piccolo
 
     void LevelDebugger::drawCameraInfo(std::shared_ptr<GObject> object) const
     {
-        const CameraComponent* camera_component = object->tryGetComponentConst<CameraComponent>("CameraComponent");
+        const CameraComponent* camera_component = object->tryGetComponentConst(CameraComponent);
         if (camera_component == nullptr)
             return;
 
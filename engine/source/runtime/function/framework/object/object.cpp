@@ -2,11 +2,13 @@
 
 #include "runtime/engine.h"
 
+#include "runtime/core/base/macro.h"
 #include "runtime/core/meta/reflection/reflection.h"
 
 #include "runtime/resource/asset_manager/asset_manager.h"
 
 #include "runtime/function/framework/component/component.h"
+#include "runtime/function/framework/component/component_store.h"
 #include "runtime/function/framework/component/transform/transform_component.h"
 #include "runtime/function/global/global_context.h"
 
@@ -33,9 +35,13 @@ namespace Piccolo
     {
         for (auto& component : m_components)
         {
+            if (m_component_store && m_component_store->release(component))
+                continue;
+
             PICCOLO_REFLECTION_DELETE(component);
         }
         m_components.clear();
+        m_component_type_mask = 0;
     }
 
     void GObject::tick(float delta_time)
@@ -51,25 +57,75 @@ namespace Piccolo
 
     bool GObject::hasComponent(const std::string& compenent_type_name) const
     {
-        for (const auto& component : m_components)
-        {
-            if (component.getTypeName() == compenent_type_name)
-                return true;
-        }
+        const uint32_t type_id = getComponentTypeId(compenent_type_name);
+        if (type_id == k_invalid_component_type_id)
+            return false;
 
-        return false;
+        return (m_component_type_mask & (1ull << type_id)) != 0;
+    }
+
+    Component* GObject::tryGetComponentByTypeName(const std::string& compenent_type_name) const
+    {
+        return tryGetComponentByTypeId(getComponentTypeId(compenent_type_name));
+    }
+
+    Component* GObject::tryGetComponentByTypeId(uint32_t component_type_id) const
+    {
+        if (component_type_id == k_invalid_component_type_id ||
+            (m_component_type_mask & (1ull << component_type_id)) == 0)
+            return nullptr;
+
+        return m_components[m_component_indices[component_type_id]].getPtr();
+    }
+
+    void GObject::registerComponentIndex(size_t component_index)
+    {
+        const uint32_t type_id = getComponentTypeId(m_components[component_index].getTypeName());
+        // the first component of a type wins, same as the former linear search
+        if (type_id == k_invalid_component_type_id || (m_component_type_mask & (1ull << type_id)) != 0)
+            return;
+
+        ASSERT(component_index <= UINT8_MAX);
+        m_component_type_mask |= 1ull << type_id;
+        m_component_indices[type_id] = static_cast<uint8_t>(component_index);
     }
 
     bool GObject::load(const ObjectInstanceRes& object_instance_res)
+    {
+        ObjectDefinitionRes definition_res;
+
+        const bool is_loaded_success =
+            g_runtime_global_context.m_asset_manager->loadAsset(object_instance_res.m_definition, definition_res);
+        if (!is_loaded_success)
+            return false;
+
+        return load(object_instance_res, definition_res);
+    }
+
+    bool GObject::load(const ObjectInstanceRes& object_instance_res, ObjectDefinitionRes& definition_res)
     {
         // clear old components
         m_components.clear();
+        m_component_type_mask = 0;
 
         setName(object_instance_res.m_name);
 
         // load object instanced components
         m_components = object_instance_res.m_instanced_components;
-        for (auto component : m_components)
+        for (size_t component_index = 0; component_index < m_components.size(); ++component_index)
+        {
+            auto& component = m_components[component_index];
+            if (component)
+            {
+                if (m_component_store)
+                {
+                    m_component_store->adopt(component);
+                }
+                registerComponentIndex(component_index);
+            }
+        }
+        // index all instanced components first, postLoadResource may look up sibling components
+        for (auto& component : m_components)
         {
             if (component)
             {
@@ -80,23 +136,27 @@ namespace Piccolo
         // load object definition components
         m_definition_url = object_instance_res.m_definition;
 
-        ObjectDefinitionRes definition_res;
-
-        const bool is_loaded_success = g_runtime_global_context.m_asset_manager->loadAsset(m_definition_url, definition_res);
-        if (!is_loaded_success)
-            return false;
-
-        for (auto loaded_component : definition_res.m_components)
+        for (auto& loaded_component : definition_res.m_components)
         {
             const std::string type_name = loaded_component.getTypeName();
             // don't create component if it has been instanced
             if (hasComponent(type_name))
+            {
+                PICCOLO_REFLECTION_DELETE(loaded_component);
                 continue;
+            }
 
-            loaded_component->postLoadResource(weak_from_this());
+            if (m_component_store)
+            {
+                m_component_store->adopt(loaded_component);
+            }
 
             m_components.push_back(loaded_component);
+            registerComponentIndex(m_components.size() - 1);
+
+            loaded_component->postLoadResource(weak_from_this());
         }
+        definition_res.m_components.clear();
 
         return true;
     }
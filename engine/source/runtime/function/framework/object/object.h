@@ -1,10 +1,13 @@
 #pragma once
 
 #include "runtime/function/framework/component/component.h"
+#include "runtime/function/framework/component/component_type_id.h"
 #include "runtime/function/framework/object/object_id_allocator.h"
 
 #include "runtime/resource/res_type/common/object.h"
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -12,18 +15,28 @@
 
 namespace Piccolo
 {
+    class ComponentStore;
+
+    // whether components of the type should tick, only white-listed types tick in editor mode
+    bool shouldComponentTick(std::string component_type_name);
+
     /// GObject : Game Object base class
     class GObject : public std::enable_shared_from_this<GObject>
     {
         typedef std::unordered_set<std::string> TypeNameSet;
 
     public:
-        GObject(GObjectID id) : m_id {id} {}
+        GObject(GObjectID id, std::shared_ptr<ComponentStore> component_store = nullptr) :
+            m_id {id}, m_component_store {component_store}
+        {}
         virtual ~GObject();
 
         virtual void tick(float delta_time);
 
         bool load(const ObjectInstanceRes& object_instance_res);
+        /// load with a definition that is already read, e.g. by level streaming. The definition components are
+        /// taken over, the ones shadowed by an instanced component are deleted
+        bool load(const ObjectInstanceRes& object_instance_res, ObjectDefinitionRes& definition_res);
         void save(ObjectInstanceRes& out_object_instance_res);
 
         GObjectID getID() const { return m_id; }
@@ -33,39 +46,39 @@ namespace Piccolo
 
         bool hasComponent(const std::string& compenent_type_name) const;
 
-        std::vector<Reflection::ReflectionPtr<Component>> getComponents() { return m_components; }
+        const std::vector<Reflection::ReflectionPtr<Component>>& getComponents() const { return m_components; }
 
         template<typename TComponent>
-        TComponent* tryGetComponent(const std::string& compenent_type_name)
+        TComponent* tryGetComponent()
         {
-            for (auto& component : m_components)
-            {
-                if (component.getTypeName() == compenent_type_name)
-                {
-                    return static_cast<TComponent*>(component.operator->());
-                }
-            }
-
-            return nullptr;
+            const uint32_t type_id = getComponentTypeId<TComponent>();
+            if ((m_component_type_mask & (1ull << type_id)) == 0)
+                return nullptr;
+
+            return static_cast<TComponent*>(m_components[m_component_indices[type_id]].operator->());
         }
 
         template<typename TComponent>
-        const TComponent* tryGetComponentConst(const std::string& compenent_type_name) const
+        const TComponent* tryGetComponentConst() const
         {
-            for (const auto& component : m_components)
-            {
-                if (component.getTypeName() == compenent_type_name)
-                {
-                    return static_cast<const TComponent*>(component.operator->());
-                }
-            }
-            return nullptr;
+            const uint32_t type_id = getComponentTypeId<TComponent>();
+            if ((m_component_type_mask & (1ull << type_id)) == 0)
+                return nullptr;
+
+            return static_cast<const TComponent*>(m_components[m_component_indices[type_id]].operator->());
         }
 
-#define tryGetComponent(COMPONENT_TYPE) tryGetComponent<COMPONENT_TYPE>(#COMPONENT_TYPE)
-#define tryGetComponentConst(COMPONENT_TYPE) tryGetComponentConst<const COMPONENT_TYPE>(#COMPONENT_TYPE)
+        // lookup by reflected type name, for callers that only know the name at runtime like scripts
+        Component* tryGetComponentByTypeName(const std::string& compenent_type_name) const;
+        // lookup by a type id the caller resolved from the name once
+        Component* tryGetComponentByTypeId(uint32_t component_type_id) const;
+
+#define tryGetComponent(COMPONENT_TYPE) tryGetComponent<COMPONENT_TYPE>()
+#define tryGetComponentConst(COMPONENT_TYPE) tryGetComponentConst<const COMPONENT_TYPE>()
 
     protected:
+        void registerComponentIndex(size_t component_index);
+
         GObjectID   m_id {k_invalid_gobject_id};
         std::string m_name;
         std::string m_definition_url;
@@ -73,5 +86,13 @@ namespace Piccolo
         // we have to use the ReflectionPtr due to that the components need to be reflected 
         // in editor, and it's polymorphism
         std::vector<Reflection::ReflectionPtr<Component>> m_components;
+
+        // component type id -> index in m_components, only valid where the bit of the type id is set in the mask
+        static_assert(k_component_type_count <= 64, "component type mask is limited to 64 component types");
+        uint64_t                                     m_component_type_mask {0};
+        std::array<uint8_t, k_component_type_count> m_component_indices {};
+
+        // when set, pooled component types live in the level's component store instead of the heap
+        std::shared_ptr<ComponentStore> m_component_store;
     };
 } // namespace Piccolo
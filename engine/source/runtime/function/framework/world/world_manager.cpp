@@ -1,6 +1,7 @@
 #include "runtime/function/framework/world/world_manager.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/profile/profiler.h"
 
 #include "runtime/resource/asset_manager/asset_manager.h"
 #include "runtime/resource/config_manager/config_manager.h"
@@ -8,6 +9,7 @@
 #include "runtime/function/framework/level/level.h"
 #include "runtime/function/global/global_context.h"
 #include "runtime/function/framework/level/level_debugger.h"
+#include "runtime/function/render/render_system.h"
 
 #include "_generated/serializer/all_serializer.h"
 
@@ -26,6 +28,12 @@ namespace Piccolo
 
     void WorldManager::clear()
     {
+        if (m_pending_level)
+        {
+            m_pending_level->unload();
+            m_pending_level.reset();
+        }
+
         // unload all loaded levels
         for (auto level_pair : m_loaded_levels)
         {
@@ -46,11 +54,18 @@ namespace Piccolo
 
     void WorldManager::tick(float delta_time)
     {
+        PICCOLO_PROFILE_ZONE("WorldManager::tick");
+
         if (!m_is_world_loaded)
         {
             loadWorld(m_current_world_url);
         }
 
+        if (m_pending_level)
+        {
+            updatePendingLevel();
+        }
+
         // tick the active level
         std::shared_ptr<Level> active_level = m_current_active_level.lock();
         if (active_level)
@@ -107,11 +122,8 @@ namespace Piccolo
         // set current level temporary
         m_current_active_level       = level;
 
-        const bool is_level_load_success = level->load(level_url);
-        if (is_level_load_success == false)
-        {
-            return false;
-        }
+        // the level publishes its objects in its own ticks once the streaming thread has read the resources
+        level->loadAsync(level_url);
 
         m_loaded_levels.emplace(level_url, level);
 
@@ -127,24 +139,75 @@ namespace Piccolo
             return;
         }
 
-        const std::string level_url = active_level->getLevelResUrl();
-        active_level->unload();
-        m_loaded_levels.erase(level_url);
+        if (m_pending_level)
+        {
+            LOG_WARN("level {} is already reloading", m_pending_level->getLevelResUrl());
+            return;
+        }
+
+        // the current level keeps ticking until the new instance has its resources in memory
+        m_pending_level = std::make_shared<Level>();
+        m_pending_level->loadAsync(active_level->getLevelResUrl());
+    }
 
-        const bool is_load_success = loadLevel(level_url);
-        if (!is_load_success)
+    void WorldManager::updatePendingLevel()
+    {
+        const LevelLoadingStage loading_stage = m_pending_level->getLoadingStage();
+        if (loading_stage == LevelLoadingStage::LoadingResources)
+        {
+            return;
+        }
+
+        const std::string level_url = m_pending_level->getLevelResUrl();
+        if (loading_stage == LevelLoadingStage::Failed)
         {
             LOG_ERROR("load level failed {}", level_url);
+            m_pending_level->unload();
+            m_pending_level.reset();
             return;
         }
 
-        // update the active level instance
-        auto iter = m_loaded_levels.find(level_url);
-        ASSERT(iter != m_loaded_levels.end());
+        auto active_level = m_current_active_level.lock();
+        if (active_level)
+        {
+            active_level->unload();
+            m_loaded_levels.erase(active_level->getLevelResUrl());
+        }
 
-        m_current_active_level = iter->second;
+        // the render scene is cleared by the render side, which may run on the render thread
+        if (g_runtime_global_context.m_render_system)
+        {
+            g_runtime_global_context.m_render_system->getSwapContext().getLogicSwapData().clearForLevelReloading();
+        }
 
-        LOG_INFO("reload current evel succeed");
+        // update the active level instance, it publishes its objects from the next tick on
+        m_loaded_levels[level_url] = m_pending_level;
+        m_current_active_level     = m_pending_level;
+        m_pending_level.reset();
+
+        LOG_INFO("reload current level succeed");
+    }
+
+    bool WorldManager::isLevelLoading() const
+    {
+        if (m_pending_level)
+        {
+            return true;
+        }
+
+        std::shared_ptr<Level> active_level = m_current_active_level.lock();
+        return active_level && active_level->isLoading();
+    }
+
+    float WorldManager::getLevelLoadingProgress() const
+    {
+        if (m_pending_level)
+        {
+            return m_pending_level->getLoadingProgress();
+        }
+
+        std::shared_ptr<Level> active_level = m_current_active_level.lock();
+        return active_level ? active_level->getLoadingProgress() : 0.f;
     }
 
     void WorldManager::saveCurrentLevel()
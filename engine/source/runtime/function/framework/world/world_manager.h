@@ -21,9 +21,16 @@ namespace Piccolo
         void initialize();
         void clear();
 
+        /// streams the level in again while the current one keeps running, the levels are switched once the new
+        /// one has its resources loaded
         void reloadCurrentLevel();
         void saveCurrentLevel();
 
+        /// whether the active level or a reloaded level is still streaming in
+        bool isLevelLoading() const;
+        /// 0 to 1, progress of the level that is streaming in
+        float getLevelLoadingProgress() const;
+
         void                 tick(float delta_time);
         std::weak_ptr<Level> getCurrentActiveLevel() const { return m_current_active_level; }
 
@@ -32,6 +39,7 @@ namespace Piccolo
     private:
         bool loadWorld(const std::string& world_url);
         bool loadLevel(const std::string& level_url);
+        void updatePendingLevel();
 
         bool                      m_is_world_loaded {false};
         std::string               m_current_world_url;
@@ -41,6 +49,8 @@ namespace Piccolo
         std::unordered_map<std::string, std::shared_ptr<Level>> m_loaded_levels;
         // active level, currently we just support one active level
         std::weak_ptr<Level> m_current_active_level;
+        // level streamed in by reloadCurrentLevel, replaces the active level when its resources are loaded
+        std::shared_ptr<Level> m_pending_level;
 
         //debug level
         std::shared_ptr<LevelDebugger> m_level_debugger;
@@ -1,5 +1,6 @@
 #include "runtime/function/global/global_context.h"
 
+#include "core/job/job_system.h"
 #include "core/log/log_system.h"
 
 #include "runtime/engine.h"
@@ -10,6 +11,7 @@
 #include "runtime/resource/config_manager/config_manager.h"
 
 #include "runtime/engine.h"
+#include "runtime/function/framework/component/lua/lua_vm_pool.h"
 #include "runtime/function/framework/world/world_manager.h"
 #include "runtime/function/input/input_system.h"
 #include "runtime/function/particle/particle_manager.h"
@@ -23,7 +25,7 @@ namespace Piccolo
 {
     RuntimeGlobalContext g_runtime_global_context;
 
-    void RuntimeGlobalContext::startSystems(const std::string& config_file_path)
+    void RuntimeGlobalContext::startSystems(const std::string& config_file_path, bool is_headless)
     {
         m_config_manager = std::make_shared<ConfigManager>();
         m_config_manager->initialize(config_file_path);
@@ -32,17 +34,26 @@ namespace Piccolo
 
         m_logger_system = std::make_shared<LogSystem>();
 
+        m_job_system = std::make_shared<JobSystem>();
+        m_job_system->initialize();
+
         m_asset_manager = std::make_shared<AssetManager>();
 
         m_physics_manager = std::make_shared<PhysicsManager>();
         m_physics_manager->initialize();
 
+        m_lua_vm_pool = std::make_shared<LuaVMPool>();
+        m_lua_vm_pool->initialize();
+
         m_world_manager = std::make_shared<WorldManager>();
         m_world_manager->initialize();
 
-        m_window_system = std::make_shared<WindowSystem>();
-        WindowCreateInfo window_create_info;
-        m_window_system->initialize(window_create_info);
+        if (!is_headless)
+        {
+            m_window_system = std::make_shared<WindowSystem>();
+            WindowCreateInfo window_create_info;
+            m_window_system->initialize(window_create_info);
+        }
 
         m_input_system = std::make_shared<InputSystem>();
         m_input_system->initialize();
@@ -53,6 +64,7 @@ namespace Piccolo
         m_render_system = std::make_shared<RenderSystem>();
         RenderSystemInitInfo render_init_info;
         render_init_info.window_system = m_window_system;
+        render_init_info.is_headless   = is_headless;
         m_render_system->initialize(render_init_info);
 
         m_debugdraw_manager = std::make_shared<DebugDrawManager>();
@@ -75,6 +87,10 @@ namespace Piccolo
         m_world_manager->clear();
         m_world_manager.reset();
 
+        // after the world, the lua components hold references into the pooled states
+        m_lua_vm_pool->clear();
+        m_lua_vm_pool.reset();
+
         m_physics_manager->clear();
         m_physics_manager.reset();
 
@@ -83,6 +99,9 @@ namespace Piccolo
 
         m_asset_manager.reset();
 
+        m_job_system->clear();
+        m_job_system.reset();
+
         m_logger_system.reset();
 
         m_file_system.reset();
@@ -6,6 +6,7 @@
 namespace Piccolo
 {
     class LogSystem;
+    class JobSystem;
     class InputSystem;
     class PhysicsManager;
     class FileSystem;
@@ -17,6 +18,7 @@ namespace Piccolo
     class ParticleManager;
     class DebugDrawManager;
     class RenderDebugConfig;
+    class LuaVMPool;
 
     struct EngineInitParams;
 
@@ -24,13 +26,15 @@ namespace Piccolo
     class RuntimeGlobalContext
     {
     public:
-        // create all global systems and initialize these systems
-        void startSystems(const std::string& config_file_path);
+        // create all global systems and initialize these systems,
+        // a headless context has no window and renders through the null rhi
+        void startSystems(const std::string& config_file_path, bool is_headless = false);
         // destroy all global systems
         void shutdownSystems();
 
     public:
         std::shared_ptr<LogSystem>         m_logger_system;
+        std::shared_ptr<JobSystem>         m_job_system;
         std::shared_ptr<InputSystem>       m_input_system;
         std::shared_ptr<FileSystem>        m_file_system;
         std::shared_ptr<AssetManager>      m_asset_manager;
@@ -42,6 +46,7 @@ namespace Piccolo
         std::shared_ptr<ParticleManager>   m_particle_manager;
         std::shared_ptr<DebugDrawManager>  m_debugdraw_manager;
         std::shared_ptr<RenderDebugConfig> m_render_debug_config;
+        std::shared_ptr<LuaVMPool>         m_lua_vm_pool;
     };
 
     extern RuntimeGlobalContext g_runtime_global_context;
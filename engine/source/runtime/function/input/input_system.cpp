@@ -120,7 +120,13 @@ namespace Piccolo
 
     void InputSystem::calculateCursorDeltaAngles()
     {
-        std::array<int, 2> window_size = g_runtime_global_context.m_window_system->getWindowSize();
+        std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
+        if (!window_system)
+        {
+            return;
+        }
+
+        std::array<int, 2> window_size = window_system->getWindowSize();
 
         if (window_size[0] < 1 || window_size[1] < 1)
         {
@@ -139,8 +145,12 @@ namespace Piccolo
 
     void InputSystem::initialize()
     {
+        // headless engines run without a window and never receive input
         std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
-        ASSERT(window_system);
+        if (!window_system)
+        {
+            return;
+        }
 
         window_system->registerOnKeyFunc(std::bind(&InputSystem::onKey,
                                                    this,
@@ -158,7 +168,7 @@ namespace Piccolo
         clear();
 
         std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
-        if (window_system->getFocusMode())
+        if (window_system && window_system->getFocusMode())
         {
             m_game_command &= (k_complement_control_command ^ (unsigned int)GameCommand::invalid);
         }
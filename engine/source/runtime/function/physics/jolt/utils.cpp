@@ -1,5 +1,7 @@
 #include "runtime/function/physics/jolt/utils.h"
 
+#include "runtime/core/base/hash.h"
+
 #include "runtime/resource/res_type/components/rigid_body.h"
 
 #include "Jolt/Physics/Collision/Shape/BoxShape.h"
@@ -7,6 +9,8 @@
 #include "Jolt/Physics/Collision/Shape/SphereShape.h"
 #include "Jolt/Physics/Collision/Shape/StaticCompoundShape.h"
 
+#include <cmath>
+
 namespace Piccolo
 {
     BPLayerInterfaceImpl::BPLayerInterfaceImpl()
@@ -112,9 +116,9 @@ namespace Piccolo
         return Matrix4x4(cols[0], cols[1], cols[2], cols[3]).transpose();
     }
 
-    JPH::Shape* toShape(const RigidBodyShape& shape, const Vector3& scale)
+    ShapeGeometry toShapeGeometry(const RigidBodyShape& shape, const Vector3& scale)
     {
-        JPH::Shape* jph_shape = nullptr;
+        ShapeGeometry geometry;
 
         const std::string shape_type_str = shape.m_geometry.getTypeName();
         if (shape_type_str == "Box")
@@ -122,10 +126,8 @@ namespace Piccolo
             const Box* box_geometry = static_cast<const Box*>(shape.m_geometry.getPtr());
             if (box_geometry)
             {
-                JPH::Vec3 jph_box(scale.x * box_geometry->m_half_extents.x,
-                                  scale.y * box_geometry->m_half_extents.y,
-                                  scale.z * box_geometry->m_half_extents.z);
-                jph_shape = new JPH::BoxShape(jph_box, 0.f);
+                geometry.m_type = RigidBodyShapeType::box;
+                geometry.m_size = scale * box_geometry->m_half_extents;
             }
         }
         else if (shape_type_str == "Sphere")
@@ -133,8 +135,8 @@ namespace Piccolo
             const Sphere* sphere_geometry = static_cast<const Sphere*>(shape.m_geometry.getPtr());
             if (sphere_geometry)
             {
-                jph_shape = new JPH::SphereShape((scale.x + scale.y + scale.z) / 3 *
-                                                 sphere_geometry->m_radius);
+                geometry.m_type   = RigidBodyShapeType::sphere;
+                geometry.m_size.x = (scale.x + scale.y + scale.z) / 3 * sphere_geometry->m_radius;
             }
         }
         else if (shape_type_str == "Capsule")
@@ -142,8 +144,9 @@ namespace Piccolo
             const Capsule* capsule_geometry = static_cast<const Capsule*>(shape.m_geometry.getPtr());
             if (capsule_geometry)
             {
-                jph_shape = new JPH::CapsuleShape(scale.z * capsule_geometry->m_half_height,
-                                                  (scale.x + scale.y) / 2 * capsule_geometry->m_radius);
+                geometry.m_type   = RigidBodyShapeType::capsule;
+                geometry.m_size.x = scale.z * capsule_geometry->m_half_height;
+                geometry.m_size.y = (scale.x + scale.y) / 2 * capsule_geometry->m_radius;
             }
         }
         else
@@ -151,7 +154,71 @@ namespace Piccolo
             LOG_ERROR("Unsupported Shape")
         }
 
-        return jph_shape;
+        return geometry;
+    }
+
+    JPH::Shape* toShape(const ShapeGeometry& geometry)
+    {
+        switch (geometry.m_type)
+        {
+            case RigidBodyShapeType::box:
+                return new JPH::BoxShape(toVec3(geometry.m_size), 0.f);
+            case RigidBodyShapeType::sphere:
+                return new JPH::SphereShape(geometry.m_size.x);
+            case RigidBodyShapeType::capsule:
+                return new JPH::CapsuleShape(geometry.m_size.x, geometry.m_size.y);
+            default:
+                return nullptr;
+        }
+    }
+
+    JPH::Shape* toShape(const RigidBodyShape& shape, const Vector3& scale)
+    {
+        return toShape(toShapeGeometry(shape, scale));
+    }
+
+    bool ShapeCache::Key::operator==(const Key& other) const
+    {
+        return m_type == other.m_type && m_size[0] == other.m_size[0] && m_size[1] == other.m_size[1] &&
+               m_size[2] == other.m_size[2];
+    }
+
+    size_t ShapeCache::KeyHash::operator()(const Key& key) const
+    {
+        size_t hash = 0;
+        hash_combine(hash, static_cast<uint8_t>(key.m_type));
+        for (int32_t size : key.m_size)
+        {
+            hash_combine(hash, size);
+        }
+        return hash;
+    }
+
+    const JPH::Shape* ShapeCache::getShape(const RigidBodyShape& shape, const Vector3& scale)
+    {
+        const ShapeGeometry geometry = toShapeGeometry(shape, scale);
+        if (geometry.m_type == RigidBodyShapeType::invalid)
+        {
+            return nullptr;
+        }
+
+        const Key key {geometry.m_type,
+                       {static_cast<int32_t>(std::lround(geometry.m_size.x * 10000.f)),
+                        static_cast<int32_t>(std::lround(geometry.m_size.y * 10000.f)),
+                        static_cast<int32_t>(std::lround(geometry.m_size.z * 10000.f))}};
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            auto                                iter = m_shapes.find(key);
+            if (iter != m_shapes.end())
+            {
+                return iter->second.GetPtr();
+            }
+        }
+
+        // another query may have created the same shape meanwhile, the first one is kept
+        JPH::Ref<JPH::Shape>                jph_shape = toShape(geometry);
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        return m_shapes.emplace(key, jph_shape).first->second.GetPtr();
     }
 
 } // namespace Piccolo
@@ -5,10 +5,16 @@
 #include "core/math/quaternion.h"
 #include "core/math/vector3.h"
 
+#include "runtime/resource/res_type/components/rigid_body.h"
+
 #include "Jolt/Jolt.h"
 
+#include "Jolt/Core/Reference.h"
 #include "Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h"
 
+#include <shared_mutex>
+#include <unordered_map>
+
 namespace JPH
 {
     class Shape;
@@ -16,7 +22,6 @@ namespace JPH
 
 namespace Piccolo
 {
-    class RigidBodyShape;
 
     namespace Layers
     {
@@ -84,6 +89,45 @@ namespace Piccolo
 
     Matrix4x4 toMat44(const JPH::Mat44& m);
 
+    /// the type and scaled size of a rigid body shape, what its jolt shape is created from
+    struct ShapeGeometry
+    {
+        RigidBodyShapeType m_type {RigidBodyShapeType::invalid};
+        // box: half extents, sphere: radius in x, capsule: half height in x and radius in y
+        Vector3 m_size {Vector3::ZERO};
+    };
+
+    ShapeGeometry toShapeGeometry(const RigidBodyShape& shape, const Vector3& scale);
+
+    JPH::Shape* toShape(const ShapeGeometry& geometry);
+
     JPH::Shape* toShape(const RigidBodyShape& shape, const Vector3& scale);
 
+    /// Jolt shapes of the rigid body shapes used by scene queries, converted once per geometry and scale. Sizes are
+    /// compared at a tenth of a millimeter so that scales decomposed from matrices still find their shape
+    class ShapeCache
+    {
+    public:
+        /// safe from parallel queries, the shape lives as long as the cache
+        /// @return: nullptr for unsupported shapes
+        const JPH::Shape* getShape(const RigidBodyShape& shape, const Vector3& scale);
+
+    private:
+        struct Key
+        {
+            RigidBodyShapeType m_type;
+            int32_t            m_size[3];
+
+            bool operator==(const Key& other) const;
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const;
+        };
+
+        std::shared_mutex                                      m_mutex;
+        std::unordered_map<Key, JPH::Ref<JPH::Shape>, KeyHash> m_shapes;
+    };
+
 } // namespace Piccolo
\ No newline at end of file
@@ -15,13 +15,23 @@ namespace Piccolo
         uint32_t m_max_body_pairs {65536};
         uint32_t m_max_contact_constraints {10240};
 
-        // job setting
+        // job setting, of the job system the physics manager shares between all scenes
         uint32_t m_max_job_count {1024};
         uint32_t m_max_barrier_count {8};
-        uint32_t m_max_concurrent_job_count {4};
+        // -1 uses the hardware concurrency minus the thread that updates the scenes
+        int32_t m_worker_thread_count {-1};
+
+        // memory a scene update may allocate temporarily, per scene updating at the same time
+        uint32_t m_temp_allocator_size {16 * 1024 * 1024};
 
         Vector3 m_gravity {0.f, 0.f, -9.8f};
 
+        // the scene is simulated in fixed steps of 1 / m_update_frequency seconds
         float m_update_frequency {60.f};
+        // steps one frame may take at most, the time of longer frames is dropped instead of solving ever more steps
+        uint32_t m_max_steps_per_frame {4};
+        // collision detection passes and integration substeps per step
+        int m_collision_steps {1};
+        int m_integration_substeps {1};
     };
 } // namespace Piccolo
@@ -8,6 +8,13 @@
 #include "runtime/function/physics/physics_scene.h"
 #include "runtime/function/render/render_system.h"
 
+#include "Jolt/Jolt.h"
+#include "Jolt/RegisterTypes.h"
+
+#include "Jolt/Core/Factory.h"
+#include "Jolt/Core/JobSystemThreadPool.h"
+#include "Jolt/Core/TempAllocator.h"
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
 #include "TestFramework.h"
 
@@ -21,6 +28,14 @@ namespace Piccolo
 {
     void PhysicsManager::initialize()
     {
+        // the factory is process wide, every scene creates its shapes through it
+        JPH::Factory::sInstance = new JPH::Factory();
+        JPH::RegisterTypes();
+
+        m_jolt_job_system = new JPH::JobSystemThreadPool(
+            m_config.m_max_job_count, m_config.m_max_barrier_count, m_config.m_worker_thread_count);
+        m_jolt_broad_phase_layer_interface = new BPLayerInterfaceImpl();
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         std::shared_ptr<ConfigManager> config_manager = g_runtime_global_context.m_config_manager;
         ASSERT(config_manager);
@@ -41,6 +56,25 @@ namespace Piccolo
     {
         m_scenes.clear();
 
+        {
+            std::lock_guard<std::mutex> lock(m_temp_allocator_mutex);
+            ASSERT(m_free_temp_allocators.size() == m_temp_allocators.size());
+            for (JPH::TempAllocator* temp_allocator : m_temp_allocators)
+            {
+                delete temp_allocator;
+            }
+            m_temp_allocators.clear();
+            m_free_temp_allocators.clear();
+        }
+
+        delete m_jolt_job_system;
+        m_jolt_job_system = nullptr;
+        delete m_jolt_broad_phase_layer_interface;
+        m_jolt_broad_phase_layer_interface = nullptr;
+
+        delete JPH::Factory::sInstance;
+        JPH::Factory::sInstance = nullptr;
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         delete m_debug_renderer;
         m_font = nullptr;
@@ -68,6 +102,32 @@ namespace Piccolo
         }
     }
 
+    const JPH::BroadPhaseLayerInterface& PhysicsManager::getBroadPhaseLayerInterface() const
+    {
+        return *m_jolt_broad_phase_layer_interface;
+    }
+
+    JPH::TempAllocator* PhysicsManager::acquireTempAllocator()
+    {
+        std::lock_guard<std::mutex> lock(m_temp_allocator_mutex);
+        if (m_free_temp_allocators.empty())
+        {
+            JPH::TempAllocator* temp_allocator = new JPH::TempAllocatorImpl(m_config.m_temp_allocator_size);
+            m_temp_allocators.push_back(temp_allocator);
+            return temp_allocator;
+        }
+
+        JPH::TempAllocator* temp_allocator = m_free_temp_allocators.back();
+        m_free_temp_allocators.pop_back();
+        return temp_allocator;
+    }
+
+    void PhysicsManager::releaseTempAllocator(JPH::TempAllocator* temp_allocator)
+    {
+        std::lock_guard<std::mutex> lock(m_temp_allocator_mutex);
+        m_free_temp_allocators.push_back(temp_allocator);
+    }
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
     void PhysicsManager::renderPhysicsWorld(float delta_time)
     {
@@ -2,9 +2,19 @@
 
 #include "runtime/core/math/vector3.h"
 
+#include "runtime/function/physics/physics_config.h"
+
 #include <memory>
+#include <mutex>
 #include <vector>
 
+namespace JPH
+{
+    class JobSystem;
+    class TempAllocator;
+    class BroadPhaseLayerInterface;
+} // namespace JPH
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
 class Renderer;
 class Font;
@@ -19,6 +29,8 @@ namespace Piccolo
 {
     class PhysicsScene;
 
+    /// Owns the jolt runtime shared by all physics scenes of the process: the type factory, one job system and a
+    /// pool of temp allocators. Creating or reloading a level only creates the physics system of its scene
     class PhysicsManager
     {
     public:
@@ -28,6 +40,13 @@ namespace Piccolo
         std::weak_ptr<PhysicsScene> createPhysicsScene(const Vector3& gravity);
         void                        deletePhysicsScene(std::weak_ptr<PhysicsScene> physics_scene);
 
+        JPH::JobSystem*                      getJobSystem() const { return m_jolt_job_system; }
+        const JPH::BroadPhaseLayerInterface& getBroadPhaseLayerInterface() const;
+
+        /// lends a temp allocator to a scene update, scenes updating at the same time get different allocators
+        JPH::TempAllocator* acquireTempAllocator();
+        void                releaseTempAllocator(JPH::TempAllocator* temp_allocator);
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         void renderPhysicsWorld(float delta_time);
 #endif
@@ -35,6 +54,15 @@ namespace Piccolo
     protected:
         std::vector<std::shared_ptr<PhysicsScene>> m_scenes;
 
+        PhysicsConfig m_config;
+
+        JPH::JobSystem*                m_jolt_job_system {nullptr};
+        JPH::BroadPhaseLayerInterface* m_jolt_broad_phase_layer_interface {nullptr};
+
+        std::mutex                       m_temp_allocator_mutex;
+        std::vector<JPH::TempAllocator*> m_temp_allocators;
+        std::vector<JPH::TempAllocator*> m_free_temp_allocators;
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         Renderer* m_renderer {nullptr};
         Font*     m_font {nullptr};
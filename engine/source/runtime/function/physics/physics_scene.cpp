@@ -1,18 +1,19 @@
 #include "runtime/function/physics/physics_scene.h"
 
 #include "core/base/macro.h"
+#include "core/job/job_system.h"
+#include "core/profile/profiler.h"
 
 #include "runtime/resource/res_type/components/rigid_body.h"
 
+#include "runtime/function/global/global_context.h"
 #include "runtime/function/physics/jolt/utils.h"
 #include "runtime/function/physics/physics_config.h"
+#include "runtime/function/physics/physics_manager.h"
 
 #include "Jolt/Jolt.h"
-#include "Jolt/RegisterTypes.h"
 
-#include "Jolt/Core/Factory.h"
 #include "Jolt/Core/JobSystem.h"
-#include "Jolt/Core/JobSystemThreadPool.h"
 #include "Jolt/Core/TempAllocator.h"
 
 #include "Jolt/Physics/Body/BodyCreationSettings.h"
@@ -29,31 +30,75 @@
 #include "Jolt/Physics/Collision/ShapeCast.h"
 #include "Jolt/Physics/PhysicsSystem.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Piccolo
 {
-    PhysicsScene::PhysicsScene(const Vector3& gravity)
+    namespace
     {
-        static_assert(s_invalid_rigidbody_id == JPH::BodyID::cInvalidBodyID);
+        // queries per job of a batch, a query costs a few microseconds
+        constexpr uint32_t k_query_batch_size = 32;
 
-        JPH::Factory::sInstance = new JPH::Factory();
-        JPH::RegisterTypes();
+        JPH::RayCast toRayCast(const Vector3& ray_origin, const Vector3& ray_direction, float ray_length)
+        {
+            JPH::RayCast ray;
+            ray.mOrigin    = toVec3(ray_origin);
+            ray.mDirection = toVec3(ray_direction.normalisedCopy() * ray_length);
+            return ray;
+        }
 
-        m_physics.m_jolt_physics_system              = new JPH::PhysicsSystem();
-        m_physics.m_jolt_broad_phase_layer_interface = new BPLayerInterfaceImpl();
+        PhysicsHitInfo toHitInfo(const JPH::PhysicsSystem& physics_system,
+                                 const JPH::RayCast&       ray,
+                                 float                     ray_length,
+                                 const JPH::RayCastResult& cast_result)
+        {
+            PhysicsHitInfo hit;
+            hit.hit_position = toVec3(ray.mOrigin + cast_result.mFraction * ray.mDirection);
+            hit.hit_distance = cast_result.mFraction * ray_length;
+            hit.body_id      = cast_result.mBodyID.GetIndexAndSequenceNumber();
 
-        m_physics.m_jolt_job_system =
-            new JPH::JobSystemThreadPool(m_config.m_max_job_count,
-                                         m_config.m_max_barrier_count,
-                                         static_cast<int>(m_config.m_max_concurrent_job_count));
+            // get hit normal
+            JPH::BodyLockRead body_lock(physics_system.GetBodyLockInterface(), cast_result.mBodyID);
+            const JPH::Body&  hit_body = body_lock.GetBody();
 
-        // 16M temp memory
-        m_physics.m_temp_allocator = new JPH::TempAllocatorImpl(16 * 1024 * 1024);
+            hit.hit_normal =
+                toVec3(hit_body.GetWorldSpaceSurfaceNormal(cast_result.mSubShapeID2, toVec3(hit.hit_position)));
+            return hit;
+        }
+
+        PhysicsHitInfo toHitInfo(const JPH::ShapeCastResult& sweep_result, float sweep_length)
+        {
+            PhysicsHitInfo hit;
+            hit.hit_position = toVec3(sweep_result.mContactPointOn2);
+            hit.hit_normal   = toVec3(sweep_result.mPenetrationAxis.Normalized());
+            hit.hit_distance = sweep_result.mFraction * sweep_length;
+            hit.body_id      = sweep_result.mBodyID2.GetIndexAndSequenceNumber();
+            return hit;
+        }
 
+        void resetQueryResults(size_t query_count, uint32_t max_hits_per_query, PhysicsQueryResults& out_results)
+        {
+            out_results.m_max_hits_per_query = max_hits_per_query;
+            out_results.m_hit_counts.assign(query_count, 0);
+            out_results.m_hits.resize(query_count * max_hits_per_query);
+        }
+    } // namespace
+
+    PhysicsScene::PhysicsScene(const Vector3& gravity) : m_shape_cache(std::make_unique<ShapeCache>())
+    {
+        static_assert(s_invalid_rigidbody_id == JPH::BodyID::cInvalidBodyID);
+
+        // the factory, job system and temp allocators are shared by all scenes and owned by the physics manager
+        std::shared_ptr<PhysicsManager> physics_manager = g_runtime_global_context.m_physics_manager;
+        ASSERT(physics_manager);
+
+        m_physics.m_jolt_physics_system = new JPH::PhysicsSystem();
         m_physics.m_jolt_physics_system->Init(m_config.m_max_body_count,
                                               m_config.m_body_mutex_count,
                                               m_config.m_max_body_pairs,
                                               m_config.m_max_contact_constraints,
-                                              *(m_physics.m_jolt_broad_phase_layer_interface),
+                                              physics_manager->getBroadPhaseLayerInterface(),
                                               BroadPhaseCanCollide,
                                               ObjectCanCollide);
         // use the default setting
@@ -66,12 +111,6 @@ namespace Piccolo
     PhysicsScene::~PhysicsScene()
     {
         delete m_physics.m_jolt_physics_system;
-        delete m_physics.m_jolt_job_system;
-        delete m_physics.m_temp_allocator;
-        delete m_physics.m_jolt_broad_phase_layer_interface;
-
-        delete JPH::Factory::sInstance;
-        JPH::Factory::sInstance = nullptr;
     }
 
     uint32_t PhysicsScene::createRigidBody(const Transform&             global_transform,
@@ -151,7 +190,11 @@ namespace Piccolo
         return jph_body->GetID().GetIndexAndSequenceNumber();
     }
 
-    void PhysicsScene::removeRigidBody(uint32_t body_id) { m_pending_remove_bodies.push_back(body_id); }
+    void PhysicsScene::removeRigidBody(uint32_t body_id)
+    {
+        std::lock_guard<std::mutex> lock(m_pending_remove_mutex);
+        m_pending_remove_bodies.push_back(body_id);
+    }
 
     void PhysicsScene::updateRigidBodyGlobalTransform(uint32_t body_id, const Transform& global_transform)
     {
@@ -165,24 +208,104 @@ namespace Piccolo
 
     void PhysicsScene::tick(float delta_time)
     {
+        PICCOLO_PROFILE_ZONE("PhysicsScene::tick");
+
         const float time_step = 1.f / m_config.m_update_frequency;
 
-        m_physics.m_jolt_physics_system->Update(time_step,
-                                                m_physics.m_collision_steps,
-                                                m_physics.m_integration_substeps,
-                                                m_physics.m_temp_allocator,
-                                                m_physics.m_jolt_job_system);
+        m_accumulated_time += delta_time;
+        uint32_t step_count = static_cast<uint32_t>(m_accumulated_time / time_step);
+        if (step_count > m_config.m_max_steps_per_frame)
+        {
+            // a spike is simulated slower than real time rather than with steps the contacts cannot be solved in
+            step_count         = m_config.m_max_steps_per_frame;
+            m_accumulated_time = step_count * time_step + std::fmod(m_accumulated_time, time_step);
+        }
 
-        JPH::BodyInterface& body_interface = m_physics.m_jolt_physics_system->GetBodyInterface();
+        if (step_count > 0)
+        {
+            std::shared_ptr<PhysicsManager> physics_manager = g_runtime_global_context.m_physics_manager;
+            // only held during the update, scenes updating one after the other reuse the same allocator
+            JPH::TempAllocator* temp_allocator = physics_manager->acquireTempAllocator();
+            for (uint32_t step_index = 0; step_index < step_count; ++step_index)
+            {
+                if (step_index + 1 == step_count)
+                {
+                    for (auto& id_transform_pair : m_moving_body_transforms)
+                    {
+                        MovingBodyTransform& body_transform = id_transform_pair.second;
+                        body_transform.m_previous_position  = body_transform.m_position;
+                        body_transform.m_previous_rotation  = body_transform.m_rotation;
+                    }
+                }
+
+                m_physics.m_jolt_physics_system->Update(time_step,
+                                                        m_config.m_collision_steps,
+                                                        m_config.m_integration_substeps,
+                                                        temp_allocator,
+                                                        physics_manager->getJobSystem());
+            }
+            physics_manager->releaseTempAllocator(temp_allocator);
+
+            m_accumulated_time -= step_count * time_step;
+            updateMovingBodyTransforms();
+        }
+        m_interpolation_alpha = std::min(m_accumulated_time / time_step, 1.f);
+
+        JPH::BodyInterface&         body_interface = m_physics.m_jolt_physics_system->GetBodyInterface();
+        std::lock_guard<std::mutex> lock(m_pending_remove_mutex);
         for (uint32_t body_id : m_pending_remove_bodies)
         {
             LOG_INFO("Remove Body {}", body_id)
             body_interface.RemoveBody(JPH::BodyID(body_id));
             body_interface.DestroyBody(JPH::BodyID(body_id));
+            m_moving_body_transforms.erase(body_id);
         }
         m_pending_remove_bodies.clear();
     }
 
+    void PhysicsScene::updateMovingBodyTransforms()
+    {
+        // only active bodies move, sleeping ones keep their last transform
+        JPH::BodyIDVector active_body_ids;
+        m_physics.m_jolt_physics_system->GetActiveBodies(active_body_ids);
+
+        const JPH::BodyInterface& body_interface = m_physics.m_jolt_physics_system->GetBodyInterface();
+        for (const JPH::BodyID& body_id : active_body_ids)
+        {
+            JPH::Vec3 position;
+            JPH::Quat rotation;
+            body_interface.GetPositionAndRotation(body_id, position, rotation);
+
+            auto iter = m_moving_body_transforms.find(body_id.GetIndexAndSequenceNumber());
+            if (iter == m_moving_body_transforms.end())
+            {
+                // nothing to interpolate from in the first step the body moved
+                iter = m_moving_body_transforms
+                           .emplace(body_id.GetIndexAndSequenceNumber(),
+                                    MovingBodyTransform {toVec3(position), toQuat(rotation)})
+                           .first;
+            }
+            iter->second.m_position = toVec3(position);
+            iter->second.m_rotation = toQuat(rotation);
+        }
+    }
+
+    bool PhysicsScene::getInterpolatedTransform(uint32_t body_id, Transform& out_transform) const
+    {
+        auto iter = m_moving_body_transforms.find(body_id);
+        if (iter == m_moving_body_transforms.end())
+        {
+            return false;
+        }
+
+        const MovingBodyTransform& body_transform = iter->second;
+        out_transform.m_position =
+            Vector3::lerp(body_transform.m_previous_position, body_transform.m_position, m_interpolation_alpha);
+        out_transform.m_rotation = Quaternion::nLerp(
+            m_interpolation_alpha, body_transform.m_previous_rotation, body_transform.m_rotation, true);
+        return true;
+    }
+
     bool PhysicsScene::raycast(Vector3                      ray_origin,
                                Vector3                      ray_directory,
                                float                        ray_length,
@@ -190,9 +313,7 @@ namespace Piccolo
     {
         const JPH::NarrowPhaseQuery& scene_query = m_physics.m_jolt_physics_system->GetNarrowPhaseQuery();
 
-        JPH::RayCast ray;
-        ray.mOrigin    = toVec3(ray_origin);
-        ray.mDirection = toVec3(ray_directory.normalisedCopy() * ray_length);
+        const JPH::RayCast ray = toRayCast(ray_origin, ray_directory, ray_length);
 
         JPH::RayCastSettings raycast_setting;
 
@@ -207,26 +328,10 @@ namespace Piccolo
 
         collector.Sort();
 
-        std::vector<JPH::RayCastResult> raycast_results(collector.mHits.begin(), collector.mHits.end());
-
-        out_hits.clear();
-        out_hits.resize(raycast_results.size());
-
-        for (size_t index = 0; index < raycast_results.size(); index++)
+        out_hits.resize(collector.mHits.size());
+        for (size_t index = 0; index < collector.mHits.size(); index++)
         {
-            const JPH::RayCastResult& cast_result = raycast_results[index];
-
-            PhysicsHitInfo& hit = out_hits[index];
-            hit.hit_position    = toVec3(ray.mOrigin + cast_result.mFraction * ray.mDirection);
-            hit.hit_distance    = cast_result.mFraction * ray_length;
-            hit.body_id         = cast_result.mBodyID.GetIndexAndSequenceNumber();
-
-            // get hit normal
-            JPH::BodyLockRead body_lock(m_physics.m_jolt_physics_system->GetBodyLockInterface(), cast_result.mBodyID);
-            const JPH::Body&  hit_body = body_lock.GetBody();
-
-            hit.hit_normal =
-                toVec3(hit_body.GetWorldSpaceSurfaceNormal(cast_result.mSubShapeID2, toVec3(hit.hit_position)));
+            out_hits[index] = toHitInfo(*m_physics.m_jolt_physics_system, ray, ray_length, collector.mHits[index]);
         }
 
         return true;
@@ -240,15 +345,8 @@ namespace Piccolo
     {
         const JPH::NarrowPhaseQuery& scene_query = m_physics.m_jolt_physics_system->GetNarrowPhaseQuery();
 
-        const Matrix4x4 shape_global_transform = shape_transform * shape.m_local_transform.getMatrix();
-
-        Vector3    global_position, global_scale;
-        Quaternion global_rotation;
-
-        shape_global_transform.decomposition(global_position, global_scale, global_rotation);
-
-        JPH::Shape* jph_shape = toShape(shape, global_scale);
-
+        const Matrix4x4   shape_global_transform = shape_transform * shape.m_local_transform.getMatrix();
+        const JPH::Shape* jph_shape              = getQueryShape(shape, shape_global_transform);
         if (jph_shape == nullptr)
         {
             return false;
@@ -269,20 +367,10 @@ namespace Piccolo
 
         collector.Sort();
 
-        std::vector<JPH::ShapeCastResult> sweep_results(collector.mHits.begin(), collector.mHits.end());
-
-        out_hits.clear();
-        out_hits.resize(sweep_results.size());
-
-        for (size_t index = 0; index < sweep_results.size(); index++)
+        out_hits.resize(collector.mHits.size());
+        for (size_t index = 0; index < collector.mHits.size(); index++)
         {
-            const JPH::ShapeCastResult& sweep_result = sweep_results[index];
-
-            PhysicsHitInfo& hit = out_hits[index];
-            hit.hit_position    = toVec3(sweep_result.mContactPointOn2);
-            hit.hit_normal      = toVec3(sweep_result.mPenetrationAxis.Normalized());
-            hit.hit_distance    = sweep_result.mFraction * sweep_length;
-            hit.body_id         = sweep_result.mBodyID2.GetIndexAndSequenceNumber();
+            out_hits[index] = toHitInfo(collector.mHits[index], sweep_length);
         }
 
         return true;
@@ -292,15 +380,8 @@ namespace Piccolo
     {
         const JPH::NarrowPhaseQuery& scene_query = m_physics.m_jolt_physics_system->GetNarrowPhaseQuery();
 
-        const Matrix4x4 shape_global_transform = global_transform * shape.m_local_transform.getMatrix();
-
-        Vector3    global_position, global_scale;
-        Quaternion global_rotation;
-
-        shape_global_transform.decomposition(global_position, global_scale, global_rotation);
-
-        JPH::Shape* jph_shape = toShape(shape, global_scale);
-
+        const Matrix4x4   shape_global_transform = global_transform * shape.m_local_transform.getMatrix();
+        const JPH::Shape* jph_shape              = getQueryShape(shape, shape_global_transform);
         if (jph_shape == nullptr)
         {
             return false;
@@ -316,6 +397,164 @@ namespace Piccolo
         return collector.HadHit();
     }
 
+    void PhysicsScene::raycastBatch(const std::vector<PhysicsRaycastQuery>& queries,
+                                    uint32_t                                max_hits_per_query,
+                                    PhysicsQueryResults&                    out_results)
+    {
+        PICCOLO_PROFILE_ZONE("PhysicsScene::raycastBatch");
+
+        resetQueryResults(queries.size(), max_hits_per_query, out_results);
+
+        const JPH::PhysicsSystem&    physics_system = *m_physics.m_jolt_physics_system;
+        const JPH::NarrowPhaseQuery& scene_query    = physics_system.GetNarrowPhaseQuery();
+        g_runtime_global_context.m_job_system->parallelFor(
+            static_cast<uint32_t>(queries.size()), k_query_batch_size, [&](uint32_t begin, uint32_t end) {
+                // the hit storage of the collectors is reused by the queries of a job
+                JPH::ClosestHitCollisionCollector<JPH::CastRayCollector> closest_collector;
+                JPH::AllHitCollisionCollector<JPH::CastRayCollector>     all_collector;
+                for (uint32_t query_index = begin; query_index < end; ++query_index)
+                {
+                    const PhysicsRaycastQuery& query = queries[query_index];
+                    const JPH::RayCast         ray   = toRayCast(query.m_origin, query.m_direction, query.m_length);
+
+                    PhysicsHitInfo* hits      = out_results.m_hits.data() + query_index * max_hits_per_query;
+                    uint32_t&       hit_count = out_results.m_hit_counts[query_index];
+                    if (max_hits_per_query == 1)
+                    {
+                        closest_collector.Reset();
+                        scene_query.CastRay(ray, JPH::RayCastSettings(), closest_collector);
+                        if (closest_collector.HadHit())
+                        {
+                            hits[0]   = toHitInfo(physics_system, ray, query.m_length, closest_collector.mHit);
+                            hit_count = 1;
+                        }
+                        continue;
+                    }
+
+                    all_collector.Reset();
+                    scene_query.CastRay(ray, JPH::RayCastSettings(), all_collector);
+                    all_collector.Sort();
+                    hit_count = std::min(static_cast<uint32_t>(all_collector.mHits.size()), max_hits_per_query);
+                    for (uint32_t hit_index = 0; hit_index < hit_count; ++hit_index)
+                    {
+                        hits[hit_index] =
+                            toHitInfo(physics_system, ray, query.m_length, all_collector.mHits[hit_index]);
+                    }
+                }
+            });
+    }
+
+    void PhysicsScene::sweepBatch(const std::vector<PhysicsSweepQuery>& queries,
+                                  uint32_t                              max_hits_per_query,
+                                  PhysicsQueryResults&                  out_results)
+    {
+        PICCOLO_PROFILE_ZONE("PhysicsScene::sweepBatch");
+
+        resetQueryResults(queries.size(), max_hits_per_query, out_results);
+
+        const JPH::NarrowPhaseQuery& scene_query = m_physics.m_jolt_physics_system->GetNarrowPhaseQuery();
+        g_runtime_global_context.m_job_system->parallelFor(
+            static_cast<uint32_t>(queries.size()), k_query_batch_size, [&](uint32_t begin, uint32_t end) {
+                JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> closest_collector;
+                JPH::AllHitCollisionCollector<JPH::CastShapeCollector>     all_collector;
+                for (uint32_t query_index = begin; query_index < end; ++query_index)
+                {
+                    const PhysicsSweepQuery& query = queries[query_index];
+                    ASSERT(query.m_shape);
+
+                    const Matrix4x4 shape_global_transform =
+                        query.m_shape_transform * query.m_shape->m_local_transform.getMatrix();
+                    const JPH::Shape* jph_shape = getQueryShape(*query.m_shape, shape_global_transform);
+                    if (jph_shape == nullptr)
+                    {
+                        continue;
+                    }
+
+                    const Vector3        sweep = query.m_direction.normalisedCopy() * query.m_length;
+                    const JPH::ShapeCast shape_cast =
+                        JPH::ShapeCast::sFromWorldTransform(jph_shape,
+                                                            JPH::Vec3::sReplicate(1.f),
+                                                            toMat44(shape_global_transform),
+                                                            toVec3(sweep));
+
+                    PhysicsHitInfo* hits      = out_results.m_hits.data() + query_index * max_hits_per_query;
+                    uint32_t&       hit_count = out_results.m_hit_counts[query_index];
+                    if (max_hits_per_query == 1)
+                    {
+                        closest_collector.Reset();
+                        scene_query.CastShape(shape_cast, JPH::ShapeCastSettings(), closest_collector);
+                        if (closest_collector.HadHit())
+                        {
+                            hits[0]   = toHitInfo(closest_collector.mHit, query.m_length);
+                            hit_count = 1;
+                        }
+                        continue;
+                    }
+
+                    all_collector.Reset();
+                    scene_query.CastShape(shape_cast, JPH::ShapeCastSettings(), all_collector);
+                    all_collector.Sort();
+                    hit_count = std::min(static_cast<uint32_t>(all_collector.mHits.size()), max_hits_per_query);
+                    for (uint32_t hit_index = 0; hit_index < hit_count; ++hit_index)
+                    {
+                        hits[hit_index] = toHitInfo(all_collector.mHits[hit_index], query.m_length);
+                    }
+                }
+            });
+    }
+
+    void PhysicsScene::overlapBatch(const std::vector<PhysicsOverlapQuery>& queries, PhysicsQueryResults& out_results)
+    {
+        PICCOLO_PROFILE_ZONE("PhysicsScene::overlapBatch");
+
+        resetQueryResults(queries.size(), 1, out_results);
+
+        const JPH::NarrowPhaseQuery& scene_query = m_physics.m_jolt_physics_system->GetNarrowPhaseQuery();
+        g_runtime_global_context.m_job_system->parallelFor(
+            static_cast<uint32_t>(queries.size()), k_query_batch_size, [&](uint32_t begin, uint32_t end) {
+                JPH::AnyHitCollisionCollector<JPH::CollideShapeCollector> collector;
+                for (uint32_t query_index = begin; query_index < end; ++query_index)
+                {
+                    const PhysicsOverlapQuery& query = queries[query_index];
+                    ASSERT(query.m_shape);
+
+                    const Matrix4x4 shape_global_transform =
+                        query.m_global_transform * query.m_shape->m_local_transform.getMatrix();
+                    const JPH::Shape* jph_shape = getQueryShape(*query.m_shape, shape_global_transform);
+                    if (jph_shape == nullptr)
+                    {
+                        continue;
+                    }
+
+                    collector.Reset();
+                    scene_query.CollideShape(jph_shape,
+                                             JPH::Vec3::sReplicate(1.0f),
+                                             toMat44(shape_global_transform),
+                                             JPH::CollideShapeSettings(),
+                                             collector);
+                    if (collector.HadHit())
+                    {
+                        PhysicsHitInfo& hit = out_results.m_hits[query_index];
+                        hit.hit_position    = toVec3(collector.mHit.mContactPointOn2);
+                        hit.hit_normal      = toVec3(collector.mHit.mPenetrationAxis.Normalized());
+                        hit.hit_distance    = 0.f;
+                        hit.body_id         = collector.mHit.mBodyID2.GetIndexAndSequenceNumber();
+
+                        out_results.m_hit_counts[query_index] = 1;
+                    }
+                }
+            });
+    }
+
+    const JPH::Shape* PhysicsScene::getQueryShape(const RigidBodyShape& shape, const Matrix4x4& shape_global_transform)
+    {
+        Vector3    global_position, global_scale;
+        Quaternion global_rotation;
+        shape_global_transform.decomposition(global_position, global_scale, global_rotation);
+
+        return m_shape_cache->getShape(shape, global_scale);
+    }
+
     void PhysicsScene::getShapeBoundingBoxes(uint32_t body_id, std::vector<AxisAlignedBox>& out_bounding_boxes) const
     {
         JPH::BodyLockRead body_lock(m_physics.m_jolt_physics_system->GetBodyLockInterface(), JPH::BodyID(body_id));
@@ -1,15 +1,20 @@
 #pragma once
 
 #include "runtime/core/math/axis_aligned.h"
+#include "runtime/core/math/matrix4.h"
+#include "runtime/core/math/quaternion.h"
 
 #include "runtime/function/physics/physics_config.h"
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace JPH
 {
     class PhysicsSystem;
-    class JobSystem;
-    class TempAllocator;
-    class BroadPhaseLayerInterface;
+    class Shape;
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
     class DebugRenderer;
 #endif
@@ -20,6 +25,7 @@ namespace Piccolo
     class Transform;
     class RigidBodyComponentRes;
     class RigidBodyShape;
+    class ShapeCache;
 
     static constexpr uint32_t s_invalid_rigidbody_id = 0xffffffff;
 
@@ -31,17 +37,56 @@ namespace Piccolo
         uint32_t body_id {s_invalid_rigidbody_id};
     };
 
+    struct PhysicsRaycastQuery
+    {
+        Vector3 m_origin;
+        Vector3 m_direction;
+        float   m_length {0.f};
+    };
+
+    struct PhysicsSweepQuery
+    {
+        const RigidBodyShape* m_shape {nullptr};
+        Matrix4x4             m_shape_transform;
+        Vector3               m_direction;
+        float                 m_length {0.f};
+    };
+
+    struct PhysicsOverlapQuery
+    {
+        const RigidBodyShape* m_shape {nullptr};
+        Matrix4x4             m_global_transform;
+    };
+
+    /// results of a batch of scene queries, owned by the caller and reused from batch to batch so that its storage
+    /// is only allocated while it grows
+    struct PhysicsQueryResults
+    {
+        uint32_t m_max_hits_per_query {0};
+        // per query
+        std::vector<uint32_t> m_hit_counts;
+        // m_max_hits_per_query slots per query sorted by distance, the first m_hit_counts of them are valid
+        std::vector<PhysicsHitInfo> m_hits;
+
+        const PhysicsHitInfo* getHits(size_t query_index) const
+        {
+            return m_hits.data() + query_index * m_max_hits_per_query;
+        }
+    };
+
     class PhysicsScene
     {
         struct JoltPhysics
         {
-            JPH::PhysicsSystem*            m_jolt_physics_system {nullptr};
-            JPH::JobSystem*                m_jolt_job_system {nullptr};
-            JPH::TempAllocator*            m_temp_allocator {nullptr};
-            JPH::BroadPhaseLayerInterface* m_jolt_broad_phase_layer_interface {nullptr};
+            JPH::PhysicsSystem* m_jolt_physics_system {nullptr};
+        };
 
-            int m_collision_steps {1};
-            int m_integration_substeps {1};
+        struct MovingBodyTransform
+        {
+            Vector3    m_previous_position;
+            Quaternion m_previous_rotation;
+            Vector3    m_position;
+            Quaternion m_rotation;
         };
 
     public:
@@ -55,8 +100,14 @@ namespace Piccolo
 
         void updateRigidBodyGlobalTransform(uint32_t body_id, const Transform& global_transform);
 
+        /// advances the simulation by the fixed steps that fit into the accumulated frame time
         void tick(float delta_time);
 
+        /// the transform of a moving body at the time of the frame, interpolated between the last two steps
+        /// @out_transform: position and rotation are written, the scale is kept
+        /// @return: false for static and sleeping bodies that never moved, their transform is the one set last
+        bool getInterpolatedTransform(uint32_t body_id, Transform& out_transform) const;
+
         /// cast a ray and find the hits
         /// @ray_origin: origin of ray
         /// @ray_direction: ray direction
@@ -84,6 +135,17 @@ namespace Piccolo
         /// @return: true if overlapped with any rigidbodies
         bool isOverlap(const RigidBodyShape& shape, const Matrix4x4& global_transform);
 
+        /// the batched queries run in parallel on the job system and write into the results of the caller
+        /// @max_hits_per_query: closest hits kept per query, 1 for line of sight tests
+        void raycastBatch(const std::vector<PhysicsRaycastQuery>& queries,
+                          uint32_t                                max_hits_per_query,
+                          PhysicsQueryResults&                    out_results);
+        void sweepBatch(const std::vector<PhysicsSweepQuery>& queries,
+                        uint32_t                              max_hits_per_query,
+                        PhysicsQueryResults&                  out_results);
+        /// a query has one hit when its shape overlaps any rigid body
+        void overlapBatch(const std::vector<PhysicsOverlapQuery>& queries, PhysicsQueryResults& out_results);
+
         void getShapeBoundingBoxes(uint32_t body_id, std::vector<AxisAlignedBox>& out_bounding_boxes) const;
 
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
@@ -91,11 +153,26 @@ namespace Piccolo
 #endif
 
     protected:
-        // we use single Jolt physics system for each scene
+        // we use single Jolt physics system for each scene, the rest of the jolt runtime is shared by all scenes
         JoltPhysics m_physics;
 
         PhysicsConfig m_config;
 
+        // shapes of the queries, the bodies own their shapes
+        std::unique_ptr<ShapeCache> m_shape_cache;
+
+        // frame time not simulated yet, less than one step unless steps were dropped
+        float m_accumulated_time {0.f};
+        // how far the frame time is between the last two steps
+        float m_interpolation_alpha {1.f};
+        // bodies that moved during a step, by body id
+        std::unordered_map<uint32_t, MovingBodyTransform> m_moving_body_transforms;
+
+        void              updateMovingBodyTransforms();
+        const JPH::Shape* getQueryShape(const RigidBodyShape& shape, const Matrix4x4& shape_global_transform);
+
+        // bodies may be removed from parallel transform ticks
+        std::mutex            m_pending_remove_mutex;
         std::vector<uint32_t> m_pending_remove_bodies;
     };
 } // namespace Piccolo
\ No newline at end of file
@@ -0,0 +1,557 @@
+#include "runtime/function/render/interface/null/null_rhi.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Piccolo
+{
+    void NullRHI::initialize(RHIInitInfo initialize_info)
+    {
+        m_swapchain_extent = {k_default_extent_width, k_default_extent_height};
+        m_viewport         = {0.0f, 0.0f, (float)k_default_extent_width, (float)k_default_extent_height, 0.0f, 1.0f};
+        m_scissor          = {{0, 0}, m_swapchain_extent};
+
+        m_swapchain_image_view = createObject<RHIImageView>();
+        m_depth_image          = createObject<RHIImage>();
+        m_depth_image_view     = createObject<RHIImageView>();
+
+        m_command_pool    = createObject<RHICommandPool>();
+        m_descriptor_pool = createObject<RHIDescriptorPool>();
+        m_graphics_queue  = createObject<RHIQueue>();
+        m_compute_queue   = createObject<RHIQueue>();
+        m_default_sampler = createObject<RHISampler>();
+        for (uint8_t frame_index = 0; frame_index < k_max_frames_in_flight; ++frame_index)
+        {
+            m_command_buffers[frame_index]         = createObject<RHICommandBuffer>();
+            m_frame_in_flight_fences[frame_index]  = createObject<RHIFence>();
+            m_texture_copy_semaphores[frame_index] = createObject<RHISemaphore>();
+        }
+    }
+
+    void NullRHI::prepareContext() {}
+
+    bool NullRHI::isPointLightShadowEnabled() { return false; }
+
+    bool NullRHI::allocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo,
+                                         RHICommandBuffer*&                  pCommandBuffers)
+    {
+        pCommandBuffers = createObject<RHICommandBuffer>();
+        return true;
+    }
+
+    bool NullRHI::allocateDescriptorSets(const RHIDescriptorSetAllocateInfo* pAllocateInfo,
+                                         RHIDescriptorSet*&                  pDescriptorSets)
+    {
+        pDescriptorSets = createObject<RHIDescriptorSet>();
+        return true;
+    }
+
+    void NullRHI::createSwapchain() {}
+
+    void NullRHI::recreateSwapchain() {}
+
+    void NullRHI::createSwapchainImageViews() {}
+
+    void NullRHI::createFramebufferImageAndView() {}
+
+    RHISampler* NullRHI::getOrCreateDefaultSampler(RHIDefaultSamplerType type) { return m_default_sampler; }
+
+    RHISampler* NullRHI::getOrCreateMipmapSampler(uint32_t width, uint32_t height) { return m_default_sampler; }
+
+    RHIShader* NullRHI::createShaderModule(const std::vector<unsigned char>& shader_code)
+    {
+        return createObject<RHIShader>();
+    }
+
+    void NullRHI::createBuffer(RHIDeviceSize          size,
+                               RHIBufferUsageFlags    usage,
+                               RHIMemoryPropertyFlags properties,
+                               RHIBuffer*&            buffer,
+                               RHIDeviceMemory*&      buffer_memory)
+    {
+        buffer        = createObject<RHIBuffer>();
+        buffer_memory = createDeviceMemory(size);
+    }
+
+    void NullRHI::createBufferAndInitialize(RHIBufferUsageFlags    usage,
+                                            RHIMemoryPropertyFlags properties,
+                                            RHIBuffer*&            buffer,
+                                            RHIDeviceMemory*&      buffer_memory,
+                                            RHIDeviceSize          size,
+                                            void*                  data,
+                                            int                    datasize)
+    {
+        buffer        = createObject<RHIBuffer>();
+        buffer_memory = createDeviceMemory(size);
+        if (data != nullptr && datasize > 0)
+        {
+            memcpy(static_cast<NullDeviceMemory*>(buffer_memory)->m_data.data(), data, datasize);
+        }
+    }
+
+    bool NullRHI::createBufferVMA(VmaAllocator                   allocator,
+                                  const RHIBufferCreateInfo*     pBufferCreateInfo,
+                                  const VmaAllocationCreateInfo* pAllocationCreateInfo,
+                                  RHIBuffer*&                    pBuffer,
+                                  VmaAllocation*                 pAllocation,
+                                  VmaAllocationInfo*             pAllocationInfo)
+    {
+        pBuffer = createObject<RHIBuffer>();
+        fillAllocation(pBufferCreateInfo->size, pAllocation, pAllocationInfo);
+        return true;
+    }
+
+    bool NullRHI::createBufferWithAlignmentVMA(VmaAllocator                   allocator,
+                                               const RHIBufferCreateInfo*     pBufferCreateInfo,
+                                               const VmaAllocationCreateInfo* pAllocationCreateInfo,
+                                               RHIDeviceSize                  minAlignment,
+                                               RHIBuffer*&                    pBuffer,
+                                               VmaAllocation*                 pAllocation,
+                                               VmaAllocationInfo*             pAllocationInfo)
+    {
+        pBuffer = createObject<RHIBuffer>();
+        fillAllocation(pBufferCreateInfo->size, pAllocation, pAllocationInfo);
+        return true;
+    }
+
+    void NullRHI::copyBuffer(RHIBuffer*    srcBuffer,
+                             RHIBuffer*    dstBuffer,
+                             RHIDeviceSize srcOffset,
+                             RHIDeviceSize dstOffset,
+                             RHIDeviceSize size) {}
+
+    void NullRHI::createImage(uint32_t               image_width,
+                              uint32_t               image_height,
+                              RHIFormat              format,
+                              RHIImageTiling         image_tiling,
+                              RHIImageUsageFlags     image_usage_flags,
+                              RHIMemoryPropertyFlags memory_property_flags,
+                              RHIImage*&             image,
+                              RHIDeviceMemory*&      memory,
+                              RHIImageCreateFlags    image_create_flags,
+                              uint32_t               array_layers,
+                              uint32_t               miplevels)
+    {
+        image  = createObject<RHIImage>();
+        memory = createDeviceMemory(0);
+    }
+
+    void NullRHI::createImageView(RHIImage*           image,
+                                  RHIFormat           format,
+                                  RHIImageAspectFlags image_aspect_flags,
+                                  RHIImageViewType    view_type,
+                                  uint32_t            layout_count,
+                                  uint32_t            miplevels,
+                                  RHIImageView*&      image_view)
+    {
+        image_view = createObject<RHIImageView>();
+    }
+
+    void NullRHI::createGlobalImage(RHIImage*&     image,
+                                    RHIImageView*& image_view,
+                                    VmaAllocation& image_allocation,
+                                    uint32_t       texture_image_width,
+                                    uint32_t       texture_image_height,
+                                    void*          texture_image_pixels,
+                                    RHIFormat      texture_image_format,
+                                    uint32_t       miplevels)
+    {
+        image            = createObject<RHIImage>();
+        image_view       = createObject<RHIImageView>();
+        image_allocation = VK_NULL_HANDLE;
+    }
+
+    void NullRHI::createCubeMap(RHIImage*&           image,
+                                RHIImageView*&       image_view,
+                                VmaAllocation&       image_allocation,
+                                uint32_t             texture_image_width,
+                                uint32_t             texture_image_height,
+                                std::array<void*, 6> texture_image_pixels,
+                                RHIFormat            texture_image_format,
+                                uint32_t             miplevels)
+    {
+        image            = createObject<RHIImage>();
+        image_view       = createObject<RHIImageView>();
+        image_allocation = VK_NULL_HANDLE;
+    }
+
+    void NullRHI::createCommandPool() {}
+
+    bool NullRHI::createCommandPool(const RHICommandPoolCreateInfo* pCreateInfo, RHICommandPool*& pCommandPool)
+    {
+        pCommandPool = createObject<RHICommandPool>();
+        return true;
+    }
+
+    bool NullRHI::createDescriptorPool(const RHIDescriptorPoolCreateInfo* pCreateInfo,
+                                       RHIDescriptorPool*&                pDescriptorPool)
+    {
+        pDescriptorPool = createObject<RHIDescriptorPool>();
+        return true;
+    }
+
+    bool NullRHI::createDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo* pCreateInfo,
+                                            RHIDescriptorSetLayout*&                pSetLayout)
+    {
+        pSetLayout = createObject<RHIDescriptorSetLayout>();
+        return true;
+    }
+
+    bool NullRHI::createFence(const RHIFenceCreateInfo* pCreateInfo, RHIFence*& pFence)
+    {
+        pFence = createObject<RHIFence>();
+        return true;
+    }
+
+    bool NullRHI::createFramebuffer(const RHIFramebufferCreateInfo* pCreateInfo, RHIFramebuffer*& pFramebuffer)
+    {
+        pFramebuffer = createObject<RHIFramebuffer>();
+        return true;
+    }
+
+    bool NullRHI::createGraphicsPipelines(RHIPipelineCache*                    pipelineCache,
+                                          uint32_t                             createInfoCount,
+                                          const RHIGraphicsPipelineCreateInfo* pCreateInfos,
+                                          RHIPipeline*&                        pPipelines)
+    {
+        pPipelines = createObject<RHIPipeline>();
+        return true;
+    }
+
+    bool NullRHI::createComputePipelines(RHIPipelineCache*                   pipelineCache,
+                                         uint32_t                            createInfoCount,
+                                         const RHIComputePipelineCreateInfo* pCreateInfos,
+                                         RHIPipeline*&                       pPipelines)
+    {
+        pPipelines = createObject<RHIPipeline>();
+        return true;
+    }
+
+    bool NullRHI::createPipelineLayout(const RHIPipelineLayoutCreateInfo* pCreateInfo,
+                                       RHIPipelineLayout*&                pPipelineLayout)
+    {
+        pPipelineLayout = createObject<RHIPipelineLayout>();
+        return true;
+    }
+
+    bool NullRHI::createRenderPass(const RHIRenderPassCreateInfo* pCreateInfo, RHIRenderPass*& pRenderPass)
+    {
+        pRenderPass = createObject<RHIRenderPass>();
+        return true;
+    }
+
+    bool NullRHI::createSampler(const RHISamplerCreateInfo* pCreateInfo, RHISampler*& pSampler)
+    {
+        pSampler = createObject<RHISampler>();
+        return true;
+    }
+
+    bool NullRHI::createSemaphore(const RHISemaphoreCreateInfo* pCreateInfo, RHISemaphore*& pSemaphore)
+    {
+        pSemaphore = createObject<RHISemaphore>();
+        return true;
+    }
+
+    bool NullRHI::waitForFencesPFN(uint32_t fenceCount, RHIFence* const* pFence, RHIBool32 waitAll, uint64_t timeout)
+    {
+        return true;
+    }
+
+    bool NullRHI::resetFencesPFN(uint32_t fenceCount, RHIFence* const* pFences) { return true; }
+
+    bool NullRHI::resetCommandPoolPFN(RHICommandPool* commandPool, RHICommandPoolResetFlags flags) { return true; }
+
+    bool NullRHI::beginCommandBufferPFN(RHICommandBuffer* commandBuffer, const RHICommandBufferBeginInfo* pBeginInfo)
+    {
+        return true;
+    }
+
+    bool NullRHI::endCommandBufferPFN(RHICommandBuffer* commandBuffer) { return true; }
+
+    void NullRHI::cmdBeginRenderPassPFN(RHICommandBuffer*             commandBuffer,
+                                        const RHIRenderPassBeginInfo* pRenderPassBegin,
+                                        RHISubpassContents            contents) {}
+
+    void NullRHI::cmdNextSubpassPFN(RHICommandBuffer* commandBuffer, RHISubpassContents contents) {}
+
+    void NullRHI::cmdEndRenderPassPFN(RHICommandBuffer* commandBuffer) {}
+
+    void NullRHI::cmdBindPipelinePFN(RHICommandBuffer*    commandBuffer,
+                                     RHIPipelineBindPoint pipelineBindPoint,
+                                     RHIPipeline*         pipeline) {}
+
+    void NullRHI::cmdSetViewportPFN(RHICommandBuffer*  commandBuffer,
+                                    uint32_t           firstViewport,
+                                    uint32_t           viewportCount,
+                                    const RHIViewport* pViewports) {}
+
+    void NullRHI::cmdSetScissorPFN(RHICommandBuffer* commandBuffer,
+                                   uint32_t          firstScissor,
+                                   uint32_t          scissorCount,
+                                   const RHIRect2D*  pScissors) {}
+
+    void NullRHI::cmdBindVertexBuffersPFN(RHICommandBuffer*    commandBuffer,
+                                          uint32_t             firstBinding,
+                                          uint32_t             bindingCount,
+                                          RHIBuffer* const*    pBuffers,
+                                          const RHIDeviceSize* pOffsets) {}
+
+    void NullRHI::cmdBindIndexBufferPFN(RHICommandBuffer* commandBuffer,
+                                        RHIBuffer*        buffer,
+                                        RHIDeviceSize     offset,
+                                        RHIIndexType      indexType) {}
+
+    void NullRHI::cmdBindDescriptorSetsPFN(RHICommandBuffer*              commandBuffer,
+                                           RHIPipelineBindPoint           pipelineBindPoint,
+                                           RHIPipelineLayout*             layout,
+                                           uint32_t                       firstSet,
+                                           uint32_t                       descriptorSetCount,
+                                           const RHIDescriptorSet* const* pDescriptorSets,
+                                           uint32_t                       dynamicOffsetCount,
+                                           const uint32_t*                pDynamicOffsets) {}
+
+    void NullRHI::cmdDrawIndexedPFN(RHICommandBuffer* commandBuffer,
+                                    uint32_t          indexCount,
+                                    uint32_t          instanceCount,
+                                    uint32_t          firstIndex,
+                                    int32_t           vertexOffset,
+                                    uint32_t          firstInstance) {}
+
+    void NullRHI::cmdClearAttachmentsPFN(RHICommandBuffer*         commandBuffer,
+                                         uint32_t                  attachmentCount,
+                                         const RHIClearAttachment* pAttachments,
+                                         uint32_t                  rectCount,
+                                         const RHIClearRect*       pRects) {}
+
+    bool NullRHI::beginCommandBuffer(RHICommandBuffer* commandBuffer, const RHICommandBufferBeginInfo* pBeginInfo)
+    {
+        return true;
+    }
+
+    void NullRHI::cmdCopyImageToBuffer(RHICommandBuffer*         commandBuffer,
+                                       RHIImage*                 srcImage,
+                                       RHIImageLayout            srcImageLayout,
+                                       RHIBuffer*                dstBuffer,
+                                       uint32_t                  regionCount,
+                                       const RHIBufferImageCopy* pRegions) {}
+
+    void NullRHI::cmdCopyImageToImage(RHICommandBuffer*      commandBuffer,
+                                      RHIImage*              srcImage,
+                                      RHIImageAspectFlagBits srcFlag,
+                                      RHIImage*              dstImage,
+                                      RHIImageAspectFlagBits dstFlag,
+                                      uint32_t               width,
+                                      uint32_t               height) {}
+
+    void NullRHI::cmdCopyBuffer(RHICommandBuffer* commandBuffer,
+                                RHIBuffer*        srcBuffer,
+                                RHIBuffer*        dstBuffer,
+                                uint32_t          regionCount,
+                                RHIBufferCopy*    pRegions) {}
+
+    void NullRHI::cmdDraw(RHICommandBuffer* commandBuffer,
+                          uint32_t          vertexCount,
+                          uint32_t          instanceCount,
+                          uint32_t          firstVertex,
+                          uint32_t          firstInstance) {}
+
+    void NullRHI::cmdDispatch(RHICommandBuffer* commandBuffer,
+                              uint32_t          groupCountX,
+                              uint32_t          groupCountY,
+                              uint32_t          groupCountZ) {}
+
+    void NullRHI::cmdDispatchIndirect(RHICommandBuffer* commandBuffer, RHIBuffer* buffer, RHIDeviceSize offset) {}
+
+    void NullRHI::cmdPipelineBarrier(RHICommandBuffer*             commandBuffer,
+                                     RHIPipelineStageFlags         srcStageMask,
+                                     RHIPipelineStageFlags         dstStageMask,
+                                     RHIDependencyFlags            dependencyFlags,
+                                     uint32_t                      memoryBarrierCount,
+                                     const RHIMemoryBarrier*       pMemoryBarriers,
+                                     uint32_t                      bufferMemoryBarrierCount,
+                                     const RHIBufferMemoryBarrier* pBufferMemoryBarriers,
+                                     uint32_t                      imageMemoryBarrierCount,
+                                     const RHIImageMemoryBarrier*  pImageMemoryBarriers) {}
+
+    bool NullRHI::endCommandBuffer(RHICommandBuffer* commandBuffer) { return true; }
+
+    void NullRHI::updateDescriptorSets(uint32_t                     descriptorWriteCount,
+                                       const RHIWriteDescriptorSet* pDescriptorWrites,
+                                       uint32_t                     descriptorCopyCount,
+                                       const RHICopyDescriptorSet*  pDescriptorCopies) {}
+
+    bool NullRHI::queueSubmit(RHIQueue* queue, uint32_t submitCount, const RHISubmitInfo* pSubmits, RHIFence* fence)
+    {
+        return true;
+    }
+
+    bool NullRHI::queueWaitIdle(RHIQueue* queue) { return true; }
+
+    void NullRHI::resetCommandPool() {}
+
+    void NullRHI::waitForFences() {}
+
+    void NullRHI::getPhysicalDeviceProperties(RHIPhysicalDeviceProperties* pProperties)
+    {
+        *pProperties = {};
+        // match the limits of common desktop gpus so that buffer layouts are computed the same way
+        pProperties->limits.minUniformBufferOffsetAlignment = 256;
+        pProperties->limits.minStorageBufferOffsetAlignment = 256;
+        pProperties->limits.maxStorageBufferRange           = 1u << 27;
+    }
+
+    RHICommandBuffer* NullRHI::getCurrentCommandBuffer() const { return m_command_buffers[m_current_frame_index]; }
+
+    RHICommandBuffer* const* NullRHI::getCommandBufferList() const { return m_command_buffers; }
+
+    RHICommandPool* NullRHI::getCommandPoor() const { return m_command_pool; }
+
+    RHIDescriptorPool* NullRHI::getDescriptorPoor() const { return m_descriptor_pool; }
+
+    RHIFence* const* NullRHI::getFenceList() const { return m_frame_in_flight_fences; }
+
+    QueueFamilyIndices NullRHI::getQueueFamilyIndices() const
+    {
+        QueueFamilyIndices indices;
+        indices.graphics_family  = 0;
+        indices.present_family   = 0;
+        indices.m_compute_family = 0;
+        return indices;
+    }
+
+    RHIQueue* NullRHI::getGraphicsQueue() const { return m_graphics_queue; }
+
+    RHIQueue* NullRHI::getComputeQueue() const { return m_compute_queue; }
+
+    RHISwapChainDesc NullRHI::getSwapchainInfo()
+    {
+        RHISwapChainDesc desc;
+        desc.image_format = RHI_FORMAT_B8G8R8A8_UNORM;
+        desc.extent       = m_swapchain_extent;
+        desc.viewport     = &m_viewport;
+        desc.scissor      = &m_scissor;
+        desc.imageViews   = {m_swapchain_image_view};
+        return desc;
+    }
+
+    RHIDepthImageDesc NullRHI::getDepthImageInfo() const
+    {
+        RHIDepthImageDesc desc;
+        desc.depth_image_format = RHI_FORMAT_D32_SFLOAT;
+        desc.depth_image_view   = m_depth_image_view;
+        desc.depth_image        = m_depth_image;
+        return desc;
+    }
+
+    uint8_t NullRHI::getMaxFramesInFlight() const { return k_max_frames_in_flight; }
+
+    uint8_t NullRHI::getCurrentFrameIndex() const { return m_current_frame_index; }
+
+    void NullRHI::setCurrentFrameIndex(uint8_t index) { m_current_frame_index = index; }
+
+    RHICommandBuffer* NullRHI::beginSingleTimeCommands() { return m_command_buffers[m_current_frame_index]; }
+
+    void NullRHI::endSingleTimeCommands(RHICommandBuffer* command_buffer) {}
+
+    bool NullRHI::prepareBeforePass(std::function<void()> passUpdateAfterRecreateSwapchain) { return false; }
+
+    void NullRHI::submitRendering(std::function<void()> passUpdateAfterRecreateSwapchain)
+    {
+        m_current_frame_index = (m_current_frame_index + 1) % k_max_frames_in_flight;
+    }
+
+    void NullRHI::pushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color) {}
+
+    void NullRHI::popEvent(RHICommandBuffer* commond_buffer) {}
+
+    void* NullRHI::mapUploadBuffer(RHIBuffer* buffer, RHIDeviceSize offset, RHIDeviceSize size)
+    {
+        m_upload_data.resize(std::max<size_t>(m_upload_data.size(), size));
+        return m_upload_data.data();
+    }
+
+    void NullRHI::flushUploads() {}
+
+    void NullRHI::clear() { m_objects.clear(); }
+
+    void NullRHI::clearSwapchain() {}
+
+    void NullRHI::destroyDefaultSampler(RHIDefaultSamplerType type) {}
+
+    void NullRHI::destroyMipmappedSampler() {}
+
+    void NullRHI::destroyShaderModule(RHIShader* shader) {}
+
+    void NullRHI::destroySemaphore(RHISemaphore* semaphore) {}
+
+    void NullRHI::destroySampler(RHISampler* sampler) {}
+
+    void NullRHI::destroyInstance(RHIInstance* instance) {}
+
+    void NullRHI::destroyImageView(RHIImageView* imageView) {}
+
+    void NullRHI::destroyImage(RHIImage* image) {}
+
+    void NullRHI::destroyFramebuffer(RHIFramebuffer* framebuffer) {}
+
+    void NullRHI::destroyFence(RHIFence* fence) {}
+
+    void NullRHI::destroyDevice() {}
+
+    void NullRHI::destroyCommandPool(RHICommandPool* commandPool) {}
+
+    void NullRHI::destroyBuffer(RHIBuffer*& buffer) { buffer = nullptr; }
+
+    void NullRHI::freeCommandBuffers(RHICommandPool*   commandPool,
+                                     uint32_t          commandBufferCount,
+                                     RHICommandBuffer* pCommandBuffers) {}
+
+    void NullRHI::freeMemory(RHIDeviceMemory*& memory) { memory = nullptr; }
+
+    bool NullRHI::mapMemory(RHIDeviceMemory*  memory,
+                            RHIDeviceSize     offset,
+                            RHIDeviceSize     size,
+                            RHIMemoryMapFlags flags,
+                            void**            ppData)
+    {
+        *ppData = static_cast<NullDeviceMemory*>(memory)->m_data.data() + offset;
+        return true;
+    }
+
+    void NullRHI::unmapMemory(RHIDeviceMemory* memory) {}
+
+    void NullRHI::invalidateMappedMemoryRanges(void*            pNext,
+                                               RHIDeviceMemory* memory,
+                                               RHIDeviceSize    offset,
+                                               RHIDeviceSize    size) {}
+
+    void NullRHI::flushMappedMemoryRanges(void*            pNext,
+                                          RHIDeviceMemory* memory,
+                                          RHIDeviceSize    offset,
+                                          RHIDeviceSize    size) {}
+
+    RHISemaphore*& NullRHI::getTextureCopySemaphore(uint32_t index) { return m_texture_copy_semaphores[index]; }
+
+    RHIDeviceMemory* NullRHI::createDeviceMemory(RHIDeviceSize size)
+    {
+        NullDeviceMemory* memory = createObject<NullDeviceMemory>();
+        memory->m_data.resize(static_cast<size_t>(size));
+        return memory;
+    }
+
+    void NullRHI::fillAllocation(RHIDeviceSize size, VmaAllocation* allocation, VmaAllocationInfo* allocation_info)
+    {
+        // there is no vma allocator, persistently mapped buffers get host memory instead
+        NullDeviceMemory* memory = static_cast<NullDeviceMemory*>(createDeviceMemory(size));
+        if (allocation != nullptr)
+        {
+            *allocation = VK_NULL_HANDLE;
+        }
+        if (allocation_info != nullptr)
+        {
+            *allocation_info            = {};
+            allocation_info->size        = size;
+            allocation_info->pMappedData = memory->m_data.data();
+        }
+    }
+} // namespace Piccolo
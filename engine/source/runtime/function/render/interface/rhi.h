@@ -143,6 +143,11 @@ namespace Piccolo
         virtual void pushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color) = 0;
         virtual void popEvent(RHICommandBuffer* commond_buffer) = 0;
 
+        // upload, the memory returned by mapUploadBuffer is copied into the buffer by the next flushUploads and has
+        // to be filled before the rhi is called again
+        virtual void* mapUploadBuffer(RHIBuffer* buffer, RHIDeviceSize offset, RHIDeviceSize size) = 0;
+        virtual void  flushUploads() = 0;
+
         // destory
         virtual void clear() = 0;
         virtual void clearSwapchain() = 0;
@@ -152,6 +152,8 @@ namespace Piccolo
         createFramebufferImageAndView();
 
         createAssetAllocator();
+
+        m_upload_queue.initialize(this);
     }
 
     void VulkanRHI::prepareContext()
@@ -162,6 +164,8 @@ namespace Piccolo
 
     void VulkanRHI::clear()
     {
+        m_upload_queue.clear();
+
         if (m_enable_validation_Layers)
         {
             destroyDebugUtilsMessengerEXT(m_instance, m_debug_messenger, nullptr);
@@ -472,6 +476,10 @@ namespace Piccolo
             LOG_ERROR("_vkResetFences failed!");
             return;
         }
+
+        // the uploads recorded while the frame was prepared go to the queue ahead of it
+        m_upload_queue.flush();
+
         VkResult res_queue_submit =
             vkQueueSubmit(((VulkanQueue*)m_graphics_queue)->getResource(), 1, &submit_info, m_is_frame_in_flight_fences[m_current_frame_index]);
         
@@ -535,6 +543,9 @@ namespace Piccolo
         VkCommandBuffer vk_command_buffer = ((VulkanCommandBuffer*)command_buffer)->getResource();
         _vkEndCommandBuffer(vk_command_buffer);
 
+        // the commands may read what was uploaded before them
+        m_upload_queue.flush();
+
         VkSubmitInfo submitInfo {};
         submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.commandBufferCount = 1;
@@ -764,6 +775,10 @@ namespace Piccolo
         std::set<uint32_t>                   queue_families = {m_queue_indices.graphics_family.value(),
                                              m_queue_indices.present_family.value(),
                                              m_queue_indices.m_compute_family.value()};
+        if (m_queue_indices.m_transfer_family.has_value())
+        {
+            queue_families.insert(m_queue_indices.m_transfer_family.value());
+        }
 
         float queue_priority = 1.0f;
         for (uint32_t queue_family : queue_families) // for every queue family
@@ -822,6 +837,11 @@ namespace Piccolo
         m_compute_queue = new VulkanQueue();
         ((VulkanQueue*)m_compute_queue)->setResource(vk_compute_queue);
 
+        if (m_queue_indices.m_transfer_family.has_value())
+        {
+            vkGetDeviceQueue(m_device, m_queue_indices.m_transfer_family.value(), 0, &m_transfer_queue);
+        }
+
         // more efficient pointer
         _vkResetCommandPool      = (PFN_vkResetCommandPool)vkGetDeviceProcAddr(m_device, "vkResetCommandPool");
         _vkBeginCommandBuffer    = (PFN_vkBeginCommandBuffer)vkGetDeviceProcAddr(m_device, "vkBeginCommandBuffer");
@@ -2917,6 +2937,16 @@ namespace Piccolo
         ((VulkanImageView*)image_view)->setResource(vk_image_view);
     }
 
+    void* VulkanRHI::mapUploadBuffer(RHIBuffer* buffer, RHIDeviceSize offset, RHIDeviceSize size)
+    {
+        return m_upload_queue.mapBufferUpload(((VulkanBuffer*)buffer)->getResource(), offset, size);
+    }
+
+    void VulkanRHI::flushUploads()
+    {
+        m_upload_queue.flush();
+    }
+
     void VulkanRHI::createGlobalImage(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, void* texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels)
     {
         VkImage vk_image;
@@ -3366,6 +3396,19 @@ namespace Piccolo
             }
             i++;
         }
+
+        // the copy engine of discrete gpus, the uploads use it next to the graphics queue
+        for (uint32_t family_index = 0; family_index < queue_family_count; ++family_index)
+        {
+            const VkQueueFlags queue_flags  = queue_families[family_index].queueFlags;
+            const bool         is_transfer  = (queue_flags & VK_QUEUE_TRANSFER_BIT) != 0;
+            const bool         is_dedicated = (queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0;
+            if (is_transfer && is_dedicated)
+            {
+                indices.m_transfer_family = family_index;
+                break;
+            }
+        }
         return indices;
     }
 
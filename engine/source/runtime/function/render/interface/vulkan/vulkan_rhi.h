@@ -2,6 +2,7 @@
 
 #include "runtime/function/render/interface/rhi.h"
 #include "runtime/function/render/interface/vulkan/vulkan_rhi_resource.h"
+#include "runtime/function/render/interface/vulkan/vulkan_upload_queue.h"
 
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
@@ -137,6 +138,10 @@ namespace Piccolo
         void pushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color) override;
         void popEvent(RHICommandBuffer* commond_buffer) override;
 
+        // upload
+        void* mapUploadBuffer(RHIBuffer* buffer, RHIDeviceSize offset, RHIDeviceSize size) override;
+        void  flushUploads() override;
+
         // destory
         virtual ~VulkanRHI() override final;
         void clear() override;
@@ -198,6 +203,7 @@ namespace Piccolo
         VkPhysicalDevice   m_physical_device {nullptr};
         VkDevice           m_device {nullptr};
         VkQueue            m_present_queue {nullptr};
+        VkQueue            m_transfer_queue {nullptr};
 
         VkSwapchainKHR           m_swapchain {nullptr};
         std::vector<VkImage>     m_swapchain_images;
@@ -210,6 +216,9 @@ namespace Piccolo
         // asset allocator use VMA library
         VmaAllocator m_assets_allocator;
 
+        // staging ring and batched submissions of the asset uploads
+        VulkanUploadQueue m_upload_queue;
+
         // function pointers
         PFN_vkCmdBeginDebugUtilsLabelEXT _vkCmdBeginDebugUtilsLabelEXT;
         PFN_vkCmdEndDebugUtilsLabelEXT   _vkCmdEndDebugUtilsLabelEXT;
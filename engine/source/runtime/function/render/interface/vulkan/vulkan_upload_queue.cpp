@@ -0,0 +1,440 @@
+#include "runtime/function/render/interface/vulkan/vulkan_upload_queue.h"
+#include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
+#include "runtime/function/render/interface/vulkan/vulkan_util.h"
+
+#include "runtime/core/base/macro.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    namespace
+    {
+        constexpr VkDeviceSize k_buffer_upload_alignment = 16;
+
+        // what reads the uploaded buffers in the frames after an upload
+        constexpr VkPipelineStageFlags k_consumer_stages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                                                           VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                                           VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        constexpr VkAccessFlags k_consumer_access = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                                                    VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+        VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    } // namespace
+
+    void VulkanUploadQueue::initialize(VulkanRHI* rhi)
+    {
+        m_rhi             = rhi;
+        m_device          = rhi->m_device;
+        m_graphics_queue  = ((VulkanQueue*)rhi->m_graphics_queue)->getResource();
+        m_graphics_family = rhi->m_queue_indices.graphics_family.value();
+        if (rhi->m_queue_indices.m_transfer_family.has_value())
+        {
+            m_transfer_queue  = rhi->m_transfer_queue;
+            m_transfer_family = rhi->m_queue_indices.m_transfer_family.value();
+        }
+
+        VkCommandPoolCreateInfo command_pool_create_info {};
+        command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        command_pool_create_info.flags =
+            VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        command_pool_create_info.queueFamilyIndex = m_graphics_family;
+        if (vkCreateCommandPool(m_device, &command_pool_create_info, nullptr, &m_graphics_command_pool) != VK_SUCCESS)
+        {
+            LOG_ERROR("vk create upload command pool");
+        }
+        if (isTransferQueueEnabled())
+        {
+            command_pool_create_info.queueFamilyIndex = m_transfer_family;
+            if (vkCreateCommandPool(m_device, &command_pool_create_info, nullptr, &m_transfer_command_pool) !=
+                VK_SUCCESS)
+            {
+                LOG_ERROR("vk create upload transfer command pool");
+            }
+        }
+
+        VulkanUtil::createBuffer(rhi->m_physical_device,
+                                 m_device,
+                                 k_ring_size,
+                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                 m_ring_buffer,
+                                 m_ring_memory);
+        void* ring_data = nullptr;
+        vkMapMemory(m_device, m_ring_memory, 0, VK_WHOLE_SIZE, 0, &ring_data);
+        m_ring_data = static_cast<uint8_t*>(ring_data);
+
+        for (Batch& batch : m_batches)
+        {
+            VkCommandBufferAllocateInfo command_buffer_allocate_info {};
+            command_buffer_allocate_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            command_buffer_allocate_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            command_buffer_allocate_info.commandPool        = m_graphics_command_pool;
+            command_buffer_allocate_info.commandBufferCount = 1;
+            vkAllocateCommandBuffers(m_device, &command_buffer_allocate_info, &batch.m_graphics_command_buffer);
+
+            VkFenceCreateInfo fence_create_info {};
+            fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            if (vkCreateFence(m_device, &fence_create_info, nullptr, &batch.m_fence) != VK_SUCCESS)
+            {
+                LOG_ERROR("vk create upload fence");
+            }
+
+            if (isTransferQueueEnabled())
+            {
+                command_buffer_allocate_info.commandPool = m_transfer_command_pool;
+                vkAllocateCommandBuffers(m_device, &command_buffer_allocate_info, &batch.m_transfer_command_buffer);
+
+                VkSemaphoreCreateInfo semaphore_create_info {};
+                semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+                if (vkCreateSemaphore(m_device, &semaphore_create_info, nullptr, &batch.m_transfer_semaphore) !=
+                    VK_SUCCESS)
+                {
+                    LOG_ERROR("vk create upload semaphore");
+                }
+            }
+        }
+    }
+
+    void VulkanUploadQueue::clear()
+    {
+        if (m_device == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        flush();
+        while (m_in_flight_batch_count > 0)
+        {
+            waitForOldestBatch();
+        }
+
+        for (Batch& batch : m_batches)
+        {
+            vkDestroyFence(m_device, batch.m_fence, nullptr);
+            if (batch.m_transfer_semaphore != VK_NULL_HANDLE)
+            {
+                vkDestroySemaphore(m_device, batch.m_transfer_semaphore, nullptr);
+            }
+        }
+
+        // the command buffers go with their pools
+        vkDestroyCommandPool(m_device, m_graphics_command_pool, nullptr);
+        if (m_transfer_command_pool != VK_NULL_HANDLE)
+        {
+            vkDestroyCommandPool(m_device, m_transfer_command_pool, nullptr);
+        }
+
+        vkUnmapMemory(m_device, m_ring_memory);
+        vkDestroyBuffer(m_device, m_ring_buffer, nullptr);
+        vkFreeMemory(m_device, m_ring_memory, nullptr);
+
+        *this = VulkanUploadQueue {};
+    }
+
+    void* VulkanUploadQueue::mapBufferUpload(VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size)
+    {
+        VkBuffer     staging_buffer;
+        VkDeviceSize staging_offset;
+        void*        data = allocateStaging(size, k_buffer_upload_alignment, staging_buffer, staging_offset);
+        if (size == 0)
+        {
+            return data;
+        }
+
+        Batch&       batch       = getRecordingBatch();
+        VkBufferCopy copy_region = {staging_offset, dst_offset, size};
+        if (isTransferQueueEnabled())
+        {
+            vkCmdCopyBuffer(batch.m_transfer_command_buffer, staging_buffer, dst_buffer, 1, &copy_region);
+
+            // the buffers belong to the graphics queue family once the batch is done
+            VkBufferMemoryBarrier ownership_barrier {};
+            ownership_barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            ownership_barrier.srcQueueFamilyIndex = m_transfer_family;
+            ownership_barrier.dstQueueFamilyIndex = m_graphics_family;
+            ownership_barrier.buffer              = dst_buffer;
+            ownership_barrier.offset              = dst_offset;
+            ownership_barrier.size                = size;
+            batch.m_ownership_barriers.push_back(ownership_barrier);
+            batch.m_has_transfer_commands = true;
+        }
+        else
+        {
+            vkCmdCopyBuffer(batch.m_graphics_command_buffer, staging_buffer, dst_buffer, 1, &copy_region);
+        }
+        return data;
+    }
+
+    void* VulkanUploadQueue::allocateStaging(VkDeviceSize  size,
+                                             VkDeviceSize  alignment,
+                                             VkBuffer&     staging_buffer,
+                                             VkDeviceSize& staging_offset)
+    {
+        VkDeviceSize ring_offset;
+        if (allocateRing(size, alignment, ring_offset))
+        {
+            Batch& batch     = getRecordingBatch();
+            batch.m_ring_end = m_ring_head;
+
+            staging_buffer = m_ring_buffer;
+            staging_offset = ring_offset;
+            return m_ring_data + ring_offset;
+        }
+
+        // larger than the whole ring, the batch owns a staging buffer of its own
+        Batch&        batch = getRecordingBatch();
+        StagingBuffer staging;
+        VulkanUtil::createBuffer(m_rhi->m_physical_device,
+                                 m_device,
+                                 size,
+                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                 staging.m_buffer,
+                                 staging.m_memory);
+        batch.m_dedicated_staging_buffers.push_back(staging);
+        ++m_statistics.m_dedicated_buffer_count;
+
+        // unmapped when the memory is freed
+        void* data = nullptr;
+        vkMapMemory(m_device, staging.m_memory, 0, size, 0, &data);
+
+        staging_buffer = staging.m_buffer;
+        staging_offset = 0;
+        return data;
+    }
+
+    VkCommandBuffer VulkanUploadQueue::getGraphicsCommandBuffer()
+    {
+        return getRecordingBatch().m_graphics_command_buffer;
+    }
+
+    void VulkanUploadQueue::flush()
+    {
+        retire();
+
+        Batch& batch = m_batches[(m_oldest_batch + m_in_flight_batch_count) % k_batch_count];
+        if (!batch.m_is_recording)
+        {
+            return;
+        }
+
+        if (batch.m_has_transfer_commands)
+        {
+            // released by the transfer queue and acquired by the graphics queue
+            std::vector<VkBufferMemoryBarrier>& ownership_barriers = batch.m_ownership_barriers;
+            for (VkBufferMemoryBarrier& barrier : ownership_barriers)
+            {
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = 0;
+            }
+            vkCmdPipelineBarrier(batch.m_transfer_command_buffer,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 static_cast<uint32_t>(ownership_barriers.size()),
+                                 ownership_barriers.data(),
+                                 0,
+                                 nullptr);
+
+            for (VkBufferMemoryBarrier& barrier : ownership_barriers)
+            {
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = k_consumer_access;
+            }
+            vkCmdPipelineBarrier(batch.m_graphics_command_buffer,
+                                 k_consumer_stages,
+                                 k_consumer_stages,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 static_cast<uint32_t>(ownership_barriers.size()),
+                                 ownership_barriers.data(),
+                                 0,
+                                 nullptr);
+        }
+
+        // makes the buffer copies of the graphics queue visible to the frames submitted after the batch, the images
+        // are transitioned to their final layouts by the commands that upload them
+        VkMemoryBarrier memory_barrier {};
+        memory_barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memory_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        memory_barrier.dstAccessMask = k_consumer_access;
+        vkCmdPipelineBarrier(batch.m_graphics_command_buffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             k_consumer_stages,
+                             0,
+                             1,
+                             &memory_barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        vkEndCommandBuffer(batch.m_graphics_command_buffer);
+        if (isTransferQueueEnabled())
+        {
+            vkEndCommandBuffer(batch.m_transfer_command_buffer);
+        }
+
+        if (batch.m_has_transfer_commands)
+        {
+            VkSubmitInfo transfer_submit_info {};
+            transfer_submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            transfer_submit_info.commandBufferCount   = 1;
+            transfer_submit_info.pCommandBuffers      = &batch.m_transfer_command_buffer;
+            transfer_submit_info.signalSemaphoreCount = 1;
+            transfer_submit_info.pSignalSemaphores    = &batch.m_transfer_semaphore;
+            if (vkQueueSubmit(m_transfer_queue, 1, &transfer_submit_info, VK_NULL_HANDLE) != VK_SUCCESS)
+            {
+                LOG_ERROR("vkQueueSubmit of the upload transfer batch failed!");
+            }
+        }
+
+        // the fence of the graphics submission also covers the transfer submission it waits for
+        const VkPipelineStageFlags wait_stage = k_consumer_stages;
+        VkSubmitInfo               graphics_submit_info {};
+        graphics_submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        graphics_submit_info.commandBufferCount = 1;
+        graphics_submit_info.pCommandBuffers    = &batch.m_graphics_command_buffer;
+        if (batch.m_has_transfer_commands)
+        {
+            graphics_submit_info.waitSemaphoreCount = 1;
+            graphics_submit_info.pWaitSemaphores    = &batch.m_transfer_semaphore;
+            graphics_submit_info.pWaitDstStageMask  = &wait_stage;
+        }
+        if (vkQueueSubmit(m_graphics_queue, 1, &graphics_submit_info, batch.m_fence) != VK_SUCCESS)
+        {
+            LOG_ERROR("vkQueueSubmit of the upload batch failed!");
+        }
+
+        batch.m_is_recording = false;
+        ++m_in_flight_batch_count;
+        ++m_statistics.m_submitted_batch_count;
+    }
+
+    void VulkanUploadQueue::retire()
+    {
+        while (m_in_flight_batch_count > 0 &&
+               vkGetFenceStatus(m_device, m_batches[m_oldest_batch].m_fence) == VK_SUCCESS)
+        {
+            retireOldestBatch();
+        }
+    }
+
+    VulkanUploadQueue::Batch& VulkanUploadQueue::getRecordingBatch()
+    {
+        // the slot after the batches in flight is the oldest of them when all are in flight
+        if (m_in_flight_batch_count == k_batch_count)
+        {
+            waitForOldestBatch();
+        }
+
+        Batch& batch = m_batches[(m_oldest_batch + m_in_flight_batch_count) % k_batch_count];
+        if (!batch.m_is_recording)
+        {
+            beginRecording(batch);
+        }
+        return batch;
+    }
+
+    void VulkanUploadQueue::beginRecording(Batch& batch)
+    {
+        VkCommandBufferBeginInfo begin_info {};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkBeginCommandBuffer(batch.m_graphics_command_buffer, &begin_info);
+        if (isTransferQueueEnabled())
+        {
+            vkBeginCommandBuffer(batch.m_transfer_command_buffer, &begin_info);
+        }
+
+        batch.m_ring_end              = m_ring_head;
+        batch.m_is_recording          = true;
+        batch.m_has_transfer_commands = false;
+    }
+
+    bool VulkanUploadQueue::allocateRing(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& ring_offset)
+    {
+        if (size > k_ring_size)
+        {
+            return false;
+        }
+
+        for (;;)
+        {
+            if (m_ring_head == m_ring_tail)
+            {
+                // nothing is in use, start over at the beginning of the ring
+                m_ring_head = alignUp(m_ring_head, k_ring_size);
+                m_ring_tail = m_ring_head;
+            }
+
+            // an allocation does not wrap around the end of the ring
+            uint64_t     ring_start = m_ring_head - m_ring_head % k_ring_size;
+            VkDeviceSize offset     = alignUp(m_ring_head % k_ring_size, alignment);
+            const bool   is_wrapped = offset + size > k_ring_size;
+            if (is_wrapped)
+            {
+                ring_start += k_ring_size;
+                offset = 0;
+            }
+
+            const uint64_t position = ring_start + offset;
+            if (position + size - m_ring_tail <= k_ring_size)
+            {
+                m_ring_head = position + size;
+                ring_offset = offset;
+                m_statistics.m_ring_wrap_count += is_wrapped ? 1 : 0;
+                return true;
+            }
+
+            // the ring is full, only now the cpu waits for the gpu
+            retire();
+            if (m_in_flight_batch_count > 0)
+            {
+                waitForOldestBatch();
+                ++m_statistics.m_full_ring_wait_count;
+            }
+            else
+            {
+                // the batch that records holds the whole ring
+                flush();
+                ++m_statistics.m_full_ring_flush_count;
+            }
+        }
+    }
+
+    void VulkanUploadQueue::waitForOldestBatch()
+    {
+        vkWaitForFences(m_device, 1, &m_batches[m_oldest_batch].m_fence, VK_TRUE, UINT64_MAX);
+        retireOldestBatch();
+    }
+
+    void VulkanUploadQueue::retireOldestBatch()
+    {
+        Batch& batch = m_batches[m_oldest_batch];
+        vkResetFences(m_device, 1, &batch.m_fence);
+
+        for (const StagingBuffer& staging : batch.m_dedicated_staging_buffers)
+        {
+            vkDestroyBuffer(m_device, staging.m_buffer, nullptr);
+            vkFreeMemory(m_device, staging.m_memory, nullptr);
+        }
+        batch.m_dedicated_staging_buffers.clear();
+        batch.m_ownership_barriers.clear();
+
+        // batches that did not allocate from the ring keep the position they started at
+        m_ring_tail = std::max(m_ring_tail, batch.m_ring_end);
+
+        m_oldest_batch = (m_oldest_batch + 1) % k_batch_count;
+        --m_in_flight_batch_count;
+        ++m_statistics.m_retired_batch_count;
+    }
+} // namespace Piccolo
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Piccolo
+{
+    class VulkanRHI;
+
+    /// Uploads buffers and images through a staging ring buffer that stays mapped. The copies are recorded into the
+    /// current batch and submitted together by flush(), a submitted batch gives its range of the ring back once its
+    /// fence has signaled, so that no upload waits for a queue to idle. The cpu only waits when the ring or all the
+    /// batches are in use. Buffer copies go to a dedicated transfer queue when the device has one, everything else
+    /// is recorded for the graphics queue. Only the render thread uploads
+    class VulkanUploadQueue
+    {
+    public:
+        void initialize(VulkanRHI* rhi);
+        /// submits the recorded uploads and waits for all batches
+        void clear();
+
+        /// staging memory for size bytes that the next flush copies into dst_buffer at dst_offset, the caller fills
+        /// it before it calls into the upload queue again
+        void* mapBufferUpload(VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size);
+
+        /// staging memory for size bytes at an offset into staging_buffer that is a multiple of alignment. The
+        /// caller fills it and records the copies out of it into getGraphicsCommandBuffer() before it calls into the
+        /// upload queue again, the allocation may have flushed the batch the command buffer belonged to
+        void* allocateStaging(VkDeviceSize  size,
+                              VkDeviceSize  alignment,
+                              VkBuffer&     staging_buffer,
+                              VkDeviceSize& staging_offset);
+        /// command buffer of the current batch for the graphics queue, for image copies, layout transitions and blits
+        VkCommandBuffer getGraphicsCommandBuffer();
+
+        /// submits the recorded uploads, what is submitted to the graphics queue afterwards sees their results
+        void flush();
+        /// gives back the ring ranges of the batches the gpu has finished, without waiting
+        void retire();
+
+        bool isTransferQueueEnabled() const { return m_transfer_queue != VK_NULL_HANDLE; }
+
+        /// how often the uploads took each path since initialize
+        struct Statistics
+        {
+            uint64_t m_submitted_batch_count {0};
+            uint64_t m_retired_batch_count {0};
+            // allocations that did not fit before the end of the ring and start at its beginning
+            uint64_t m_ring_wrap_count {0};
+            // allocations larger than the ring, each in a staging buffer of its own
+            uint64_t m_dedicated_buffer_count {0};
+            // the ring was full and the cpu waited for the oldest batch in flight
+            uint64_t m_full_ring_wait_count {0};
+            // the ring was full of the recording batch, which was submitted early
+            uint64_t m_full_ring_flush_count {0};
+        };
+
+        const Statistics& getStatistics() const { return m_statistics; }
+
+    private:
+        static constexpr VkDeviceSize k_ring_size   = 64 * 1024 * 1024;
+        static constexpr uint32_t     k_batch_count = 4;
+
+        struct StagingBuffer
+        {
+            VkBuffer       m_buffer {VK_NULL_HANDLE};
+            VkDeviceMemory m_memory {VK_NULL_HANDLE};
+        };
+
+        struct Batch
+        {
+            VkCommandBuffer m_graphics_command_buffer {VK_NULL_HANDLE};
+            VkCommandBuffer m_transfer_command_buffer {VK_NULL_HANDLE};
+            VkFence         m_fence {VK_NULL_HANDLE};
+            // signaled by the transfer queue and waited for by the graphics queue
+            VkSemaphore m_transfer_semaphore {VK_NULL_HANDLE};
+            // ring position after the last allocation of the batch, the ring is free up to it once the batch retires
+            uint64_t m_ring_end {0};
+            // allocations that do not fit into the ring
+            std::vector<StagingBuffer> m_dedicated_staging_buffers;
+            // queue family ownership transfers of the buffers written by the transfer queue
+            std::vector<VkBufferMemoryBarrier> m_ownership_barriers;
+            bool                               m_is_recording {false};
+            bool                               m_has_transfer_commands {false};
+        };
+
+        VulkanRHI* m_rhi {nullptr};
+        VkDevice   m_device {VK_NULL_HANDLE};
+        VkQueue    m_graphics_queue {VK_NULL_HANDLE};
+        VkQueue    m_transfer_queue {VK_NULL_HANDLE};
+        uint32_t   m_graphics_family {0};
+        uint32_t   m_transfer_family {0};
+
+        VkCommandPool m_graphics_command_pool {VK_NULL_HANDLE};
+        VkCommandPool m_transfer_command_pool {VK_NULL_HANDLE};
+
+        VkBuffer       m_ring_buffer {VK_NULL_HANDLE};
+        VkDeviceMemory m_ring_memory {VK_NULL_HANDLE};
+        uint8_t*       m_ring_data {nullptr};
+        // positions grow without wrapping, the ring offset of a position is the position modulo the ring size
+        uint64_t m_ring_head {0};
+        uint64_t m_ring_tail {0};
+
+        // the batches in flight follow the oldest one, the one after them records
+        Batch    m_batches[k_batch_count];
+        uint32_t m_oldest_batch {0};
+        uint32_t m_in_flight_batch_count {0};
+
+        Statistics m_statistics;
+
+        Batch& getRecordingBatch();
+        void   beginRecording(Batch& batch);
+        bool   allocateRing(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& ring_offset);
+        void   waitForOldestBatch();
+        void   retireOldestBatch();
+    };
+} // namespace Piccolo
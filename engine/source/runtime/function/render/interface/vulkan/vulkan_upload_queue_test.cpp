@@ -0,0 +1,457 @@
+#include "runtime/function/render/interface/vulkan/vulkan_upload_queue_test.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
+#include "runtime/function/render/interface/vulkan/vulkan_rhi_resource.h"
+#include "runtime/function/render/interface/vulkan/vulkan_util.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        constexpr uint32_t     k_texture_size            = 512;
+        constexpr VkDeviceSize k_texture_byte_size       = k_texture_size * k_texture_size * 4;
+        constexpr VkDeviceSize k_mebibyte                = 1024 * 1024;
+        constexpr VkDeviceSize k_large_mesh_byte_size    = 96 * k_mebibyte;
+        constexpr VkDeviceSize k_unflushed_byte_size     = 80 * k_mebibyte;
+        constexpr VkDeviceSize k_unflushed_mesh_size     = 8 * k_mebibyte;
+        constexpr uint32_t     k_uploads_per_frame       = 8;
+        constexpr uint32_t     k_meshes_between_textures = 8;
+
+        struct TestMesh
+        {
+            VulkanBuffer   m_rhi_buffer;
+            VkBuffer       m_buffer {VK_NULL_HANDLE};
+            VkDeviceMemory m_memory {VK_NULL_HANDLE};
+            VkDeviceSize   m_size {0};
+            uint32_t       m_seed {0};
+        };
+
+        struct TestTexture
+        {
+            VkImage       m_image {VK_NULL_HANDLE};
+            VkImageView   m_image_view {VK_NULL_HANDLE};
+            VmaAllocation m_allocation {VK_NULL_HANDLE};
+            uint32_t      m_seed {0};
+        };
+
+        void fillPattern(void* data, VkDeviceSize size, uint32_t seed)
+        {
+            uint32_t* words = static_cast<uint32_t*>(data);
+            for (VkDeviceSize word_index = 0; word_index < size / sizeof(uint32_t); ++word_index)
+            {
+                words[word_index] = seed * 2654435761u ^ static_cast<uint32_t>(word_index) * 40503u;
+            }
+        }
+
+        bool isPattern(const void* data, VkDeviceSize size, uint32_t seed)
+        {
+            const uint32_t* words = static_cast<const uint32_t*>(data);
+            for (VkDeviceSize word_index = 0; word_index < size / sizeof(uint32_t); ++word_index)
+            {
+                if (words[word_index] != (seed * 2654435761u ^ static_cast<uint32_t>(word_index) * 40503u))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // the parts of VulkanRHI::initialize the uploads use, without the window, the swapchain and the layers
+        bool createOffscreenDevice(VulkanRHI& rhi)
+        {
+            VkApplicationInfo app_info {};
+            app_info.sType      = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+            app_info.apiVersion = VK_API_VERSION_1_0;
+
+            VkInstanceCreateInfo instance_create_info {};
+            instance_create_info.sType            = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+            instance_create_info.pApplicationInfo = &app_info;
+            if (vkCreateInstance(&instance_create_info, nullptr, &rhi.m_instance) != VK_SUCCESS)
+            {
+                LOG_ERROR("vk create instance for the upload queue test");
+                return false;
+            }
+
+            uint32_t physical_device_count = 0;
+            vkEnumeratePhysicalDevices(rhi.m_instance, &physical_device_count, nullptr);
+            std::vector<VkPhysicalDevice> physical_devices(physical_device_count);
+            vkEnumeratePhysicalDevices(rhi.m_instance, &physical_device_count, physical_devices.data());
+            for (VkPhysicalDevice physical_device : physical_devices)
+            {
+                uint32_t queue_family_count = 0;
+                vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_count, nullptr);
+                std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
+                vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_count, queue_families.data());
+
+                QueueFamilyIndices queue_indices;
+                for (uint32_t family_index = 0; family_index < queue_family_count; ++family_index)
+                {
+                    const VkQueueFlags queue_flags = queue_families[family_index].queueFlags;
+                    if (!queue_indices.graphics_family.has_value() && (queue_flags & VK_QUEUE_GRAPHICS_BIT))
+                    {
+                        queue_indices.graphics_family = family_index;
+                    }
+                    // the same choice as VulkanRHI::findQueueFamilies
+                    const bool is_dedicated = (queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0;
+                    if (!queue_indices.m_transfer_family.has_value() && (queue_flags & VK_QUEUE_TRANSFER_BIT) &&
+                        is_dedicated)
+                    {
+                        queue_indices.m_transfer_family = family_index;
+                    }
+                }
+                if (queue_indices.graphics_family.has_value())
+                {
+                    rhi.m_physical_device = physical_device;
+                    rhi.m_queue_indices   = queue_indices;
+                    break;
+                }
+            }
+            if (rhi.m_physical_device == VK_NULL_HANDLE)
+            {
+                LOG_ERROR("no vulkan device with a graphics queue for the upload queue test");
+                return false;
+            }
+
+            VkPhysicalDeviceProperties physical_device_properties;
+            vkGetPhysicalDeviceProperties(rhi.m_physical_device, &physical_device_properties);
+            LOG_INFO("upload queue test on {}, {}",
+                     physical_device_properties.deviceName,
+                     rhi.m_queue_indices.m_transfer_family.has_value() ? "with a transfer queue" :
+                                                                         "without a transfer queue");
+
+            const float                          queue_priority = 1.0f;
+            std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
+            std::vector<uint32_t>                queue_families {rhi.m_queue_indices.graphics_family.value()};
+            if (rhi.m_queue_indices.m_transfer_family.has_value())
+            {
+                queue_families.push_back(rhi.m_queue_indices.m_transfer_family.value());
+            }
+            for (uint32_t queue_family : queue_families)
+            {
+                VkDeviceQueueCreateInfo queue_create_info {};
+                queue_create_info.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+                queue_create_info.queueFamilyIndex = queue_family;
+                queue_create_info.queueCount       = 1;
+                queue_create_info.pQueuePriorities = &queue_priority;
+                queue_create_infos.push_back(queue_create_info);
+            }
+
+            VkDeviceCreateInfo device_create_info {};
+            device_create_info.sType                = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+            device_create_info.queueCreateInfoCount = static_cast<uint32_t>(queue_create_infos.size());
+            device_create_info.pQueueCreateInfos    = queue_create_infos.data();
+            if (vkCreateDevice(rhi.m_physical_device, &device_create_info, nullptr, &rhi.m_device) != VK_SUCCESS)
+            {
+                LOG_ERROR("vk create device for the upload queue test");
+                return false;
+            }
+
+            VkQueue graphics_queue;
+            vkGetDeviceQueue(rhi.m_device, rhi.m_queue_indices.graphics_family.value(), 0, &graphics_queue);
+            rhi.m_graphics_queue = new VulkanQueue();
+            ((VulkanQueue*)rhi.m_graphics_queue)->setResource(graphics_queue);
+            if (rhi.m_queue_indices.m_transfer_family.has_value())
+            {
+                vkGetDeviceQueue(rhi.m_device, rhi.m_queue_indices.m_transfer_family.value(), 0, &rhi.m_transfer_queue);
+            }
+
+            VmaVulkanFunctions vulkan_functions    = {};
+            vulkan_functions.vkGetInstanceProcAddr = &vkGetInstanceProcAddr;
+            vulkan_functions.vkGetDeviceProcAddr   = &vkGetDeviceProcAddr;
+
+            VmaAllocatorCreateInfo allocator_create_info = {};
+            allocator_create_info.vulkanApiVersion       = VK_API_VERSION_1_0;
+            allocator_create_info.physicalDevice         = rhi.m_physical_device;
+            allocator_create_info.device                 = rhi.m_device;
+            allocator_create_info.instance               = rhi.m_instance;
+            allocator_create_info.pVulkanFunctions       = &vulkan_functions;
+            vmaCreateAllocator(&allocator_create_info, &rhi.m_assets_allocator);
+
+            rhi.m_upload_queue.initialize(&rhi);
+            return true;
+        }
+
+        void destroyOffscreenDevice(VulkanRHI& rhi)
+        {
+            rhi.m_upload_queue.clear();
+            if (rhi.m_assets_allocator != VK_NULL_HANDLE)
+            {
+                vmaDestroyAllocator(rhi.m_assets_allocator);
+            }
+            if (rhi.m_device != VK_NULL_HANDLE)
+            {
+                vkDestroyDevice(rhi.m_device, nullptr);
+            }
+            if (rhi.m_instance != VK_NULL_HANDLE)
+            {
+                vkDestroyInstance(rhi.m_instance, nullptr);
+            }
+            delete rhi.m_graphics_queue;
+            rhi.m_graphics_queue = nullptr;
+        }
+
+        void uploadMesh(VulkanRHI& rhi, TestMesh& mesh, VkDeviceSize size, uint32_t seed)
+        {
+            VulkanUtil::createBuffer(rhi.m_physical_device,
+                                     rhi.m_device,
+                                     size,
+                                     VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                     mesh.m_buffer,
+                                     mesh.m_memory);
+            mesh.m_rhi_buffer.setResource(mesh.m_buffer);
+            mesh.m_size = size;
+            mesh.m_seed = seed;
+
+            fillPattern(rhi.mapUploadBuffer(&mesh.m_rhi_buffer, 0, size), size, seed);
+        }
+
+        void uploadTexture(VulkanRHI& rhi, TestTexture& texture, std::vector<uint32_t>& pixels, uint32_t seed)
+        {
+            fillPattern(pixels.data(), k_texture_byte_size, seed);
+            texture.m_seed = seed;
+            VulkanUtil::createGlobalImage(&rhi,
+                                          texture.m_image,
+                                          texture.m_image_view,
+                                          texture.m_allocation,
+                                          k_texture_size,
+                                          k_texture_size,
+                                          pixels.data(),
+                                          RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM);
+        }
+
+        /// copies what the uploads wrote into a host visible buffer, one blocking submission per resource
+        class Readback
+        {
+        public:
+            Readback(VulkanRHI& rhi, VkDeviceSize size) : m_rhi(rhi)
+            {
+                m_queue = ((VulkanQueue*)rhi.m_graphics_queue)->getResource();
+
+                VkCommandPoolCreateInfo command_pool_create_info {};
+                command_pool_create_info.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                command_pool_create_info.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+                command_pool_create_info.queueFamilyIndex = rhi.m_queue_indices.graphics_family.value();
+                vkCreateCommandPool(rhi.m_device, &command_pool_create_info, nullptr, &m_command_pool);
+
+                VkCommandBufferAllocateInfo command_buffer_allocate_info {};
+                command_buffer_allocate_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                command_buffer_allocate_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                command_buffer_allocate_info.commandPool        = m_command_pool;
+                command_buffer_allocate_info.commandBufferCount = 1;
+                vkAllocateCommandBuffers(rhi.m_device, &command_buffer_allocate_info, &m_command_buffer);
+
+                VulkanUtil::createBuffer(rhi.m_physical_device,
+                                         rhi.m_device,
+                                         size,
+                                         VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                         m_buffer,
+                                         m_memory);
+                vkMapMemory(rhi.m_device, m_memory, 0, VK_WHOLE_SIZE, 0, &m_data);
+            }
+
+            ~Readback()
+            {
+                vkUnmapMemory(m_rhi.m_device, m_memory);
+                vkDestroyBuffer(m_rhi.m_device, m_buffer, nullptr);
+                vkFreeMemory(m_rhi.m_device, m_memory, nullptr);
+                vkDestroyCommandPool(m_rhi.m_device, m_command_pool, nullptr);
+            }
+
+            const void* readBuffer(VkBuffer buffer, VkDeviceSize size)
+            {
+                begin();
+                VkBufferCopy copy_region = {0, 0, size};
+                vkCmdCopyBuffer(m_command_buffer, buffer, m_buffer, 1, &copy_region);
+                return submit();
+            }
+
+            // the first mip, the upload leaves all mips ready to be sampled
+            const void* readTexture(VkImage image, uint32_t width, uint32_t height)
+            {
+                begin();
+                VkImageMemoryBarrier barrier {};
+                barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.srcAccessMask               = VK_ACCESS_SHADER_READ_BIT;
+                barrier.dstAccessMask               = VK_ACCESS_TRANSFER_READ_BIT;
+                barrier.oldLayout                   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                barrier.newLayout                   = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+                barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+                barrier.image                       = image;
+                barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                barrier.subresourceRange.levelCount = 1;
+                barrier.subresourceRange.layerCount = 1;
+                vkCmdPipelineBarrier(m_command_buffer,
+                                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     0,
+                                     0,
+                                     nullptr,
+                                     0,
+                                     nullptr,
+                                     1,
+                                     &barrier);
+
+                VkBufferImageCopy copy_region {};
+                copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                copy_region.imageSubresource.layerCount = 1;
+                copy_region.imageExtent                 = {width, height, 1};
+                vkCmdCopyImageToBuffer(
+                    m_command_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_buffer, 1, &copy_region);
+                return submit();
+            }
+
+        private:
+            void begin()
+            {
+                VkCommandBufferBeginInfo begin_info {};
+                begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                vkBeginCommandBuffer(m_command_buffer, &begin_info);
+            }
+
+            const void* submit()
+            {
+                vkEndCommandBuffer(m_command_buffer);
+
+                VkSubmitInfo submit_info {};
+                submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submit_info.commandBufferCount = 1;
+                submit_info.pCommandBuffers    = &m_command_buffer;
+                vkQueueSubmit(m_queue, 1, &submit_info, VK_NULL_HANDLE);
+                vkQueueWaitIdle(m_queue);
+                return m_data;
+            }
+
+            VulkanRHI&      m_rhi;
+            VkQueue         m_queue {VK_NULL_HANDLE};
+            VkCommandPool   m_command_pool {VK_NULL_HANDLE};
+            VkCommandBuffer m_command_buffer {VK_NULL_HANDLE};
+            VkBuffer        m_buffer {VK_NULL_HANDLE};
+            VkDeviceMemory  m_memory {VK_NULL_HANDLE};
+            void*           m_data {nullptr};
+        };
+    } // namespace
+
+    bool runUploadQueueStressTest(uint32_t mesh_count, uint32_t texture_count)
+    {
+        VulkanRHI rhi;
+        if (!createOffscreenDevice(rhi))
+        {
+            destroyOffscreenDevice(rhi);
+            return false;
+        }
+
+        std::vector<TestMesh>    meshes(1 + k_unflushed_byte_size / k_unflushed_mesh_size + mesh_count);
+        std::vector<TestTexture> textures(texture_count);
+        std::vector<uint32_t>    pixels(k_texture_byte_size / sizeof(uint32_t));
+        uint32_t                 seed = 1;
+
+        // one mesh larger than the ring, then more than the ring holds without a flush in between
+        size_t mesh_index = 0;
+        uploadMesh(rhi, meshes[mesh_index++], k_large_mesh_byte_size, seed++);
+        for (VkDeviceSize unflushed_size = 0; unflushed_size < k_unflushed_byte_size;
+             unflushed_size += k_unflushed_mesh_size)
+        {
+            uploadMesh(rhi, meshes[mesh_index++], k_unflushed_mesh_size, seed++);
+        }
+        rhi.flushUploads();
+
+        // meshes of varying size with a texture now and then, flushed every few uploads like the frames do
+        uint32_t texture_index = 0;
+        uint32_t upload_count  = 0;
+        while (mesh_index < meshes.size() || texture_index < texture_count)
+        {
+            const bool is_texture_next =
+                texture_index < texture_count &&
+                (mesh_index == meshes.size() || upload_count % (k_meshes_between_textures + 1) == 0);
+            if (is_texture_next)
+            {
+                uploadTexture(rhi, textures[texture_index++], pixels, seed++);
+            }
+            else
+            {
+                const VkDeviceSize mesh_size = (256 + mesh_index * 7919 % 1281) * 1024;
+                uploadMesh(rhi, meshes[mesh_index++], mesh_size, seed++);
+            }
+
+            if (++upload_count % k_uploads_per_frame == 0)
+            {
+                rhi.flushUploads();
+            }
+        }
+        rhi.flushUploads();
+        vkDeviceWaitIdle(rhi.m_device);
+        rhi.m_upload_queue.retire();
+
+        uint32_t mismatch_count = 0;
+        {
+            Readback readback(rhi, k_large_mesh_byte_size);
+            for (const TestMesh& mesh : meshes)
+            {
+                if (!isPattern(readback.readBuffer(mesh.m_buffer, mesh.m_size), mesh.m_size, mesh.m_seed))
+                {
+                    LOG_ERROR("mesh {} of {} bytes differs from what was uploaded", mesh.m_seed, mesh.m_size);
+                    ++mismatch_count;
+                }
+            }
+            for (const TestTexture& texture : textures)
+            {
+                const void* texels = readback.readTexture(texture.m_image, k_texture_size, k_texture_size);
+                if (!isPattern(texels, k_texture_byte_size, texture.m_seed))
+                {
+                    LOG_ERROR("texture {} differs from what was uploaded", texture.m_seed);
+                    ++mismatch_count;
+                }
+            }
+        }
+
+        const VulkanUploadQueue::Statistics statistics = rhi.m_upload_queue.getStatistics();
+        LOG_INFO("uploaded {} meshes and {} textures in {} batches: {} retired, {} ring wraps, {} dedicated staging "
+                 "buffers, {} waits and {} flushes on a full ring, {} mismatches",
+                 meshes.size(),
+                 textures.size(),
+                 statistics.m_submitted_batch_count,
+                 statistics.m_retired_batch_count,
+                 statistics.m_ring_wrap_count,
+                 statistics.m_dedicated_buffer_count,
+                 statistics.m_full_ring_wait_count,
+                 statistics.m_full_ring_flush_count,
+                 mismatch_count);
+
+        bool is_passed = mismatch_count == 0;
+        auto check     = [&is_passed](bool is_taken, const char* path) {
+            if (!is_taken)
+            {
+                LOG_ERROR("the uploads never took the path: {}", path);
+                is_passed = false;
+            }
+        };
+        check(statistics.m_ring_wrap_count > 0, "ring wrap, upload more meshes");
+        check(statistics.m_retired_batch_count == statistics.m_submitted_batch_count, "fence retirement");
+        check(statistics.m_dedicated_buffer_count > 0, "dedicated staging buffer");
+        check(statistics.m_full_ring_flush_count > 0, "flush on a full ring");
+
+        for (TestMesh& mesh : meshes)
+        {
+            vkDestroyBuffer(rhi.m_device, mesh.m_buffer, nullptr);
+            vkFreeMemory(rhi.m_device, mesh.m_memory, nullptr);
+        }
+        for (TestTexture& texture : textures)
+        {
+            vkDestroyImageView(rhi.m_device, texture.m_image_view, nullptr);
+            vmaDestroyImage(rhi.m_assets_allocator, texture.m_image, texture.m_allocation);
+        }
+        destroyOffscreenDevice(rhi);
+
+        return is_passed;
+    }
+} // namespace Piccolo
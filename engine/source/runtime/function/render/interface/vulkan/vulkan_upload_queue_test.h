@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Piccolo
+{
+    /**
+     *  Uploads meshes and textures through the staging ring of a VulkanRHI on an offscreen device, the way the render
+     *  resources do: buffers through mapUploadBuffer, textures through VulkanUtil::createGlobalImage with their mip
+     *  chains. One mesh is larger than the ring and a run of meshes is recorded without a flush, the others are
+     *  flushed a few uploads at a time like frames. Afterwards every buffer and the first mip of every texture are
+     *  read back and compared, the run fails on a mismatch or when the ring did not wrap, retire batches, flush on
+     *  full or fall back to a dedicated staging buffer. Needs the log system started and a Vulkan driver, no window
+     *  @mesh_count: meshes of 0.25 to 1.5 MiB, a few hundred wrap the 64 MiB ring several times
+     *  @texture_count: 512x512 rgba textures of 1 MiB
+     */
+    bool runUploadQueueStressTest(uint32_t mesh_count, uint32_t texture_count);
+} // namespace Piccolo
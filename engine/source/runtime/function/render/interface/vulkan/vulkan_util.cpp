@@ -322,22 +322,15 @@ namespace Piccolo
                 break;
         }
 
-        // use staging buffer
-        VkBuffer       inefficient_staging_buffer;
-        VkDeviceMemory inefficient_staging_buffer_memory;
-        VulkanUtil::createBuffer(static_cast<VulkanRHI*>(rhi)->m_physical_device,
-                                 static_cast<VulkanRHI*>(rhi)->m_device,
-                                 texture_byte_size,
-                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                 inefficient_staging_buffer,
-                                 inefficient_staging_buffer_memory);
-
-        void* data;
-        vkMapMemory(
-            static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, 0, texture_byte_size, 0, &data);
+        // staged in the upload ring, the copies run with the next upload batch
+        VulkanUploadQueue& upload_queue = static_cast<VulkanRHI*>(rhi)->m_upload_queue;
+        VkBuffer           staging_buffer;
+        VkDeviceSize       staging_offset;
+        // copies out of a buffer start at multiples of the texel size and of 4
+        const VkDeviceSize texel_byte_size = texture_byte_size / (texture_image_width * texture_image_height);
+        void*              data            = upload_queue.allocateStaging(
+            texture_byte_size, texel_byte_size * 4, staging_buffer, staging_offset);
         memcpy(data, texture_image_pixels, static_cast<size_t>(texture_byte_size));
-        vkUnmapMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory);
 
         // generate mipmapped image
         uint32_t mip_levels =
@@ -371,8 +364,9 @@ namespace Piccolo
                        &image_allocation,
                        NULL);
 
+        VkCommandBuffer command_buffer = upload_queue.getGraphicsCommandBuffer();
         // layout transitions -- image layout is set from none to destination
-        transitionImageLayout(rhi,
+        transitionImageLayout(command_buffer,
                               image,
                               VK_IMAGE_LAYOUT_UNDEFINED,
                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -380,9 +374,10 @@ namespace Piccolo
                               1,
                               VK_IMAGE_ASPECT_COLOR_BIT);
         // copy from staging buffer as destination
-        copyBufferToImage(rhi, inefficient_staging_buffer, image, texture_image_width, texture_image_height, 1);
+        copyBufferToImage(
+            command_buffer, staging_buffer, staging_offset, image, texture_image_width, texture_image_height, 1);
         // layout transitions -- image layout is set from destination to shader_read
-        transitionImageLayout(rhi,
+        transitionImageLayout(command_buffer,
                               image,
                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
@@ -390,11 +385,8 @@ namespace Piccolo
                               1,
                               VK_IMAGE_ASPECT_COLOR_BIT);
 
-        vkDestroyBuffer(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer, nullptr);
-        vkFreeMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, nullptr);
-
         // generate mipmapped image
-        genMipmappedImage(rhi, image, texture_image_width, texture_image_height, mip_levels);
+        genMipmappedImage(command_buffer, image, texture_image_width, texture_image_height, mip_levels);
 
         image_view = createImageView(static_cast<VulkanRHI*>(rhi)->m_device,
                                      image,
@@ -486,29 +478,24 @@ namespace Piccolo
                        &image_allocation,
                        NULL);
 
-        VkBuffer       inefficient_staging_buffer;
-        VkDeviceMemory inefficient_staging_buffer_memory;
-        createBuffer(static_cast<VulkanRHI*>(rhi)->m_physical_device,
-                     static_cast<VulkanRHI*>(rhi)->m_device,
-                     cube_byte_size,
-                     VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                     inefficient_staging_buffer,
-                     inefficient_staging_buffer_memory);
-
-        void* data = NULL;
-        vkMapMemory(
-            static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, 0, cube_byte_size, 0, &data);
+        // staged in the upload ring, the copies run with the next upload batch
+        VulkanUploadQueue& upload_queue = static_cast<VulkanRHI*>(rhi)->m_upload_queue;
+        VkBuffer           staging_buffer;
+        VkDeviceSize       staging_offset;
+        // copies out of a buffer start at multiples of the texel size and of 4
+        const VkDeviceSize texel_byte_size = texture_layer_byte_size / (texture_image_width * texture_image_height);
+        void*              data =
+            upload_queue.allocateStaging(cube_byte_size, texel_byte_size * 4, staging_buffer, staging_offset);
         for (int i = 0; i < 6; i++)
         {
             memcpy((void*)(static_cast<char*>(data) + texture_layer_byte_size * i),
                    texture_image_pixels[i],
                    static_cast<size_t>(texture_layer_byte_size));
         }
-        vkUnmapMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory);
 
+        VkCommandBuffer command_buffer = upload_queue.getGraphicsCommandBuffer();
         // layout transitions -- image layout is set from none to destination
-        transitionImageLayout(rhi,
+        transitionImageLayout(command_buffer,
                               image,
                               VK_IMAGE_LAYOUT_UNDEFINED,
                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -516,18 +503,22 @@ namespace Piccolo
                               miplevels,
                               VK_IMAGE_ASPECT_COLOR_BIT);
         // copy from staging buffer as destination
-        copyBufferToImage(rhi,
-                          inefficient_staging_buffer,
+        copyBufferToImage(command_buffer,
+                          staging_buffer,
+                          staging_offset,
                           image,
                           static_cast<uint32_t>(texture_image_width),
                           static_cast<uint32_t>(texture_image_height),
                           6);
 
-        vkDestroyBuffer(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer, nullptr);
-        vkFreeMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, nullptr);
-
-        generateTextureMipMaps(
-            rhi, image, vulkan_image_format, texture_image_width, texture_image_height, 6, miplevels);
+        generateTextureMipMaps(rhi,
+                               command_buffer,
+                               image,
+                               vulkan_image_format,
+                               texture_image_width,
+                               texture_image_height,
+                               6,
+                               miplevels);
 
         image_view = createImageView(static_cast<VulkanRHI*>(rhi)->m_device,
                                      image,
@@ -538,13 +529,14 @@ namespace Piccolo
                                      miplevels);
     }
 
-    void VulkanUtil::generateTextureMipMaps(RHI*     rhi,
-                                            VkImage  image,
-                                            VkFormat image_format,
-                                            uint32_t texture_width,
-                                            uint32_t texture_height,
-                                            uint32_t layers,
-                                            uint32_t miplevels)
+    void VulkanUtil::generateTextureMipMaps(RHI*            rhi,
+                                            VkCommandBuffer command_buffer,
+                                            VkImage         image,
+                                            VkFormat        image_format,
+                                            uint32_t        texture_width,
+                                            uint32_t        texture_height,
+                                            uint32_t        layers,
+                                            uint32_t        miplevels)
     {
         VkFormatProperties format_properties;
         vkGetPhysicalDeviceFormatProperties(
@@ -555,9 +547,6 @@ namespace Piccolo
             return;
         }
 
-        RHICommandBuffer* rhi_command_buffer = static_cast<VulkanRHI*>(rhi)->beginSingleTimeCommands();
-        VkCommandBuffer command_buffer = ((VulkanCommandBuffer*)rhi_command_buffer)->getResource();
-
         VkImageMemoryBarrier barrier {};
         barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         barrier.image                           = image;
@@ -652,11 +641,9 @@ namespace Piccolo
                              nullptr,
                              1,
                              &barrier);
-
-        static_cast<VulkanRHI*>(rhi)->endSingleTimeCommands(rhi_command_buffer);
     }
 
-    void VulkanUtil::transitionImageLayout(RHI*               rhi,
+    void VulkanUtil::transitionImageLayout(VkCommandBuffer    command_buffer,
                                            VkImage            image,
                                            VkImageLayout      old_layout,
                                            VkImageLayout      new_layout,
@@ -664,15 +651,6 @@ namespace Piccolo
                                            uint32_t           miplevels,
                                            VkImageAspectFlags aspect_mask_bits)
     {
-        if (rhi == nullptr)
-        {
-            LOG_ERROR("rhi is nullptr");
-            return;
-        }
-
-        RHICommandBuffer* rhi_command_buffer = static_cast<VulkanRHI*>(rhi)->beginSingleTimeCommands();
-        VkCommandBuffer command_buffer = ((VulkanCommandBuffer*)rhi_command_buffer)->getResource();
-
         VkImageMemoryBarrier barrier {};
         barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         barrier.oldLayout                       = old_layout;
@@ -742,28 +720,18 @@ namespace Piccolo
         }
 
         vkCmdPipelineBarrier(command_buffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-        static_cast<VulkanRHI*>(rhi)->endSingleTimeCommands(rhi_command_buffer);
     }
 
-    void VulkanUtil::copyBufferToImage(RHI*     rhi,
-                                       VkBuffer buffer,
-                                       VkImage  image,
-                                       uint32_t width,
-                                       uint32_t height,
-                                       uint32_t layer_count)
+    void VulkanUtil::copyBufferToImage(VkCommandBuffer command_buffer,
+                                       VkBuffer        buffer,
+                                       VkDeviceSize    buffer_offset,
+                                       VkImage         image,
+                                       uint32_t        width,
+                                       uint32_t        height,
+                                       uint32_t        layer_count)
     {
-        if (rhi == nullptr)
-        {
-            LOG_ERROR("rhi is nullptr");
-            return;
-        }
-
-        RHICommandBuffer* rhi_command_buffer = static_cast<VulkanRHI*>(rhi)->beginSingleTimeCommands();
-        VkCommandBuffer command_buffer = ((VulkanCommandBuffer*)rhi_command_buffer)->getResource();
-
         VkBufferImageCopy region {};
-        region.bufferOffset                    = 0;
+        region.bufferOffset                    = buffer_offset;
         region.bufferRowLength                 = 0;
         region.bufferImageHeight               = 0;
         region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -774,21 +742,14 @@ namespace Piccolo
         region.imageExtent                     = {width, height, 1};
 
         vkCmdCopyBufferToImage(command_buffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-        static_cast<VulkanRHI*>(rhi)->endSingleTimeCommands(rhi_command_buffer);
     }
 
-    void VulkanUtil::genMipmappedImage(RHI* rhi, VkImage image, uint32_t width, uint32_t height, uint32_t mip_levels)
+    void VulkanUtil::genMipmappedImage(VkCommandBuffer command_buffer,
+                                       VkImage         image,
+                                       uint32_t        width,
+                                       uint32_t        height,
+                                       uint32_t        mip_levels)
     {
-        if (rhi == nullptr)
-        {
-            LOG_ERROR("rhi is nullptr");
-            return;
-        }
-
-        RHICommandBuffer* rhi_command_buffer = static_cast<VulkanRHI*>(rhi)->beginSingleTimeCommands();
-        VkCommandBuffer command_buffer = ((VulkanCommandBuffer*)rhi_command_buffer)->getResource();
-
         for (uint32_t i = 1; i < mip_levels; i++)
         {
             VkImageBlit imageBlit {};
@@ -887,8 +848,6 @@ namespace Piccolo
                              nullptr,
                              1,
                              &barrier);
-
-        static_cast<VulkanRHI*>(rhi)->endSingleTimeCommands(rhi_command_buffer);
     }
 
     VkSampler VulkanUtil::getOrCreateMipmapSampler(VkPhysicalDevice physical_device,
@@ -77,27 +77,33 @@ namespace Piccolo
                                             std::array<void*, 6> texture_image_pixels,
                                             RHIFormat   texture_image_format,
                                             uint32_t             miplevels);
-        static void           generateTextureMipMaps(RHI*     rhi,
-                                                     VkImage  image,
-                                                     VkFormat image_format,
-                                                     uint32_t texture_width,
-                                                     uint32_t texture_height,
-                                                     uint32_t layers,
-                                                     uint32_t miplevels);
-        static void           transitionImageLayout(RHI*               rhi,
+        static void           generateTextureMipMaps(RHI*            rhi,
+                                                     VkCommandBuffer command_buffer,
+                                                     VkImage         image,
+                                                     VkFormat        image_format,
+                                                     uint32_t        texture_width,
+                                                     uint32_t        texture_height,
+                                                     uint32_t        layers,
+                                                     uint32_t        miplevels);
+        static void           transitionImageLayout(VkCommandBuffer    command_buffer,
                                                     VkImage            image,
                                                     VkImageLayout      old_layout,
                                                     VkImageLayout      new_layout,
                                                     uint32_t           layer_count,
                                                     uint32_t           miplevels,
                                                     VkImageAspectFlags aspect_mask_bits);
-        static void           copyBufferToImage(RHI*     rhi,
-                                                VkBuffer buffer,
-                                                VkImage  image,
-                                                uint32_t width,
-                                                uint32_t height,
-                                                uint32_t layer_count);
-        static void genMipmappedImage(RHI* rhi, VkImage image, uint32_t width, uint32_t height, uint32_t mip_levels);
+        static void           copyBufferToImage(VkCommandBuffer command_buffer,
+                                                VkBuffer        buffer,
+                                                VkDeviceSize    buffer_offset,
+                                                VkImage         image,
+                                                uint32_t        width,
+                                                uint32_t        height,
+                                                uint32_t        layer_count);
+        static void           genMipmappedImage(VkCommandBuffer command_buffer,
+                                                VkImage         image,
+                                                uint32_t        width,
+                                                uint32_t        height,
+                                                uint32_t        mip_levels);
 
         static VkSampler
         getOrCreateMipmapSampler(VkPhysicalDevice physical_device, VkDevice device, uint32_t width, uint32_t height);
@@ -1,5 +1,7 @@
 #include "runtime/function/render/passes/color_grading_pass.h"
 
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 #include "runtime/function/render/interface/vulkan/vulkan_util.h"
 
@@ -250,6 +252,8 @@ namespace Piccolo
 
     void ColorGradingPass::draw()
     {
+        PICCOLO_PROFILE_ZONE("ColorGradingPass::draw");
+
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Color Grading", color);
 
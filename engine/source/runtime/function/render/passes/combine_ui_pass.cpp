@@ -1,5 +1,7 @@
 #include "runtime/function/render/passes/combine_ui_pass.h"
 
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 #include "runtime/function/render/interface/vulkan/vulkan_util.h"
 
@@ -249,6 +251,8 @@ namespace Piccolo
 
     void CombineUIPass::draw()
     {
+        PICCOLO_PROFILE_ZONE("CombineUIPass::draw");
+
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Combine UI", color);
 
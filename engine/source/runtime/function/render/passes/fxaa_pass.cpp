@@ -1,5 +1,7 @@
 #include "runtime/function/render/passes/fxaa_pass.h"
 
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/function/render/render_common.h"
 #include "runtime/function/render/render_mesh.h"
 #include "runtime/function/render/render_pass.h"
@@ -237,6 +239,8 @@ namespace Piccolo
 
     void FXAAPass::draw()
     {
+        PICCOLO_PROFILE_ZONE("FXAAPass::draw");
+
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "FXAA", color);
 
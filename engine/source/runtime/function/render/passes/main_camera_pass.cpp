@@ -1,4 +1,7 @@
 #include "runtime/function/render/passes/main_camera_pass.h"
+
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/function/render/render_helper.h"
 #include "runtime/function/render/render_mesh.h"
 #include "runtime/function/render/render_resource.h"
@@ -1918,6 +1921,8 @@ namespace Piccolo
                               ParticlePass&     particle_pass,
                               uint32_t          current_swapchain_image_index)
     {
+        PICCOLO_PROFILE_ZONE("MainCameraPass::draw");
+
         {
             RHIRenderPassBeginInfo renderpass_begin_info {};
             renderpass_begin_info.sType             = RHI_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -2019,6 +2024,8 @@ namespace Piccolo
                                      ParticlePass&     particle_pass,
                                      uint32_t          current_swapchain_image_index)
     {
+        PICCOLO_PROFILE_ZONE("MainCameraPass::drawForward");
+
         {
             RHIRenderPassBeginInfo renderpass_begin_info {};
             renderpass_begin_info.sType             = RHI_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -2102,31 +2109,7 @@ namespace Piccolo
 
     void MainCameraPass::drawMeshGbuffer()
     {
-        struct MeshNode
-        {
-            const Matrix4x4* model_matrix {nullptr};
-            const Matrix4x4* joint_matrices {nullptr};
-            uint32_t         joint_count {0};
-        };
-
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
-
-        // reorganize mesh
-        for (RenderMeshNode& node : *(m_visiable_nodes.p_main_camera_visible_mesh_nodes))
-        {
-            auto& mesh_instanced = main_camera_mesh_drawcall_batch[node.ref_material];
-            auto& mesh_nodes     = mesh_instanced[node.ref_mesh];
-
-            MeshNode temp;
-            temp.model_matrix = node.model_matrix;
-            if (node.enable_vertex_blending)
-            {
-                temp.joint_matrices = node.joint_matrices;
-                temp.joint_count    = node.joint_count;
-            }
-
-            mesh_nodes.push_back(temp);
-        }
+        const RenderDrawList& draw_list = *m_visiable_nodes.p_main_camera_draw_list;
 
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Mesh GBuffer", color);
@@ -2157,75 +2140,116 @@ namespace Piccolo
                 m_global_render_resource->_storage_buffer._global_upload_ringbuffer_memory_pointer) +
             perframe_dynamic_offset)) = m_mesh_perframe_storage_buffer_object;
 
-        for (auto& pair1 : main_camera_mesh_drawcall_batch)
+        const VulkanPBRMaterial* bound_material = nullptr;
+        for (const RenderDrawBatch& batch : draw_list.getBatches())
         {
-            VulkanPBRMaterial& material       = (*pair1.first);
-            auto&              mesh_instanced = pair1.second;
-
-            // bind per material
-            m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                            m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
-                                            2,
-                                            1,
-                                            &material.material_descriptor_set,
-                                            0,
-                                            NULL);
-
-            // TODO: render from near to far
-
-            for (auto& pair2 : mesh_instanced)
+            VulkanPBRMaterial&    material   = *batch.m_material;
+            VulkanMesh&           mesh       = *batch.m_mesh;
+            const RenderMeshNode* mesh_nodes = draw_list.getNodes().data() + batch.m_first_node;
+
+            // bind per material, the batches of a material are sorted next to each other
+            if (&material != bound_material)
             {
-                VulkanMesh& mesh       = (*pair2.first);
-                auto&       mesh_nodes = pair2.second;
+                m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
+                                                2,
+                                                1,
+                                                &material.material_descriptor_set,
+                                                0,
+                                                NULL);
+                bound_material = &material;
+            }
 
-                uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-                if (total_instance_count > 0)
+            uint32_t total_instance_count = batch.m_node_count;
+            if (total_instance_count > 0)
+            {
+                // bind per mesh
+                m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
+                                                1,
+                                                1,
+                                                &mesh.mesh_vertex_blending_descriptor_set,
+                                                0,
+                                                NULL);
+
+
+                RHIBuffer* vertex_buffers[] = {mesh.mesh_vertex_position_buffer,
+                                             mesh.mesh_vertex_varying_enable_blending_buffer,
+                                             mesh.mesh_vertex_varying_buffer};
+                RHIDeviceSize offsets[]        = {0, 0, 0};
+                m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(),
+                                               0,
+                                               (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
+                                               vertex_buffers,
+                                               offsets);
+                m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, mesh.mesh_index_type);
+
+                uint32_t drawcall_max_instance_count =
+                    (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) /
+                     sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
+                uint32_t drawcall_count =
+                    roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
+
+                for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index)
                 {
-                    // bind per mesh
-                    m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                    m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
-                                                    1,
-                                                    1,
-                                                    &mesh.mesh_vertex_blending_descriptor_set,
-                                                    0,
-                                                    NULL);
-
-
-                    RHIBuffer* vertex_buffers[] = {mesh.mesh_vertex_position_buffer,
-                                                 mesh.mesh_vertex_varying_enable_blending_buffer,
-                                                 mesh.mesh_vertex_varying_buffer};
-                    RHIDeviceSize offsets[]        = {0, 0, 0};
-                    m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(),
-                                                   0,
-                                                   (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
-                                                   vertex_buffers,
-                                                   offsets);
-                    m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
-                    uint32_t drawcall_max_instance_count =
-                        (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) /
-                         sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
-                    uint32_t drawcall_count =
-                        roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
-
-                    for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index)
+                    uint32_t current_instance_count =
+                        ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
+                         drawcall_max_instance_count) ?
+                            (total_instance_count - drawcall_max_instance_count * drawcall_index) :
+                            drawcall_max_instance_count;
+
+                    // per drawcall storage buffer
+                    uint32_t perdrawcall_dynamic_offset =
+                        roundUp(m_global_render_resource->_storage_buffer
+                                    ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+                                m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
+                    m_global_render_resource->_storage_buffer
+                        ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
+                        perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
+                    assert(m_global_render_resource->_storage_buffer
+                               ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
+                           (m_global_render_resource->_storage_buffer
+                                ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
+                            m_global_render_resource->_storage_buffer
+                                ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
+
+                    MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
+                        (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
+                            reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
+                                                            ._global_upload_ringbuffer_memory_pointer) +
+                            perdrawcall_dynamic_offset));
+                    for (uint32_t i = 0; i < current_instance_count; ++i)
+                    {
+                        perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
+                            *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
+                        perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
+                            mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
+                                                                                                          -1.0;
+                    }
+
+                    // per drawcall vertex blending storage buffer
+                    uint32_t per_drawcall_vertex_blending_dynamic_offset;
+                    bool     least_one_enable_vertex_blending = true;
+                    for (uint32_t i = 0; i < current_instance_count; ++i)
+                    {
+                        if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
+                        {
+                            least_one_enable_vertex_blending = false;
+                            break;
+                        }
+                    }
+                    if (least_one_enable_vertex_blending)
                     {
-                        uint32_t current_instance_count =
-                            ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
-                             drawcall_max_instance_count) ?
-                                (total_instance_count - drawcall_max_instance_count * drawcall_index) :
-                                drawcall_max_instance_count;
-
-                        // per drawcall storage buffer
-                        uint32_t perdrawcall_dynamic_offset =
+                        per_drawcall_vertex_blending_dynamic_offset =
                             roundUp(m_global_render_resource->_storage_buffer
                                         ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
                                     m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
                         m_global_render_resource->_storage_buffer
                             ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                            perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
+                            per_drawcall_vertex_blending_dynamic_offset +
+                            sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
                         assert(m_global_render_resource->_storage_buffer
                                    ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
                                (m_global_render_resource->_storage_buffer
@@ -2233,95 +2257,52 @@ namespace Piccolo
                                 m_global_render_resource->_storage_buffer
                                     ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
 
-                        MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
-                            (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
-                                reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                ._global_upload_ringbuffer_memory_pointer) +
-                                perdrawcall_dynamic_offset));
+                        MeshPerdrawcallVertexBlendingStorageBufferObject&
+                            per_drawcall_vertex_blending_storage_buffer_object =
+                                (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
+                                    reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
+                                                                    ._global_upload_ringbuffer_memory_pointer) +
+                                    per_drawcall_vertex_blending_dynamic_offset));
                         for (uint32_t i = 0; i < current_instance_count; ++i)
                         {
-                            perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
-                                *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-                            perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
-                                mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
-                                                                                                              -1.0;
-                        }
-
-                        // per drawcall vertex blending storage buffer
-                        uint32_t per_drawcall_vertex_blending_dynamic_offset;
-                        bool     least_one_enable_vertex_blending = true;
-                        for (uint32_t i = 0; i < current_instance_count; ++i)
-                        {
-                            if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
-                            {
-                                least_one_enable_vertex_blending = false;
-                                break;
-                            }
-                        }
-                        if (least_one_enable_vertex_blending)
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset =
-                                roundUp(m_global_render_resource->_storage_buffer
-                                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-                                        m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
-                            m_global_render_resource->_storage_buffer
-                                ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                                per_drawcall_vertex_blending_dynamic_offset +
-                                sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
-                            assert(m_global_render_resource->_storage_buffer
-                                       ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                                   (m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                    m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
-
-                            MeshPerdrawcallVertexBlendingStorageBufferObject&
-                                per_drawcall_vertex_blending_storage_buffer_object =
-                                    (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
-                                        reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                        ._global_upload_ringbuffer_memory_pointer) +
-                                        per_drawcall_vertex_blending_dynamic_offset));
-                            for (uint32_t i = 0; i < current_instance_count; ++i)
+                            if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
                             {
-                                if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
+                                for (uint32_t j = 0;
+                                     j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count;
+                                     ++j)
                                 {
-                                    for (uint32_t j = 0;
-                                         j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count;
-                                         ++j)
-                                    {
-                                        per_drawcall_vertex_blending_storage_buffer_object
-                                            .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] =
-                                            mesh_nodes[drawcall_max_instance_count * drawcall_index + i]
-                                                .joint_matrices[j];
-                                    }
+                                    per_drawcall_vertex_blending_storage_buffer_object
+                                        .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] =
+                                        mesh_nodes[drawcall_max_instance_count * drawcall_index + i]
+                                            .joint_matrices[j];
                                 }
                             }
                         }
-                        else
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset = 0;
-                        }
-
-                        // bind perdrawcall
-                        uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
-                                                       perdrawcall_dynamic_offset,
-                                                       per_drawcall_vertex_blending_dynamic_offset};
-                        m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                        m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
-                                                        0,
-                                                        1,
-                                                        &m_descriptor_infos[_mesh_global].descriptor_set,
-                                                        3,
-                                                        dynamic_offsets);
-
-                        m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
-                                                 mesh.mesh_index_count,
-                                                 current_instance_count,
-                                                 0,
-                                                 0,
-                                                 0);
                     }
+                    else
+                    {
+                        per_drawcall_vertex_blending_dynamic_offset = 0;
+                    }
+
+                    // bind perdrawcall
+                    uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
+                                                   perdrawcall_dynamic_offset,
+                                                   per_drawcall_vertex_blending_dynamic_offset};
+                    m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                    m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
+                                                    0,
+                                                    1,
+                                                    &m_descriptor_infos[_mesh_global].descriptor_set,
+                                                    3,
+                                                    dynamic_offsets);
+
+                    m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
+                                             mesh.mesh_index_count,
+                                             current_instance_count,
+                                             0,
+                                             0,
+                                             0);
                 }
             }
         }
@@ -2375,31 +2356,7 @@ namespace Piccolo
 
     void MainCameraPass::drawMeshLighting()
     {
-        struct MeshNode
-        {
-            const Matrix4x4* model_matrix {nullptr};
-            const Matrix4x4* joint_matrices {nullptr};
-            uint32_t         joint_count {0};
-        };
-
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
-
-        // reorganize mesh
-        for (RenderMeshNode& node : *(m_visiable_nodes.p_main_camera_visible_mesh_nodes))
-        {
-            auto& mesh_instanced = main_camera_mesh_drawcall_batch[node.ref_material];
-            auto& mesh_nodes     = mesh_instanced[node.ref_mesh];
-
-            MeshNode temp;
-            temp.model_matrix = node.model_matrix;
-            if (node.enable_vertex_blending)
-            {
-                temp.joint_matrices = node.joint_matrices;
-                temp.joint_count    = node.joint_count;
-            }
-
-            mesh_nodes.push_back(temp);
-        }
+        const RenderDrawList& draw_list = *m_visiable_nodes.p_main_camera_draw_list;
 
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Model", color);
@@ -2430,74 +2387,115 @@ namespace Piccolo
                 m_global_render_resource->_storage_buffer._global_upload_ringbuffer_memory_pointer) +
             perframe_dynamic_offset)) = m_mesh_perframe_storage_buffer_object;
 
-        for (auto& pair1 : main_camera_mesh_drawcall_batch)
+        const VulkanPBRMaterial* bound_material = nullptr;
+        for (const RenderDrawBatch& batch : draw_list.getBatches())
         {
-            VulkanPBRMaterial& material       = (*pair1.first);
-            auto&              mesh_instanced = pair1.second;
-
-            // bind per material
-            m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                            m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
-                                            2,
-                                            1,
-                                            &material.material_descriptor_set,
-                                            0,
-                                            NULL);
-
-            // TODO: render from near to far
-
-            for (auto& pair2 : mesh_instanced)
+            VulkanPBRMaterial&    material   = *batch.m_material;
+            VulkanMesh&           mesh       = *batch.m_mesh;
+            const RenderMeshNode* mesh_nodes = draw_list.getNodes().data() + batch.m_first_node;
+
+            // bind per material, the batches of a material are sorted next to each other
+            if (&material != bound_material)
             {
-                VulkanMesh& mesh       = (*pair2.first);
-                auto&       mesh_nodes = pair2.second;
+                m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
+                                                2,
+                                                1,
+                                                &material.material_descriptor_set,
+                                                0,
+                                                NULL);
+                bound_material = &material;
+            }
 
-                uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-                if (total_instance_count > 0)
+            uint32_t total_instance_count = batch.m_node_count;
+            if (total_instance_count > 0)
+            {
+                // bind per mesh
+                m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
+                                                1,
+                                                1,
+                                                &mesh.mesh_vertex_blending_descriptor_set,
+                                                0,
+                                                NULL);
+
+                RHIBuffer*     vertex_buffers[3] = {mesh.mesh_vertex_position_buffer,
+                                             mesh.mesh_vertex_varying_enable_blending_buffer,
+                                             mesh.mesh_vertex_varying_buffer};
+                RHIDeviceSize offsets[]        = {0, 0, 0};
+                m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(),
+                                               0,
+                                               (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
+                                               vertex_buffers,
+                                               offsets);
+                m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, mesh.mesh_index_type);
+
+                uint32_t drawcall_max_instance_count =
+                    (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) /
+                     sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
+                uint32_t drawcall_count =
+                    roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
+
+                for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index)
                 {
-                    // bind per mesh
-                    m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                    m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
-                                                    1,
-                                                    1,
-                                                    &mesh.mesh_vertex_blending_descriptor_set,
-                                                    0,
-                                                    NULL);
-
-                    RHIBuffer*     vertex_buffers[3] = {mesh.mesh_vertex_position_buffer,
-                                                 mesh.mesh_vertex_varying_enable_blending_buffer,
-                                                 mesh.mesh_vertex_varying_buffer};
-                    RHIDeviceSize offsets[]        = {0, 0, 0};
-                    m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(),
-                                                   0,
-                                                   (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
-                                                   vertex_buffers,
-                                                   offsets);
-                    m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
-                    uint32_t drawcall_max_instance_count =
-                        (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) /
-                         sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
-                    uint32_t drawcall_count =
-                        roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
-
-                    for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index)
+                    uint32_t current_instance_count =
+                        ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
+                         drawcall_max_instance_count) ?
+                            (total_instance_count - drawcall_max_instance_count * drawcall_index) :
+                            drawcall_max_instance_count;
+
+                    // per drawcall storage buffer
+                    uint32_t perdrawcall_dynamic_offset =
+                        roundUp(m_global_render_resource->_storage_buffer
+                                    ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+                                m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
+                    m_global_render_resource->_storage_buffer
+                        ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
+                        perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
+                    assert(m_global_render_resource->_storage_buffer
+                               ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
+                           (m_global_render_resource->_storage_buffer
+                                ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
+                            m_global_render_resource->_storage_buffer
+                                ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
+
+                    MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
+                        (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
+                            reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
+                                                            ._global_upload_ringbuffer_memory_pointer) +
+                            perdrawcall_dynamic_offset));
+                    for (uint32_t i = 0; i < current_instance_count; ++i)
+                    {
+                        perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
+                            *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
+                        perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
+                            mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
+                                                                                                          -1.0;
+                    }
+
+                    // per drawcall vertex blending storage buffer
+                    uint32_t per_drawcall_vertex_blending_dynamic_offset;
+                    bool     least_one_enable_vertex_blending = true;
+                    for (uint32_t i = 0; i < current_instance_count; ++i)
                     {
-                        uint32_t current_instance_count =
-                            ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
-                             drawcall_max_instance_count) ?
-                                (total_instance_count - drawcall_max_instance_count * drawcall_index) :
-                                drawcall_max_instance_count;
-
-                        // per drawcall storage buffer
-                        uint32_t perdrawcall_dynamic_offset =
+                        if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
+                        {
+                            least_one_enable_vertex_blending = false;
+                            break;
+                        }
+                    }
+                    if (least_one_enable_vertex_blending)
+                    {
+                        per_drawcall_vertex_blending_dynamic_offset =
                             roundUp(m_global_render_resource->_storage_buffer
                                         ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
                                     m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
                         m_global_render_resource->_storage_buffer
                             ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                            perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
+                            per_drawcall_vertex_blending_dynamic_offset +
+                            sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
                         assert(m_global_render_resource->_storage_buffer
                                    ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
                                (m_global_render_resource->_storage_buffer
@@ -2505,95 +2503,52 @@ namespace Piccolo
                                 m_global_render_resource->_storage_buffer
                                     ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
 
-                        MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
-                            (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
-                                reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                ._global_upload_ringbuffer_memory_pointer) +
-                                perdrawcall_dynamic_offset));
-                        for (uint32_t i = 0; i < current_instance_count; ++i)
-                        {
-                            perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
-                                *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-                            perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
-                                mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
-                                                                                                              -1.0;
-                        }
-
-                        // per drawcall vertex blending storage buffer
-                        uint32_t per_drawcall_vertex_blending_dynamic_offset;
-                        bool     least_one_enable_vertex_blending = true;
+                        MeshPerdrawcallVertexBlendingStorageBufferObject&
+                            per_drawcall_vertex_blending_storage_buffer_object =
+                                (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
+                                    reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
+                                                                    ._global_upload_ringbuffer_memory_pointer) +
+                                    per_drawcall_vertex_blending_dynamic_offset));
                         for (uint32_t i = 0; i < current_instance_count; ++i)
                         {
-                            if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
-                            {
-                                least_one_enable_vertex_blending = false;
-                                break;
-                            }
-                        }
-                        if (least_one_enable_vertex_blending)
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset =
-                                roundUp(m_global_render_resource->_storage_buffer
-                                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-                                        m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
-                            m_global_render_resource->_storage_buffer
-                                ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                                per_drawcall_vertex_blending_dynamic_offset +
-                                sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
-                            assert(m_global_render_resource->_storage_buffer
-                                       ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                                   (m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                    m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
-
-                            MeshPerdrawcallVertexBlendingStorageBufferObject&
-                                per_drawcall_vertex_blending_storage_buffer_object =
-                                    (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
-                                        reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                        ._global_upload_ringbuffer_memory_pointer) +
-                                        per_drawcall_vertex_blending_dynamic_offset));
-                            for (uint32_t i = 0; i < current_instance_count; ++i)
+                            if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
                             {
-                                if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
+                                for (uint32_t j = 0;
+                                     j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count;
+                                     ++j)
                                 {
-                                    for (uint32_t j = 0;
-                                         j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count;
-                                         ++j)
-                                    {
-                                        per_drawcall_vertex_blending_storage_buffer_object
-                                            .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] =
-                                            mesh_nodes[drawcall_max_instance_count * drawcall_index + i]
-                                                .joint_matrices[j];
-                                    }
+                                    per_drawcall_vertex_blending_storage_buffer_object
+                                        .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] =
+                                        mesh_nodes[drawcall_max_instance_count * drawcall_index + i]
+                                            .joint_matrices[j];
                                 }
                             }
                         }
-                        else
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset = 0;
-                        }
-
-                        // bind perdrawcall
-                        uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
-                                                       perdrawcall_dynamic_offset,
-                                                       per_drawcall_vertex_blending_dynamic_offset};
-                        m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                        m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
-                                                        0,
-                                                        1,
-                                                        &m_descriptor_infos[_mesh_global].descriptor_set,
-                                                        3,
-                                                        dynamic_offsets);
-
-                        m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
-                                                 mesh.mesh_index_count,
-                                                 current_instance_count,
-                                                 0,
-                                                 0,
-                                                 0);
                     }
+                    else
+                    {
+                        per_drawcall_vertex_blending_dynamic_offset = 0;
+                    }
+
+                    // bind perdrawcall
+                    uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
+                                                   perdrawcall_dynamic_offset,
+                                                   per_drawcall_vertex_blending_dynamic_offset};
+                    m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                    m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
+                                                    0,
+                                                    1,
+                                                    &m_descriptor_infos[_mesh_global].descriptor_set,
+                                                    3,
+                                                    dynamic_offsets);
+
+                    m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
+                                             mesh.mesh_index_count,
+                                             current_instance_count,
+                                             0,
+                                             0,
+                                             0);
                 }
             }
         }
@@ -2697,7 +2652,7 @@ namespace Piccolo
         m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(),
                                      m_visiable_nodes.p_axis_node->ref_mesh->mesh_index_buffer,
                                      0,
-                                     RHI_INDEX_TYPE_UINT16);
+                                     m_visiable_nodes.p_axis_node->ref_mesh->mesh_index_type);
         (*reinterpret_cast<AxisStorageBufferObject*>(reinterpret_cast<uintptr_t>(
             m_global_render_resource->_storage_buffer._axis_inefficient_storage_buffer_memory_pointer))) =
             m_axis_storage_buffer_object;
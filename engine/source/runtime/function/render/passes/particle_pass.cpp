@@ -1,5 +1,7 @@
 #include "runtime/function/render/passes/particle_pass.h"
 
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 #include "runtime/function/render/interface/vulkan/vulkan_util.h"
 
@@ -308,6 +310,8 @@ namespace Piccolo
 
     void ParticlePass::draw()
     {
+        PICCOLO_PROFILE_ZONE("ParticlePass::draw");
+
         for (int i = 0; i < m_emitter_count; ++i)
         {
             float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
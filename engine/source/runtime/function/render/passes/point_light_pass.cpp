@@ -1,5 +1,7 @@
 #include "runtime/function/render/passes/point_light_pass.h"
 
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/function/render/render_helper.h"
 #include "runtime/function/render/render_mesh.h"
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
@@ -40,6 +42,8 @@ namespace Piccolo
     }
     void PointLightShadowPass::draw()
     {
+        PICCOLO_PROFILE_ZONE("PointLightShadowPass::draw");
+
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Point Light Shadow", color);
 
@@ -469,31 +473,7 @@ namespace Piccolo
     }
     void PointLightShadowPass::drawModel()
     {
-        struct MeshNode
-        {
-            const Matrix4x4* model_matrix {nullptr};
-            const Matrix4x4* joint_matrices {nullptr};
-            uint32_t         joint_count {0};
-        };
-
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> point_lights_mesh_drawcall_batch;
-
-        // reorganize mesh
-        for (RenderMeshNode& node : *(m_visiable_nodes.p_point_lights_visible_mesh_nodes))
-        {
-            auto& mesh_instanced = point_lights_mesh_drawcall_batch[node.ref_material];
-            auto& mesh_nodes     = mesh_instanced[node.ref_mesh];
-
-            MeshNode temp;
-            temp.model_matrix = node.model_matrix;
-            if (node.enable_vertex_blending)
-            {
-                temp.joint_matrices = node.joint_matrices;
-                temp.joint_count    = node.joint_count;
-            }
-
-            mesh_nodes.push_back(temp);
-        }
+        const RenderDrawList& draw_list = *m_visiable_nodes.p_point_lights_draw_list;
 
         RHIRenderPassBeginInfo renderpass_begin_info {};
         renderpass_begin_info.sType             = RHI_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -538,59 +518,94 @@ namespace Piccolo
                     perframe_dynamic_offset));
             perframe_storage_buffer_object = m_mesh_point_light_shadow_perframe_storage_buffer_object;
 
-            for (auto& pair1 : point_lights_mesh_drawcall_batch)
+            for (const RenderDrawBatch& batch : draw_list.getBatches())
             {
-                VulkanPBRMaterial& material       = (*pair1.first);
-                auto&              mesh_instanced = pair1.second;
+                VulkanMesh&           mesh       = *batch.m_mesh;
+                const RenderMeshNode* mesh_nodes = draw_list.getNodes().data() + batch.m_first_node;
 
-                // TODO: render from near to far
-
-                for (auto& pair2 : mesh_instanced)
+                uint32_t total_instance_count = batch.m_node_count;
+                if (total_instance_count > 0)
                 {
-                    VulkanMesh& mesh       = (*pair2.first);
-                    auto&       mesh_nodes = pair2.second;
-
-                    uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-                    if (total_instance_count > 0)
+                    // bind per mesh
+                    m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                    m_render_pipelines[0].layout,
+                                                    1,
+                                                    1,
+                                                    &mesh.mesh_vertex_blending_descriptor_set,
+                                                    0,
+                                                    NULL);
+
+                    RHIBuffer*     vertex_buffers[] = {mesh.mesh_vertex_position_buffer};
+                    RHIDeviceSize offsets[]        = {0};
+                    m_rhi->cmdBindVertexBuffersPFN(
+                        m_rhi->getCurrentCommandBuffer(), 0, 1, vertex_buffers, offsets);
+                    m_rhi->cmdBindIndexBufferPFN(
+                        m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, mesh.mesh_index_type);
+
+                    uint32_t drawcall_max_instance_count =
+                        (sizeof(MeshPointLightShadowPerdrawcallStorageBufferObject::mesh_instances) /
+                         sizeof(MeshPointLightShadowPerdrawcallStorageBufferObject::mesh_instances[0]));
+                    uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
+
+                    for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index)
                     {
-                        // bind per mesh
-                        m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                        m_render_pipelines[0].layout,
-                                                        1,
-                                                        1,
-                                                        &mesh.mesh_vertex_blending_descriptor_set,
-                                                        0,
-                                                        NULL);
-
-                        RHIBuffer*     vertex_buffers[] = {mesh.mesh_vertex_position_buffer};
-                        RHIDeviceSize offsets[]        = {0};
-                        m_rhi->cmdBindVertexBuffersPFN(
-                            m_rhi->getCurrentCommandBuffer(), 0, 1, vertex_buffers, offsets);
-                        m_rhi->cmdBindIndexBufferPFN(
-                            m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
-                        uint32_t drawcall_max_instance_count =
-                            (sizeof(MeshPointLightShadowPerdrawcallStorageBufferObject::mesh_instances) /
-                             sizeof(MeshPointLightShadowPerdrawcallStorageBufferObject::mesh_instances[0]));
-                        uint32_t drawcall_count = roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
+                        uint32_t current_instance_count =
+                            ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
+                             drawcall_max_instance_count) ?
+                                (total_instance_count - drawcall_max_instance_count * drawcall_index) :
+                                drawcall_max_instance_count;
+
+                        // perdrawcall storage buffer
+                        uint32_t perdrawcall_dynamic_offset =
+                            roundUp(m_global_render_resource->_storage_buffer
+                                        ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+                                    m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
+                        m_global_render_resource->_storage_buffer
+                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
+                            perdrawcall_dynamic_offset + sizeof(MeshPointLightShadowPerdrawcallStorageBufferObject);
+                        assert(m_global_render_resource->_storage_buffer
+                                   ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
+                               (m_global_render_resource->_storage_buffer
+                                    ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
+                                m_global_render_resource->_storage_buffer
+                                    ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
+
+                        MeshPointLightShadowPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
+                            (*reinterpret_cast<MeshPointLightShadowPerdrawcallStorageBufferObject*>(
+                                reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
+                                                                ._global_upload_ringbuffer_memory_pointer) +
+                                perdrawcall_dynamic_offset));
+                        for (uint32_t i = 0; i < current_instance_count; ++i)
+                        {
+                            perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
+                                *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
+                            perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
+                                mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
+                                                                                                              -1.0;
+                        }
 
-                        for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index)
+                        // per drawcall vertex blending storage buffer
+                        uint32_t per_drawcall_vertex_blending_dynamic_offset;
+                        bool     least_one_enable_vertex_blending = true;
+                        for (uint32_t i = 0; i < current_instance_count; ++i)
+                        {
+                            if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
+                            {
+                                least_one_enable_vertex_blending = false;
+                                break;
+                            }
+                        }
+                        if (mesh.enable_vertex_blending)
                         {
-                            uint32_t current_instance_count =
-                                ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
-                                 drawcall_max_instance_count) ?
-                                    (total_instance_count - drawcall_max_instance_count * drawcall_index) :
-                                    drawcall_max_instance_count;
-
-                            // perdrawcall storage buffer
-                            uint32_t perdrawcall_dynamic_offset =
-                                roundUp(m_global_render_resource->_storage_buffer
-                                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-                                        m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
+                            per_drawcall_vertex_blending_dynamic_offset = roundUp(
+                                m_global_render_resource->_storage_buffer
+                                    ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+                                m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
                             m_global_render_resource->_storage_buffer
                                 ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                                perdrawcall_dynamic_offset + sizeof(MeshPointLightShadowPerdrawcallStorageBufferObject);
+                                per_drawcall_vertex_blending_dynamic_offset +
+                                sizeof(MeshPointLightShadowPerdrawcallVertexBlendingStorageBufferObject);
                             assert(m_global_render_resource->_storage_buffer
                                        ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
                                    (m_global_render_resource->_storage_buffer
@@ -598,97 +613,54 @@ namespace Piccolo
                                     m_global_render_resource->_storage_buffer
                                         ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
 
-                            MeshPointLightShadowPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
-                                (*reinterpret_cast<MeshPointLightShadowPerdrawcallStorageBufferObject*>(
-                                    reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                    ._global_upload_ringbuffer_memory_pointer) +
-                                    perdrawcall_dynamic_offset));
-                            for (uint32_t i = 0; i < current_instance_count; ++i)
-                            {
-                                perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
-                                    *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-                                perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
-                                    mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
-                                                                                                                  -1.0;
-                            }
-
-                            // per drawcall vertex blending storage buffer
-                            uint32_t per_drawcall_vertex_blending_dynamic_offset;
-                            bool     least_one_enable_vertex_blending = true;
+                            MeshPointLightShadowPerdrawcallVertexBlendingStorageBufferObject&
+                                per_drawcall_vertex_blending_storage_buffer_object =
+                                    (*reinterpret_cast<
+                                        MeshPointLightShadowPerdrawcallVertexBlendingStorageBufferObject*>(
+                                        reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
+                                                                        ._global_upload_ringbuffer_memory_pointer) +
+                                        per_drawcall_vertex_blending_dynamic_offset));
                             for (uint32_t i = 0; i < current_instance_count; ++i)
                             {
-                                if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
+                                if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
                                 {
-                                    least_one_enable_vertex_blending = false;
-                                    break;
-                                }
-                            }
-                            if (mesh.enable_vertex_blending)
-                            {
-                                per_drawcall_vertex_blending_dynamic_offset = roundUp(
-                                    m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-                                    m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
-                                m_global_render_resource->_storage_buffer
-                                    ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                                    per_drawcall_vertex_blending_dynamic_offset +
-                                    sizeof(MeshPointLightShadowPerdrawcallVertexBlendingStorageBufferObject);
-                                assert(m_global_render_resource->_storage_buffer
-                                           ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                                       (m_global_render_resource->_storage_buffer
-                                            ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                        m_global_render_resource->_storage_buffer
-                                            ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
-
-                                MeshPointLightShadowPerdrawcallVertexBlendingStorageBufferObject&
-                                    per_drawcall_vertex_blending_storage_buffer_object =
-                                        (*reinterpret_cast<
-                                            MeshPointLightShadowPerdrawcallVertexBlendingStorageBufferObject*>(
-                                            reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                            ._global_upload_ringbuffer_memory_pointer) +
-                                            per_drawcall_vertex_blending_dynamic_offset));
-                                for (uint32_t i = 0; i < current_instance_count; ++i)
-                                {
-                                    if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
+                                    for (uint32_t j = 0;
+                                         j <
+                                         mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count;
+                                         ++j)
                                     {
-                                        for (uint32_t j = 0;
-                                             j <
-                                             mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count;
-                                             ++j)
-                                        {
-                                            per_drawcall_vertex_blending_storage_buffer_object
-                                                .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] =
-                                                mesh_nodes[drawcall_max_instance_count * drawcall_index + i]
-                                                    .joint_matrices[j];
-                                        }
+                                        per_drawcall_vertex_blending_storage_buffer_object
+                                            .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] =
+                                            mesh_nodes[drawcall_max_instance_count * drawcall_index + i]
+                                                .joint_matrices[j];
                                     }
                                 }
                             }
-                            else
-                            {
-                                per_drawcall_vertex_blending_dynamic_offset = 0;
-                            }
-
-                            // bind perdrawcall
-                            uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
-                                                           perdrawcall_dynamic_offset,
-                                                           per_drawcall_vertex_blending_dynamic_offset};
-                            m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                            m_render_pipelines[0].layout,
-                                                            0,
-                                                            1,
-                                                            &m_descriptor_infos[0].descriptor_set,
-                                                            (sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0])),
-                                                            dynamic_offsets);
-
-                            m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
-                                                     mesh.mesh_index_count,
-                                                     current_instance_count,
-                                                     0,
-                                                     0,
-                                                     0);
                         }
+                        else
+                        {
+                            per_drawcall_vertex_blending_dynamic_offset = 0;
+                        }
+
+                        // bind perdrawcall
+                        uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
+                                                       perdrawcall_dynamic_offset,
+                                                       per_drawcall_vertex_blending_dynamic_offset};
+                        m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                        m_render_pipelines[0].layout,
+                                                        0,
+                                                        1,
+                                                        &m_descriptor_infos[0].descriptor_set,
+                                                        (sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0])),
+                                                        dynamic_offsets);
+
+                        m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
+                                                 mesh.mesh_index_count,
+                                                 current_instance_count,
+                                                 0,
+                                                 0,
+                                                 0);
                     }
                 }
             }
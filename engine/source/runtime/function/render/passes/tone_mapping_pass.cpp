@@ -1,5 +1,7 @@
 #include "runtime/function/render/passes/tone_mapping_pass.h"
 
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 #include "runtime/function/render/interface/vulkan/vulkan_util.h"
 
@@ -225,6 +227,8 @@ namespace Piccolo
 
     void ToneMappingPass::draw()
     {
+        PICCOLO_PROFILE_ZONE("ToneMappingPass::draw");
+
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Tone Map", color);
 
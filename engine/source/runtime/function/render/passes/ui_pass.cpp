@@ -1,5 +1,7 @@
 #include "runtime/function/render/passes/ui_pass.h"
 
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 
 #include "runtime/resource/config_manager/config_manager.h"
@@ -86,6 +88,8 @@ namespace Piccolo
 
     void UIPass::draw()
     {
+        PICCOLO_PROFILE_ZONE("UIPass::draw");
+
         if (m_window_ui)
         {
             ImGui_ImplVulkan_NewFrame();
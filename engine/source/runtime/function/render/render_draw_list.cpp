@@ -0,0 +1,141 @@
+#include "runtime/function/render/render_draw_list.h"
+
+#include <cstring>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // bit layout of the sort keys, from the most significant bits down
+        constexpr uint32_t k_pass_shift     = 60;
+        constexpr uint32_t k_pipeline_shift = 56;
+        constexpr uint32_t k_material_shift = 40;
+        constexpr uint32_t k_mesh_shift     = 24;
+        constexpr uint64_t k_asset_id_mask  = 0xffff;
+        constexpr uint32_t k_depth_bits     = 24;
+
+        /// the bits of a float remapped so that they order like the float, truncated to the depth bits
+        uint64_t quantizeDepth(float depth)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &depth, sizeof(bits));
+            bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+            return bits >> (32 - k_depth_bits);
+        }
+
+        /// stable least significant digit radix sort on the bytes of the keys, the bytes that are the same in every
+        /// key, like the pass, are skipped
+        void radixSort(std::vector<RenderDrawPacket>& packets, std::vector<RenderDrawPacket>& sort_buffer)
+        {
+            const size_t packet_count = packets.size();
+            if (packet_count < 2)
+            {
+                return;
+            }
+            sort_buffer.resize(packet_count);
+
+            uint32_t histograms[sizeof(uint64_t)][256] = {};
+            for (const RenderDrawPacket& packet : packets)
+            {
+                for (uint32_t byte_index = 0; byte_index < sizeof(uint64_t); ++byte_index)
+                {
+                    ++histograms[byte_index][(packet.m_sort_key >> (byte_index * 8)) & 0xff];
+                }
+            }
+
+            for (uint32_t byte_index = 0; byte_index < sizeof(uint64_t); ++byte_index)
+            {
+                const uint32_t shift     = byte_index * 8;
+                uint32_t*      histogram = histograms[byte_index];
+                if (histogram[(packets[0].m_sort_key >> shift) & 0xff] == packet_count)
+                {
+                    continue;
+                }
+
+                uint32_t offset = 0;
+                for (uint32_t digit = 0; digit < 256; ++digit)
+                {
+                    const uint32_t count = histogram[digit];
+                    histogram[digit]     = offset;
+                    offset += count;
+                }
+                for (const RenderDrawPacket& packet : packets)
+                {
+                    sort_buffer[histogram[(packet.m_sort_key >> shift) & 0xff]++] = packet;
+                }
+                packets.swap(sort_buffer);
+            }
+        }
+    } // namespace
+
+    uint64_t RenderDrawList::makeSortKey(RenderDrawPass pass, const RenderMeshNode& node, float depth)
+    {
+        uint64_t sort_key = static_cast<uint64_t>(pass) << k_pass_shift;
+        // skinned nodes upload their joints and are drawn after the static ones
+        sort_key |= static_cast<uint64_t>(node.enable_vertex_blending ? 1 : 0) << k_pipeline_shift;
+        // the shadow passes do not bind materials, their batches only split on meshes
+        if (pass == RenderDrawPass::MainCamera)
+        {
+            sort_key |= (node.material_asset_id & k_asset_id_mask) << k_material_shift;
+        }
+        sort_key |= (node.mesh_asset_id & k_asset_id_mask) << k_mesh_shift;
+        sort_key |= quantizeDepth(depth);
+        return sort_key;
+    }
+
+    void RenderDrawList::build(RenderDrawPass                     pass,
+                               const std::vector<RenderMeshNode>& nodes,
+                               const Vector3&                     view_position,
+                               const Vector3&                     view_direction)
+    {
+        const uint32_t node_count = static_cast<uint32_t>(nodes.size());
+
+        m_packets.resize(node_count);
+        for (uint32_t node_index = 0; node_index < node_count; ++node_index)
+        {
+            const RenderMeshNode& node  = nodes[node_index];
+            const float           depth = view_direction.dotProduct(node.model_matrix->getTrans() - view_position);
+
+            RenderDrawPacket& packet = m_packets[node_index];
+            packet.m_sort_key        = makeSortKey(pass, node, depth);
+            packet.m_node_index      = node_index;
+        }
+        radixSort(m_packets, m_sort_buffer);
+
+        m_sorted_nodes.resize(node_count);
+        m_batches.clear();
+        const bool is_material_bound = pass == RenderDrawPass::MainCamera;
+        for (uint32_t sorted_index = 0; sorted_index < node_count; ++sorted_index)
+        {
+            RenderMeshNode& node = m_sorted_nodes[sorted_index];
+            node                 = nodes[m_packets[sorted_index].m_node_index];
+            if (!node.enable_vertex_blending)
+            {
+                // the passes upload joints for the nodes that have them
+                node.joint_matrices = nullptr;
+                node.joint_count    = 0;
+            }
+
+            VulkanPBRMaterial* material = is_material_bound ? node.ref_material : nullptr;
+            // the asset ids are truncated in the keys, so the batches compare the assets themselves
+            if (m_batches.empty() || m_batches.back().m_mesh != node.ref_mesh ||
+                m_batches.back().m_material != material ||
+                m_batches.back().m_enable_vertex_blending != node.enable_vertex_blending)
+            {
+                RenderDrawBatch& batch         = m_batches.emplace_back();
+                batch.m_mesh                   = node.ref_mesh;
+                batch.m_material               = material;
+                batch.m_first_node             = sorted_index;
+                batch.m_enable_vertex_blending = node.enable_vertex_blending;
+            }
+            ++m_batches.back().m_node_count;
+        }
+    }
+
+    void RenderDrawList::clear()
+    {
+        m_packets.clear();
+        m_sorted_nodes.clear();
+        m_batches.clear();
+    }
+} // namespace Piccolo
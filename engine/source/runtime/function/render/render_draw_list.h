@@ -0,0 +1,61 @@
+#pragma once
+
+#include "runtime/function/render/render_common.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Piccolo
+{
+    enum class RenderDrawPass : uint8_t
+    {
+        MainCamera,
+        DirectionalLightShadow,
+        PointLightShadow
+    };
+
+    /// a visible mesh node, ordered by its key
+    struct RenderDrawPacket
+    {
+        uint64_t m_sort_key {0};
+        uint32_t m_node_index {0};
+    };
+
+    /// consecutive sorted nodes drawn instanced, with the same mesh, material and pipeline
+    struct RenderDrawBatch
+    {
+        VulkanMesh*        m_mesh {nullptr};
+        // null in the passes that do not bind materials
+        VulkanPBRMaterial* m_material {nullptr};
+        uint32_t           m_first_node {0};
+        uint32_t           m_node_count {0};
+        bool               m_enable_vertex_blending {false};
+    };
+
+    /// The visible mesh nodes of a pass sorted by a 64 bit key of pass, pipeline, material, mesh and depth, and
+    /// grouped into instanced batches. The list keeps its storage from frame to frame, so that rebuilding it does
+    /// not allocate once it has grown to the size of the scene
+    class RenderDrawList
+    {
+    public:
+        /// rebuilds the list from the visible nodes of the pass, the nodes are drawn front to back along the view
+        /// direction inside of their batches
+        void build(RenderDrawPass                     pass,
+                   const std::vector<RenderMeshNode>& nodes,
+                   const Vector3&                     view_position,
+                   const Vector3&                     view_direction);
+        void clear();
+
+        /// the nodes in draw order, the batches index into them
+        const std::vector<RenderMeshNode>&  getNodes() const { return m_sorted_nodes; }
+        const std::vector<RenderDrawBatch>& getBatches() const { return m_batches; }
+
+        static uint64_t makeSortKey(RenderDrawPass pass, const RenderMeshNode& node, float depth);
+
+    private:
+        std::vector<RenderDrawPacket> m_packets;
+        std::vector<RenderDrawPacket> m_sort_buffer;
+        std::vector<RenderMeshNode>   m_sorted_nodes;
+        std::vector<RenderDrawBatch>  m_batches;
+    };
+} // namespace Piccolo
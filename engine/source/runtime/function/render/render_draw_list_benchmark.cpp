@@ -0,0 +1,121 @@
+#include "runtime/function/render/render_draw_list_benchmark.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/render/render_draw_list.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        constexpr uint32_t k_benchmark_mesh_count     = 256;
+        constexpr uint32_t k_benchmark_material_count = 64;
+
+        // what the mesh passes kept per node before the draw lists
+        struct BenchmarkMeshNode
+        {
+            const Matrix4x4* model_matrix {nullptr};
+            const Matrix4x4* joint_matrices {nullptr};
+            uint32_t         joint_count {0};
+        };
+
+        struct BenchmarkTiming
+        {
+            double m_total_ms {0.0};
+            double m_max_ms {0.0};
+
+            void add(double duration_ms)
+            {
+                m_total_ms += duration_ms;
+                m_max_ms = std::max(m_max_ms, duration_ms);
+            }
+        };
+    } // namespace
+
+    void runDrawListBenchmark(uint32_t node_count, uint32_t frame_count)
+    {
+        using namespace std::chrono;
+
+        std::vector<VulkanMesh>        meshes(k_benchmark_mesh_count);
+        std::vector<VulkanPBRMaterial> materials(k_benchmark_material_count);
+        std::vector<Matrix4x4>         model_matrices(node_count);
+
+        std::mt19937                            random_engine(0);
+        std::uniform_real_distribution<float>   position_distribution(-500.0f, 500.0f);
+        std::uniform_int_distribution<uint32_t> mesh_distribution(0, k_benchmark_mesh_count - 1);
+        std::uniform_int_distribution<uint32_t> material_distribution(0, k_benchmark_material_count - 1);
+
+        std::vector<RenderMeshNode> nodes(node_count);
+        for (uint32_t node_index = 0; node_index < node_count; ++node_index)
+        {
+            model_matrices[node_index] = Matrix4x4::getTrans(Vector3(position_distribution(random_engine),
+                                                                     position_distribution(random_engine),
+                                                                     position_distribution(random_engine)));
+
+            const uint32_t  mesh_index     = mesh_distribution(random_engine);
+            const uint32_t  material_index = material_distribution(random_engine);
+            RenderMeshNode& node           = nodes[node_index];
+            node.model_matrix              = &model_matrices[node_index];
+            node.ref_mesh                  = &meshes[mesh_index];
+            node.ref_material              = &materials[material_index];
+            node.mesh_asset_id             = mesh_index;
+            node.material_asset_id         = material_index;
+            node.node_id                   = node_index;
+        }
+
+        RenderDrawList  draw_list;
+        BenchmarkTiming map_timing;
+        BenchmarkTiming draw_list_timing;
+        size_t          map_batch_count = 0;
+        // the first frame grows the draw list and is not counted
+        for (uint32_t frame_index = 0; frame_index <= frame_count; ++frame_index)
+        {
+            // the camera turns a little every frame, like the culled nodes of a moving view
+            const float   angle = static_cast<float>(frame_index) * 0.01f;
+            const Vector3 view_direction(std::cos(angle), std::sin(angle), 0.0f);
+
+            const steady_clock::time_point map_begin = steady_clock::now();
+            {
+                std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<BenchmarkMeshNode>>> batches;
+                for (const RenderMeshNode& node : nodes)
+                {
+                    BenchmarkMeshNode temp;
+                    temp.model_matrix = node.model_matrix;
+                    batches[node.ref_material][node.ref_mesh].push_back(temp);
+                }
+                map_batch_count = 0;
+                for (const auto& material_batches : batches)
+                {
+                    map_batch_count += material_batches.second.size();
+                }
+            }
+            const steady_clock::time_point draw_list_begin = steady_clock::now();
+            draw_list.build(RenderDrawPass::MainCamera, nodes, Vector3::ZERO, view_direction);
+            const steady_clock::time_point draw_list_end = steady_clock::now();
+
+            if (frame_index > 0)
+            {
+                map_timing.add(duration<double, std::milli>(draw_list_begin - map_begin).count());
+                draw_list_timing.add(duration<double, std::milli>(draw_list_end - draw_list_begin).count());
+            }
+        }
+
+        LOG_INFO("draw list build: {} nodes, {} frames, map batching {:.3f} ms average {:.3f} ms max for {} batches, "
+                 "sorted draw list {:.3f} ms average {:.3f} ms max for {} batches",
+                 node_count,
+                 frame_count,
+                 frame_count > 0 ? map_timing.m_total_ms / frame_count : 0.0,
+                 map_timing.m_max_ms,
+                 map_batch_count,
+                 frame_count > 0 ? draw_list_timing.m_total_ms / frame_count : 0.0,
+                 draw_list_timing.m_max_ms,
+                 draw_list.getBatches().size());
+    }
+} // namespace Piccolo
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Piccolo
+{
+    /**
+     *  Builds the main camera draw list of node_count visible mesh nodes spread over a few hundred meshes and
+     *  materials for frame_count frames, next to the per-frame map batching it replaced, and logs the time per
+     *  frame of both. Needs the log system started, headless is enough
+     */
+    void runDrawListBenchmark(uint32_t node_count, uint32_t frame_count);
+} // namespace Piccolo
@@ -0,0 +1,511 @@
+#include "runtime/function/render/render_entity_bvh.h"
+
+#include "runtime/core/base/macro.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PICCOLO_RENDER_CULLING_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Piccolo
+{
+    namespace
+    {
+        // the refits may make the tree this much more expensive to traverse than after its build
+        constexpr float k_rebuild_cost_ratio = 1.5f;
+
+        // the projected radius of a padded slot is negative, so it is outside of every plane
+        const Vector3 k_padding_extent {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+        enum class Containment
+        {
+            Outside,
+            Intersecting,
+            Inside
+        };
+
+        /// the model matrices are affine, so the box is transformed by its center and the absolute matrix instead
+        /// of by its eight corners
+        void calculateWorldBounds(const RenderEntity& entity, Vector3& out_center, Vector3& out_extent)
+        {
+            const Vector3 min_corner   = entity.m_bounding_box.getMinCorner();
+            const Vector3 max_corner   = entity.m_bounding_box.getMaxCorner();
+            const Vector3 local_center = (max_corner + min_corner) * 0.5f;
+            const Vector3 local_extent = (max_corner - min_corner) * 0.5f;
+
+            const Matrix4x4& model_matrix = entity.m_model_matrix;
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                out_center[axis] = model_matrix[axis][0] * local_center.x + model_matrix[axis][1] * local_center.y +
+                                   model_matrix[axis][2] * local_center.z + model_matrix[axis][3];
+                out_extent[axis] = std::fabs(model_matrix[axis][0]) * local_extent.x +
+                                   std::fabs(model_matrix[axis][1]) * local_extent.y +
+                                   std::fabs(model_matrix[axis][2]) * local_extent.z;
+            }
+        }
+
+        /// same plane tests as TiledFrustumIntersectBox, the planes point out of the frustum
+        Containment testFrustum(const ClusterFrustum& frustum, const Vector3& min_bound, const Vector3& max_bound)
+        {
+            const Vector4 center((max_bound.x + min_bound.x) * 0.5f,
+                                 (max_bound.y + min_bound.y) * 0.5f,
+                                 (max_bound.z + min_bound.z) * 0.5f,
+                                 1.0f);
+            const Vector3 extent = (max_bound - min_bound) * 0.5f;
+
+            const Vector4* planes[] = {&frustum.m_plane_right,
+                                       &frustum.m_plane_left,
+                                       &frustum.m_plane_top,
+                                       &frustum.m_plane_bottom,
+                                       &frustum.m_plane_near,
+                                       &frustum.m_plane_far};
+
+            Containment containment = Containment::Inside;
+            for (const Vector4* plane : planes)
+            {
+                const float signed_distance = plane->dotProduct(center);
+                const float projected_radius =
+                    std::fabs(plane->x) * extent.x + std::fabs(plane->y) * extent.y + std::fabs(plane->z) * extent.z;
+                if (signed_distance >= projected_radius)
+                {
+                    return Containment::Outside;
+                }
+                if (signed_distance > -projected_radius)
+                {
+                    containment = Containment::Intersecting;
+                }
+            }
+            return containment;
+        }
+
+        /// same test as BoxIntersectsWithSphere, per axis
+        bool intersectsSphere(const Vector3& center, const Vector3& extent, const BoundingSphere& sphere)
+        {
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                if (std::fabs(sphere.m_center[axis] - center[axis]) - extent[axis] > sphere.m_radius)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        float surfaceArea(const Vector3& min_bound, const Vector3& max_bound)
+        {
+            const Vector3 size = max_bound - min_bound;
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+    } // namespace
+
+    void RenderEntityBVH::markEntityDirty(size_t entity_index)
+    {
+        if (!m_is_structure_dirty)
+        {
+            m_dirty_entities.push_back(static_cast<uint32_t>(entity_index));
+        }
+    }
+
+    void RenderEntityBVH::update(const std::vector<RenderEntity>& entities)
+    {
+        if (m_is_structure_dirty || m_entity_slots.size() != entities.size())
+        {
+            build(entities);
+        }
+        else if (!m_dirty_entities.empty())
+        {
+            refit(entities);
+            if (m_cost > m_built_cost * k_rebuild_cost_ratio)
+            {
+                build(entities);
+            }
+        }
+        m_dirty_entities.clear();
+    }
+
+    void RenderEntityBVH::build(const std::vector<RenderEntity>& entities)
+    {
+        const uint32_t entity_count = static_cast<uint32_t>(entities.size());
+
+        std::vector<Vector3> centers(entity_count);
+        std::vector<Vector3> extents(entity_count);
+        for (uint32_t entity_index = 0; entity_index < entity_count; ++entity_index)
+        {
+            calculateWorldBounds(entities[entity_index], centers[entity_index], extents[entity_index]);
+        }
+
+        m_nodes.clear();
+        m_slot_center_x.clear();
+        m_slot_center_y.clear();
+        m_slot_center_z.clear();
+        m_slot_extent_x.clear();
+        m_slot_extent_y.clear();
+        m_slot_extent_z.clear();
+        m_slot_entities.clear();
+        m_entity_slots.assign(entity_count, k_invalid_index);
+        m_entity_leaves.assign(entity_count, k_invalid_index);
+
+        if (entity_count > 0)
+        {
+            m_nodes.reserve(2 * (entity_count / (k_leaf_size / 2) + 1));
+
+            std::vector<uint32_t> entity_indices(entity_count);
+            for (uint32_t entity_index = 0; entity_index < entity_count; ++entity_index)
+            {
+                entity_indices[entity_index] = entity_index;
+            }
+            buildNode(entity_indices, 0, entity_count, centers, extents);
+        }
+
+        m_cost = 0.0f;
+        for (const Node& node : m_nodes)
+        {
+            m_cost += surfaceArea(node.m_min_bound, node.m_max_bound);
+        }
+        m_built_cost         = m_cost;
+        m_is_structure_dirty = false;
+    }
+
+    uint32_t RenderEntityBVH::buildNode(std::vector<uint32_t>&      entity_indices,
+                                        uint32_t                    begin,
+                                        uint32_t                    end,
+                                        const std::vector<Vector3>& centers,
+                                        const std::vector<Vector3>& extents)
+    {
+        const uint32_t node_index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+
+        if (end - begin <= k_leaf_size)
+        {
+            const uint32_t first_slot = static_cast<uint32_t>(m_slot_entities.size());
+            const uint32_t slot_count = (end - begin + k_simd_width - 1) / k_simd_width * k_simd_width;
+            for (uint32_t slot_index = 0; slot_index < slot_count; ++slot_index)
+            {
+                const bool     is_padding   = begin + slot_index >= end;
+                const uint32_t entity_index = is_padding ? k_invalid_index : entity_indices[begin + slot_index];
+                const Vector3  center       = is_padding ? Vector3::ZERO : centers[entity_index];
+                const Vector3  extent       = is_padding ? k_padding_extent : extents[entity_index];
+
+                m_slot_center_x.push_back(center.x);
+                m_slot_center_y.push_back(center.y);
+                m_slot_center_z.push_back(center.z);
+                m_slot_extent_x.push_back(extent.x);
+                m_slot_extent_y.push_back(extent.y);
+                m_slot_extent_z.push_back(extent.z);
+                m_slot_entities.push_back(entity_index);
+
+                if (!is_padding)
+                {
+                    m_entity_slots[entity_index]  = first_slot + slot_index;
+                    m_entity_leaves[entity_index] = node_index;
+                }
+            }
+
+            Node& leaf        = m_nodes[node_index];
+            leaf.m_first_slot = first_slot;
+            leaf.m_slot_count = slot_count;
+            refitNode(leaf);
+            return node_index;
+        }
+
+        // split at the median of the centers along the axis they spread the most
+        Vector3 min_center = centers[entity_indices[begin]];
+        Vector3 max_center = min_center;
+        for (uint32_t index = begin + 1; index < end; ++index)
+        {
+            min_center.makeFloor(centers[entity_indices[index]]);
+            max_center.makeCeil(centers[entity_indices[index]]);
+        }
+        const Vector3 center_spread = max_center - min_center;
+        size_t        split_axis    = 0;
+        if (center_spread.y > center_spread[split_axis])
+        {
+            split_axis = 1;
+        }
+        if (center_spread.z > center_spread[split_axis])
+        {
+            split_axis = 2;
+        }
+
+        // select on contiguous keys, comparing through the indices misses the cache on every access
+        std::vector<std::pair<float, uint32_t>> split_keys(end - begin);
+        for (uint32_t index = begin; index < end; ++index)
+        {
+            const uint32_t entity_index = entity_indices[index];
+            split_keys[index - begin]   = {centers[entity_index][split_axis], entity_index};
+        }
+        const uint32_t middle = begin + (end - begin) / 2;
+        std::nth_element(split_keys.begin(), split_keys.begin() + (middle - begin), split_keys.end());
+        for (uint32_t index = begin; index < end; ++index)
+        {
+            entity_indices[index] = split_keys[index - begin].second;
+        }
+
+        const uint32_t left_child  = buildNode(entity_indices, begin, middle, centers, extents);
+        const uint32_t right_child = buildNode(entity_indices, middle, end, centers, extents);
+
+        m_nodes[left_child].m_parent  = node_index;
+        m_nodes[right_child].m_parent = node_index;
+
+        Node& node         = m_nodes[node_index];
+        node.m_left_child  = left_child;
+        node.m_right_child = right_child;
+        node.m_first_slot  = m_nodes[left_child].m_first_slot;
+        node.m_slot_count  = m_nodes[right_child].m_first_slot + m_nodes[right_child].m_slot_count - node.m_first_slot;
+        refitNode(node);
+        return node_index;
+    }
+
+    void RenderEntityBVH::refit(const std::vector<RenderEntity>& entities)
+    {
+        std::sort(m_dirty_entities.begin(), m_dirty_entities.end());
+        m_dirty_entities.erase(std::unique(m_dirty_entities.begin(), m_dirty_entities.end()), m_dirty_entities.end());
+
+        std::vector<uint32_t> dirty_leaves;
+        dirty_leaves.reserve(m_dirty_entities.size());
+        for (uint32_t entity_index : m_dirty_entities)
+        {
+            ASSERT(entity_index < entities.size());
+
+            Vector3 center, extent;
+            calculateWorldBounds(entities[entity_index], center, extent);
+
+            const uint32_t slot_index    = m_entity_slots[entity_index];
+            m_slot_center_x[slot_index] = center.x;
+            m_slot_center_y[slot_index] = center.y;
+            m_slot_center_z[slot_index] = center.z;
+            m_slot_extent_x[slot_index] = extent.x;
+            m_slot_extent_y[slot_index] = extent.y;
+            m_slot_extent_z[slot_index] = extent.z;
+
+            dirty_leaves.push_back(m_entity_leaves[entity_index]);
+        }
+
+        std::sort(dirty_leaves.begin(), dirty_leaves.end());
+        dirty_leaves.erase(std::unique(dirty_leaves.begin(), dirty_leaves.end()), dirty_leaves.end());
+        for (uint32_t leaf_index : dirty_leaves)
+        {
+            // the ancestors only change as long as their child did
+            uint32_t node_index = leaf_index;
+            while (node_index != k_invalid_index && refitNode(m_nodes[node_index]))
+            {
+                node_index = m_nodes[node_index].m_parent;
+            }
+        }
+    }
+
+    bool RenderEntityBVH::refitNode(Node& node)
+    {
+        Vector3 min_bound(FLT_MAX, FLT_MAX, FLT_MAX);
+        Vector3 max_bound(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        if (node.m_left_child != k_invalid_index)
+        {
+            const Node& left_child  = m_nodes[node.m_left_child];
+            const Node& right_child = m_nodes[node.m_right_child];
+            min_bound               = left_child.m_min_bound;
+            max_bound               = left_child.m_max_bound;
+            min_bound.makeFloor(right_child.m_min_bound);
+            max_bound.makeCeil(right_child.m_max_bound);
+        }
+        else
+        {
+            for (uint32_t slot_index = node.m_first_slot; slot_index < node.m_first_slot + node.m_slot_count;
+                 ++slot_index)
+            {
+                if (m_slot_entities[slot_index] == k_invalid_index)
+                {
+                    continue;
+                }
+
+                const Vector3 center(
+                    m_slot_center_x[slot_index], m_slot_center_y[slot_index], m_slot_center_z[slot_index]);
+                const Vector3 extent(
+                    m_slot_extent_x[slot_index], m_slot_extent_y[slot_index], m_slot_extent_z[slot_index]);
+                min_bound.makeFloor(center - extent);
+                max_bound.makeCeil(center + extent);
+            }
+        }
+
+        if (min_bound == node.m_min_bound && max_bound == node.m_max_bound)
+        {
+            return false;
+        }
+
+        m_cost += surfaceArea(min_bound, max_bound) - surfaceArea(node.m_min_bound, node.m_max_bound);
+        node.m_min_bound = min_bound;
+        node.m_max_bound = max_bound;
+        return true;
+    }
+
+    void RenderEntityBVH::cullFrustum(const ClusterFrustum& frustum, std::vector<uint32_t>& out_entity_indices) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        const Vector4* planes[] = {&frustum.m_plane_right,
+                                   &frustum.m_plane_left,
+                                   &frustum.m_plane_top,
+                                   &frustum.m_plane_bottom,
+                                   &frustum.m_plane_near,
+                                   &frustum.m_plane_far};
+
+        uint32_t node_stack[64];
+        uint32_t stack_size       = 0;
+        node_stack[stack_size++] = 0;
+        while (stack_size > 0)
+        {
+            const Node& node = m_nodes[node_stack[--stack_size]];
+
+            const Containment containment = testFrustum(frustum, node.m_min_bound, node.m_max_bound);
+            if (containment == Containment::Outside)
+            {
+                continue;
+            }
+            if (containment == Containment::Inside)
+            {
+                appendSlots(node, out_entity_indices);
+                continue;
+            }
+            if (node.m_left_child != k_invalid_index)
+            {
+                node_stack[stack_size++] = node.m_right_child;
+                node_stack[stack_size++] = node.m_left_child;
+                continue;
+            }
+
+            for (uint32_t block_begin = node.m_first_slot; block_begin < node.m_first_slot + node.m_slot_count;
+                 block_begin += k_simd_width)
+            {
+#ifdef PICCOLO_RENDER_CULLING_SSE
+                const __m128 center_x = _mm_loadu_ps(m_slot_center_x.data() + block_begin);
+                const __m128 center_y = _mm_loadu_ps(m_slot_center_y.data() + block_begin);
+                const __m128 center_z = _mm_loadu_ps(m_slot_center_z.data() + block_begin);
+                const __m128 extent_x = _mm_loadu_ps(m_slot_extent_x.data() + block_begin);
+                const __m128 extent_y = _mm_loadu_ps(m_slot_extent_y.data() + block_begin);
+                const __m128 extent_z = _mm_loadu_ps(m_slot_extent_z.data() + block_begin);
+
+                __m128 is_inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+                for (const Vector4* plane : planes)
+                {
+                    const __m128 signed_distance =
+                        _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane->x), center_x),
+                                              _mm_mul_ps(_mm_set1_ps(plane->y), center_y)),
+                                   _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane->z), center_z), _mm_set1_ps(plane->w)));
+                    const __m128 projected_radius =
+                        _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(plane->x)), extent_x),
+                                              _mm_mul_ps(_mm_set1_ps(std::fabs(plane->y)), extent_y)),
+                                   _mm_mul_ps(_mm_set1_ps(std::fabs(plane->z)), extent_z));
+                    is_inside = _mm_and_ps(is_inside, _mm_cmplt_ps(signed_distance, projected_radius));
+                }
+                const int inside_mask = _mm_movemask_ps(is_inside);
+#else
+                int inside_mask = 0;
+                for (uint32_t lane = 0; lane < k_simd_width; ++lane)
+                {
+                    const uint32_t slot_index = block_begin + lane;
+                    bool           is_inside  = true;
+                    for (const Vector4* plane : planes)
+                    {
+                        const float signed_distance = plane->x * m_slot_center_x[slot_index] +
+                                                      plane->y * m_slot_center_y[slot_index] +
+                                                      plane->z * m_slot_center_z[slot_index] + plane->w;
+                        const float projected_radius = std::fabs(plane->x) * m_slot_extent_x[slot_index] +
+                                                       std::fabs(plane->y) * m_slot_extent_y[slot_index] +
+                                                       std::fabs(plane->z) * m_slot_extent_z[slot_index];
+                        is_inside = is_inside && signed_distance < projected_radius;
+                    }
+                    inside_mask |= is_inside ? 1 << lane : 0;
+                }
+#endif
+                for (uint32_t lane = 0; lane < k_simd_width; ++lane)
+                {
+                    if (inside_mask & (1 << lane))
+                    {
+                        out_entity_indices.push_back(m_slot_entities[block_begin + lane]);
+                    }
+                }
+            }
+        }
+    }
+
+    void RenderEntityBVH::cullSpheres(const std::vector<BoundingSphere>& spheres,
+                                      std::vector<uint32_t>&             out_entity_indices) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        uint32_t node_stack[64];
+        uint32_t stack_size       = 0;
+        node_stack[stack_size++] = 0;
+        while (stack_size > 0)
+        {
+            const Node&   node   = m_nodes[node_stack[--stack_size]];
+            const Vector3 center = (node.m_max_bound + node.m_min_bound) * 0.5f;
+            const Vector3 extent = (node.m_max_bound - node.m_min_bound) * 0.5f;
+
+            const bool is_intersecting = std::all_of(spheres.begin(), spheres.end(), [&](const BoundingSphere& sphere) {
+                return intersectsSphere(center, extent, sphere);
+            });
+            if (!is_intersecting)
+            {
+                continue;
+            }
+            if (node.m_left_child != k_invalid_index)
+            {
+                node_stack[stack_size++] = node.m_right_child;
+                node_stack[stack_size++] = node.m_left_child;
+                continue;
+            }
+
+            for (uint32_t slot_index = node.m_first_slot; slot_index < node.m_first_slot + node.m_slot_count;
+                 ++slot_index)
+            {
+                if (m_slot_entities[slot_index] == k_invalid_index)
+                {
+                    continue;
+                }
+
+                const Vector3 slot_center(
+                    m_slot_center_x[slot_index], m_slot_center_y[slot_index], m_slot_center_z[slot_index]);
+                const Vector3 slot_extent(
+                    m_slot_extent_x[slot_index], m_slot_extent_y[slot_index], m_slot_extent_z[slot_index]);
+                const bool is_slot_intersecting =
+                    std::all_of(spheres.begin(), spheres.end(), [&](const BoundingSphere& sphere) {
+                        return intersectsSphere(slot_center, slot_extent, sphere);
+                    });
+                if (is_slot_intersecting)
+                {
+                    out_entity_indices.push_back(m_slot_entities[slot_index]);
+                }
+            }
+        }
+    }
+
+    BoundingBox RenderEntityBVH::getBounds() const
+    {
+        if (m_nodes.empty())
+        {
+            return BoundingBox(Vector3(FLT_MAX, FLT_MAX, FLT_MAX), Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+        }
+        return BoundingBox(m_nodes[0].m_min_bound, m_nodes[0].m_max_bound);
+    }
+
+    void RenderEntityBVH::appendSlots(const Node& node, std::vector<uint32_t>& out_entity_indices) const
+    {
+        for (uint32_t slot_index = node.m_first_slot; slot_index < node.m_first_slot + node.m_slot_count; ++slot_index)
+        {
+            if (m_slot_entities[slot_index] != k_invalid_index)
+            {
+                out_entity_indices.push_back(m_slot_entities[slot_index]);
+            }
+        }
+    }
+} // namespace Piccolo
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "runtime/function/render/render_entity.h"
+#include "runtime/function/render/render_helper.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Piccolo
+{
+    /// Bounding volume hierarchy over the world space bounds of the render entities of a scene.
+    /// Leaves keep the bounds of their entities in SoA arrays, so that a leaf is tested against the frustum planes
+    /// four boxes at a time. Moved entities only refit the bounds of their leaves and of the nodes above, the tree
+    /// is rebuilt when entities are added or removed, or when the refits made it much looser than it was built
+    class RenderEntityBVH
+    {
+    public:
+        /// entities were added or removed, their indices changed
+        void markStructureDirty() { m_is_structure_dirty = true; }
+        /// the model matrix or the bounding box of the entity changed
+        void markEntityDirty(size_t entity_index);
+
+        /// rebuilds or refits what was marked dirty since the last update
+        void update(const std::vector<RenderEntity>& entities);
+
+        /// appends the indices of the entities whose world bounds intersect the frustum, in tree order
+        void cullFrustum(const ClusterFrustum& frustum, std::vector<uint32_t>& out_entity_indices) const;
+        /// appends the indices of the entities whose world bounds intersect every sphere
+        void cullSpheres(const std::vector<BoundingSphere>& spheres, std::vector<uint32_t>& out_entity_indices) const;
+
+        /// union of the world bounds of all entities, inverted when there are none
+        BoundingBox getBounds() const;
+
+    private:
+        static constexpr uint32_t k_invalid_index = 0xffffffff;
+        // entities per leaf at most, a leaf is padded to a multiple of the simd width
+        static constexpr uint32_t k_leaf_size  = 8;
+        static constexpr uint32_t k_simd_width = 4;
+
+        struct Node
+        {
+            Vector3 m_min_bound;
+            Vector3 m_max_bound;
+            // slots of all entities below the node, padded slots included
+            uint32_t m_first_slot {0};
+            uint32_t m_slot_count {0};
+            // the right child follows the whole subtree of the left child, leaves have no children
+            uint32_t m_left_child {k_invalid_index};
+            uint32_t m_right_child {k_invalid_index};
+            uint32_t m_parent {k_invalid_index};
+        };
+
+        // children are stored after their parents
+        std::vector<Node> m_nodes;
+
+        // world bounds per slot in tree order, padded slots have negative extents and never intersect
+        std::vector<float>    m_slot_center_x;
+        std::vector<float>    m_slot_center_y;
+        std::vector<float>    m_slot_center_z;
+        std::vector<float>    m_slot_extent_x;
+        std::vector<float>    m_slot_extent_y;
+        std::vector<float>    m_slot_extent_z;
+        std::vector<uint32_t> m_slot_entities;
+
+        std::vector<uint32_t> m_entity_slots;
+        std::vector<uint32_t> m_entity_leaves;
+
+        bool                  m_is_structure_dirty {true};
+        std::vector<uint32_t> m_dirty_entities;
+        // sum of the node surface areas, a measure of the cost of a traversal, kept up to date by the refits
+        float m_cost {0.0f};
+        float m_built_cost {0.0f};
+
+        void     build(const std::vector<RenderEntity>& entities);
+        uint32_t buildNode(std::vector<uint32_t>&      entity_indices,
+                           uint32_t                    begin,
+                           uint32_t                    end,
+                           const std::vector<Vector3>& centers,
+                           const std::vector<Vector3>& extents);
+        void     refit(const std::vector<RenderEntity>& entities);
+        // returns whether the bounds of the node changed
+        bool     refitNode(Node& node);
+
+        void appendSlots(const Node& node, std::vector<uint32_t>& out_entity_indices) const;
+    };
+} // namespace Piccolo
@@ -0,0 +1,103 @@
+#include "runtime/function/render/render_entity_spawn_benchmark.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/render/render_scene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        struct BenchmarkTiming
+        {
+            double m_total_ms {0.0};
+            double m_max_ms {0.0};
+
+            void add(double duration_ms)
+            {
+                m_total_ms += duration_ms;
+                m_max_ms = std::max(m_max_ms, duration_ms);
+            }
+        };
+    } // namespace
+
+    void runRenderEntitySpawnBenchmark(uint32_t entity_count, uint32_t round_count)
+    {
+        using namespace std::chrono;
+        using InstanceIdAllocator = GuidAllocator<GameObjectPartId>;
+
+        RenderScene          render_scene;
+        InstanceIdAllocator& instance_id_allocator = render_scene.getInstanceIdAllocator();
+
+        std::mt19937           random_engine(0);
+        std::vector<GObjectID> object_ids(entity_count);
+        std::vector<uint32_t>  instance_ids(entity_count);
+        GObjectID              next_object_id = 0;
+        size_t                 slot_count     = 0;
+        size_t                 leaked_count   = 0;
+        BenchmarkTiming        spawn_timing;
+        BenchmarkTiming        despawn_timing;
+        for (uint32_t round_index = 0; round_index < round_count; ++round_index)
+        {
+            // what processSwapData does for a new object with a single part
+            const steady_clock::time_point spawn_begin = steady_clock::now();
+            for (uint32_t entity_index = 0; entity_index < entity_count; ++entity_index)
+            {
+                const GObjectID object_id = next_object_id++;
+
+                RenderEntity render_entity;
+                render_entity.m_instance_id =
+                    static_cast<uint32_t>(instance_id_allocator.allocGuid(GameObjectPartId {object_id, 0}));
+                render_scene.addInstanceIdToMap(render_entity.m_instance_id, object_id);
+                render_scene.addRenderEntity(render_entity);
+
+                object_ids[entity_index]   = object_id;
+                instance_ids[entity_index] = render_entity.m_instance_id;
+            }
+            const steady_clock::time_point spawn_end = steady_clock::now();
+
+            for (uint32_t instance_id : instance_ids)
+            {
+                slot_count = std::max(slot_count, InstanceIdAllocator::getGuidIndex(instance_id) + 1);
+            }
+
+            // despawned in another order than spawned, like objects that die over time
+            std::shuffle(object_ids.begin(), object_ids.end(), random_engine);
+            const steady_clock::time_point despawn_begin = steady_clock::now();
+            for (GObjectID object_id : object_ids)
+            {
+                render_scene.deleteEntityByGObjectID(object_id);
+            }
+            const steady_clock::time_point despawn_end = steady_clock::now();
+
+            // the ids of the round must not resolve anymore, even though the next round reuses their slots
+            for (uint32_t instance_id : instance_ids)
+            {
+                if (render_scene.getGObjectIDByMeshID(instance_id) != GObjectID())
+                {
+                    ++leaked_count;
+                }
+            }
+            leaked_count += render_scene.m_render_entities.size();
+
+            spawn_timing.add(duration<double, std::milli>(spawn_end - spawn_begin).count());
+            despawn_timing.add(duration<double, std::milli>(despawn_end - despawn_begin).count());
+        }
+
+        LOG_INFO("render entity spawn: {} entities, {} rounds, spawn {:.3f} ms average {:.3f} ms max, "
+                 "despawn {:.3f} ms average {:.3f} ms max, {} instance id slots, {} leaked",
+                 entity_count,
+                 round_count,
+                 round_count > 0 ? spawn_timing.m_total_ms / round_count : 0.0,
+                 spawn_timing.m_max_ms,
+                 round_count > 0 ? despawn_timing.m_total_ms / round_count : 0.0,
+                 despawn_timing.m_max_ms,
+                 slot_count,
+                 leaked_count);
+    }
+} // namespace Piccolo
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Piccolo
+{
+    /**
+     *  Spawns entity_count render entities into a render scene and despawns them again in random order, for
+     *  round_count rounds, and logs the time per round of both. Every round spawns new objects, so that the instance
+     *  ids of the previous rounds are freed and reused. Needs the log system started, headless is enough
+     */
+    void runRenderEntitySpawnBenchmark(uint32_t entity_count, uint32_t round_count);
+} // namespace Piccolo
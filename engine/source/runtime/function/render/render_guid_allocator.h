@@ -1,54 +1,81 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 namespace Piccolo
 {
     static const size_t s_invalid_guid = 0;
 
+    /// Gives every element a guid, the same element keeps its guid until it is freed. The low bits of a guid are
+    /// the index of its slot plus one and the high bits the generation of the slot. Freed slots are reused through
+    /// a free list and their generation is bumped, so that the guids of freed elements are not taken for the guids
+    /// of the elements that reuse their slots. Guids fit in 32 bits and their slot indices are dense, so that they
+    /// can index arrays
     template<typename T>
     class GuidAllocator
     {
     public:
+        static constexpr uint32_t k_index_bits      = 22;
+        static constexpr size_t   k_index_mask      = (size_t(1) << k_index_bits) - 1;
+        static constexpr uint32_t k_generation_mask = (1u << (32 - k_index_bits)) - 1;
+
         static bool isValidGuid(size_t guid) { return guid != s_invalid_guid; }
+        /// index of the slot of a valid guid, lower than the number of slots ever allocated
+        static size_t getGuidIndex(size_t guid) { return (guid & k_index_mask) - 1; }
 
         size_t allocGuid(const T& t)
         {
-            auto find_it = m_elements_guid_map.find(t);
-            if (find_it != m_elements_guid_map.end())
+            auto find_it = m_element_guids.find(t);
+            if (find_it != m_element_guids.end())
             {
                 return find_it->second;
             }
 
-            for (size_t i = 0; i < m_guid_elements_map.size() + 1; i++)
+            uint32_t slot_index;
+            if (m_free_slot_head != k_invalid_slot)
+            {
+                slot_index       = m_free_slot_head;
+                m_free_slot_head = m_slots[slot_index].m_next_free_slot;
+            }
+            else
             {
-                size_t guid = i + 1;
-                if (m_guid_elements_map.find(guid) == m_guid_elements_map.end())
+                // the index plus one has to fit into the index bits
+                if (m_slots.size() >= k_index_mask)
                 {
-                    m_guid_elements_map.insert(std::make_pair(guid, t));
-                    m_elements_guid_map.insert(std::make_pair(t, guid));
-                    return guid;
+                    return s_invalid_guid;
                 }
+                slot_index = static_cast<uint32_t>(m_slots.size());
+                m_slots.emplace_back();
             }
 
-            return s_invalid_guid;
+            Slot& slot            = m_slots[slot_index];
+            slot.m_element        = t;
+            slot.m_is_allocated   = true;
+            slot.m_next_free_slot = k_invalid_slot;
+
+            const size_t guid = makeGuid(slot_index, slot.m_generation);
+            m_element_guids.emplace(t, guid);
+            return guid;
         }
 
-        bool getGuidRelatedElement(size_t guid, T& t)
+        bool getGuidRelatedElement(size_t guid, T& t) const
         {
-            auto find_it = m_guid_elements_map.find(guid);
-            if (find_it != m_guid_elements_map.end())
+            const Slot* slot = findSlot(guid);
+            if (slot != nullptr)
             {
-                t = find_it->second;
+                t = slot->m_element;
                 return true;
             }
             return false;
         }
 
-        bool getElementGuid(const T& t, size_t& guid)
+        bool getElementGuid(const T& t, size_t& guid) const
         {
-            auto find_it = m_elements_guid_map.find(t);
-            if (find_it != m_elements_guid_map.end())
+            auto find_it = m_element_guids.find(t);
+            if (find_it != m_element_guids.end())
             {
                 guid = find_it->second;
                 return true;
@@ -56,49 +83,102 @@ namespace Piccolo
             return false;
         }
 
-        bool hasElement(const T& t) { return m_elements_guid_map.find(t) != m_elements_guid_map.end(); }
+        bool hasElement(const T& t) const { return m_element_guids.find(t) != m_element_guids.end(); }
+
+        /// false for the guids of freed elements, even when their slots are in use again
+        bool isAllocated(size_t guid) const { return findSlot(guid) != nullptr; }
 
         void freeGuid(size_t guid)
         {
-            auto find_it = m_guid_elements_map.find(guid);
-            if (find_it != m_guid_elements_map.end())
+            if (findSlot(guid) != nullptr)
             {
-                const auto& ele = find_it->second;
-                m_elements_guid_map.erase(ele);
-                m_guid_elements_map.erase(guid);
+                freeSlot(static_cast<uint32_t>(getGuidIndex(guid)));
             }
         }
 
         void freeElement(const T& t)
         {
-            auto find_it = m_elements_guid_map.find(t);
-            if (find_it != m_elements_guid_map.end())
+            size_t guid;
+            if (getElementGuid(t, guid))
             {
-                const auto& guid = find_it->second;
-                m_elements_guid_map.erase(t);
-                m_guid_elements_map.erase(guid);
+                freeGuid(guid);
             }
         }
 
         std::vector<size_t> getAllocatedGuids() const
         {
             std::vector<size_t> allocated_guids;
-            for (const auto& ele : m_guid_elements_map)
+            allocated_guids.reserve(m_element_guids.size());
+            for (uint32_t slot_index = 0; slot_index < m_slots.size(); ++slot_index)
             {
-                allocated_guids.push_back(ele.first);
+                if (m_slots[slot_index].m_is_allocated)
+                {
+                    allocated_guids.push_back(makeGuid(slot_index, m_slots[slot_index].m_generation));
+                }
             }
             return allocated_guids;
         }
 
+        /// frees all elements, the slots are kept with their generations bumped so that no guid is handed out twice
         void clear()
         {
-            m_elements_guid_map.clear();
-            m_guid_elements_map.clear();
+            // freed in reverse, so that the low slots are reused first
+            for (uint32_t slot_index = static_cast<uint32_t>(m_slots.size()); slot_index > 0; --slot_index)
+            {
+                if (m_slots[slot_index - 1].m_is_allocated)
+                {
+                    freeSlot(slot_index - 1);
+                }
+            }
+            m_element_guids.clear();
         }
 
     private:
-        std::unordered_map<T, size_t> m_elements_guid_map;
-        std::unordered_map<size_t, T> m_guid_elements_map;
+        static constexpr uint32_t k_invalid_slot = 0xffffffff;
+
+        struct Slot
+        {
+            T        m_element {};
+            uint32_t m_generation {0};
+            uint32_t m_next_free_slot {k_invalid_slot};
+            bool     m_is_allocated {false};
+        };
+
+        std::vector<Slot>             m_slots;
+        uint32_t                      m_free_slot_head {k_invalid_slot};
+        std::unordered_map<T, size_t> m_element_guids;
+
+        static size_t makeGuid(uint32_t slot_index, uint32_t generation)
+        {
+            return (static_cast<size_t>(generation) << k_index_bits) | (slot_index + 1);
+        }
+
+        const Slot* findSlot(size_t guid) const
+        {
+            if (!isValidGuid(guid) || getGuidIndex(guid) >= m_slots.size())
+            {
+                return nullptr;
+            }
+
+            const Slot& slot = m_slots[getGuidIndex(guid)];
+            if (!slot.m_is_allocated || makeGuid(static_cast<uint32_t>(getGuidIndex(guid)), slot.m_generation) != guid)
+            {
+                return nullptr;
+            }
+            return &slot;
+        }
+
+        void freeSlot(uint32_t slot_index)
+        {
+            Slot& slot = m_slots[slot_index];
+            m_element_guids.erase(slot.m_element);
+            // also releases what the element holds, like the file names of the descs
+            slot.m_element        = T {};
+            slot.m_is_allocated   = false;
+            slot.m_generation     = (slot.m_generation + 1) & k_generation_mask;
+            slot.m_next_free_slot = m_free_slot_head;
+            m_free_slot_head      = slot_index;
+        }
     };
 
 } // namespace Piccolo
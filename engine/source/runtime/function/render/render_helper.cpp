@@ -300,21 +300,8 @@ namespace Piccolo
             }
         }
 
-        BoundingBox scene_bounding_box;
-        {
-            scene_bounding_box.min_bound = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
-            scene_bounding_box.max_bound = Vector3(FLT_MIN, FLT_MIN, FLT_MIN);
-
-            for (const RenderEntity& entity : scene.m_render_entities)
-            {
-                BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
-                                                     entity.m_bounding_box.getMaxCorner()};
-
-                BoundingBox mesh_bounding_box_world =
-                    BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix);
-                scene_bounding_box.merge(mesh_bounding_box_world);
-            }
-        }
+        // kept up to date by the hierarchy of the render entities
+        BoundingBox scene_bounding_box = scene.getRenderEntitiesBounds();
 
         // CascadedShadowMaps11 / ComputeNearAndFar
         Matrix4x4 light_view;
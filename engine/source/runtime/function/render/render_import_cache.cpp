@@ -0,0 +1,271 @@
+#include "runtime/function/render/render_import_cache.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/meta/serializer/binary_serializer.h"
+
+#include "runtime/platform/file_service/mapped_file.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Piccolo
+{
+    static constexpr uint32_t k_import_cache_magic   = 0x43444450; // "PDDC"
+    static constexpr uint32_t k_import_cache_version = 1;
+
+    enum class ImportCacheEntryType : uint32_t
+    {
+        StaticMesh = 1,
+        Texture    = 2
+    };
+
+    namespace
+    {
+        void writeEntryHeader(BinaryWriter& writer, ImportCacheEntryType entry_type, uint64_t key)
+        {
+            writer.writeValue(k_import_cache_magic);
+            writer.writeValue(k_import_cache_version);
+            writer.writeValue(entry_type);
+            writer.writeValue(key);
+        }
+
+        bool readEntryHeader(BinaryReader& reader, ImportCacheEntryType entry_type, uint64_t key)
+        {
+            const uint32_t             magic     = reader.readValue<uint32_t>();
+            const uint32_t             version   = reader.readValue<uint32_t>();
+            const ImportCacheEntryType read_type = reader.readValue<ImportCacheEntryType>();
+            const uint64_t             read_key  = reader.readValue<uint64_t>();
+            return reader.isValid() && magic == k_import_cache_magic && version == k_import_cache_version &&
+                   read_type == entry_type && read_key == key;
+        }
+
+        void writeBlob(BinaryWriter& writer, const BufferData& buffer_data)
+        {
+            writer.writeValue(static_cast<uint64_t>(buffer_data.m_size));
+            writer.writeBytes(buffer_data.m_data, buffer_data.m_size);
+        }
+
+        std::shared_ptr<BufferData> readBlob(BinaryReader& reader)
+        {
+            const uint64_t size  = reader.readValue<uint64_t>();
+            const uint8_t* bytes = reader.readBytes(static_cast<size_t>(size));
+            if (bytes == nullptr)
+            {
+                return nullptr;
+            }
+
+            std::shared_ptr<BufferData> buffer_data = std::make_shared<BufferData>(static_cast<size_t>(size));
+            std::memcpy(buffer_data->m_data, bytes, static_cast<size_t>(size));
+            return buffer_data;
+        }
+    } // namespace
+
+    void RenderImportCache::initialize(const std::filesystem::path& cache_folder)
+    {
+        m_cache_folder = cache_folder;
+        if (m_cache_folder.empty())
+        {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(m_cache_folder, error);
+        if (error)
+        {
+            LOG_WARN("create import cache folder {} failed, the import cache is disabled",
+                     m_cache_folder.generic_string());
+            m_cache_folder.clear();
+        }
+    }
+
+    uint64_t RenderImportCache::computeKey(const std::vector<uint8_t>& source_data,
+                                           const char*                 importer_name,
+                                           uint32_t                    importer_version,
+                                           uint32_t                    importer_settings)
+    {
+        // fnv-1a over the source followed by everything that identifies the importer
+        uint64_t hash       = 14695981039346656037ull;
+        auto     hash_bytes = [&hash](const void* data, size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            for (size_t index = 0; index < size; ++index)
+            {
+                hash = (hash ^ bytes[index]) * 1099511628211ull;
+            }
+        };
+
+        hash_bytes(source_data.data(), source_data.size());
+        hash_bytes(importer_name, std::strlen(importer_name));
+        hash_bytes(&importer_version, sizeof(importer_version));
+        hash_bytes(&importer_settings, sizeof(importer_settings));
+        return hash;
+    }
+
+    bool RenderImportCache::loadStaticMesh(uint64_t        key,
+                                           StaticMeshData& out_mesh_data,
+                                           AxisAlignedBox& out_bounding_box)
+    {
+        if (!isEnabled())
+        {
+            return false;
+        }
+
+        MappedFile entry_file;
+        if (!entry_file.open(getEntryPath(key)))
+        {
+            ++m_statistics.m_miss_count;
+            return false;
+        }
+
+        BinaryReader reader(entry_file.getData(), entry_file.getSize());
+        if (!readEntryHeader(reader, ImportCacheEntryType::StaticMesh, key))
+        {
+            ++m_statistics.m_rejected_count;
+            return false;
+        }
+
+        const Vector3               min_corner    = reader.readValue<Vector3>();
+        const Vector3               max_corner    = reader.readValue<Vector3>();
+        const RHIIndexType          index_type    = reader.readValue<RHIIndexType>();
+        std::shared_ptr<BufferData> vertex_buffer = readBlob(reader);
+        std::shared_ptr<BufferData> index_buffer  = readBlob(reader);
+        if (!reader.isValid() || reader.getOffset() != reader.getSize())
+        {
+            ++m_statistics.m_rejected_count;
+            return false;
+        }
+
+        out_mesh_data.m_vertex_buffer = vertex_buffer;
+        out_mesh_data.m_index_buffer  = index_buffer;
+        out_mesh_data.m_index_type    = index_type;
+        out_bounding_box.merge(min_corner);
+        out_bounding_box.merge(max_corner);
+
+        ++m_statistics.m_hit_count;
+        return true;
+    }
+
+    void RenderImportCache::saveStaticMesh(uint64_t              key,
+                                           const StaticMeshData& mesh_data,
+                                           const AxisAlignedBox& bounding_box)
+    {
+        if (!isEnabled())
+        {
+            return;
+        }
+
+        BinaryWriter writer;
+        writeEntryHeader(writer, ImportCacheEntryType::StaticMesh, key);
+        writer.writeValue(bounding_box.getMinCorner());
+        writer.writeValue(bounding_box.getMaxCorner());
+        writer.writeValue(mesh_data.m_index_type);
+        writeBlob(writer, *mesh_data.m_vertex_buffer);
+        writeBlob(writer, *mesh_data.m_index_buffer);
+        writeEntry(key, writer.getBuffer());
+    }
+
+    std::shared_ptr<TextureData> RenderImportCache::loadTexture(uint64_t key)
+    {
+        if (!isEnabled())
+        {
+            return nullptr;
+        }
+
+        MappedFile entry_file;
+        if (!entry_file.open(getEntryPath(key)))
+        {
+            ++m_statistics.m_miss_count;
+            return nullptr;
+        }
+
+        BinaryReader reader(entry_file.getData(), entry_file.getSize());
+        if (!readEntryHeader(reader, ImportCacheEntryType::Texture, key))
+        {
+            ++m_statistics.m_rejected_count;
+            return nullptr;
+        }
+
+        const uint32_t  width           = reader.readValue<uint32_t>();
+        const uint32_t  height          = reader.readValue<uint32_t>();
+        const RHIFormat format          = reader.readValue<RHIFormat>();
+        const uint64_t  pixel_data_size = reader.readValue<uint64_t>();
+        const uint8_t*  pixel_data      = reader.readBytes(static_cast<size_t>(pixel_data_size));
+        if (!reader.isValid() || reader.getOffset() != reader.getSize())
+        {
+            ++m_statistics.m_rejected_count;
+            return nullptr;
+        }
+
+        // TextureData releases its pixels with free
+        std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
+        texture->m_pixels                    = malloc(static_cast<size_t>(pixel_data_size));
+        std::memcpy(texture->m_pixels, pixel_data, static_cast<size_t>(pixel_data_size));
+        texture->m_width        = width;
+        texture->m_height       = height;
+        texture->m_format       = format;
+        texture->m_depth        = 1;
+        texture->m_array_layers = 1;
+        texture->m_mip_levels   = 1;
+        texture->m_type         = PICCOLO_IMAGE_TYPE::PICCOLO_IMAGE_TYPE_2D;
+
+        ++m_statistics.m_hit_count;
+        return texture;
+    }
+
+    void RenderImportCache::saveTexture(uint64_t key, const TextureData& texture, size_t pixel_data_size)
+    {
+        if (!isEnabled())
+        {
+            return;
+        }
+
+        BinaryWriter writer;
+        writeEntryHeader(writer, ImportCacheEntryType::Texture, key);
+        writer.writeValue(texture.m_width);
+        writer.writeValue(texture.m_height);
+        writer.writeValue(texture.m_format);
+        writer.writeValue(static_cast<uint64_t>(pixel_data_size));
+        writer.writeBytes(texture.m_pixels, pixel_data_size);
+        writeEntry(key, writer.getBuffer());
+    }
+
+    std::filesystem::path RenderImportCache::getEntryPath(uint64_t key) const
+    {
+        std::ostringstream file_name;
+        file_name << std::hex << std::setw(16) << std::setfill('0') << key << ".ddc";
+        return m_cache_folder / file_name.str();
+    }
+
+    void RenderImportCache::writeEntry(uint64_t key, const std::vector<uint8_t>& entry_data)
+    {
+        const std::filesystem::path entry_path = getEntryPath(key);
+
+        // write aside and rename, a crash while writing must not leave a truncated entry under the real name
+        std::filesystem::path temporary_path = entry_path;
+        temporary_path += ".tmp";
+        {
+            std::ofstream entry_file(temporary_path, std::ios::binary | std::ios::trunc);
+            if (!entry_file)
+            {
+                LOG_WARN("open file {} failed!", temporary_path.generic_string());
+                return;
+            }
+            entry_file.write(reinterpret_cast<const char*>(entry_data.data()),
+                             static_cast<std::streamsize>(entry_data.size()));
+            if (!entry_file.good())
+            {
+                LOG_WARN("write file {} failed!", temporary_path.generic_string());
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary_path, entry_path, error);
+        if (error)
+        {
+            std::filesystem::remove(temporary_path, error);
+        }
+    }
+} // namespace Piccolo
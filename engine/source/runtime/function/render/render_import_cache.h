@@ -0,0 +1,53 @@
+#pragma once
+
+#include "runtime/core/math/axis_aligned.h"
+#include "runtime/function/render/render_type.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Piccolo
+{
+    /// On-disk derived data cache of the render importers, holding ready-to-upload mesh buffers and decoded
+    /// texture pixels. Entries are keyed by a hash of the source content and of the importer version, so an
+    /// edited source or a changed importer misses instead of returning stale data
+    class RenderImportCache
+    {
+    public:
+        struct Statistics
+        {
+            uint32_t m_hit_count {0};
+            uint32_t m_miss_count {0};
+            // entries that exist but could not be used, e.g. truncated or written by another cache version
+            uint32_t m_rejected_count {0};
+        };
+
+        /// an empty folder disables the cache
+        void initialize(const std::filesystem::path& cache_folder);
+        bool isEnabled() const { return !m_cache_folder.empty(); }
+
+        /// the key of an imported result, importer_version has to change whenever the importer output changes and
+        /// importer_settings holds the options the output depends on
+        static uint64_t computeKey(const std::vector<uint8_t>& source_data,
+                                   const char*                 importer_name,
+                                   uint32_t                    importer_version,
+                                   uint32_t                    importer_settings = 0);
+
+        bool loadStaticMesh(uint64_t key, StaticMeshData& out_mesh_data, AxisAlignedBox& out_bounding_box);
+        void saveStaticMesh(uint64_t key, const StaticMeshData& mesh_data, const AxisAlignedBox& bounding_box);
+
+        std::shared_ptr<TextureData> loadTexture(uint64_t key);
+        void saveTexture(uint64_t key, const TextureData& texture, size_t pixel_data_size);
+
+        const Statistics& getStatistics() const { return m_statistics; }
+
+    private:
+        std::filesystem::path getEntryPath(uint64_t key) const;
+        void                  writeEntry(uint64_t key, const std::vector<uint8_t>& entry_data);
+
+        std::filesystem::path m_cache_folder;
+        Statistics            m_statistics;
+    };
+} // namespace Piccolo
@@ -0,0 +1,129 @@
+#include "runtime/function/render/render_import_cache_test.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/render/render_import_cache.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        constexpr size_t k_test_vertex_buffer_size = sizeof(MeshVertexDataDefinition) * 3;
+        constexpr size_t k_test_index_buffer_size  = sizeof(uint16_t) * 3;
+        constexpr size_t k_test_pixel_data_size    = 2 * 2 * 4;
+
+        bool isSameBuffer(const std::shared_ptr<BufferData>& lhs, const std::shared_ptr<BufferData>& rhs)
+        {
+            return lhs && rhs && lhs->m_size == rhs->m_size && std::memcmp(lhs->m_data, rhs->m_data, lhs->m_size) == 0;
+        }
+
+        bool isSameMesh(const StaticMeshData& lhs, const StaticMeshData& rhs)
+        {
+            return lhs.m_index_type == rhs.m_index_type && isSameBuffer(lhs.m_vertex_buffer, rhs.m_vertex_buffer) &&
+                   isSameBuffer(lhs.m_index_buffer, rhs.m_index_buffer);
+        }
+    } // namespace
+
+    bool runImportCacheInvalidationTest(const std::filesystem::path& cache_folder)
+    {
+        uint32_t failed_check_count = 0;
+        auto     check              = [&failed_check_count](bool is_passed, const char* description) {
+            if (!is_passed)
+            {
+                LOG_ERROR("import cache check failed: {}", description);
+                ++failed_check_count;
+            }
+        };
+
+        std::error_code error_code;
+        std::filesystem::remove_all(cache_folder, error_code);
+
+        RenderImportCache import_cache;
+        import_cache.initialize(cache_folder);
+        check(import_cache.isEnabled(), "the cache is enabled by a folder");
+
+        // every input of the key changes it
+        std::vector<uint8_t> source_data {1, 2, 3, 4};
+        const uint64_t       mesh_key    = RenderImportCache::computeKey(source_data, "static_mesh", 1);
+        const uint64_t       version_key = RenderImportCache::computeKey(source_data, "static_mesh", 2);
+        const uint64_t       texture_key = RenderImportCache::computeKey(source_data, "texture", 1);
+        const uint64_t       setting_key = RenderImportCache::computeKey(source_data, "static_mesh", 1, 1);
+        source_data.back()               = 5;
+        const uint64_t edited_key        = RenderImportCache::computeKey(source_data, "static_mesh", 1);
+        check(mesh_key != version_key, "a new importer version changes the key");
+        check(mesh_key != texture_key, "another importer changes the key");
+        check(mesh_key != setting_key, "other importer settings change the key");
+        check(mesh_key != edited_key, "an edited source changes the key");
+
+        StaticMeshData mesh_data;
+        mesh_data.m_vertex_buffer = std::make_shared<BufferData>(k_test_vertex_buffer_size);
+        mesh_data.m_index_buffer  = std::make_shared<BufferData>(k_test_index_buffer_size);
+        mesh_data.m_index_type    = RHI_INDEX_TYPE_UINT16;
+        std::memset(mesh_data.m_vertex_buffer->m_data, 7, k_test_vertex_buffer_size);
+        std::memset(mesh_data.m_index_buffer->m_data, 1, k_test_index_buffer_size);
+        AxisAlignedBox bounding_box;
+        bounding_box.merge(Vector3(1.0f, 2.0f, 3.0f));
+        bounding_box.merge(Vector3(-1.0f, 0.0f, 5.0f));
+
+        StaticMeshData loaded_mesh_data;
+        AxisAlignedBox loaded_bounding_box;
+        check(!import_cache.loadStaticMesh(mesh_key, loaded_mesh_data, loaded_bounding_box), "a new key misses");
+
+        import_cache.saveStaticMesh(mesh_key, mesh_data, bounding_box);
+        check(import_cache.loadStaticMesh(mesh_key, loaded_mesh_data, loaded_bounding_box), "a saved mesh hits");
+        check(isSameMesh(mesh_data, loaded_mesh_data), "a saved mesh loads with the same buffers");
+        check(loaded_bounding_box.getMinCorner() == bounding_box.getMinCorner() &&
+                  loaded_bounding_box.getMaxCorner() == bounding_box.getMaxCorner(),
+              "a saved mesh loads with the same bounding box");
+        check(!import_cache.loadStaticMesh(version_key, loaded_mesh_data, loaded_bounding_box),
+              "the mesh of another importer version misses");
+        check(!import_cache.loadStaticMesh(edited_key, loaded_mesh_data, loaded_bounding_box),
+              "the mesh of an edited source misses");
+        check(import_cache.loadTexture(mesh_key) == nullptr, "a mesh entry is not read as a texture");
+
+        TextureData texture;
+        texture.m_width  = 2;
+        texture.m_height = 2;
+        texture.m_format = RHI_FORMAT_R8G8B8A8_SRGB;
+        texture.m_pixels = std::malloc(k_test_pixel_data_size);
+        std::memset(texture.m_pixels, 9, k_test_pixel_data_size);
+        import_cache.saveTexture(texture_key, texture, k_test_pixel_data_size);
+
+        std::shared_ptr<TextureData> loaded_texture = import_cache.loadTexture(texture_key);
+        check(loaded_texture != nullptr, "a saved texture hits");
+        check(loaded_texture && loaded_texture->m_width == texture.m_width &&
+                  loaded_texture->m_height == texture.m_height && loaded_texture->m_format == texture.m_format &&
+                  std::memcmp(loaded_texture->m_pixels, texture.m_pixels, k_test_pixel_data_size) == 0,
+              "a saved texture loads with the same pixels");
+
+        // entries cut off by a crash while writing
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(cache_folder))
+        {
+            std::filesystem::resize_file(entry.path(), entry.file_size() / 2);
+        }
+        check(!import_cache.loadStaticMesh(mesh_key, loaded_mesh_data, loaded_bounding_box),
+              "a truncated mesh entry is rejected");
+        check(import_cache.loadTexture(texture_key) == nullptr, "a truncated texture entry is rejected");
+
+        // the importer runs again and overwrites the rejected entry
+        import_cache.saveStaticMesh(mesh_key, mesh_data, bounding_box);
+        check(import_cache.loadStaticMesh(mesh_key, loaded_mesh_data, loaded_bounding_box) &&
+                  isSameMesh(mesh_data, loaded_mesh_data),
+              "a rewritten mesh entry hits again");
+
+        const RenderImportCache::Statistics& statistics = import_cache.getStatistics();
+        LOG_INFO("import cache test: {} failed checks, {} hits, {} misses, {} rejected entries",
+                 failed_check_count,
+                 statistics.m_hit_count,
+                 statistics.m_miss_count,
+                 statistics.m_rejected_count);
+
+        std::filesystem::remove_all(cache_folder, error_code);
+        return failed_check_count == 0;
+    }
+} // namespace Piccolo
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <filesystem>
+
+namespace Piccolo
+{
+    /**
+     *  Checks that the import cache misses whenever the source, the importer or its version change, that saved
+     *  entries hit with the same data, and that entries of another type or truncated ones are rejected and
+     *  rewritten. Works in cache_folder, which is emptied first. Logs every failed check and returns whether all
+     *  passed. Needs the log system started, headless is enough
+     */
+    bool runImportCacheInvalidationTest(const std::filesystem::path& cache_folder);
+} // namespace Piccolo
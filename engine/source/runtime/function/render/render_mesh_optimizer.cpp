@@ -0,0 +1,410 @@
+#include "runtime/function/render/render_mesh_optimizer.h"
+
+#include "runtime/core/base/hash.h"
+#include "runtime/core/math/vector3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // size of the simulated lru cache the triangle order is scored against
+        constexpr uint32_t k_vertex_cache_size = 32;
+        // fifo size of the cache simulation that splits the triangles into runs for the overdraw order
+        constexpr uint32_t k_overdraw_cache_size = 16;
+        constexpr uint32_t k_invalid_triangle    = std::numeric_limits<uint32_t>::max();
+
+        // the attributes vertices are merged by, tangents are averaged over the merged vertices
+        struct VertexKey
+        {
+            float m_attributes[8];
+
+            bool operator==(const VertexKey& rhs) const
+            {
+                return std::memcmp(m_attributes, rhs.m_attributes, sizeof(m_attributes)) == 0;
+            }
+        };
+
+        struct VertexKeyHash
+        {
+            size_t operator()(const VertexKey& key) const
+            {
+                size_t hash = 0;
+                for (float attribute : key.m_attributes)
+                {
+                    hash_combine(hash, attribute);
+                }
+                return hash;
+            }
+        };
+
+        VertexKey makeVertexKey(const MeshVertexDataDefinition& vertex)
+        {
+            return VertexKey {{vertex.x, vertex.y, vertex.z, vertex.nx, vertex.ny, vertex.nz, vertex.u, vertex.v}};
+        }
+
+        float getVertexScore(int32_t cache_position, uint32_t remaining_valence)
+        {
+            if (remaining_valence == 0)
+            {
+                return -1.f;
+            }
+
+            float score = 0.f;
+            if (cache_position >= 0)
+            {
+                // the vertices of the last triangle get a fixed score so that strips do not simply turn back
+                if (cache_position < 3)
+                {
+                    score = 0.75f;
+                }
+                else
+                {
+                    const float scaler = 1.f / (k_vertex_cache_size - 3);
+                    score              = std::pow(1.f - (cache_position - 3) * scaler, 1.5f);
+                }
+            }
+
+            // favour vertices with few triangles left, they would otherwise be left behind as lone triangles
+            score += 2.f / std::sqrt(static_cast<float>(remaining_valence));
+            return score;
+        }
+
+        Vector3 getPosition(const MeshVertexDataDefinition& vertex) { return Vector3(vertex.x, vertex.y, vertex.z); }
+    } // namespace
+
+    void deduplicateVertices(const std::vector<MeshVertexDataDefinition>& triangle_vertices,
+                             std::vector<MeshVertexDataDefinition>&       out_vertices,
+                             std::vector<uint32_t>&                       out_indices)
+    {
+        out_vertices.clear();
+        out_indices.clear();
+        out_indices.reserve(triangle_vertices.size());
+
+        std::unordered_map<VertexKey, uint32_t, VertexKeyHash> vertex_indices;
+        vertex_indices.reserve(triangle_vertices.size());
+        std::vector<Vector3> tangent_sums;
+
+        for (const MeshVertexDataDefinition& vertex : triangle_vertices)
+        {
+            const Vector3 tangent(vertex.tx, vertex.ty, vertex.tz);
+
+            auto emplace_result =
+                vertex_indices.emplace(makeVertexKey(vertex), static_cast<uint32_t>(out_vertices.size()));
+            if (emplace_result.second)
+            {
+                out_vertices.push_back(vertex);
+                tangent_sums.push_back(tangent);
+            }
+            else
+            {
+                tangent_sums[emplace_result.first->second] += tangent;
+            }
+            out_indices.push_back(emplace_result.first->second);
+        }
+
+        for (size_t vertex_index = 0; vertex_index < out_vertices.size(); ++vertex_index)
+        {
+            MeshVertexDataDefinition& vertex  = out_vertices[vertex_index];
+            Vector3                   tangent = tangent_sums[vertex_index].normalisedCopy();
+            // opposite uv mirroring cancelled out, keep the tangent of the first face
+            if (tangent.isZeroLength())
+            {
+                continue;
+            }
+
+            vertex.tx = tangent.x;
+            vertex.ty = tangent.y;
+            vertex.tz = tangent.z;
+        }
+    }
+
+    void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertex_count)
+    {
+        const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+        if (triangle_count == 0)
+        {
+            return;
+        }
+
+        // triangles of each vertex, the still unemitted ones are kept at the front of the vertex range
+        std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+        for (uint32_t index : indices)
+        {
+            ++adjacency_offsets[index + 1];
+        }
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            adjacency_offsets[vertex_index + 1] += adjacency_offsets[vertex_index];
+        }
+
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> remaining_valence(vertex_count, 0);
+        for (uint32_t triangle_index = 0; triangle_index < triangle_count; ++triangle_index)
+        {
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t vertex_index = indices[triangle_index * 3 + corner];
+                adjacency[adjacency_offsets[vertex_index] + remaining_valence[vertex_index]++] = triangle_index;
+            }
+        }
+
+        std::vector<int32_t> cache_positions(vertex_count, -1);
+        std::vector<float>   vertex_scores(vertex_count);
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            vertex_scores[vertex_index] = getVertexScore(-1, remaining_valence[vertex_index]);
+        }
+
+        std::vector<float> triangle_scores(triangle_count);
+        uint32_t           best_triangle = 0;
+        for (uint32_t triangle_index = 0; triangle_index < triangle_count; ++triangle_index)
+        {
+            triangle_scores[triangle_index] = vertex_scores[indices[triangle_index * 3 + 0]] +
+                                              vertex_scores[indices[triangle_index * 3 + 1]] +
+                                              vertex_scores[indices[triangle_index * 3 + 2]];
+            if (triangle_scores[triangle_index] > triangle_scores[best_triangle])
+            {
+                best_triangle = triangle_index;
+            }
+        }
+
+        std::vector<uint8_t>  is_emitted(triangle_count, 0);
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> new_cache;
+        std::vector<uint32_t> output;
+        cache.reserve(k_vertex_cache_size + 3);
+        new_cache.reserve(k_vertex_cache_size + 3);
+        output.reserve(indices.size());
+
+        // rescores a vertex and moves the difference onto its remaining triangles
+        auto update_vertex_score = [&](uint32_t vertex_index) {
+            const float new_score = getVertexScore(cache_positions[vertex_index], remaining_valence[vertex_index]);
+            const float delta     = new_score - vertex_scores[vertex_index];
+            vertex_scores[vertex_index] = new_score;
+
+            const uint32_t begin = adjacency_offsets[vertex_index];
+            for (uint32_t offset = begin; offset < begin + remaining_valence[vertex_index]; ++offset)
+            {
+                triangle_scores[adjacency[offset]] += delta;
+            }
+        };
+
+        uint32_t scan_cursor = 0;
+        while (best_triangle != k_invalid_triangle)
+        {
+            is_emitted[best_triangle] = 1;
+
+            new_cache.clear();
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t vertex_index = indices[best_triangle * 3 + corner];
+                output.push_back(vertex_index);
+
+                // drop the triangle from the unemitted range of the vertex
+                const uint32_t begin = adjacency_offsets[vertex_index];
+                const uint32_t end   = begin + remaining_valence[vertex_index];
+                const auto     iter  = std::find(adjacency.begin() + begin, adjacency.begin() + end, best_triangle);
+                std::iter_swap(iter, adjacency.begin() + end - 1);
+                --remaining_valence[vertex_index];
+
+                if (std::find(new_cache.begin(), new_cache.end(), vertex_index) == new_cache.end())
+                {
+                    new_cache.push_back(vertex_index);
+                }
+            }
+
+            // the emitted vertices move to the front, the rest keeps its order
+            const size_t emitted_count = new_cache.size();
+            for (uint32_t vertex_index : cache)
+            {
+                const auto emitted_end = new_cache.begin() + emitted_count;
+                if (std::find(new_cache.begin(), emitted_end, vertex_index) == emitted_end)
+                {
+                    new_cache.push_back(vertex_index);
+                }
+            }
+
+            for (size_t cache_index = k_vertex_cache_size; cache_index < new_cache.size(); ++cache_index)
+            {
+                cache_positions[new_cache[cache_index]] = -1;
+                update_vertex_score(new_cache[cache_index]);
+            }
+            if (new_cache.size() > k_vertex_cache_size)
+            {
+                new_cache.resize(k_vertex_cache_size);
+            }
+            cache.swap(new_cache);
+
+            for (size_t cache_index = 0; cache_index < cache.size(); ++cache_index)
+            {
+                cache_positions[cache[cache_index]] = static_cast<int32_t>(cache_index);
+                update_vertex_score(cache[cache_index]);
+            }
+
+            // the next triangle is the best one touching the cache
+            best_triangle    = k_invalid_triangle;
+            float best_score = -1.f;
+            for (uint32_t vertex_index : cache)
+            {
+                const uint32_t begin = adjacency_offsets[vertex_index];
+                for (uint32_t offset = begin; offset < begin + remaining_valence[vertex_index]; ++offset)
+                {
+                    const uint32_t triangle_index = adjacency[offset];
+                    if (triangle_scores[triangle_index] > best_score)
+                    {
+                        best_score    = triangle_scores[triangle_index];
+                        best_triangle = triangle_index;
+                    }
+                }
+            }
+
+            // nothing left around the cache, continue with the next triangle in the source order
+            if (best_triangle == k_invalid_triangle)
+            {
+                while (scan_cursor < triangle_count && is_emitted[scan_cursor])
+                {
+                    ++scan_cursor;
+                }
+                if (scan_cursor < triangle_count)
+                {
+                    best_triangle = scan_cursor;
+                }
+            }
+        }
+
+        indices.swap(output);
+    }
+
+    void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<MeshVertexDataDefinition>& vertices)
+    {
+        const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+        if (triangle_count == 0)
+        {
+            return;
+        }
+
+        // a run starts wherever a triangle misses the simulated cache with all of its vertices
+        std::vector<uint32_t> run_starts;
+        std::vector<uint32_t> cache_timestamps(vertices.size(), 0);
+        uint32_t              timestamp = k_overdraw_cache_size + 1;
+        for (uint32_t triangle_index = 0; triangle_index < triangle_count; ++triangle_index)
+        {
+            uint32_t cache_misses = 0;
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t vertex_index = indices[triangle_index * 3 + corner];
+                if (timestamp - cache_timestamps[vertex_index] > k_overdraw_cache_size)
+                {
+                    cache_timestamps[vertex_index] = timestamp++;
+                    ++cache_misses;
+                }
+            }
+
+            if (triangle_index == 0 || cache_misses == 3)
+            {
+                run_starts.push_back(triangle_index);
+            }
+        }
+        run_starts.push_back(triangle_count);
+
+        Vector3 mesh_center = Vector3::ZERO;
+        for (const MeshVertexDataDefinition& vertex : vertices)
+        {
+            mesh_center += getPosition(vertex);
+        }
+        mesh_center /= static_cast<float>(std::max<size_t>(vertices.size(), 1));
+
+        // runs that face away from the center are likely in front of the others from any view point
+        const size_t        run_count = run_starts.size() - 1;
+        std::vector<float>  run_sort_keys(run_count);
+        std::vector<size_t> run_order(run_count);
+        for (size_t run_index = 0; run_index < run_count; ++run_index)
+        {
+            Vector3 run_center      = Vector3::ZERO;
+            Vector3 run_normal      = Vector3::ZERO;
+            float   run_area_weight = 0.f;
+            for (uint32_t triangle_index = run_starts[run_index]; triangle_index < run_starts[run_index + 1];
+                 ++triangle_index)
+            {
+                const Vector3 p0 = getPosition(vertices[indices[triangle_index * 3 + 0]]);
+                const Vector3 p1 = getPosition(vertices[indices[triangle_index * 3 + 1]]);
+                const Vector3 p2 = getPosition(vertices[indices[triangle_index * 3 + 2]]);
+
+                // the cross product is area weighted
+                const Vector3 normal = (p1 - p0).crossProduct(p2 - p0);
+                const float   area   = normal.length();
+                run_center += (p0 + p1 + p2) * (area / 3.f);
+                run_normal += normal;
+                run_area_weight += area;
+            }
+
+            if (run_area_weight > 0.f)
+            {
+                run_center /= run_area_weight;
+            }
+            run_sort_keys[run_index] = (run_center - mesh_center).dotProduct(run_normal.normalisedCopy());
+            run_order[run_index]     = run_index;
+        }
+
+        std::stable_sort(run_order.begin(), run_order.end(), [&run_sort_keys](size_t lhs, size_t rhs) {
+            return run_sort_keys[lhs] > run_sort_keys[rhs];
+        });
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        for (size_t run_index : run_order)
+        {
+            output.insert(output.end(),
+                          indices.begin() + run_starts[run_index] * 3,
+                          indices.begin() + run_starts[run_index + 1] * 3);
+        }
+        indices.swap(output);
+    }
+
+    void optimizeVertexFetch(std::vector<MeshVertexDataDefinition>& vertices, std::vector<uint32_t>& indices)
+    {
+        std::vector<uint32_t>                 remap(vertices.size(), std::numeric_limits<uint32_t>::max());
+        std::vector<MeshVertexDataDefinition> output;
+        output.reserve(vertices.size());
+
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == std::numeric_limits<uint32_t>::max())
+            {
+                remap[index] = static_cast<uint32_t>(output.size());
+                output.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+
+        vertices.swap(output);
+    }
+
+    std::shared_ptr<BufferData>
+    createIndexBufferData(const std::vector<uint32_t>& indices, uint32_t vertex_count, RHIIndexType& out_index_type)
+    {
+        // 0xffff stays unused so that the 16-bit buffers keep working with primitive restart
+        if (vertex_count <= std::numeric_limits<uint16_t>::max())
+        {
+            out_index_type                          = RHI_INDEX_TYPE_UINT16;
+            std::shared_ptr<BufferData> buffer_data = std::make_shared<BufferData>(indices.size() * sizeof(uint16_t));
+            uint16_t*                   index_data  = static_cast<uint16_t*>(buffer_data->m_data);
+            for (size_t index = 0; index < indices.size(); ++index)
+            {
+                index_data[index] = static_cast<uint16_t>(indices[index]);
+            }
+            return buffer_data;
+        }
+
+        out_index_type                          = RHI_INDEX_TYPE_UINT32;
+        std::shared_ptr<BufferData> buffer_data = std::make_shared<BufferData>(indices.size() * sizeof(uint32_t));
+        std::memcpy(buffer_data->m_data, indices.data(), indices.size() * sizeof(uint32_t));
+        return buffer_data;
+    }
+} // namespace Piccolo
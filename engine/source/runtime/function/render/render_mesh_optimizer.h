@@ -0,0 +1,32 @@
+#pragma once
+
+#include "runtime/function/render/render_type.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Piccolo
+{
+    /// merges vertices with bitwise identical position, normal and uv, the triangle list is rewritten to index the
+    /// unique vertices. The tangents of the merged vertices are averaged, the tangent of the first one is kept where
+    /// they cancel out
+    void deduplicateVertices(const std::vector<MeshVertexDataDefinition>& triangle_vertices,
+                             std::vector<MeshVertexDataDefinition>&       out_vertices,
+                             std::vector<uint32_t>&                       out_indices);
+
+    /// reorders the triangles for the post-transform vertex cache, Forsyth's linear-speed vertex cache optimization
+    void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertex_count);
+
+    /// reorders runs of the cache optimized triangles so that the outward facing parts of the mesh are drawn
+    /// first. Runs only break where the vertex cache is cold anyway, so the cache efficiency is kept
+    void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<MeshVertexDataDefinition>& vertices);
+
+    /// renumbers the vertices in the order the triangles first use them, vertex fetch then walks the buffer
+    /// linearly. Vertices that no triangle uses are dropped
+    void optimizeVertexFetch(std::vector<MeshVertexDataDefinition>& vertices, std::vector<uint32_t>& indices);
+
+    /// 16-bit indices whenever the vertex count allows it, 32-bit otherwise
+    std::shared_ptr<BufferData>
+    createIndexBufferData(const std::vector<uint32_t>& indices, uint32_t vertex_count, RHIIndexType& out_index_type);
+} // namespace Piccolo
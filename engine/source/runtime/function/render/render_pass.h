@@ -1,6 +1,7 @@
 #pragma once
 
 #include "runtime/function/render/render_common.h"
+#include "runtime/function/render/render_draw_list.h"
 #include "runtime/function/render/render_pass_base.h"
 #include "runtime/function/render/render_resource.h"
 
@@ -48,6 +49,10 @@ namespace Piccolo
         std::vector<RenderMeshNode>*              p_point_lights_visible_mesh_nodes {nullptr};
         std::vector<RenderMeshNode>*              p_main_camera_visible_mesh_nodes {nullptr};
         RenderAxisNode*                           p_axis_node {nullptr};
+        // the visible mesh nodes sorted and batched for drawing
+        RenderDrawList*                           p_directional_light_draw_list {nullptr};
+        RenderDrawList*                           p_point_lights_draw_list {nullptr};
+        RenderDrawList*                           p_main_camera_draw_list {nullptr};
     };
 
     class RenderPass : public RenderPassBase
@@ -17,6 +17,15 @@ namespace Piccolo
 {
     void RenderResource::clear()
     {
+        const RenderImportCache& import_cache = getImportCache();
+        if (import_cache.isEnabled())
+        {
+            const RenderImportCache::Statistics& statistics = import_cache.getStatistics();
+            LOG_INFO("import cache: {} hits, {} misses, {} rejected entries",
+                     statistics.m_hit_count,
+                     statistics.m_miss_count,
+                     statistics.m_rejected_count);
+        }
     }
 
     void RenderResource::uploadGlobalRenderResource(std::shared_ptr<RHI> rhi, LevelResourceDesc level_resource_desc)
@@ -286,6 +295,7 @@ namespace Piccolo
 
             uint32_t index_buffer_size = static_cast<uint32_t>(mesh_data.m_static_mesh_data.m_index_buffer->m_size);
             void* index_buffer_data = mesh_data.m_static_mesh_data.m_index_buffer->m_data;
+            RHIIndexType index_type = mesh_data.m_static_mesh_data.m_index_type;
 
             uint32_t vertex_buffer_size = static_cast<uint32_t>(mesh_data.m_static_mesh_data.m_vertex_buffer->m_size);
             MeshVertexDataDefinition* vertex_buffer_data =
@@ -302,6 +312,7 @@ namespace Piccolo
                                true,
                                index_buffer_size,
                                index_buffer_data,
+                               index_type,
                                vertex_buffer_size,
                                vertex_buffer_data,
                                joint_binding_buffer_size,
@@ -314,6 +325,7 @@ namespace Piccolo
                                false,
                                index_buffer_size,
                                index_buffer_data,
+                               index_type,
                                vertex_buffer_size,
                                vertex_buffer_data,
                                0,
@@ -408,46 +420,11 @@ namespace Piccolo
 
             VulkanPBRMaterial& now_material = res.first->second;
 
-            // similiarly to the vertex/index buffer, we should allocate the uniform
-            // buffer in DEVICE_LOCAL memory and use the temp stage buffer to copy the
-            // data
+            // similiarly to the vertex/index buffer, we allocate the uniform buffer in DEVICE_LOCAL memory and
+            // upload the data through the staging ring of the rhi
             {
-                // temporary staging buffer
-
                 RHIDeviceSize buffer_size = sizeof(MeshPerMaterialUniformBufferObject);
 
-                RHIBuffer* inefficient_staging_buffer = RHI_NULL_HANDLE;
-                RHIDeviceMemory* inefficient_staging_buffer_memory = RHI_NULL_HANDLE;
-                rhi->createBuffer(
-                    buffer_size,
-                    RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                    RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                    inefficient_staging_buffer,
-                    inefficient_staging_buffer_memory);
-                // RHI_BUFFER_USAGE_TRANSFER_SRC_BIT: buffer can be used as source in a
-                // memory transfer operation
-
-                void* staging_buffer_data = nullptr;
-                rhi->mapMemory(
-                    inefficient_staging_buffer_memory,
-                    0,
-                    buffer_size,
-                    0,
-                    &staging_buffer_data);
-                
-                MeshPerMaterialUniformBufferObject& material_uniform_buffer_info =
-                    (*static_cast<MeshPerMaterialUniformBufferObject*>(staging_buffer_data));
-                material_uniform_buffer_info.is_blend = entity.m_blend;
-                material_uniform_buffer_info.is_double_sided = entity.m_double_sided;
-                material_uniform_buffer_info.baseColorFactor = entity.m_base_color_factor;
-                material_uniform_buffer_info.metallicFactor = entity.m_metallic_factor;
-                material_uniform_buffer_info.roughnessFactor = entity.m_roughness_factor;
-                material_uniform_buffer_info.normalScale = entity.m_normal_scale;
-                material_uniform_buffer_info.occlusionStrength = entity.m_occlusion_strength;
-                material_uniform_buffer_info.emissiveFactor = entity.m_emissive_factor;
-
-                rhi->unmapMemory(inefficient_staging_buffer_memory);
-
                 // use the vmaAllocator to allocate asset uniform buffer
                 RHIBufferCreateInfo bufferInfo = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
                 bufferInfo.size = buffer_size;
@@ -465,12 +442,17 @@ namespace Piccolo
                     &now_material.material_uniform_buffer_allocation,
                     NULL);
 
-                // use the data from staging buffer
-                rhi->copyBuffer(inefficient_staging_buffer, now_material.material_uniform_buffer, 0, 0, buffer_size);
-
-                // release staging buffer
-                rhi->destroyBuffer(inefficient_staging_buffer);
-                rhi->freeMemory(inefficient_staging_buffer_memory);
+                MeshPerMaterialUniformBufferObject& material_uniform_buffer_info =
+                    (*static_cast<MeshPerMaterialUniformBufferObject*>(
+                        rhi->mapUploadBuffer(now_material.material_uniform_buffer, 0, buffer_size)));
+                material_uniform_buffer_info.is_blend = entity.m_blend;
+                material_uniform_buffer_info.is_double_sided = entity.m_double_sided;
+                material_uniform_buffer_info.baseColorFactor = entity.m_base_color_factor;
+                material_uniform_buffer_info.metallicFactor = entity.m_metallic_factor;
+                material_uniform_buffer_info.roughnessFactor = entity.m_roughness_factor;
+                material_uniform_buffer_info.normalScale = entity.m_normal_scale;
+                material_uniform_buffer_info.occlusionStrength = entity.m_occlusion_strength;
+                material_uniform_buffer_info.emissiveFactor = entity.m_emissive_factor;
             }
 
             TextureDataToUpdate update_texture_data;
@@ -591,6 +573,7 @@ namespace Piccolo
                                         bool                                   enable_vertex_blending,
                                         uint32_t                               index_buffer_size,
                                         void*                                  index_buffer_data,
+                                        RHIIndexType                           index_type,
                                         uint32_t                               vertex_buffer_size,
                                         MeshVertexDataDefinition const*        vertex_buffer_data,
                                         uint32_t                               joint_binding_buffer_size,
@@ -606,11 +589,11 @@ namespace Piccolo
                            vertex_buffer_data,
                            joint_binding_buffer_size,
                            joint_binding_buffer_data,
-                           index_buffer_size,
-                           reinterpret_cast<uint16_t*>(index_buffer_data),
                            now_mesh);
-        assert(0 == (index_buffer_size % sizeof(uint16_t)));
-        now_mesh.mesh_index_count = index_buffer_size / sizeof(uint16_t);
+        const uint32_t index_stride = index_type == RHI_INDEX_TYPE_UINT32 ? sizeof(uint32_t) : sizeof(uint16_t);
+        assert(0 == (index_buffer_size % index_stride));
+        now_mesh.mesh_index_count = index_buffer_size / index_stride;
+        now_mesh.mesh_index_type  = index_type;
         updateIndexBuffer(rhi, index_buffer_size, index_buffer_data, now_mesh);
     }
 
@@ -620,8 +603,6 @@ namespace Piccolo
                                             MeshVertexDataDefinition const*        vertex_buffer_data,
                                             uint32_t                               joint_binding_buffer_size,
                                             MeshVertexBindingDataDefinition const* joint_binding_buffer_data,
-                                            uint32_t                               index_buffer_size,
-                                            uint16_t*                              index_buffer_data,
                                             VulkanMesh&                            now_mesh)
     {
         VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
@@ -630,110 +611,24 @@ namespace Piccolo
         {
             assert(0 == (vertex_buffer_size % sizeof(MeshVertexDataDefinition)));
             uint32_t vertex_count = vertex_buffer_size / sizeof(MeshVertexDataDefinition);
-            assert(0 == (index_buffer_size % sizeof(uint16_t)));
-            uint32_t index_count = index_buffer_size / sizeof(uint16_t);
+            assert(0 == (joint_binding_buffer_size % sizeof(MeshVertexBindingDataDefinition)));
+            assert(joint_binding_buffer_size / sizeof(MeshVertexBindingDataDefinition) == vertex_count);
 
             RHIDeviceSize vertex_position_buffer_size = sizeof(MeshVertex::VulkanMeshVertexPostition) * vertex_count;
             RHIDeviceSize vertex_varying_enable_blending_buffer_size =
                 sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * vertex_count;
             RHIDeviceSize vertex_varying_buffer_size = sizeof(MeshVertex::VulkanMeshVertexVarying) * vertex_count;
+            // the vertex shader reads the binding by gl_VertexIndex, so it is stored per vertex like the attributes
             RHIDeviceSize vertex_joint_binding_buffer_size =
-                sizeof(MeshVertex::VulkanMeshVertexJointBinding) * index_count;
-
-            RHIDeviceSize vertex_position_buffer_offset = 0;
-            RHIDeviceSize vertex_varying_enable_blending_buffer_offset =
-                vertex_position_buffer_offset + vertex_position_buffer_size;
-            RHIDeviceSize vertex_varying_buffer_offset =
-                vertex_varying_enable_blending_buffer_offset + vertex_varying_enable_blending_buffer_size;
-            RHIDeviceSize vertex_joint_binding_buffer_offset = vertex_varying_buffer_offset + vertex_varying_buffer_size;
-
-            // temporary staging buffer
-            RHIDeviceSize inefficient_staging_buffer_size =
-                vertex_position_buffer_size + vertex_varying_enable_blending_buffer_size + vertex_varying_buffer_size +
-                vertex_joint_binding_buffer_size;
-            RHIBuffer* inefficient_staging_buffer = RHI_NULL_HANDLE;
-            RHIDeviceMemory* inefficient_staging_buffer_memory = RHI_NULL_HANDLE;
-            rhi->createBuffer(inefficient_staging_buffer_size,
-                              RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                              RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                              inefficient_staging_buffer,
-                              inefficient_staging_buffer_memory);
-
-            void* inefficient_staging_buffer_data;
-            rhi->mapMemory(inefficient_staging_buffer_memory,
-                           0,
-                           RHI_WHOLE_SIZE,
-                           0,
-                           &inefficient_staging_buffer_data);
-
-            MeshVertex::VulkanMeshVertexPostition* mesh_vertex_positions =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexPostition*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_position_buffer_offset);
-            MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_blending_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) +
-                    vertex_varying_enable_blending_buffer_offset);
-            MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVarying*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_varying_buffer_offset);
-            MeshVertex::VulkanMeshVertexJointBinding* mesh_vertex_joint_binding =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexJointBinding*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_joint_binding_buffer_offset);
-
-            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
-            {
-                Vector3 normal = Vector3(vertex_buffer_data[vertex_index].nx,
-                    vertex_buffer_data[vertex_index].ny,
-                    vertex_buffer_data[vertex_index].nz);
-                Vector3 tangent = Vector3(vertex_buffer_data[vertex_index].tx,
-                    vertex_buffer_data[vertex_index].ty,
-                    vertex_buffer_data[vertex_index].tz);
-
-                mesh_vertex_positions[vertex_index].position = Vector3(vertex_buffer_data[vertex_index].x,
-                    vertex_buffer_data[vertex_index].y,
-                    vertex_buffer_data[vertex_index].z);
-
-                mesh_vertex_blending_varyings[vertex_index].normal = normal;
-                mesh_vertex_blending_varyings[vertex_index].tangent = tangent;
-
-                mesh_vertex_varyings[vertex_index].texcoord =
-                    Vector2(vertex_buffer_data[vertex_index].u, vertex_buffer_data[vertex_index].v);
-            }
-
-            for (uint32_t index_index = 0; index_index < index_count; ++index_index)
-            {
-                uint32_t vertex_buffer_index = index_buffer_data[index_index];
-
-                // TODO: move to assets loading process
-
-                mesh_vertex_joint_binding[index_index].indices[0] = joint_binding_buffer_data[vertex_buffer_index].m_index0;
-                mesh_vertex_joint_binding[index_index].indices[1] = joint_binding_buffer_data[vertex_buffer_index].m_index1;
-                mesh_vertex_joint_binding[index_index].indices[2] = joint_binding_buffer_data[vertex_buffer_index].m_index2;
-                mesh_vertex_joint_binding[index_index].indices[3] = joint_binding_buffer_data[vertex_buffer_index].m_index3;
-
-                float inv_total_weight = joint_binding_buffer_data[vertex_buffer_index].m_weight0 +
-                                         joint_binding_buffer_data[vertex_buffer_index].m_weight1 +
-                                         joint_binding_buffer_data[vertex_buffer_index].m_weight2 +
-                                         joint_binding_buffer_data[vertex_buffer_index].m_weight3;
-
-                inv_total_weight = (inv_total_weight != 0.0) ? 1 / inv_total_weight : 1.0;
-
-                mesh_vertex_joint_binding[index_index].weights =
-                    Vector4(joint_binding_buffer_data[vertex_buffer_index].m_weight0 * inv_total_weight,
-                        joint_binding_buffer_data[vertex_buffer_index].m_weight1 * inv_total_weight,
-                        joint_binding_buffer_data[vertex_buffer_index].m_weight2 * inv_total_weight,
-                        joint_binding_buffer_data[vertex_buffer_index].m_weight3 * inv_total_weight);
-            }
-
-            rhi->unmapMemory(inefficient_staging_buffer_memory);
+                sizeof(MeshVertex::VulkanMeshVertexJointBinding) * vertex_count;
 
             // use the vmaAllocator to allocate asset vertex buffer
             RHIBufferCreateInfo bufferInfo = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+            bufferInfo.usage = RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
 
             VmaAllocationCreateInfo allocInfo = {};
             allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
-            bufferInfo.usage = RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
             bufferInfo.size = vertex_position_buffer_size;
             rhi->createBufferVMA(vulkan_context->m_assets_allocator,
                                  &bufferInfo,
@@ -765,31 +660,66 @@ namespace Piccolo
                                  &now_mesh.mesh_vertex_joint_binding_buffer_allocation,
                                  NULL);
 
-            // use the data from staging buffer
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_position_buffer,
-                            vertex_position_buffer_offset,
-                            0,
-                            vertex_position_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_varying_enable_blending_buffer,
-                            vertex_varying_enable_blending_buffer_offset,
-                            0,
-                            vertex_varying_enable_blending_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_varying_buffer,
-                            vertex_varying_buffer_offset,
-                            0,
-                            vertex_varying_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_joint_binding_buffer,
-                            vertex_joint_binding_buffer_offset,
-                            0,
-                            vertex_joint_binding_buffer_size);
-
-            // release staging buffer
-            rhi->destroyBuffer(inefficient_staging_buffer);
-            rhi->freeMemory(inefficient_staging_buffer_memory);
+            // every stream is filled before the next one is mapped, the upload memory is only valid until then
+            MeshVertex::VulkanMeshVertexPostition* mesh_vertex_positions =
+                static_cast<MeshVertex::VulkanMeshVertexPostition*>(
+                    rhi->mapUploadBuffer(now_mesh.mesh_vertex_position_buffer, 0, vertex_position_buffer_size));
+            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                mesh_vertex_positions[vertex_index].position = Vector3(vertex_buffer_data[vertex_index].x,
+                    vertex_buffer_data[vertex_index].y,
+                    vertex_buffer_data[vertex_index].z);
+            }
+
+            MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_blending_varyings =
+                static_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(
+                    rhi->mapUploadBuffer(now_mesh.mesh_vertex_varying_enable_blending_buffer,
+                                         0,
+                                         vertex_varying_enable_blending_buffer_size));
+            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                mesh_vertex_blending_varyings[vertex_index].normal = Vector3(vertex_buffer_data[vertex_index].nx,
+                    vertex_buffer_data[vertex_index].ny,
+                    vertex_buffer_data[vertex_index].nz);
+                mesh_vertex_blending_varyings[vertex_index].tangent = Vector3(vertex_buffer_data[vertex_index].tx,
+                    vertex_buffer_data[vertex_index].ty,
+                    vertex_buffer_data[vertex_index].tz);
+            }
+
+            MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings =
+                static_cast<MeshVertex::VulkanMeshVertexVarying*>(
+                    rhi->mapUploadBuffer(now_mesh.mesh_vertex_varying_buffer, 0, vertex_varying_buffer_size));
+            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                mesh_vertex_varyings[vertex_index].texcoord =
+                    Vector2(vertex_buffer_data[vertex_index].u, vertex_buffer_data[vertex_index].v);
+            }
+
+            MeshVertex::VulkanMeshVertexJointBinding* mesh_vertex_joint_binding =
+                static_cast<MeshVertex::VulkanMeshVertexJointBinding*>(rhi->mapUploadBuffer(
+                    now_mesh.mesh_vertex_joint_binding_buffer, 0, vertex_joint_binding_buffer_size));
+            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                // TODO: move to assets loading process
+
+                mesh_vertex_joint_binding[vertex_index].indices[0] = joint_binding_buffer_data[vertex_index].m_index0;
+                mesh_vertex_joint_binding[vertex_index].indices[1] = joint_binding_buffer_data[vertex_index].m_index1;
+                mesh_vertex_joint_binding[vertex_index].indices[2] = joint_binding_buffer_data[vertex_index].m_index2;
+                mesh_vertex_joint_binding[vertex_index].indices[3] = joint_binding_buffer_data[vertex_index].m_index3;
+
+                float inv_total_weight = joint_binding_buffer_data[vertex_index].m_weight0 +
+                                         joint_binding_buffer_data[vertex_index].m_weight1 +
+                                         joint_binding_buffer_data[vertex_index].m_weight2 +
+                                         joint_binding_buffer_data[vertex_index].m_weight3;
+
+                inv_total_weight = (inv_total_weight != 0.0) ? 1 / inv_total_weight : 1.0;
+
+                mesh_vertex_joint_binding[vertex_index].weights =
+                    Vector4(joint_binding_buffer_data[vertex_index].m_weight0 * inv_total_weight,
+                        joint_binding_buffer_data[vertex_index].m_weight1 * inv_total_weight,
+                        joint_binding_buffer_data[vertex_index].m_weight2 * inv_total_weight,
+                        joint_binding_buffer_data[vertex_index].m_weight3 * inv_total_weight);
+            }
 
             // update descriptor set
             RHIDescriptorSetAllocateInfo mesh_vertex_blending_per_mesh_descriptor_set_alloc_info;
@@ -847,63 +777,6 @@ namespace Piccolo
                 sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * vertex_count;
             RHIDeviceSize vertex_varying_buffer_size = sizeof(MeshVertex::VulkanMeshVertexVarying) * vertex_count;
 
-            RHIDeviceSize vertex_position_buffer_offset = 0;
-            RHIDeviceSize vertex_varying_enable_blending_buffer_offset =
-                vertex_position_buffer_offset + vertex_position_buffer_size;
-            RHIDeviceSize vertex_varying_buffer_offset =
-                vertex_varying_enable_blending_buffer_offset + vertex_varying_enable_blending_buffer_size;
-
-            // temporary staging buffer
-            RHIDeviceSize inefficient_staging_buffer_size =
-                vertex_position_buffer_size + vertex_varying_enable_blending_buffer_size + vertex_varying_buffer_size;
-            RHIBuffer* inefficient_staging_buffer = RHI_NULL_HANDLE;
-            RHIDeviceMemory* inefficient_staging_buffer_memory = RHI_NULL_HANDLE;
-            rhi->createBuffer(inefficient_staging_buffer_size,
-                              RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                              RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                              inefficient_staging_buffer,
-                              inefficient_staging_buffer_memory);
-
-            void* inefficient_staging_buffer_data;
-            rhi->mapMemory(inefficient_staging_buffer_memory,
-                           0,
-                           RHI_WHOLE_SIZE,
-                           0,
-                           &inefficient_staging_buffer_data);
-
-            MeshVertex::VulkanMeshVertexPostition* mesh_vertex_positions =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexPostition*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_position_buffer_offset);
-            MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_blending_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) +
-                    vertex_varying_enable_blending_buffer_offset);
-            MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVarying*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_varying_buffer_offset);
-
-            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
-            {
-                Vector3 normal = Vector3(vertex_buffer_data[vertex_index].nx,
-                    vertex_buffer_data[vertex_index].ny,
-                    vertex_buffer_data[vertex_index].nz);
-                Vector3 tangent = Vector3(vertex_buffer_data[vertex_index].tx,
-                    vertex_buffer_data[vertex_index].ty,
-                    vertex_buffer_data[vertex_index].tz);
-
-                mesh_vertex_positions[vertex_index].position = Vector3(vertex_buffer_data[vertex_index].x,
-                    vertex_buffer_data[vertex_index].y,
-                    vertex_buffer_data[vertex_index].z);
-
-                mesh_vertex_blending_varyings[vertex_index].normal = normal;
-                mesh_vertex_blending_varyings[vertex_index].tangent = tangent;
-
-                mesh_vertex_varyings[vertex_index].texcoord =
-                    Vector2(vertex_buffer_data[vertex_index].u, vertex_buffer_data[vertex_index].v);
-            }
-
-            rhi->unmapMemory(inefficient_staging_buffer_memory);
-
             // use the vmaAllocator to allocate asset vertex buffer
             RHIBufferCreateInfo bufferInfo = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
             bufferInfo.usage = RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
@@ -933,26 +806,40 @@ namespace Piccolo
                                  &now_mesh.mesh_vertex_varying_buffer_allocation,
                                  NULL);
 
-            // use the data from staging buffer
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_position_buffer,
-                            vertex_position_buffer_offset,
-                            0,
-                            vertex_position_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_varying_enable_blending_buffer,
-                            vertex_varying_enable_blending_buffer_offset,
-                            0,
-                            vertex_varying_enable_blending_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_varying_buffer,
-                            vertex_varying_buffer_offset,
-                            0,
-                            vertex_varying_buffer_size);
-
-            // release staging buffer
-            rhi->destroyBuffer(inefficient_staging_buffer);
-            rhi->freeMemory(inefficient_staging_buffer_memory);
+            // every stream is filled before the next one is mapped, the upload memory is only valid until then
+            MeshVertex::VulkanMeshVertexPostition* mesh_vertex_positions =
+                static_cast<MeshVertex::VulkanMeshVertexPostition*>(
+                    rhi->mapUploadBuffer(now_mesh.mesh_vertex_position_buffer, 0, vertex_position_buffer_size));
+            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                mesh_vertex_positions[vertex_index].position = Vector3(vertex_buffer_data[vertex_index].x,
+                    vertex_buffer_data[vertex_index].y,
+                    vertex_buffer_data[vertex_index].z);
+            }
+
+            MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_blending_varyings =
+                static_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(
+                    rhi->mapUploadBuffer(now_mesh.mesh_vertex_varying_enable_blending_buffer,
+                                         0,
+                                         vertex_varying_enable_blending_buffer_size));
+            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                mesh_vertex_blending_varyings[vertex_index].normal = Vector3(vertex_buffer_data[vertex_index].nx,
+                    vertex_buffer_data[vertex_index].ny,
+                    vertex_buffer_data[vertex_index].nz);
+                mesh_vertex_blending_varyings[vertex_index].tangent = Vector3(vertex_buffer_data[vertex_index].tx,
+                    vertex_buffer_data[vertex_index].ty,
+                    vertex_buffer_data[vertex_index].tz);
+            }
+
+            MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings =
+                static_cast<MeshVertex::VulkanMeshVertexVarying*>(
+                    rhi->mapUploadBuffer(now_mesh.mesh_vertex_varying_buffer, 0, vertex_varying_buffer_size));
+            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                mesh_vertex_varyings[vertex_index].texcoord =
+                    Vector2(vertex_buffer_data[vertex_index].u, vertex_buffer_data[vertex_index].v);
+            }
 
             // update descriptor set
             RHIDescriptorSetAllocateInfo mesh_vertex_blending_per_mesh_descriptor_set_alloc_info;
@@ -1010,22 +897,8 @@ namespace Piccolo
     {
         VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
 
-        // temp staging buffer
         RHIDeviceSize buffer_size = index_buffer_size;
 
-        RHIBuffer* inefficient_staging_buffer;
-        RHIDeviceMemory* inefficient_staging_buffer_memory;
-        rhi->createBuffer(buffer_size,
-                          RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                          RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                          inefficient_staging_buffer,
-                          inefficient_staging_buffer_memory);
-
-        void* staging_buffer_data;
-        rhi->mapMemory(inefficient_staging_buffer_memory, 0, buffer_size, 0, &staging_buffer_data);
-        memcpy(staging_buffer_data, index_buffer_data, (size_t)buffer_size);
-        rhi->unmapMemory(inefficient_staging_buffer_memory);
-
         // use the vmaAllocator to allocate asset index buffer
         RHIBufferCreateInfo bufferInfo = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
         bufferInfo.size = buffer_size;
@@ -1041,12 +914,9 @@ namespace Piccolo
                              &now_mesh.mesh_index_buffer_allocation,
                              NULL);
 
-        // use the data from staging buffer
-        rhi->copyBuffer( inefficient_staging_buffer, now_mesh.mesh_index_buffer, 0, 0, buffer_size);
-
-        // release temp staging buffer
-        rhi->destroyBuffer(inefficient_staging_buffer);
-        rhi->freeMemory(inefficient_staging_buffer_memory);
+        // copied by the next flush of the uploads, before the first frame that draws the mesh
+        void* upload_data = rhi->mapUploadBuffer(now_mesh.mesh_index_buffer, 0, buffer_size);
+        memcpy(upload_data, index_buffer_data, (size_t)buffer_size);
     }
 
     void RenderResource::updateTextureImageData(std::shared_ptr<RHI> rhi, const TextureDataToUpdate& texture_data)
@@ -1097,7 +967,16 @@ namespace Piccolo
             texture_data.emissive_image_format);
     }
 
-    VulkanMesh& RenderResource::getEntityMesh(RenderEntity entity)
+    void RenderResource::createHeadlessGameObjectRenderResource(RenderEntity render_entity)
+    {
+        VulkanMesh mesh {};
+        mesh.enable_vertex_blending = render_entity.m_enable_vertex_blending;
+        m_vulkan_meshes.emplace(render_entity.m_mesh_asset_id, mesh);
+
+        m_vulkan_pbr_materials.emplace(render_entity.m_material_asset_id, VulkanPBRMaterial {});
+    }
+
+    VulkanMesh& RenderResource::getEntityMesh(const RenderEntity& entity)
     {
         size_t assetid = entity.m_mesh_asset_id;
 
@@ -1112,7 +991,7 @@ namespace Piccolo
         }
     }
 
-    VulkanPBRMaterial& RenderResource::getEntityMaterial(RenderEntity entity)
+    VulkanPBRMaterial& RenderResource::getEntityMaterial(const RenderEntity& entity)
     {
         size_t assetid = entity.m_material_asset_id;
 
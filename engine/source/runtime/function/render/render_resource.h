@@ -125,9 +125,12 @@ namespace Piccolo
         virtual void updatePerFrameBuffer(std::shared_ptr<RenderScene>  render_scene,
             std::shared_ptr<RenderCamera> camera) override final;
 
-        VulkanMesh& getEntityMesh(RenderEntity entity);
+        // cpu only stand-ins for the gpu mesh and material of an entity, used when rendering headless
+        void createHeadlessGameObjectRenderResource(RenderEntity render_entity);
 
-        VulkanPBRMaterial& getEntityMaterial(RenderEntity entity);
+        VulkanMesh& getEntityMesh(const RenderEntity& entity);
+
+        VulkanPBRMaterial& getEntityMaterial(const RenderEntity& entity);
 
         void resetRingBufferOffset(uint8_t current_frame_index);
 
@@ -167,6 +170,7 @@ namespace Piccolo
                             bool                                          enable_vertex_blending,
                             uint32_t                                      index_buffer_size,
                             void*                                         index_buffer_data,
+                            RHIIndexType                                  index_type,
                             uint32_t                                      vertex_buffer_size,
                             struct MeshVertexDataDefinition const*        vertex_buffer_data,
                             uint32_t                                      joint_binding_buffer_size,
@@ -178,8 +182,6 @@ namespace Piccolo
                                 struct MeshVertexDataDefinition const*        vertex_buffer_data,
                                 uint32_t                                      joint_binding_buffer_size,
                                 struct MeshVertexBindingDataDefinition const* joint_binding_buffer_data,
-                                uint32_t                                      index_buffer_size,
-                                uint16_t*                                     index_buffer_data,
                                 VulkanMesh&                                   now_mesh);
         void updateIndexBuffer(std::shared_ptr<RHI> rhi,
                                uint32_t             index_buffer_size,
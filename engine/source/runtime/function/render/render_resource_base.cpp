@@ -7,6 +7,7 @@
 #include "runtime/resource/res_type/data/mesh_data.h"
 
 #include "runtime/function/global/global_context.h"
+#include "runtime/function/render/render_mesh_optimizer.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -15,21 +16,54 @@
 #include "tiny_obj_loader.h"
 
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <vector>
 
 namespace Piccolo
 {
+    // bump the version of an importer whenever its output changes, the import cache keys change with it
+    static constexpr uint32_t k_static_mesh_importer_version = 1;
+    static constexpr uint32_t k_texture_importer_version     = 1;
+    static constexpr uint32_t k_hdr_texture_importer_version = 1;
+
+    namespace
+    {
+        bool readSourceFile(const std::filesystem::path& file_path, std::vector<uint8_t>& out_data)
+        {
+            std::ifstream source_file(file_path, std::ios::binary | std::ios::ate);
+            if (!source_file)
+            {
+                return false;
+            }
+
+            out_data.resize(static_cast<size_t>(source_file.tellg()));
+            source_file.seekg(0);
+            source_file.read(reinterpret_cast<char*>(out_data.data()), static_cast<std::streamsize>(out_data.size()));
+            return source_file.good();
+        }
+    } // namespace
+
     std::shared_ptr<TextureData> RenderResourceBase::loadTextureHDR(std::string file, int desired_channels)
     {
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
         ASSERT(asset_manager);
 
+        std::vector<uint8_t> source_data;
+        if (!readSourceFile(asset_manager->getFullPath(file), source_data))
+            return nullptr;
+
+        const uint64_t cache_key =
+            RenderImportCache::computeKey(source_data, "hdr_texture", k_hdr_texture_importer_version, desired_channels);
+        if (std::shared_ptr<TextureData> cached_texture = m_import_cache.loadTexture(cache_key))
+            return cached_texture;
+
         std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
 
         int iw, ih, n;
-        texture->m_pixels =
-            stbi_loadf(asset_manager->getFullPath(file).generic_string().c_str(), &iw, &ih, &n, desired_channels);
+        texture->m_pixels = stbi_loadf_from_memory(
+            source_data.data(), static_cast<int>(source_data.size()), &iw, &ih, &n, desired_channels);
 
         if (!texture->m_pixels)
             return nullptr;
@@ -54,6 +88,9 @@ namespace Piccolo
         texture->m_mip_levels   = 1;
         texture->m_type         = PICCOLO_IMAGE_TYPE::PICCOLO_IMAGE_TYPE_2D;
 
+        m_import_cache.saveTexture(
+            cache_key, *texture, static_cast<size_t>(iw) * ih * desired_channels * sizeof(float));
+
         return texture;
     }
 
@@ -62,10 +99,24 @@ namespace Piccolo
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
         ASSERT(asset_manager);
 
+        std::vector<uint8_t> source_data;
+        if (!readSourceFile(asset_manager->getFullPath(file), source_data))
+            return nullptr;
+
+        // the color space only changes the format, the pixels are the same
+        const uint64_t cache_key = RenderImportCache::computeKey(source_data, "texture", k_texture_importer_version);
+        if (std::shared_ptr<TextureData> cached_texture = m_import_cache.loadTexture(cache_key))
+        {
+            cached_texture->m_format =
+                (is_srgb) ? RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB : RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
+            return cached_texture;
+        }
+
         std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
 
         int iw, ih, n;
-        texture->m_pixels = stbi_load(asset_manager->getFullPath(file).generic_string().c_str(), &iw, &ih, &n, 4);
+        texture->m_pixels =
+            stbi_load_from_memory(source_data.data(), static_cast<int>(source_data.size()), &iw, &ih, &n, 4);
 
         if (!texture->m_pixels)
             return nullptr;
@@ -79,6 +130,8 @@ namespace Piccolo
         texture->m_mip_levels   = 1;
         texture->m_type         = PICCOLO_IMAGE_TYPE::PICCOLO_IMAGE_TYPE_2D;
 
+        m_import_cache.saveTexture(cache_key, *texture, static_cast<size_t>(iw) * ih * 4);
+
         return texture;
     }
 
@@ -121,13 +174,11 @@ namespace Piccolo
             }
 
             // index buffer
-            size_t index_size                     = bind_data->index_buffer.size() * sizeof(uint16_t);
-            ret.m_static_mesh_data.m_index_buffer = std::make_shared<BufferData>(index_size);
-            uint16_t* index                       = (uint16_t*)ret.m_static_mesh_data.m_index_buffer->m_data;
-            for (size_t i = 0; i < bind_data->index_buffer.size(); i++)
-            {
-                index[i] = static_cast<uint16_t>(bind_data->index_buffer[i]);
-            }
+            std::vector<uint32_t> indices(bind_data->index_buffer.begin(), bind_data->index_buffer.end());
+            ret.m_static_mesh_data.m_index_buffer =
+                createIndexBufferData(indices,
+                                      static_cast<uint32_t>(bind_data->vertex_buffer.size()),
+                                      ret.m_static_mesh_data.m_index_type);
 
             // skeleton binding buffer
             size_t data_size              = bind_data->bind.size() * sizeof(MeshVertexBindingDataDefinition);
@@ -177,10 +228,25 @@ namespace Piccolo
     {
         StaticMeshData mesh_data;
 
+        std::vector<uint8_t> source_data;
+        if (!readSourceFile(filename, source_data))
+        {
+            LOG_ERROR("loadMesh {} failed, error: can not read the file", filename);
+            assert(0);
+        }
+
+        const uint64_t cache_key =
+            RenderImportCache::computeKey(source_data, "static_mesh", k_static_mesh_importer_version);
+        if (m_import_cache.loadStaticMesh(cache_key, mesh_data, bounding_box))
+        {
+            return mesh_data;
+        }
+
+        // materials are not used, so no material file is parsed
         tinyobj::ObjReader       reader;
         tinyobj::ObjReaderConfig reader_config;
         reader_config.vertex_color = false;
-        if (!reader.ParseFromFile(filename, reader_config))
+        if (!reader.ParseFromString(std::string(source_data.begin(), source_data.end()), std::string(), reader_config))
         {
             if (!reader.Error().empty())
             {
@@ -219,7 +285,6 @@ namespace Piccolo
                     continue;
                 }
 
-                // expanding vertex data is not efficient and is for testing purposes only
                 for (size_t v = 0; v < fv; v++)
                 {
                     auto idx = shapes[s].mesh.indices[index_offset + v];
@@ -323,20 +388,39 @@ namespace Piccolo
             }
         }
 
-        uint32_t stride           = sizeof(MeshVertexDataDefinition);
-        mesh_data.m_vertex_buffer = std::make_shared<BufferData>(mesh_vertices.size() * stride);
-        mesh_data.m_index_buffer  = std::make_shared<BufferData>(mesh_vertices.size() * sizeof(uint16_t));
-
-        assert(mesh_vertices.size() <= std::numeric_limits<uint16_t>::max()); // take care of the index range, should be
-                                                                              // consistent with the index range used by
-                                                                              // vulkan
+        // faces are expanded above so that tangents can be computed per face, merge them back into an indexed mesh
+        std::vector<MeshVertexDataDefinition> unique_vertices;
+        std::vector<uint32_t>                 indices;
+        deduplicateVertices(mesh_vertices, unique_vertices, indices);
 
-        uint16_t* indices = (uint16_t*)mesh_data.m_index_buffer->m_data;
-        for (size_t i = 0; i < mesh_vertices.size(); i++)
+        // faces that collapsed into a line or a point once their vertices were merged
+        size_t kept_index_count = 0;
+        for (size_t index = 0; index < indices.size(); index += 3)
         {
-            ((MeshVertexDataDefinition*)(mesh_data.m_vertex_buffer->m_data))[i] = mesh_vertices[i];
-            indices[i]                                                          = static_cast<uint16_t>(i);
+            const uint32_t i0 = indices[index + 0];
+            const uint32_t i1 = indices[index + 1];
+            const uint32_t i2 = indices[index + 2];
+            if (i0 != i1 && i1 != i2 && i0 != i2)
+            {
+                indices[kept_index_count++] = i0;
+                indices[kept_index_count++] = i1;
+                indices[kept_index_count++] = i2;
+            }
         }
+        indices.resize(kept_index_count);
+
+        optimizeVertexCache(indices, static_cast<uint32_t>(unique_vertices.size()));
+        optimizeOverdraw(indices, unique_vertices);
+        optimizeVertexFetch(unique_vertices, indices);
+
+        const size_t vertex_buffer_size = unique_vertices.size() * sizeof(MeshVertexDataDefinition);
+        mesh_data.m_vertex_buffer       = std::make_shared<BufferData>(vertex_buffer_size);
+        memcpy(mesh_data.m_vertex_buffer->m_data, unique_vertices.data(), vertex_buffer_size);
+
+        mesh_data.m_index_buffer =
+            createIndexBufferData(indices, static_cast<uint32_t>(unique_vertices.size()), mesh_data.m_index_type);
+
+        m_import_cache.saveStaticMesh(cache_key, mesh_data, bounding_box);
 
         return mesh_data;
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "runtime/function/render/render_import_cache.h"
 #include "runtime/function/render/render_scene.h"
 #include "runtime/function/render/render_swap_context.h"
 #include "runtime/function/render/render_type.h"
@@ -39,7 +40,9 @@ namespace Piccolo
         virtual void updatePerFrameBuffer(std::shared_ptr<RenderScene>  render_scene,
                                           std::shared_ptr<RenderCamera> camera) = 0;
 
-        // TODO: data caching
+        /// the importers below look up their results here first, disabled until it is initialized
+        RenderImportCache& getImportCache() { return m_import_cache; }
+
         std::shared_ptr<TextureData> loadTextureHDR(std::string file, int desired_channels = 4);
         std::shared_ptr<TextureData> loadTexture(std::string file, bool is_srgb = false);
         RenderMeshData               loadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box);
@@ -50,5 +53,7 @@ namespace Piccolo
         StaticMeshData loadStaticMesh(std::string mesh_file, AxisAlignedBox& bounding_box);
 
         std::unordered_map<MeshSourceDesc, AxisAlignedBox> m_bounding_box_cache_map;
+
+        RenderImportCache m_import_cache;
     };
 } // namespace Piccolo
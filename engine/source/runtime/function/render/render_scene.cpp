@@ -1,10 +1,46 @@
 #include "runtime/function/render/render_scene.h"
+
+#include "runtime/core/job/job_system.h"
+#include "runtime/core/profile/profiler.h"
+
+#include "runtime/function/global/global_context.h"
+
 #include "runtime/function/render/render_helper.h"
 #include "runtime/function/render/render_pass.h"
 #include "runtime/function/render/render_resource.h"
 
+#include <algorithm>
+
 namespace Piccolo
 {
+    namespace
+    {
+        void fillMeshNode(RenderResource& render_resource, const RenderEntity& entity, RenderMeshNode& out_node)
+        {
+            out_node = RenderMeshNode();
+
+            out_node.model_matrix = &entity.m_model_matrix;
+
+            assert(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
+            if (!entity.m_joint_matrices.empty())
+            {
+                out_node.joint_count    = static_cast<uint32_t>(entity.m_joint_matrices.size());
+                out_node.joint_matrices = entity.m_joint_matrices.data();
+            }
+            out_node.node_id = entity.m_instance_id;
+
+            VulkanMesh& mesh_asset          = render_resource.getEntityMesh(entity);
+            out_node.ref_mesh               = &mesh_asset;
+            out_node.enable_vertex_blending = entity.m_enable_vertex_blending;
+
+            VulkanPBRMaterial& material_asset = render_resource.getEntityMaterial(entity);
+            out_node.ref_material             = &material_asset;
+
+            out_node.mesh_asset_id     = static_cast<uint32_t>(entity.m_mesh_asset_id);
+            out_node.material_asset_id = static_cast<uint32_t>(entity.m_material_asset_id);
+        }
+    } // namespace
+
     void RenderScene::clear()
     {
     }
@@ -12,9 +48,31 @@ namespace Piccolo
     void RenderScene::updateVisibleObjects(std::shared_ptr<RenderResource> render_resource,
                                            std::shared_ptr<RenderCamera>   camera)
     {
-        updateVisibleObjectsDirectionalLight(render_resource, camera);
-        updateVisibleObjectsPointLight(render_resource);
-        updateVisibleObjectsMainCamera(render_resource, camera);
+        PICCOLO_PROFILE_ZONE("RenderScene::updateVisibleObjects");
+
+        {
+            PICCOLO_PROFILE_ZONE("RenderEntityBVH::update");
+            m_render_entity_bvh.update(m_render_entities);
+        }
+
+        // the passes only read the scene and each writes its own lists
+        g_runtime_global_context.m_job_system->parallelFor(3, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t pass_index = begin; pass_index < end; ++pass_index)
+            {
+                switch (pass_index)
+                {
+                    case 0:
+                        updateVisibleObjectsDirectionalLight(render_resource, camera);
+                        break;
+                    case 1:
+                        updateVisibleObjectsPointLight(render_resource);
+                        break;
+                    default:
+                        updateVisibleObjectsMainCamera(render_resource, camera);
+                        break;
+                }
+            }
+        });
         updateVisibleObjectsAxis(render_resource);
         updateVisibleObjectsParticle(render_resource);
     }
@@ -25,6 +83,9 @@ namespace Piccolo
         RenderPass::m_visiable_nodes.p_point_lights_visible_mesh_nodes      = &m_point_lights_visible_mesh_nodes;
         RenderPass::m_visiable_nodes.p_main_camera_visible_mesh_nodes       = &m_main_camera_visible_mesh_nodes;
         RenderPass::m_visiable_nodes.p_axis_node                            = &m_axis_node;
+        RenderPass::m_visiable_nodes.p_directional_light_draw_list          = &m_directional_light_draw_list;
+        RenderPass::m_visiable_nodes.p_point_lights_draw_list               = &m_point_lights_draw_list;
+        RenderPass::m_visiable_nodes.p_main_camera_draw_list                = &m_main_camera_draw_list;
     }
 
     GuidAllocator<GameObjectPartId>& RenderScene::getInstanceIdAllocator() { return m_instance_id_allocator; }
@@ -36,57 +97,130 @@ namespace Piccolo
         return m_material_asset_id_allocator;
     }
 
+    void RenderScene::addRenderEntity(const RenderEntity& entity)
+    {
+        getInstanceSlot(entity.m_instance_id).m_entity_index = static_cast<uint32_t>(m_render_entities.size());
+
+        m_render_entities.push_back(entity);
+        m_render_entity_bvh.markStructureDirty();
+    }
+
+    void RenderScene::updateRenderEntity(const RenderEntity& entity)
+    {
+        if (RenderEntity* scene_entity = findRenderEntity(entity.m_instance_id))
+        {
+            *scene_entity = entity;
+            m_render_entity_bvh.markEntityDirty(getInstanceSlot(entity.m_instance_id).m_entity_index);
+        }
+    }
+
+    void RenderScene::updateRenderEntityTransform(const GameObjectPartId& part_id,
+                                                  const Matrix4x4&        model_matrix,
+                                                  const Matrix4x4*        joint_matrices,
+                                                  uint32_t                joint_count)
+    {
+        size_t instance_id;
+        if (!m_instance_id_allocator.getElementGuid(part_id, instance_id))
+        {
+            return;
+        }
+
+        RenderEntity* entity = findRenderEntity(static_cast<uint32_t>(instance_id));
+        if (entity == nullptr)
+        {
+            return;
+        }
+
+        entity->m_model_matrix = model_matrix;
+        // same size every frame, the joints are copied into the storage the entity already has
+        entity->m_joint_matrices.assign(joint_matrices, joint_matrices + joint_count);
+        m_render_entity_bvh.markEntityDirty(getInstanceSlot(entity->m_instance_id).m_entity_index);
+    }
+
+    RenderScene::RenderInstanceSlot& RenderScene::getInstanceSlot(uint32_t instance_id)
+    {
+        const size_t slot_index = GuidAllocator<GameObjectPartId>::getGuidIndex(instance_id);
+        if (slot_index >= m_instance_slots.size())
+        {
+            m_instance_slots.resize(slot_index + 1);
+        }
+        return m_instance_slots[slot_index];
+    }
+
+    RenderEntity* RenderScene::findRenderEntity(uint32_t instance_id)
+    {
+        if (!m_instance_id_allocator.isAllocated(instance_id))
+        {
+            return nullptr;
+        }
+
+        const uint32_t entity_index = getInstanceSlot(instance_id).m_entity_index;
+        return entity_index != k_invalid_entity_index ? &m_render_entities[entity_index] : nullptr;
+    }
+
+    void RenderScene::removeRenderEntity(size_t entity_index)
+    {
+        // the last entity takes the place of the removed one
+        getInstanceSlot(m_render_entities[entity_index].m_instance_id).m_entity_index = k_invalid_entity_index;
+        if (entity_index + 1 < m_render_entities.size())
+        {
+            m_render_entities[entity_index] = std::move(m_render_entities.back());
+            getInstanceSlot(m_render_entities[entity_index].m_instance_id).m_entity_index =
+                static_cast<uint32_t>(entity_index);
+        }
+        m_render_entities.pop_back();
+        m_render_entity_bvh.markStructureDirty();
+    }
+
+    BoundingBox RenderScene::getRenderEntitiesBounds() const { return m_render_entity_bvh.getBounds(); }
+
     void RenderScene::addInstanceIdToMap(uint32_t instance_id, GObjectID go_id)
     {
-        m_mesh_object_id_map[instance_id] = go_id;
+        getInstanceSlot(instance_id).m_object_id = go_id;
     }
 
     GObjectID RenderScene::getGObjectIDByMeshID(uint32_t mesh_id) const
     {
-        auto find_it = m_mesh_object_id_map.find(mesh_id);
-        if (find_it != m_mesh_object_id_map.end())
+        const size_t slot_index = GuidAllocator<GameObjectPartId>::getGuidIndex(mesh_id);
+        if (m_instance_id_allocator.isAllocated(mesh_id) && slot_index < m_instance_slots.size() &&
+            m_instance_slots[slot_index].m_object_id != k_invalid_gobject_id)
         {
-            return find_it->second;
+            return m_instance_slots[slot_index].m_object_id;
         }
         return GObjectID();
     }
 
     void RenderScene::deleteEntityByGObjectID(GObjectID go_id)
     {
-        for (auto it = m_mesh_object_id_map.begin(); it != m_mesh_object_id_map.end(); it++)
+        // the parts of an object are numbered from zero
+        size_t instance_id;
+        for (size_t part_index = 0; m_instance_id_allocator.getElementGuid({go_id, part_index}, instance_id);
+             ++part_index)
         {
-            if (it->second == go_id)
+            RenderInstanceSlot& instance_slot = getInstanceSlot(static_cast<uint32_t>(instance_id));
+            if (instance_slot.m_entity_index != k_invalid_entity_index)
             {
-                m_mesh_object_id_map.erase(it);
-                break;
+                removeRenderEntity(instance_slot.m_entity_index);
             }
-        }
+            instance_slot.m_object_id = k_invalid_gobject_id;
 
-        GameObjectPartId part_id = {go_id, 0};
-        size_t           find_guid;
-        if (m_instance_id_allocator.getElementGuid(part_id, find_guid))
-        {
-            for (auto it = m_render_entities.begin(); it != m_render_entities.end(); it++)
-            {
-                if (it->m_instance_id == find_guid)
-                {
-                    m_render_entities.erase(it);
-                    break;
-                }
-            }
+            m_instance_id_allocator.freeGuid(instance_id);
         }
     }
 
     void RenderScene::clearForLevelReloading()
     {
         m_instance_id_allocator.clear();
-        m_mesh_object_id_map.clear();
+        m_instance_slots.clear();
         m_render_entities.clear();
+        m_render_entity_bvh.markStructureDirty();
     }
 
     void RenderScene::updateVisibleObjectsDirectionalLight(std::shared_ptr<RenderResource> render_resource,
                                                            std::shared_ptr<RenderCamera>   camera)
     {
+        PICCOLO_PROFILE_ZONE("RenderScene::updateVisibleObjectsDirectionalLight");
+
         Matrix4x4 directional_light_proj_view = CalculateDirectionalLightCamera(*this, *camera);
 
         render_resource->m_mesh_perframe_storage_buffer_object.directional_light_proj_view =
@@ -94,44 +228,29 @@ namespace Piccolo
         render_resource->m_mesh_directional_light_shadow_perframe_storage_buffer_object.light_proj_view =
             directional_light_proj_view;
 
-        m_directional_light_visible_mesh_nodes.clear();
-
         ClusterFrustum frustum =
             CreateClusterFrustumFromMatrix(directional_light_proj_view, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
 
-        for (const RenderEntity& entity : m_render_entities)
-        {
-            BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
-                                                 entity.m_bounding_box.getMaxCorner()};
-
-            if (TiledFrustumIntersectBox(frustum, BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix)))
-            {
-                m_directional_light_visible_mesh_nodes.emplace_back();
-                RenderMeshNode& temp_node = m_directional_light_visible_mesh_nodes.back();
-
-                temp_node.model_matrix = &entity.m_model_matrix;
-
-                assert(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
-                if (!entity.m_joint_matrices.empty())
-                {
-                    temp_node.joint_count    = static_cast<uint32_t>(entity.m_joint_matrices.size());
-                    temp_node.joint_matrices = entity.m_joint_matrices.data();
-                }
-                temp_node.node_id = entity.m_instance_id;
+        m_directional_light_visible_entities.clear();
+        m_render_entity_bvh.cullFrustum(frustum, m_directional_light_visible_entities);
 
-                VulkanMesh& mesh_asset           = render_resource->getEntityMesh(entity);
-                temp_node.ref_mesh               = &mesh_asset;
-                temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
-
-                VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
-                temp_node.ref_material            = &material_asset;
-            }
+        m_directional_light_visible_mesh_nodes.resize(m_directional_light_visible_entities.size());
+        for (size_t node_index = 0; node_index < m_directional_light_visible_entities.size(); ++node_index)
+        {
+            const RenderEntity& entity = m_render_entities[m_directional_light_visible_entities[node_index]];
+            fillMeshNode(*render_resource, entity, m_directional_light_visible_mesh_nodes[node_index]);
         }
+
+        // front to back along the light
+        m_directional_light_draw_list.build(RenderDrawPass::DirectionalLightShadow,
+                                            m_directional_light_visible_mesh_nodes,
+                                            Vector3::ZERO,
+                                            m_directional_light.m_direction);
     }
 
     void RenderScene::updateVisibleObjectsPointLight(std::shared_ptr<RenderResource> render_resource)
     {
-        m_point_lights_visible_mesh_nodes.clear();
+        PICCOLO_PROFILE_ZONE("RenderScene::updateVisibleObjectsPointLight");
 
         std::vector<BoundingSphere> point_lights_bounding_spheres;
         uint32_t                    point_light_num = static_cast<uint32_t>(m_point_light_list.m_lights.size());
@@ -142,51 +261,28 @@ namespace Piccolo
             point_lights_bounding_spheres[i].m_radius = m_point_light_list.m_lights[i].calculateRadius();
         }
 
-        for (const RenderEntity& entity : m_render_entities)
-        {
-            BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
-                                                 entity.m_bounding_box.getMaxCorner()};
+        m_point_lights_visible_entities.clear();
+        m_render_entity_bvh.cullSpheres(point_lights_bounding_spheres, m_point_lights_visible_entities);
 
-            bool intersect_with_point_lights = true;
-            for (size_t i = 0; i < point_light_num; i++)
-            {
-                if (!BoxIntersectsWithSphere(BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix),
-                                             point_lights_bounding_spheres[i]))
-                {
-                    intersect_with_point_lights = false;
-                    break;
-                }
-            }
-
-            if (intersect_with_point_lights)
-            {
-                m_point_lights_visible_mesh_nodes.emplace_back();
-                RenderMeshNode& temp_node = m_point_lights_visible_mesh_nodes.back();
-
-                temp_node.model_matrix = &entity.m_model_matrix;
-
-                assert(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
-                if (!entity.m_joint_matrices.empty())
-                {
-                    temp_node.joint_count    = static_cast<uint32_t>(entity.m_joint_matrices.size());
-                    temp_node.joint_matrices = entity.m_joint_matrices.data();
-                }
-                temp_node.node_id = entity.m_instance_id;
-
-                VulkanMesh& mesh_asset           = render_resource->getEntityMesh(entity);
-                temp_node.ref_mesh               = &mesh_asset;
-                temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
-
-                VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
-                temp_node.ref_material            = &material_asset;
-            }
+        m_point_lights_visible_mesh_nodes.resize(m_point_lights_visible_entities.size());
+        for (size_t node_index = 0; node_index < m_point_lights_visible_entities.size(); ++node_index)
+        {
+            const RenderEntity& entity = m_render_entities[m_point_lights_visible_entities[node_index]];
+            fillMeshNode(*render_resource, entity, m_point_lights_visible_mesh_nodes[node_index]);
         }
+
+        // the nodes are drawn once per light, there is no single view to order them along
+        m_point_lights_draw_list.build(
+            RenderDrawPass::PointLightShadow, m_point_lights_visible_mesh_nodes, Vector3::ZERO, Vector3::ZERO);
     }
 
     void RenderScene::updateVisibleObjectsMainCamera(std::shared_ptr<RenderResource> render_resource,
                                                      std::shared_ptr<RenderCamera>   camera)
     {
-        m_main_camera_visible_mesh_nodes.clear();
+        PICCOLO_PROFILE_ZONE("RenderScene::updateVisibleObjectsMainCamera");
+
+        m_main_camera_culled_skinned_object_ids.clear();
+        m_main_camera_visible_skinned_object_ids.clear();
 
         Matrix4x4 view_matrix      = camera->getViewMatrix();
         Matrix4x4 proj_matrix      = camera->getPersProjMatrix();
@@ -194,33 +290,41 @@ namespace Piccolo
 
         ClusterFrustum f = CreateClusterFrustumFromMatrix(proj_view_matrix, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
 
-        for (const RenderEntity& entity : m_render_entities)
+        m_main_camera_visible_entities.clear();
+        m_render_entity_bvh.cullFrustum(f, m_main_camera_visible_entities);
+
+        m_main_camera_visible_mesh_nodes.resize(m_main_camera_visible_entities.size());
+        for (size_t node_index = 0; node_index < m_main_camera_visible_entities.size(); ++node_index)
         {
-            BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
-                                                 entity.m_bounding_box.getMaxCorner()};
+            const RenderEntity& entity = m_render_entities[m_main_camera_visible_entities[node_index]];
+            fillMeshNode(*render_resource, entity, m_main_camera_visible_mesh_nodes[node_index]);
 
-            if (TiledFrustumIntersectBox(f, BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix)))
+            if (entity.m_enable_vertex_blending)
             {
-                m_main_camera_visible_mesh_nodes.emplace_back();
-                RenderMeshNode& temp_node = m_main_camera_visible_mesh_nodes.back();
-                temp_node.model_matrix    = &entity.m_model_matrix;
-
-                assert(entity.m_joint_matrices.size() <= s_mesh_vertex_blending_max_joint_count);
-                if (!entity.m_joint_matrices.empty())
-                {
-                    temp_node.joint_count    = static_cast<uint32_t>(entity.m_joint_matrices.size());
-                    temp_node.joint_matrices = entity.m_joint_matrices.data();
-                }
-                temp_node.node_id = entity.m_instance_id;
+                m_main_camera_visible_skinned_object_ids.push_back(getGObjectIDByMeshID(entity.m_instance_id));
+            }
+        }
 
-                VulkanMesh& mesh_asset           = render_resource->getEntityMesh(entity);
-                temp_node.ref_mesh               = &mesh_asset;
-                temp_node.enable_vertex_blending = entity.m_enable_vertex_blending;
+        m_main_camera_draw_list.build(
+            RenderDrawPass::MainCamera, m_main_camera_visible_mesh_nodes, camera->position(), camera->forward());
 
-                VulkanPBRMaterial& material_asset = render_resource->getEntityMaterial(entity);
-                temp_node.ref_material            = &material_asset;
+        // an object is culled when none of its parts is visible
+        std::vector<GObjectID>& visible_ids = m_main_camera_visible_skinned_object_ids;
+        std::vector<GObjectID>& culled_ids  = m_main_camera_culled_skinned_object_ids;
+        std::sort(visible_ids.begin(), visible_ids.end());
+        for (const RenderEntity& entity : m_render_entities)
+        {
+            if (entity.m_enable_vertex_blending)
+            {
+                culled_ids.push_back(getGObjectIDByMeshID(entity.m_instance_id));
             }
         }
+        std::sort(culled_ids.begin(), culled_ids.end());
+        culled_ids.erase(std::unique(culled_ids.begin(), culled_ids.end()), culled_ids.end());
+        auto is_visible = [&visible_ids](GObjectID object_id) {
+            return std::binary_search(visible_ids.begin(), visible_ids.end(), object_id);
+        };
+        culled_ids.erase(std::remove_if(culled_ids.begin(), culled_ids.end(), is_visible), culled_ids.end());
     }
 
     void RenderScene::updateVisibleObjectsAxis(std::shared_ptr<RenderResource> render_resource)
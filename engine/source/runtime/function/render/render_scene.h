@@ -4,7 +4,9 @@
 
 #include "runtime/function/render/light.h"
 #include "runtime/function/render/render_common.h"
+#include "runtime/function/render/render_draw_list.h"
 #include "runtime/function/render/render_entity.h"
+#include "runtime/function/render/render_entity_bvh.h"
 #include "runtime/function/render/render_guid_allocator.h"
 #include "runtime/function/render/render_object.h"
 
@@ -24,7 +26,7 @@ namespace Piccolo
         PDirectionalLight m_directional_light;
         PointLightList    m_point_light_list;
 
-        // render entities
+        // render entities, added, updated and removed through the scene so that their hierarchy stays up to date
         std::vector<RenderEntity> m_render_entities;
 
         // axis, for editor
@@ -36,10 +38,30 @@ namespace Piccolo
         std::vector<RenderMeshNode> m_main_camera_visible_mesh_nodes;
         RenderAxisNode              m_axis_node;
 
+        // visible mesh nodes sorted and batched for drawing (updated per frame)
+        RenderDrawList m_directional_light_draw_list;
+        RenderDrawList m_point_lights_draw_list;
+        RenderDrawList m_main_camera_draw_list;
+
+        // objects with skinned render entities of which none is visible to the main camera, sorted (updated per
+        // frame), the animation skips them
+        std::vector<GObjectID> m_main_camera_culled_skinned_object_ids;
+
         // clear
         void clear();
 
-        // update visible objects in each frame
+        void addRenderEntity(const RenderEntity& entity);
+        // replaces the entity with the same instance id
+        void updateRenderEntity(const RenderEntity& entity);
+        // moves the entity of the part, ignored when the part has no entity
+        void updateRenderEntityTransform(const GameObjectPartId& part_id,
+                                         const Matrix4x4&        model_matrix,
+                                         const Matrix4x4*        joint_matrices,
+                                         uint32_t                joint_count);
+        // union of the world bounds of all render entities
+        BoundingBox getRenderEntitiesBounds() const;
+
+        // update visible objects in each frame, the light and camera passes run in parallel
         void updateVisibleObjects(std::shared_ptr<RenderResource> render_resource,
                                   std::shared_ptr<RenderCamera>   camera);
 
@@ -52,16 +74,38 @@ namespace Piccolo
 
         void      addInstanceIdToMap(uint32_t instance_id, GObjectID go_id);
         GObjectID getGObjectIDByMeshID(uint32_t mesh_id) const;
+        // removes the render entities of all parts of the object and frees their instance ids
         void      deleteEntityByGObjectID(GObjectID go_id);
 
         void clearForLevelReloading();
 
     private:
+        static constexpr uint32_t k_invalid_entity_index = 0xffffffff;
+
+        // what the scene knows of an instance id, per slot of the instance id allocator
+        struct RenderInstanceSlot
+        {
+            uint32_t  m_entity_index {k_invalid_entity_index};
+            GObjectID m_object_id {k_invalid_gobject_id};
+        };
+
         GuidAllocator<GameObjectPartId>   m_instance_id_allocator;
         GuidAllocator<MeshSourceDesc>     m_mesh_asset_id_allocator;
         GuidAllocator<MaterialSourceDesc> m_material_asset_id_allocator;
 
-        std::unordered_map<uint32_t, GObjectID> m_mesh_object_id_map;
+        std::vector<RenderInstanceSlot> m_instance_slots;
+
+        std::vector<GObjectID> m_main_camera_visible_skinned_object_ids;
+
+        RenderEntityBVH m_render_entity_bvh;
+        // indices of the entities each pass found, kept to reuse their storage
+        std::vector<uint32_t> m_directional_light_visible_entities;
+        std::vector<uint32_t> m_point_lights_visible_entities;
+        std::vector<uint32_t> m_main_camera_visible_entities;
+
+        RenderInstanceSlot& getInstanceSlot(uint32_t instance_id);
+        RenderEntity*       findRenderEntity(uint32_t instance_id);
+        void          removeRenderEntity(size_t entity_index);
 
         void updateVisibleObjectsDirectionalLight(std::shared_ptr<RenderResource> render_resource,
                                                   std::shared_ptr<RenderCamera>   camera);
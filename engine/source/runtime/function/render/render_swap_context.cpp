@@ -1,5 +1,7 @@
 #include "runtime/function/render/render_swap_context.h"
 
+#include "runtime/core/base/macro.h"
+
 #include <utility>
 
 namespace Piccolo
@@ -30,6 +32,14 @@ namespace Piccolo
         return m_transform_descs[index];
     }
 
+    bool RenderEntityDeltaStream::isEmpty() const { return m_transform_deltas.empty(); }
+
+    void RenderEntityDeltaStream::clear()
+    {
+        m_transform_deltas.clear();
+        m_joint_matrices.clear();
+    }
+
     RenderSwapData& RenderSwapContext::getLogicSwapData() { return m_swap_data[m_logic_swap_data_index]; }
 
     RenderSwapData& RenderSwapContext::getRenderSwapData() { return m_swap_data[m_render_swap_data_index]; }
@@ -42,6 +52,67 @@ namespace Piccolo
         }
     }
 
+    void RenderSwapContext::publishLogicFrame(float delta_time)
+    {
+        std::unique_lock<std::mutex> lock(m_frame_mutex);
+        m_frame_condition.wait(lock,
+                               [this]() { return !m_is_pipelining || m_render_frame_index == m_logic_frame_index; });
+
+        // the render thread is between frames now, so both sides of the swap data can be touched.
+        // data the render side did not consume stays queued on the logic side, same as the single thread path
+        getLogicSwapData().m_frame_index = m_logic_frame_index + 1;
+        if (isReadyToSwap())
+        {
+            swap();
+        }
+
+        m_published_delta_time = delta_time;
+        ++m_logic_frame_index;
+        m_frame_condition.notify_all();
+    }
+
+    bool RenderSwapContext::waitForLogicFrame(float& out_delta_time, uint64_t& out_frame_index)
+    {
+        std::unique_lock<std::mutex> lock(m_frame_mutex);
+        m_frame_condition.wait(lock,
+                               [this]() { return !m_is_pipelining || m_logic_frame_index > m_render_frame_index; });
+        if (!m_is_pipelining)
+            return false;
+
+        // frames are consumed in order and the logic can only be one frame ahead
+        ASSERT(m_logic_frame_index == m_render_frame_index + 1);
+        out_delta_time  = m_published_delta_time;
+        out_frame_index = m_logic_frame_index;
+        return true;
+    }
+
+    void RenderSwapContext::notifyRenderDataConsumed()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_frame_mutex);
+            m_render_frame_index = m_logic_frame_index;
+        }
+        m_frame_condition.notify_all();
+    }
+
+    void RenderSwapContext::startPipelining()
+    {
+        std::lock_guard<std::mutex> lock(m_frame_mutex);
+        m_is_pipelining      = true;
+        m_render_frame_index = m_logic_frame_index;
+    }
+
+    void RenderSwapContext::stopPipelining()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_frame_mutex);
+            // the last frame is not dropped, its swap data may create or delete render entities
+            m_frame_condition.wait(lock, [this]() { return m_render_frame_index == m_logic_frame_index; });
+            m_is_pipelining = false;
+        }
+        m_frame_condition.notify_all();
+    }
+
     bool RenderSwapContext::isReadyToSwap() const
     {
         return !(m_swap_data[m_render_swap_data_index].m_level_resource_desc.has_value() ||
@@ -50,7 +121,9 @@ namespace Piccolo
                  m_swap_data[m_render_swap_data_index].m_camera_swap_data.has_value() ||
                  m_swap_data[m_render_swap_data_index].m_particle_submit_request.has_value() ||
                  m_swap_data[m_render_swap_data_index].m_emitter_tick_request.has_value() ||
-                 m_swap_data[m_render_swap_data_index].m_emitter_transform_request.has_value());
+                 m_swap_data[m_render_swap_data_index].m_emitter_transform_request.has_value() ||
+                 !m_swap_data[m_render_swap_data_index].m_render_entity_deltas.isEmpty() ||
+                 m_swap_data[m_render_swap_data_index].m_is_level_reloading);
     }
 
     void RenderSwapContext::resetLevelRsourceSwapData()
@@ -85,6 +158,16 @@ namespace Piccolo
         m_swap_data[m_render_swap_data_index].m_emitter_transform_request.reset();
     }
 
+    void RenderSwapContext::resetRenderEntityDeltas()
+    {
+        m_swap_data[m_render_swap_data_index].m_render_entity_deltas.clear();
+    }
+
+    void RenderSwapContext::resetLevelReloading()
+    {
+        m_swap_data[m_render_swap_data_index].m_is_level_reloading = false;
+    }
+
     void RenderSwapContext::swap()
     {
         resetLevelRsourceSwapData();
@@ -94,11 +177,14 @@ namespace Piccolo
         resetEmitterTickSwapData();
         resetEmitterTransformSwapData();
         resetPartilceBatchSwapData();
+        resetRenderEntityDeltas();
+        resetLevelReloading();
         std::swap(m_logic_swap_data_index, m_render_swap_data_index);
     }
 
     void RenderSwapData::addDirtyGameObject(GameObjectDesc&& desc)
     {
+        std::lock_guard<std::mutex> lock(m_game_object_mutex);
         if (m_game_object_resource_desc.has_value())
         {
             m_game_object_resource_desc->add(desc);
@@ -113,6 +199,7 @@ namespace Piccolo
 
     void RenderSwapData::addDeleteGameObject(GameObjectDesc&& desc)
     {
+        std::lock_guard<std::mutex> lock(m_game_object_mutex);
         if (m_game_object_to_delete.has_value())
         {
             m_game_object_to_delete->add(desc);
@@ -125,6 +212,35 @@ namespace Piccolo
         }
     }
 
+    void RenderSwapData::addRenderEntityTransforms(GObjectID                     go_id,
+                                                   const std::vector<Matrix4x4>& part_model_matrices,
+                                                   const std::vector<Matrix4x4>& joint_matrices)
+    {
+        std::lock_guard<std::mutex> lock(m_game_object_mutex);
+
+        const uint32_t first_joint = static_cast<uint32_t>(m_render_entity_deltas.m_joint_matrices.size());
+        m_render_entity_deltas.m_joint_matrices.insert(
+            m_render_entity_deltas.m_joint_matrices.end(), joint_matrices.begin(), joint_matrices.end());
+
+        for (size_t part_index = 0; part_index < part_model_matrices.size(); ++part_index)
+        {
+            RenderEntityTransformDelta& delta = m_render_entity_deltas.m_transform_deltas.emplace_back();
+            delta.m_part_id                   = {go_id, part_index};
+            delta.m_model_matrix              = part_model_matrices[part_index];
+            delta.m_first_joint               = first_joint;
+            delta.m_joint_count               = static_cast<uint32_t>(joint_matrices.size());
+        }
+    }
+
+    void RenderSwapData::clearForLevelReloading()
+    {
+        std::lock_guard<std::mutex> lock(m_game_object_mutex);
+        m_game_object_resource_desc.reset();
+        m_game_object_to_delete.reset();
+        m_render_entity_deltas.clear();
+        m_is_level_reloading = true;
+    }
+
     void RenderSwapData::addNewParticleEmitter(ParticleEmitterDesc& desc)
     {
         if (m_particle_submit_request.has_value())
@@ -8,8 +8,10 @@
 #include "runtime/resource/res_type/global/global_particle.h"
 #include "runtime/resource/res_type/global/global_rendering.h"
 
+#include <condition_variable>
 #include <cstdint>
 #include <deque>
+#include <mutex>
 #include <optional>
 #include <string>
 
@@ -81,6 +83,27 @@ namespace Piccolo
         const ParticleEmitterTransformDesc& getNextEmitterTransformDesc(unsigned int index);
     };
 
+    /// new transform of a render entity that is already in the scene, its joints are a range of the joint
+    /// matrices of the stream
+    struct RenderEntityTransformDelta
+    {
+        GameObjectPartId m_part_id;
+        Matrix4x4        m_model_matrix {Matrix4x4::IDENTITY};
+        uint32_t         m_first_joint {0};
+        uint32_t         m_joint_count {0};
+    };
+
+    /// transforms and joints of the render entities that moved, so that moving objects send neither their mesh
+    /// and material descs nor a copy of their joints per part. Cleared instead of reset, the storage is reused
+    struct RenderEntityDeltaStream
+    {
+        std::vector<RenderEntityTransformDelta> m_transform_deltas;
+        std::vector<Matrix4x4>                  m_joint_matrices;
+
+        bool isEmpty() const;
+        void clear();
+    };
+
     struct RenderSwapData
     {
         std::optional<LevelResourceDesc>       m_level_resource_desc;
@@ -90,9 +113,26 @@ namespace Piccolo
         std::optional<ParticleSubmitRequest>   m_particle_submit_request;
         std::optional<EmitterTickRequest>      m_emitter_tick_request;
         std::optional<EmitterTransformRequest> m_emitter_transform_request;
+        RenderEntityDeltaStream                m_render_entity_deltas;
+        // the render scene is cleared before the objects of this data are processed
+        bool m_is_level_reloading {false};
+        // pipelined mode, the logic frame the data was published with
+        uint64_t m_frame_index {0};
+
+        // game objects are added from parallel component ticks
+        std::mutex m_game_object_mutex;
 
         void addDirtyGameObject(GameObjectDesc&& desc);
         void addDeleteGameObject(GameObjectDesc&& desc);
+        /// the render entities of the parts of the object moved, part i gets part_model_matrices[i]. All parts
+        /// share the joint matrices, which may be empty
+        void addRenderEntityTransforms(GObjectID                     go_id,
+                                       const std::vector<Matrix4x4>& part_model_matrices,
+                                       const std::vector<Matrix4x4>& joint_matrices);
+
+        /// the active level was replaced: drops the object data of the old level and has the render side clear its
+        /// scene, so that the logic thread never touches the render scene
+        void clearForLevelReloading();
 
         void addNewParticleEmitter(ParticleEmitterDesc& desc);
         void addTickParticleEmitter(ParticleEmitterID id);
@@ -119,12 +159,35 @@ namespace Piccolo
         void            resetPartilceBatchSwapData();
         void            resetEmitterTickSwapData();
         void            resetEmitterTransformSwapData();
+        void            resetRenderEntityDeltas();
+        void            resetLevelReloading();
+
+        // pipelined mode, the render thread consumes frame N while the logic thread simulates frame N+1
+
+        /// logic thread: hand the logic data of the finished frame to the render thread, blocks until the render
+        /// thread has consumed the previous frame so that the logic is never more than one frame ahead
+        void publishLogicFrame(float delta_time);
+        /// render thread: wait for the next published frame, returns false once pipelining is stopped. Frames are
+        /// numbered from one on and the render swap data carries the index of the frame it was published with
+        bool waitForLogicFrame(float& out_delta_time, uint64_t& out_frame_index);
+        /// render thread: called after the render swap data is processed, the logic thread may swap again
+        void notifyRenderDataConsumed();
+        void startPipelining();
+        /// waits until the render thread has consumed the last published frame
+        void stopPipelining();
 
     private:
         uint8_t        m_logic_swap_data_index {LogicSwapDataType};
         uint8_t        m_render_swap_data_index {RenderSwapDataType};
         RenderSwapData m_swap_data[SwapDataTypeCount];
 
+        std::mutex              m_frame_mutex;
+        std::condition_variable m_frame_condition;
+        uint64_t                m_logic_frame_index {0};
+        uint64_t                m_render_frame_index {0};
+        float                   m_published_delta_time {0.f};
+        bool                    m_is_pipelining {false};
+
         bool isReadyToSwap() const;
         void swap();
     };
@@ -1,10 +1,12 @@
 #include "runtime/function/render/render_system.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/profile/profiler.h"
 
 #include "runtime/resource/asset_manager/asset_manager.h"
 #include "runtime/resource/config_manager/config_manager.h"
 
+#include "runtime/function/animation/animation_lod.h"
 #include "runtime/function/render/render_camera.h"
 #include "runtime/function/render/render_pass.h"
 #include "runtime/function/render/render_pipeline.h"
@@ -18,6 +20,7 @@
 #include "runtime/function/render/passes/main_camera_pass.h"
 #include "runtime/function/render/passes/particle_pass.h"
 
+#include "runtime/function/render/interface/null/null_rhi.h"
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 
 namespace Piccolo
@@ -38,7 +41,15 @@ namespace Piccolo
         RHIInitInfo rhi_init_info;
         rhi_init_info.window_system = init_info.window_system;
 
-        m_rhi = std::make_shared<VulkanRHI>();
+        m_is_headless = init_info.is_headless;
+        if (m_is_headless)
+        {
+            m_rhi = std::make_shared<NullRHI>();
+        }
+        else
+        {
+            m_rhi = std::make_shared<VulkanRHI>();
+        }
         m_rhi->initialize(rhi_init_info);
 
         // global rendering resource
@@ -55,7 +66,11 @@ namespace Piccolo
             global_rendering_res.m_color_grading_map;
 
         m_render_resource = std::make_shared<RenderResource>();
-        m_render_resource->uploadGlobalRenderResource(m_rhi, level_resource_desc);
+        m_render_resource->getImportCache().initialize(config_manager->getImportCacheFolder());
+        if (!m_is_headless)
+        {
+            m_render_resource->uploadGlobalRenderResource(m_rhi, level_resource_desc);
+        }
 
         // setup render camera
         const CameraPose& camera_pose = global_rendering_res.m_camera_config.m_pose;
@@ -74,6 +89,12 @@ namespace Piccolo
         m_render_scene->m_directional_light.m_color = global_rendering_res.m_directional_light.m_color.toVector3();
         m_render_scene->setVisibleNodesReference();
 
+        AnimationLodManager::setConfig(global_rendering_res.m_animation_lod_config);
+
+        // the render pipeline records gpu commands only
+        if (m_is_headless)
+            return;
+
         // initialize render pipeline
         RenderPipelineInitInfo pipeline_init_info;
         pipeline_init_info.enable_fxaa     = global_rendering_res.m_enable_fxaa;
@@ -96,8 +117,23 @@ namespace Piccolo
 
     void RenderSystem::tick(float delta_time)
     {
+        PICCOLO_PROFILE_ZONE("RenderSystem::tick");
+
         // process swap data between logic and render contexts
         processSwapData();
+        m_swap_context.notifyRenderDataConsumed();
+
+        if (m_is_headless)
+        {
+            // without a gpu the frame ends after the cpu side work, visibility is still computed
+            m_render_scene->updateVisibleObjects(std::static_pointer_cast<RenderResource>(m_render_resource),
+                                                 m_render_camera);
+            publishMainCameraView();
+            return;
+        }
+
+        // start the copies of the resources the swap data created while the cpu prepares the frame
+        m_rhi->flushUploads();
 
         // prepare render command context
         m_rhi->prepareContext();
@@ -108,6 +144,7 @@ namespace Piccolo
         // update per-frame visible objects
         m_render_scene->updateVisibleObjects(std::static_pointer_cast<RenderResource>(m_render_resource),
                                              m_render_camera);
+        publishMainCameraView();
 
         // prepare pipeline's render passes data
         m_render_pipeline->preparePassData(m_render_resource);
@@ -156,6 +193,14 @@ namespace Piccolo
         m_render_pipeline.reset();
     }
 
+    void RenderSystem::publishMainCameraView()
+    {
+        // the published ids are swapped out, the scene refills the vector it gets back next frame
+        AnimationLodManager::publishMainCameraView(m_render_camera->position(),
+                                                   m_render_camera->getFOV().y,
+                                                   std::move(m_render_scene->m_main_camera_culled_skinned_object_ids));
+    }
+
     void RenderSystem::swapLogicRenderData() { m_swap_context.swapLogicRenderData(); }
 
     RenderSwapContext& RenderSystem::getSwapContext() { return m_swap_context; }
@@ -232,11 +277,6 @@ namespace Piccolo
         return m_render_scene->getMeshAssetIdAllocator();
     }
 
-    void RenderSystem::clearForLevelReloading()
-    {
-        m_render_scene->clearForLevelReloading();
-    }
-
     void RenderSystem::setRenderPipelineType(RENDER_PIPELINE_TYPE pipeline_type)
     {
         m_render_pipeline_type = pipeline_type;
@@ -254,10 +294,20 @@ namespace Piccolo
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
         ASSERT(asset_manager);
 
+        // the objects of this data already belong to the new level
+        if (swap_data.m_is_level_reloading)
+        {
+            m_render_scene->clearForLevelReloading();
+            m_swap_context.resetLevelReloading();
+        }
+
         // TODO: update global resources if needed
         if (swap_data.m_level_resource_desc.has_value())
         {
-            m_render_resource->uploadGlobalRenderResource(m_rhi, *swap_data.m_level_resource_desc);
+            if (!m_is_headless)
+            {
+                m_render_resource->uploadGlobalRenderResource(m_rhi, *swap_data.m_level_resource_desc);
+            }
 
             // reset level resource swap data to a clean state
             m_swap_context.resetLevelRsourceSwapData();
@@ -331,8 +381,9 @@ namespace Piccolo
                     }
                     bool is_material_loaded = m_render_scene->getMaterialAssetdAllocator().hasElement(material_source);
 
+                    // textures are only decoded for the gpu upload
                     RenderMaterialData material_data;
-                    if (!is_material_loaded)
+                    if (!is_material_loaded && !m_is_headless)
                     {
                         material_data = m_render_resource->loadMaterialData(material_source);
                     }
@@ -341,31 +392,32 @@ namespace Piccolo
                         m_render_scene->getMaterialAssetdAllocator().allocGuid(material_source);
 
                     // create game object on the graphics api side
-                    if (!is_mesh_loaded)
+                    if (m_is_headless)
                     {
-                        m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, mesh_data);
+                        std::static_pointer_cast<RenderResource>(m_render_resource)
+                            ->createHeadlessGameObjectRenderResource(render_entity);
                     }
-
-                    if (!is_material_loaded)
+                    else
                     {
-                        m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, material_data);
+                        if (!is_mesh_loaded)
+                        {
+                            m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, mesh_data);
+                        }
+
+                        if (!is_material_loaded)
+                        {
+                            m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, material_data);
+                        }
                     }
 
                     // add object to render scene if needed
                     if (!is_entity_in_scene)
                     {
-                        m_render_scene->m_render_entities.push_back(render_entity);
+                        m_render_scene->addRenderEntity(render_entity);
                     }
                     else
                     {
-                        for (auto& entity : m_render_scene->m_render_entities)
-                        {
-                            if (entity.m_instance_id == render_entity.m_instance_id)
-                            {
-                                entity = render_entity;
-                                break;
-                            }
-                        }
+                        m_render_scene->updateRenderEntity(render_entity);
                     }
                 }
                 // after finished processing, pop this game object
@@ -376,6 +428,21 @@ namespace Piccolo
             m_swap_context.resetGameObjectResourceSwapData();
         }
 
+        // move render entities, the entities are found through their part ids without touching the descs
+        if (!swap_data.m_render_entity_deltas.isEmpty())
+        {
+            const RenderEntityDeltaStream& deltas = swap_data.m_render_entity_deltas;
+            for (const RenderEntityTransformDelta& delta : deltas.m_transform_deltas)
+            {
+                m_render_scene->updateRenderEntityTransform(delta.m_part_id,
+                                                            delta.m_model_matrix,
+                                                            deltas.m_joint_matrices.data() + delta.m_first_joint,
+                                                            delta.m_joint_count);
+            }
+
+            m_swap_context.resetRenderEntityDeltas();
+        }
+
         // remove deleted objects
         if (swap_data.m_game_object_to_delete.has_value())
         {
@@ -410,6 +477,20 @@ namespace Piccolo
             m_swap_context.resetCameraSwapData();
         }
 
+        // particles are simulated by the particle pass on the gpu, headless mode only drops the requests
+        if (swap_data.m_particle_submit_request.has_value() && m_is_headless)
+        {
+            m_swap_context.resetPartilceBatchSwapData();
+        }
+        if (swap_data.m_emitter_tick_request.has_value() && m_is_headless)
+        {
+            m_swap_context.resetEmitterTickSwapData();
+        }
+        if (swap_data.m_emitter_transform_request.has_value() && m_is_headless)
+        {
+            m_swap_context.resetEmitterTransformSwapData();
+        }
+
         if (swap_data.m_particle_submit_request.has_value())
         {
             std::shared_ptr<ParticlePass> particle_pass =
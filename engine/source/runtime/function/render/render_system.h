@@ -24,6 +24,8 @@ namespace Piccolo
     {
         std::shared_ptr<WindowSystem> window_system;
         std::shared_ptr<DebugDrawManager> debugdraw_manager;
+        // no window and no gpu, only the cpu side of the frame is processed
+        bool is_headless {false};
     };
 
     struct EngineContentViewport
@@ -49,6 +51,7 @@ namespace Piccolo
         std::shared_ptr<RenderCamera> getRenderCamera() const;
         std::shared_ptr<RHI>          getRHI() const;
 
+        bool      isHeadless() const { return m_is_headless; }
         void      setRenderPipelineType(RENDER_PIPELINE_TYPE pipeline_type);
         void      initializeUIRenderBackend(WindowUI* window_ui);
         void      updateEngineContentViewport(float offset_x, float offset_y, float width, float height);
@@ -63,13 +66,13 @@ namespace Piccolo
         GuidAllocator<GameObjectPartId>& getGOInstanceIdAllocator();
         GuidAllocator<MeshSourceDesc>&   getMeshAssetIdAllocator();
 
-        void clearForLevelReloading();
-
     private:
         RENDER_PIPELINE_TYPE m_render_pipeline_type {RENDER_PIPELINE_TYPE::DEFERRED_PIPELINE};
 
         RenderSwapContext m_swap_context;
 
+        bool m_is_headless {false};
+
         std::shared_ptr<RHI>                m_rhi;
         std::shared_ptr<RenderCamera>       m_render_camera;
         std::shared_ptr<RenderScene>        m_render_scene;
@@ -77,5 +80,7 @@ namespace Piccolo
         std::shared_ptr<RenderPipelineBase> m_render_pipeline;
 
         void processSwapData();
+        // hands what the main camera saw to the animation lod selection of the logic thread
+        void publishMainCameraView();
     };
 } // namespace Piccolo
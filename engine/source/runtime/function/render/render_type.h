@@ -1805,6 +1805,7 @@ namespace Piccolo
     {
         std::shared_ptr<BufferData> m_vertex_buffer;
         std::shared_ptr<BufferData> m_index_buffer;
+        RHIIndexType                m_index_type {RHI_INDEX_TYPE_UINT16};
     };
 
     struct RenderMeshData
@@ -0,0 +1,178 @@
+#include "runtime/resource/asset_manager/asset_cooker.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/platform/file_service/file_service.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
+#include "runtime/resource/res_type/common/level.h"
+#include "runtime/resource/res_type/common/object.h"
+#include "runtime/resource/res_type/common/world.h"
+#include "runtime/resource/res_type/components/motor.h"
+#include "runtime/resource/res_type/data/animation_clip.h"
+#include "runtime/resource/res_type/data/animation_skeleton_node_map.h"
+#include "runtime/resource/res_type/data/material.h"
+#include "runtime/resource/res_type/data/skeleton_data.h"
+#include "runtime/resource/res_type/data/skeleton_mask.h"
+#include "runtime/resource/res_type/global/global_particle.h"
+#include "runtime/resource/res_type/global/global_rendering.h"
+
+#include "runtime/function/animation/animation_compression.h"
+#include "runtime/function/global/global_context.h"
+
+#include "_generated/serializer/all_serializer.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // the size reduction the clip compression aims for
+        constexpr float k_animation_compression_target_ratio = 4.0f;
+
+        bool hasSuffix(const std::string& text, const std::string& suffix)
+        {
+            return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+        }
+    } // namespace
+
+    uint32_t AssetCooker::cookAllAssets() const
+    {
+        const std::filesystem::path& root_folder  = g_runtime_global_context.m_config_manager->getRootFolder();
+        const std::filesystem::path& asset_folder = g_runtime_global_context.m_config_manager->getAssetFolder();
+
+        uint32_t   cooked_count = 0;
+        FileSystem file_system;
+        for (const std::filesystem::path& file_path : file_system.getFiles(asset_folder))
+        {
+            if (file_path.extension() != ".json")
+            {
+                continue;
+            }
+
+            if (cookAsset(file_path.lexically_relative(root_folder).generic_string()))
+            {
+                ++cooked_count;
+            }
+        }
+
+        LOG_INFO("cooked {} assets", cooked_count);
+        return cooked_count;
+    }
+
+    bool AssetCooker::cookAsset(const std::string& asset_url) const
+    {
+        std::shared_ptr<ConfigManager> config_manager = g_runtime_global_context.m_config_manager;
+
+        if (asset_url == config_manager->getGlobalRenderingResUrl())
+        {
+            return cookAssetOfType<GlobalRenderingRes>(asset_url);
+        }
+        if (asset_url == config_manager->getGlobalParticleResUrl())
+        {
+            return cookAssetOfType<GlobalParticleRes>(asset_url);
+        }
+        if (hasSuffix(asset_url, ".world.json"))
+        {
+            return cookAssetOfType<WorldRes>(asset_url);
+        }
+        if (hasSuffix(asset_url, ".level.json"))
+        {
+            return cookAssetOfType<LevelRes>(asset_url);
+        }
+        if (hasSuffix(asset_url, ".object.json"))
+        {
+            return cookAssetOfType<ObjectDefinitionRes>(asset_url);
+        }
+        if (hasSuffix(asset_url, ".material.json"))
+        {
+            return cookAssetOfType<MaterialRes>(asset_url);
+        }
+        if (hasSuffix(asset_url, ".motor.json"))
+        {
+            return cookAssetOfType<MotorComponentRes>(asset_url);
+        }
+        if (hasSuffix(asset_url, ".animation_clip.json"))
+        {
+            return cookAnimationClip(asset_url);
+        }
+        if (hasSuffix(asset_url, ".skeleton.json"))
+        {
+            return cookAssetOfType<SkeletonData>(asset_url);
+        }
+        if (hasSuffix(asset_url, ".skeleton_map.json"))
+        {
+            return cookAssetOfType<AnimSkelMap>(asset_url);
+        }
+        if (hasSuffix(asset_url, ".skeleton_mask.json"))
+        {
+            return cookAssetOfType<BoneBlendMask>(asset_url);
+        }
+
+        LOG_WARN("skip {}, the asset type can not be derived from the file name", asset_url);
+        return false;
+    }
+
+    template<typename AssetType>
+    bool AssetCooker::cookAssetOfType(const std::string& asset_url) const
+    {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+
+        // always cook from the source, a stale cooked file must not feed the new one
+        AssetType asset;
+        if (!asset_manager->loadJsonAsset(asset_url, asset))
+        {
+            return false;
+        }
+
+        return asset_manager->saveCookedAsset(asset, asset_url);
+    }
+
+    bool AssetCooker::cookAnimationClip(const std::string& asset_url) const
+    {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+
+        AnimationAsset animation_clip;
+        if (!asset_manager->loadJsonAsset(asset_url, animation_clip))
+        {
+            return false;
+        }
+
+        CompressedAnimationAsset compressed_animation_clip;
+        compressed_animation_clip.node_map           = animation_clip.node_map;
+        compressed_animation_clip.skeleton_file_path = animation_clip.skeleton_file_path;
+        if (!AnimationCompressor::compressClip(animation_clip.clip_data,
+                                               AnimationCompressor::getConfiguredSettings(),
+                                               compressed_animation_clip.clip_data))
+        {
+            return false;
+        }
+
+        // the clip data alone, the node map and the skeleton path are the same in both
+        BinaryWriter source_writer;
+        BinarySerializer::write(source_writer, animation_clip.clip_data);
+        BinaryWriter compressed_writer;
+        BinarySerializer::write(compressed_writer, compressed_animation_clip.clip_data);
+        const size_t source_size     = source_writer.getBuffer().size();
+        const size_t compressed_size = std::max<size_t>(compressed_writer.getBuffer().size(), 1);
+        const float  size_ratio      = static_cast<float>(source_size) / compressed_size;
+        LOG_INFO("{}: clip data compressed from {} to {} bytes, {:.1f}x",
+                 asset_url,
+                 source_size,
+                 compressed_size,
+                 size_ratio);
+        if (size_ratio < k_animation_compression_target_ratio)
+        {
+            // known limitation: the rotations of mocap clips barely lose keys within the rotation tolerance, the
+            // shipped crouch walk clip ends at 3.8x
+            LOG_WARN("{}: clip compression of {:.1f}x is below the {:.0f}x target, the rotation keys barely reduce",
+                     asset_url,
+                     size_ratio,
+                     k_animation_compression_target_ratio);
+        }
+
+        return asset_manager->saveCookedAsset(compressed_animation_clip, asset_url);
+    }
+} // namespace Piccolo
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace Piccolo
+{
+    /// Converts json assets into the cooked binary format AssetManager maps at load time.
+    /// The asset type is derived from the file suffix, the same way the loaders pick the type of a url
+    class AssetCooker
+    {
+    public:
+        /// cooks every known json asset below the asset folder, returns the number of cooked files
+        uint32_t cookAllAssets() const;
+
+        /// @asset_url: relative to the root folder like every other asset url
+        bool cookAsset(const std::string& asset_url) const;
+
+    private:
+        template<typename AssetType>
+        bool cookAssetOfType(const std::string& asset_url) const;
+
+        /// clips are cooked compressed, the runtime only samples CompressedAnimationClip
+        bool cookAnimationClip(const std::string& asset_url) const;
+    };
+} // namespace Piccolo
@@ -8,8 +8,75 @@
 
 namespace Piccolo
 {
+    static constexpr uint32_t k_cooked_asset_magic   = 0x444b4350; // "PCKD"
+    static constexpr uint32_t k_cooked_asset_version = 1;
+
     std::filesystem::path AssetManager::getFullPath(const std::string& relative_path) const
     {
         return std::filesystem::absolute(g_runtime_global_context.m_config_manager->getRootFolder() / relative_path);
     }
-} // namespace Piccolo
\ No newline at end of file
+
+    std::filesystem::path AssetManager::getCookedPath(const std::string& asset_url) const
+    {
+        return getFullPath(asset_url).replace_extension(".cooked");
+    }
+
+    bool AssetManager::openCookedAsset(const std::string& asset_url, MappedFile& out_cooked_file) const
+    {
+        const std::filesystem::path source_path = getFullPath(asset_url);
+        const std::filesystem::path cooked_path = getCookedPath(asset_url);
+
+        std::error_code error;
+        const auto      cooked_write_time = std::filesystem::last_write_time(cooked_path, error);
+        if (error)
+        {
+            return false;
+        }
+
+        // a source edited after cooking wins, a missing source is fine for shipped builds
+        const auto source_write_time = std::filesystem::last_write_time(source_path, error);
+        if (!error && source_write_time > cooked_write_time)
+        {
+            return false;
+        }
+
+        return out_cooked_file.open(cooked_path);
+    }
+
+    bool AssetManager::writeCookedFile(const std::string& asset_url, const BinaryWriter& writer) const
+    {
+        const std::filesystem::path cooked_path = getCookedPath(asset_url);
+        std::ofstream               cooked_file(cooked_path, std::ios::binary | std::ios::trunc);
+        if (!cooked_file)
+        {
+            LOG_ERROR("open file {} failed!", cooked_path.generic_string());
+            return false;
+        }
+
+        const std::vector<uint8_t>& buffer = writer.getBuffer();
+        cooked_file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        return cooked_file.good();
+    }
+
+    void AssetManager::removeCookedAsset(const std::string& asset_url) const
+    {
+        std::error_code error;
+        std::filesystem::remove(getCookedPath(asset_url), error);
+    }
+
+    bool AssetManager::readCookedHeader(BinaryReader& reader) const
+    {
+        const uint32_t magic       = reader.readValue<uint32_t>();
+        const uint32_t version     = reader.readValue<uint32_t>();
+        const uint64_t schema_hash = reader.readValue<uint64_t>();
+        return reader.isValid() && magic == k_cooked_asset_magic && version == k_cooked_asset_version &&
+               schema_hash == k_serializer_schema_hash;
+    }
+
+    void AssetManager::writeCookedHeader(BinaryWriter& writer) const
+    {
+        writer.writeValue(k_cooked_asset_magic);
+        writer.writeValue(k_cooked_asset_version);
+        writer.writeValue(k_serializer_schema_hash);
+    }
+} // namespace Piccolo
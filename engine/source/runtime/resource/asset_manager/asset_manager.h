@@ -1,8 +1,11 @@
 #pragma once
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/meta/serializer/binary_serializer.h"
 #include "runtime/core/meta/serializer/serializer.h"
 
+#include "runtime/platform/file_service/mapped_file.h"
+
 #include <filesystem>
 #include <fstream>
 #include <functional>
@@ -16,8 +19,19 @@ namespace Piccolo
     class AssetManager
     {
     public:
+        /// loads the cooked binary version of the asset if it is up to date, the json source otherwise
         template<typename AssetType>
         bool loadAsset(const std::string& asset_url, AssetType& out_asset) const
+        {
+            if (loadCookedAsset(asset_url, out_asset))
+            {
+                return true;
+            }
+            return loadJsonAsset(asset_url, out_asset);
+        }
+
+        template<typename AssetType>
+        bool loadJsonAsset(const std::string& asset_url, AssetType& out_asset) const
         {
             // read json file to string
             std::filesystem::path asset_path = getFullPath(asset_url);
@@ -45,6 +59,35 @@ namespace Piccolo
             return true;
         }
 
+        /// reads the asset straight from the mapped cooked file, fails quietly if there is no usable cooked file
+        template<typename AssetType>
+        bool loadCookedAsset(const std::string& asset_url, AssetType& out_asset) const
+        {
+            MappedFile cooked_file;
+            if (!openCookedAsset(asset_url, cooked_file))
+            {
+                return false;
+            }
+
+            BinaryReader reader(cooked_file.getData(), cooked_file.getSize());
+            if (!readCookedHeader(reader))
+            {
+                LOG_WARN("cooked asset of {} was cooked with another schema, load json instead", asset_url);
+                return false;
+            }
+
+            AssetType cooked_asset;
+            BinarySerializer::read(reader, cooked_asset);
+            if (!reader.isValid() || reader.getOffset() != reader.getSize())
+            {
+                LOG_WARN("cooked asset of {} is corrupted, load json instead", asset_url);
+                return false;
+            }
+
+            out_asset = std::move(cooked_asset);
+            return true;
+        }
+
         template<typename AssetType>
         bool saveAsset(const AssetType& out_asset, const std::string& asset_url) const
         {
@@ -63,10 +106,32 @@ namespace Piccolo
             asset_json_file << asset_json_text;
             asset_json_file.flush();
 
+            // the cooked version no longer matches the source
+            removeCookedAsset(asset_url);
+
             return true;
         }
 
+        template<typename AssetType>
+        bool saveCookedAsset(const AssetType& asset, const std::string& asset_url) const
+        {
+            BinaryWriter writer;
+            writeCookedHeader(writer);
+            BinarySerializer::write(writer, asset);
+            return writeCookedFile(asset_url, writer);
+        }
+
         std::filesystem::path getFullPath(const std::string& relative_path) const;
 
+        /// cooked files sit next to their source with the .json extension replaced
+        std::filesystem::path getCookedPath(const std::string& asset_url) const;
+
+    private:
+        bool openCookedAsset(const std::string& asset_url, MappedFile& out_cooked_file) const;
+        bool writeCookedFile(const std::string& asset_url, const BinaryWriter& writer) const;
+        void removeCookedAsset(const std::string& asset_url) const;
+
+        bool readCookedHeader(BinaryReader& reader) const;
+        void writeCookedHeader(BinaryWriter& writer) const;
     };
 } // namespace Piccolo
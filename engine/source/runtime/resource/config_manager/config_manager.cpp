@@ -2,12 +2,34 @@
 
 #include "runtime/engine.h"
 
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <string>
 
 namespace Piccolo
 {
+    namespace
+    {
+        // the log system starts after the config, a malformed or negative value keeps the default silently
+        void parseTolerance(const std::string& value, float& out_tolerance)
+        {
+            char*       end       = nullptr;
+            const float tolerance = std::strtof(value.c_str(), &end);
+            const bool  is_parsed = end != value.c_str();
+            while (std::isspace(static_cast<unsigned char>(*end)))
+            {
+                ++end;
+            }
+            if (is_parsed && *end == '\0' && std::isfinite(tolerance) && tolerance >= 0.0f)
+            {
+                out_tolerance = tolerance;
+            }
+        }
+    } // namespace
+
     void ConfigManager::initialize(const std::filesystem::path& config_file_path)
     {
         // read configs
@@ -48,6 +70,14 @@ namespace Piccolo
                 {
                     m_editor_font_path = m_root_folder / value;
                 }
+                else if (name == "ImportCacheFolder")
+                {
+                    // an empty value disables the cache
+                    if (!value.empty())
+                    {
+                        m_import_cache_folder = m_root_folder / value;
+                    }
+                }
                 else if (name == "GlobalRenderingRes")
                 {
                     m_global_rendering_res_url = value;
@@ -56,6 +86,26 @@ namespace Piccolo
                 {
                     m_global_particle_res_url = value;
                 }
+                else if (name == "AnimationPositionTolerance")
+                {
+                    parseTolerance(value, m_animation_position_tolerance);
+                }
+                else if (name == "AnimationRotationTolerance")
+                {
+                    parseTolerance(value, m_animation_rotation_tolerance);
+                }
+                else if (name == "AnimationScalingTolerance")
+                {
+                    parseTolerance(value, m_animation_scaling_tolerance);
+                }
+                else if (name == "EnableComponentStore")
+                {
+                    m_enable_component_store = value == "1" || value == "true";
+                }
+                else if (name == "EnableRenderThread")
+                {
+                    m_enable_render_thread = value == "1" || value == "true";
+                }
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
                 else if (name == "JoltAssetFolder")
                 {
@@ -78,6 +128,8 @@ namespace Piccolo
 
     const std::filesystem::path& ConfigManager::getEditorFontPath() const { return m_editor_font_path; }
 
+    const std::filesystem::path& ConfigManager::getImportCacheFolder() const { return m_import_cache_folder; }
+
     const std::string& ConfigManager::getDefaultWorldUrl() const { return m_default_world_url; }
 
     const std::string& ConfigManager::getGlobalRenderingResUrl() const { return m_global_rendering_res_url; }
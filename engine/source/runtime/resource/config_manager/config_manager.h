@@ -17,6 +17,8 @@ namespace Piccolo
         const std::filesystem::path& getEditorBigIconPath() const;
         const std::filesystem::path& getEditorSmallIconPath() const;
         const std::filesystem::path& getEditorFontPath() const;
+        // empty if the import cache is disabled
+        const std::filesystem::path& getImportCacheFolder() const;
 
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         const std::filesystem::path& getJoltPhysicsAssetFolder() const;
@@ -26,6 +28,14 @@ namespace Piccolo
         const std::string& getGlobalRenderingResUrl() const;
         const std::string& getGlobalParticleResUrl() const;
 
+        // the error animation clips are compressed to, see AnimationCompressionSettings
+        float getAnimationPositionTolerance() const { return m_animation_position_tolerance; }
+        float getAnimationRotationTolerance() const { return m_animation_rotation_tolerance; }
+        float getAnimationScalingTolerance() const { return m_animation_scaling_tolerance; }
+
+        bool isComponentStoreEnabled() const { return m_enable_component_store; }
+        bool isRenderThreadEnabled() const { return m_enable_render_thread; }
+
     private:
         std::filesystem::path m_root_folder;
         std::filesystem::path m_asset_folder;
@@ -33,6 +43,7 @@ namespace Piccolo
         std::filesystem::path m_editor_big_icon_path;
         std::filesystem::path m_editor_small_icon_path;
         std::filesystem::path m_editor_font_path;
+        std::filesystem::path m_import_cache_folder;
 
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         std::filesystem::path m_jolt_physics_asset_folder;
@@ -41,5 +52,12 @@ namespace Piccolo
         std::string m_default_world_url;
         std::string m_global_rendering_res_url;
         std::string m_global_particle_res_url;
+
+        float m_animation_position_tolerance {0.0005f};
+        float m_animation_rotation_tolerance {0.001f};
+        float m_animation_scaling_tolerance {0.0005f};
+
+        bool m_enable_component_store {false};
+        bool m_enable_render_thread {false};
     };
 } // namespace Piccolo
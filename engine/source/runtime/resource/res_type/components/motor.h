@@ -34,7 +34,7 @@ namespace Piccolo
     };
 
     REFLECTION_TYPE(MotorComponentRes)
-    CLASS(MotorComponentRes, Fields)
+    CLASS(MotorComponentRes, Fields, LuaBinding)
     {
         REFLECTION_BODY(MotorComponentRes);
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "runtime/core/math/transform.h"
 #include "runtime/core/meta/reflection/reflection.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 namespace Piccolo
@@ -49,4 +50,47 @@ namespace Piccolo
         std::string   skeleton_file_path;
     };
 
+    /// The keys of one kind of track (position, rotation or scaling) of all nodes of a clip, stored together so
+    /// sampling walks one array per kind. The keys of node i are [key_offsets[i], key_offsets[i + 1]), each key
+    /// is a frame and three quantized components
+    REFLECTION_TYPE(CompressedAnimationTrackGroup)
+    CLASS(CompressedAnimationTrackGroup, Fields)
+    {
+        REFLECTION_BODY(CompressedAnimationTrackGroup);
+
+    public:
+        // the meta parser drops the spaces of the type names, so the fields use the fixed width aliases
+        std::vector<uint32_t> key_offsets;
+        std::vector<uint16_t> key_frames;
+        std::vector<uint16_t> key_values;
+        // minimum and quantization step per component and node of the quantized vectors, empty for rotations
+        std::vector<float> ranges;
+    };
+
+    /// AnimationClip with the redundant keys removed and the remaining keys quantized, see AnimationCompressor
+    REFLECTION_TYPE(CompressedAnimationClip)
+    CLASS(CompressedAnimationClip, Fields)
+    {
+        REFLECTION_BODY(CompressedAnimationClip);
+
+    public:
+        int                           total_frame {0};
+        int                           node_count {0};
+        CompressedAnimationTrackGroup position_tracks;
+        CompressedAnimationTrackGroup rotation_tracks;
+        CompressedAnimationTrackGroup scaling_tracks;
+    };
+
+    /// the cooked form of AnimationAsset
+    REFLECTION_TYPE(CompressedAnimationAsset)
+    CLASS(CompressedAnimationAsset, Fields)
+    {
+        REFLECTION_BODY(CompressedAnimationAsset);
+
+    public:
+        AnimNodeMap             node_map;
+        CompressedAnimationClip clip_data;
+        std::string             skeleton_file_path;
+    };
+
 } // namespace Piccolo
\ No newline at end of file
@@ -46,6 +46,25 @@ namespace Piccolo
         Color   m_color;
     };
 
+    REFLECTION_TYPE(AnimationLodConfig)
+    CLASS(AnimationLodConfig, Fields)
+    {
+        REFLECTION_BODY(AnimationLodConfig);
+
+    public:
+        bool m_enable {true};
+        // fraction of the screen height covered by a character below which the reduced / minimal lod is used
+        float m_reduced_screen_coverage {0.25f};
+        float m_minimal_screen_coverage {0.08f};
+        // frames between two evaluations of the skeleton, the frames in between are interpolated
+        int m_reduced_update_interval {2};
+        int m_minimal_update_interval {4};
+        // at the minimal lod, bones deeper in the hierarchy than this, like the fingers, keep their binding pose
+        int m_minimal_max_bone_depth {8};
+        // characters culled by the main camera are not evaluated
+        bool m_skip_culled {true};
+    };
+
     REFLECTION_TYPE(GlobalRenderingRes)
     CLASS(GlobalRenderingRes, Fields)
     {
@@ -62,5 +81,7 @@ namespace Piccolo
         Color            m_ambient_light;
         CameraConfig     m_camera_config;
         DirectionalLight m_directional_light;
+
+        AnimationLodConfig m_animation_lod_config;
     };
 } // namespace Piccolo
\ No newline at end of file